@@ -0,0 +1,119 @@
+# ************************************************************************
+# * This file is part of GGEMS.                                          *
+# *                                                                      *
+# * GGEMS is free software: you can redistribute it and/or modify        *
+# * it under the terms of the GNU General Public License as published by *
+# * the Free Software Foundation, either version 3 of the License, or    *
+# * (at your option) any later version.                                  *
+# *                                                                      *
+# * GGEMS is distributed in the hope that it will be useful,             *
+# * but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+# * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+# * GNU General Public License for more details.                         *
+# *                                                                      *
+# * You should have received a copy of the GNU General Public License    *
+# * along with GGEMS.  If not, see <https://www.gnu.org/licenses/>.      *
+# *                                                                      *
+# ************************************************************************
+
+#-------------------------------------------------------------------------------
+# GGEMSSPIRVKernels.cmake
+#
+# Precompile the OpenCL kernel variants used by GGEMS to SPIR-V (target
+# ggems_spirv_kernels). A SPIR-V file is named after the kernel file and the
+# sorted macros of the variant, the same name is built at runtime by
+# GGEMSOpenCLManager::GetSPIRVFilename
+#
+# Authors :
+#   - Julien Bert <julien.bert@univ-brest.fr>
+#   - Didier Benoit <didier.benoit@inserm.fr>
+#
+# Generated on : 18/10/2026
+#-------------------------------------------------------------------------------
+
+FIND_PROGRAM(CLANG_OPENCL_COMPILER NAMES clang)
+FIND_PROGRAM(LLVM_SPIRV_TRANSLATOR NAMES llvm-spirv)
+IF(NOT CLANG_OPENCL_COMPILER OR NOT LLVM_SPIRV_TRANSLATOR)
+  MESSAGE(FATAL_ERROR "clang and llvm-spirv are mandatory to precompile OpenCL kernels to SPIR-V!!!")
+ENDIF()
+
+#-------------------------------------------------------------------------------
+# Kernel variants: kernel file and macros separated by ':'
+SET(SPIRV_KERNEL_VARIANTS
+  "IsAlive"
+  "GetPrimariesGGEMSXRaySource"
+  "GetPrimariesGGEMSXRaySource:GGEMS_TRACKING"
+  "GetPrimariesGGEMSPhaseSpaceSource"
+  "GetPrimariesGGEMSPhaseSpaceSource:GGEMS_TRACKING"
+  "WorldTracking"
+  "WorldTracking:GGEMS_TRACKING"
+  "ComputeDoseGGEMSVoxelizedSolid"
+  "ParticleSolidDistanceGGEMSMotherVolume"
+  "ParticleSolidDistanceGGEMSMotherVolume:GGEMS_TRACKING"
+  "ProjectToGGEMSMotherVolume"
+  "ProjectToGGEMSMotherVolume:GGEMS_TRACKING"
+  "PrepareProjectToSolid"
+)
+
+# Same variants for the three kernels of a solid (distance, projection and tracking)
+SET(SPIRV_SOLID_VARIANTS
+  "GGEMSVoxelizedSolid"
+  "GGEMSVoxelizedSolid:DOSIMETRY"
+  "GGEMSVoxelizedSolid:DOSIMETRY:TLE"
+  "GGEMSVoxelizedSolid:DOSIMETRY:CSDA"
+  "GGEMSVoxelizedSolid:PHASE_SPACE"
+  "GGEMSVoxelizedSolid:DOSIMETRY:PHASE_SPACE"
+  "GGEMSSolidBox:HISTOGRAM"
+  "GGEMSSolidBox:HISTOGRAM:ANTI_SCATTER_GRID"
+  "GGEMSSolidBox:HISTOGRAM:MODULE_LAYERS"
+  "GGEMSSolidBox:HISTOGRAM:ANTI_SCATTER_GRID:MODULE_LAYERS"
+  "GGEMSSolidArc:HISTOGRAM"
+  "GGEMSSolidArc:HISTOGRAM:ANTI_SCATTER_GRID"
+  "GGEMSSolidMesh"
+  "GGEMSSolidPrimitive"
+)
+FOREACH(SOLID_VARIANT ${SPIRV_SOLID_VARIANTS})
+  FOREACH(SOLID_KERNEL ParticleSolidDistance ProjectTo TrackThrough)
+    LIST(APPEND SPIRV_KERNEL_VARIANTS "${SOLID_KERNEL}${SOLID_VARIANT}")
+  ENDFOREACH()
+ENDFOREACH()
+
+#-------------------------------------------------------------------------------
+# Options of GGEMSOpenCLManager::SetOpenCLCompilationOptions
+SET(SPIRV_COMPILATION_OPTIONS -cl-std=CL1.2 -cl-fast-relaxed-math -w -O3 -target spir64 -emit-llvm -Xclang -finclude-default-header -I${GGEMS_PATH}/include)
+
+SET(SPIRV_KERNEL_FILES "")
+FOREACH(KERNEL_VARIANT ${SPIRV_KERNEL_VARIANTS})
+  STRING(REPLACE ":" ";" KERNEL_VARIANT_LIST ${KERNEL_VARIANT})
+  LIST(GET KERNEL_VARIANT_LIST 0 KERNEL_NAME)
+  LIST(REMOVE_AT KERNEL_VARIANT_LIST 0)
+
+  # Global macros added to all kernels
+  IF(DOSIMETRY_DOUBLE_PRECISION)
+    LIST(APPEND KERNEL_VARIANT_LIST DOSIMETRY_DOUBLE_PRECISION)
+  ENDIF()
+  IF(OPENGL_VISUALIZATION)
+    LIST(APPEND KERNEL_VARIANT_LIST OPENGL)
+  ENDIF()
+  LIST(SORT KERNEL_VARIANT_LIST)
+
+  SET(SPIRV_NAME ${KERNEL_NAME})
+  SET(KERNEL_MACROS "")
+  FOREACH(KERNEL_MACRO ${KERNEL_VARIANT_LIST})
+    SET(SPIRV_NAME "${SPIRV_NAME}_${KERNEL_MACRO}")
+    LIST(APPEND KERNEL_MACROS -D${KERNEL_MACRO})
+  ENDFOREACH()
+
+  ADD_CUSTOM_COMMAND(
+    OUTPUT ${OPENCL_SPIRV_PATH}/${SPIRV_NAME}.spv
+    COMMAND ${CMAKE_COMMAND} -E make_directory ${OPENCL_SPIRV_PATH}
+    COMMAND ${CLANG_OPENCL_COMPILER} -c ${SPIRV_COMPILATION_OPTIONS} ${KERNEL_MACROS} ${OPENCL_KERNEL_PATH}/${KERNEL_NAME}.cl -o ${OPENCL_SPIRV_PATH}/${SPIRV_NAME}.bc
+    COMMAND ${LLVM_SPIRV_TRANSLATOR} ${OPENCL_SPIRV_PATH}/${SPIRV_NAME}.bc -o ${OPENCL_SPIRV_PATH}/${SPIRV_NAME}.spv
+    DEPENDS ${OPENCL_KERNEL_PATH}/${KERNEL_NAME}.cl
+    IMPLICIT_DEPENDS C ${OPENCL_KERNEL_PATH}/${KERNEL_NAME}.cl
+    COMMENT "Precompiling OpenCL kernel ${SPIRV_NAME} to SPIR-V"
+  )
+  LIST(APPEND SPIRV_KERNEL_FILES ${OPENCL_SPIRV_PATH}/${SPIRV_NAME}.spv)
+ENDFOREACH()
+
+ADD_CUSTOM_TARGET(ggems_spirv_kernels ALL DEPENDS ${SPIRV_KERNEL_FILES})
@@ -0,0 +1,144 @@
+#ifndef GUARD_GGEMS_GEOMETRIES_GGEMSANTISCATTERGRID_HH
+#define GUARD_GGEMS_GEOMETRIES_GGEMSANTISCATTERGRID_HH
+
+// ************************************************************************
+// * This file is part of GGEMS.                                          *
+// *                                                                      *
+// * GGEMS is free software: you can redistribute it and/or modify        *
+// * it under the terms of the GNU General Public License as published by *
+// * the Free Software Foundation, either version 3 of the License, or    *
+// * (at your option) any later version.                                  *
+// *                                                                      *
+// * GGEMS is distributed in the hope that it will be useful,             *
+// * but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+// * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+// * GNU General Public License for more details.                         *
+// *                                                                      *
+// * You should have received a copy of the GNU General Public License    *
+// * along with GGEMS.  If not, see <https://www.gnu.org/licenses/>.      *
+// *                                                                      *
+// ************************************************************************
+
+/*!
+  \file GGEMSAntiScatterGrid.hh
+
+  \brief Analytic model of a linear focused anti-scatter grid placed on the entrance face of a detector
+
+  \author Julien BERT <julien.bert@univ-brest.fr>
+  \author Didier BENOIT <didier.benoit@inserm.fr>
+  \author LaTIM, INSERM - U1101, Brest, FRANCE
+  \version 1.0
+  \date Sunday October 18, 2026
+*/
+
+#include "GGEMS/tools/GGEMSTypes.hh"
+
+/*!
+  \struct GGEMSAntiScatterGrid_t
+  \brief Structure storing parameters of a linear focused anti-scatter grid, lamellae are parallel to local X axis of detector
+*/
+typedef struct GGEMSAntiScatterGrid_t
+{
+  GGfloat lamella_pitch_; /*!< Distance between center of two lamellae */
+  GGfloat lamella_thickness_; /*!< Thickness of a lamella */
+  GGfloat lamella_height_; /*!< Height of lamella (grid thickness) */
+  GGfloat focus_distance_; /*!< Distance between focus line and entrance face of detector */
+  GGfloat focus_position_; /*!< Lateral position of focus line in local frame of detector */
+  GGint lamella_material_id_; /*!< Index of lamella material in navigator */
+  GGint interspace_material_id_; /*!< Index of interspace material in navigator */
+} GGEMSAntiScatterGrid; /*!< Using C convention name of struct to C++ (_t deletion) */
+
+#ifdef __OPENCL_C_VERSION__
+
+#include "GGEMS/physics/GGEMSMuData.hh"
+#include "GGEMS/geometries/GGEMSGeometryConstants.hh"
+#include "GGEMS/maths/GGEMSMathAlgorithms.hh"
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+  \fn inline GGfloat GetAttenuationAnalytically(global GGEMSMuMuEnData const* attenuations, GGint const material_id, GGfloat const energy)
+  \param attenuations - pointer on attenuation values
+  \param material_id - index of material
+  \param energy - energy of particle
+  \return linear attenuation coefficient in cm-1
+  \brief Interpolate the linear attenuation coefficient of a material
+*/
+inline GGfloat GetAttenuationAnalytically(global GGEMSMuMuEnData const* attenuations, GGint const material_id, GGfloat const energy)
+{
+  GGint E_index = BinarySearchLeft(energy, attenuations->energy_bins_, attenuations->number_of_bins_, 0, 0);
+
+  if (E_index == 0) return attenuations->mu_[material_id*attenuations->number_of_bins_];
+
+  return LinearInterpolation(
+    attenuations->energy_bins_[E_index-1], attenuations->mu_[material_id*attenuations->number_of_bins_ + E_index-1],
+    attenuations->energy_bins_[E_index], attenuations->mu_[material_id*attenuations->number_of_bins_ + E_index],
+    energy
+  );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+  \fn inline GGfloat GetCumulativeLamellaLength(GGfloat const lateral_position, GGfloat const pitch, GGfloat const thickness)
+  \param lateral_position - lateral position, origin at the left border of a lamella
+  \param pitch - distance between two lamellae
+  \param thickness - thickness of lamella
+  \return cumulative length covered by lamellae between 0 and lateral position
+  \brief Compute the cumulative length covered by lamellae along the grid
+*/
+inline GGfloat GetCumulativeLamellaLength(GGfloat const lateral_position, GGfloat const pitch, GGfloat const thickness)
+{
+  GGfloat period = floor(lateral_position / pitch);
+  return period*thickness + fmin(lateral_position - period*pitch, thickness);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+  \fn inline GGfloat ComputeAntiScatterGridTransmission(global GGEMSAntiScatterGrid const* grid, global GGEMSMuMuEnData const* attenuations, GGfloat const lateral_position, GGfloat const relative_slope, GGfloat const path_length, GGfloat const energy)
+  \param grid - pointer on anti-scatter grid parameters
+  \param attenuations - pointer on attenuation values
+  \param lateral_position - lateral position of particle on the entrance face, origin on focus line
+  \param relative_slope - lateral displacement of particle per unit of height, relative to the lamella crossed
+  \param path_length - length of particle path inside the grid
+  \param energy - energy of particle
+  \return probability for the particle to cross the grid
+  \brief Compute analytically the transmission of a particle through a linear anti-scatter grid. The particle path is traced back over the lamella height, the fraction of the path inside the lamellae is computed from the periodic structure of the grid
+*/
+inline GGfloat ComputeAntiScatterGridTransmission(global GGEMSAntiScatterGrid const* grid, global GGEMSMuMuEnData const* attenuations, GGfloat const lateral_position, GGfloat const relative_slope, GGfloat const path_length, GGfloat const energy)
+{
+  GGfloat pitch = grid->lamella_pitch_;
+  GGfloat thickness = grid->lamella_thickness_;
+
+  // Lateral interval crossed by the particle, origin at the left border of a lamella
+  GGfloat lateral_end = lateral_position + thickness*0.5f;
+  GGfloat lateral_start = lateral_end - relative_slope*grid->lamella_height_;
+  GGfloat lateral_shift = fabs(lateral_end - lateral_start);
+
+  // Fraction of path inside lamellae
+  GGfloat lamella_fraction = 0.0f;
+  if (lateral_shift < EPSILON6) {
+    GGfloat phase = lateral_end - floor(lateral_end / pitch)*pitch;
+    lamella_fraction = phase < thickness ? 1.0f : 0.0f;
+  }
+  else {
+    lamella_fraction = fabs(GetCumulativeLamellaLength(lateral_end, pitch, thickness) - GetCumulativeLamellaLength(lateral_start, pitch, thickness)) / lateral_shift;
+  }
+
+  // Attenuation coefficients in cm-1, path length in mm
+  GGfloat mu_lamella = GetAttenuationAnalytically(attenuations, grid->lamella_material_id_, energy);
+  GGfloat mu_interspace = GetAttenuationAnalytically(attenuations, grid->interspace_material_id_, energy);
+
+  return exp(-(lamella_fraction*mu_lamella + (1.0f-lamella_fraction)*mu_interspace) * path_length * 0.1f);
+}
+
+#endif
+
+#endif // GUARD_GGEMS_GEOMETRIES_GGEMSANTISCATTERGRID_HH
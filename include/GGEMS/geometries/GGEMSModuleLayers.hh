@@ -0,0 +1,94 @@
+#ifndef GUARD_GGEMS_GEOMETRIES_GGEMSMODULELAYERS_HH
+#define GUARD_GGEMS_GEOMETRIES_GGEMSMODULELAYERS_HH
+
+// ************************************************************************
+// * This file is part of GGEMS.                                          *
+// *                                                                      *
+// * GGEMS is free software: you can redistribute it and/or modify        *
+// * it under the terms of the GNU General Public License as published by *
+// * the Free Software Foundation, either version 3 of the License, or    *
+// * (at your option) any later version.                                  *
+// *                                                                      *
+// * GGEMS is distributed in the hope that it will be useful,             *
+// * but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+// * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+// * GNU General Public License for more details.                         *
+// *                                                                      *
+// * You should have received a copy of the GNU General Public License    *
+// * along with GGEMS.  If not, see <https://www.gnu.org/licenses/>.      *
+// *                                                                      *
+// ************************************************************************
+
+/*!
+  \file GGEMSModuleLayers.hh
+
+  \brief Stack of material layers along the normal of a detector module (local Z axis), layer boundaries are planes handled analytically
+
+  \author Julien BERT <julien.bert@univ-brest.fr>
+  \author Didier BENOIT <didier.benoit@inserm.fr>
+  \author LaTIM, INSERM - U1101, Brest, FRANCE
+  \version 1.0
+  \date Sunday October 18, 2026
+*/
+
+#include "GGEMS/tools/GGEMSTypes.hh"
+
+#define MAXIMUM_MODULE_LAYERS 8 /*!< Maximum number of layers in a detector module */
+
+/*!
+  \struct GGEMSModuleLayers_t
+  \brief Structure storing the layers of a detector module, first layer is on the entrance face of module
+*/
+typedef struct GGEMSModuleLayers_t
+{
+  GGint number_of_layers_; /*!< Number of layers in module */
+  GGint sensitive_layer_; /*!< Index of layer where interactions are counted */
+  GGfloat layer_z_min_[MAXIMUM_MODULE_LAYERS+1]; /*!< Boundaries of layers along local Z axis, layer i is between layer_z_min_[i] and layer_z_min_[i+1] */
+  GGint layer_material_id_[MAXIMUM_MODULE_LAYERS]; /*!< Index of layer material in navigator */
+} GGEMSModuleLayers; /*!< Using C convention name of struct to C++ (_t deletion) */
+
+#ifdef __OPENCL_C_VERSION__
+
+#include "GGEMS/physics/GGEMSParticleConstants.hh"
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+  \fn inline GGint GetModuleLayer(global GGEMSModuleLayers const* layers, GGfloat const z)
+  \param layers - pointer on layers of module
+  \param z - position along local Z axis
+  \return index of layer containing the position
+  \brief Find the layer containing a position, position outside the stack is clamped to first or last layer
+*/
+inline GGint GetModuleLayer(global GGEMSModuleLayers const* layers, GGfloat const z)
+{
+  GGint layer = 0;
+  while (layer < layers->number_of_layers_-1 && z >= layers->layer_z_min_[layer+1]) ++layer;
+  return layer;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+  \fn inline GGfloat ComputeDistanceToModuleLayerBoundary(global GGEMSModuleLayers const* layers, GGint const layer, GGfloat const z, GGfloat const dz)
+  \param layers - pointer on layers of module
+  \param layer - index of current layer
+  \param z - position along local Z axis
+  \param dz - direction along local Z axis
+  \return distance to the next plane boundary of current layer
+  \brief Compute distance to the boundary of current layer along the direction of particle
+*/
+inline GGfloat ComputeDistanceToModuleLayerBoundary(global GGEMSModuleLayers const* layers, GGint const layer, GGfloat const z, GGfloat const dz)
+{
+  if (dz > 0.0f) return (layers->layer_z_min_[layer+1] - z) / dz;
+  if (dz < 0.0f) return (layers->layer_z_min_[layer] - z) / dz;
+  return OUT_OF_WORLD;
+}
+
+#endif
+
+#endif // GUARD_GGEMS_GEOMETRIES_GGEMSMODULELAYERS_HH
@@ -0,0 +1,47 @@
+#ifndef GUARD_GGEMS_GEOMETRIES_GGEMSMOTHERVOLUMEDATA_HH
+#define GUARD_GGEMS_GEOMETRIES_GGEMSMOTHERVOLUMEDATA_HH
+
+// ************************************************************************
+// * This file is part of GGEMS.                                          *
+// *                                                                      *
+// * GGEMS is free software: you can redistribute it and/or modify        *
+// * it under the terms of the GNU General Public License as published by *
+// * the Free Software Foundation, either version 3 of the License, or    *
+// * (at your option) any later version.                                  *
+// *                                                                      *
+// * GGEMS is distributed in the hope that it will be useful,             *
+// * but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+// * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+// * GNU General Public License for more details.                         *
+// *                                                                      *
+// * You should have received a copy of the GNU General Public License    *
+// * along with GGEMS.  If not, see <https://www.gnu.org/licenses/>.      *
+// *                                                                      *
+// ************************************************************************
+
+/*!
+  \file GGEMSMotherVolumeData.hh
+
+  \brief Structure storing the data for mother volume, a box containing daughter navigators
+
+  \author Julien BERT <julien.bert@univ-brest.fr>
+  \author Didier BENOIT <didier.benoit@inserm.fr>
+  \author LaTIM, INSERM - U1101, Brest, FRANCE
+  \version 1.0
+  \date Sunday October 18, 2026
+*/
+
+#include "GGEMS/geometries/GGEMSPrimitiveGeometries.hh"
+
+/*!
+  \struct GGEMSMotherVolumeData_t
+  \brief Structure storing the stack of data for mother volume
+*/
+typedef struct GGEMSMotherVolumeData_t
+{
+  GGEMSOBB obb_geometry_; /*!< OBB storing border of mother volume and matrix of transformation */
+  GGint solid_id_; /*!< Solid index of mother volume, after solids of navigators */
+  GGint mother_id_; /*!< Solid index of mother volume containing this mother volume, -1 if world */
+} GGEMSMotherVolumeData; /*!< Using C convention name of struct to C++ (_t deletion) */
+
+#endif // GUARD_GGEMS_GEOMETRIES_GGEMSMOTHERVOLUMEDATA_HH
@@ -39,9 +39,24 @@
 */
 typedef struct GGEMSOBB_t
 {
-  GGfloat44 matrix_transformation_; /*!< Matrix of transformation including angle of rotation */
+  GGEMSTransformationMatrix matrix_transformation_; /*!< Transformation including angle of rotation, and its inverse */
   GGfloat3 border_min_xyz_; /*!< Min. of border in X, Y and Z */
   GGfloat3 border_max_xyz_; /*!< Max. of border in X, Y and Z */
 } GGEMSOBB; /*!< Using C convention name of struct to C++ (_t deletion) */
 
+/*!
+  \struct GGEMSArc_t
+  \brief Structure storing a cylindrical arc geometry, axis of cylinder along local Z and arc centered on local X
+*/
+typedef struct GGEMSArc_t
+{
+  GGEMSTransformationMatrix matrix_transformation_; /*!< Transformation including angle of rotation, and its inverse, origin is the center of cylinder */
+  GGfloat radius_min_; /*!< Inner radius of arc */
+  GGfloat radius_max_; /*!< Outer radius of arc */
+  GGfloat angle_min_; /*!< Min. angle of arc in local XY plane (from local X axis) */
+  GGfloat angle_max_; /*!< Max. angle of arc in local XY plane (from local X axis) */
+  GGfloat z_min_; /*!< Min. of border in Z */
+  GGfloat z_max_; /*!< Max. of border in Z */
+} GGEMSArc; /*!< Using C convention name of struct to C++ (_t deletion) */
+
 #endif // GUARD_GGEMS_GEOMETRIES_GGEMSPRIMITIVEGEOMETRIES_HH
@@ -37,6 +37,8 @@
 
 #include "GGEMS/geometries/GGEMSGeometryConstants.hh"
 #include "GGEMS/geometries/GGEMSVoxelizedSolidData.hh"
+#include "GGEMS/geometries/GGEMSSolidMeshData.hh"
+#include "GGEMS/geometries/GGEMSSolidPrimitiveData.hh"
 
 #include "GGEMS/maths/GGEMSMatrixOperations.hh"
 #include "GGEMS/maths/GGEMSReferentialTransformation.hh"
@@ -325,6 +327,459 @@ inline GGfloat ComputeDistanceToOBB(GGfloat3 const* position, GGfloat3 const* di
   );
 }
 
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+  \fn inline void TransportGetSafetyInsideArc(GGfloat3* position, global GGEMSArc const* arc_data, GGfloat const tolerance)
+  \param position - pointer on primary particle position in local arc frame
+  \param arc_data - arc data infos
+  \param tolerance - tolerance for geometry
+  \brief Moving particle slightly inside a cylindrical arc solid
+*/
+inline void TransportGetSafetyInsideArc(GGfloat3* position, global GGEMSArc const* arc_data, GGfloat const tolerance)
+{
+  // Polar coordinates in XY plane
+  GGfloat radius = sqrt(position->x*position->x + position->y*position->y);
+  GGfloat angle = atan2(position->y, position->x);
+
+  GGfloat new_radius = clamp(radius, arc_data->radius_min_ + tolerance, arc_data->radius_max_ - tolerance);
+  GGfloat angle_tolerance = tolerance / new_radius;
+  GGfloat new_angle = clamp(angle, arc_data->angle_min_ + angle_tolerance, arc_data->angle_max_ - angle_tolerance);
+
+  // Only rebuild position if necessary, avoiding float drift
+  if (new_radius != radius || new_angle != angle) {
+    position->x = new_radius * cos(new_angle);
+    position->y = new_radius * sin(new_angle);
+  }
+
+  position->z = clamp(position->z, arc_data->z_min_ + tolerance, arc_data->z_max_ - tolerance);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+  \fn inline GGchar IsParticleInArc(GGfloat3 const* position, global GGEMSArc const* arc_data, GGfloat const tolerance)
+  \param position - pointer on primary particle position in local arc frame
+  \param arc_data - arc data infos
+  \param tolerance - tolerance for geometry
+  \return false if particle outside arc object, and true if particle inside arc object
+  \brief Check if particle is inside or outside cylindrical arc object
+*/
+inline GGchar IsParticleInArc(GGfloat3 const* position, global GGEMSArc const* arc_data, GGfloat const tolerance)
+{
+  if (position->z < (arc_data->z_min_ + tolerance) || position->z > (arc_data->z_max_ - tolerance)) return FALSE;
+
+  GGfloat radius = sqrt(position->x*position->x + position->y*position->y);
+  if (radius < (arc_data->radius_min_ + tolerance) || radius > (arc_data->radius_max_ - tolerance)) return FALSE;
+
+  GGfloat angle = atan2(position->y, position->x);
+  GGfloat angle_tolerance = tolerance / radius;
+  if (angle < (arc_data->angle_min_ + angle_tolerance) || angle > (arc_data->angle_max_ - angle_tolerance)) return FALSE;
+
+  return TRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+  \fn inline void ComputeDistanceToCylinder(GGfloat3 const* position, GGfloat3 const* direction, GGfloat const radius, GGfloat* t_min, GGfloat* t_max)
+  \param position - pointer on primary particle position
+  \param direction - pointer on primary particle direction
+  \param radius - radius of cylinder, axis along Z
+  \param t_min - first root of intersection, OUT_OF_WORLD if no intersection
+  \param t_max - second root of intersection, OUT_OF_WORLD if no intersection
+  \brief Compute both intersections between a ray and an infinite cylinder along Z
+*/
+inline void ComputeDistanceToCylinder(GGfloat3 const* position, GGfloat3 const* direction, GGfloat const radius, GGfloat* t_min, GGfloat* t_max)
+{
+  *t_min = OUT_OF_WORLD;
+  *t_max = OUT_OF_WORLD;
+
+  // Solving a*t^2 + 2*b*t + c = 0
+  GGfloat a = direction->x*direction->x + direction->y*direction->y;
+  if (a < EPSILON6) return; // Ray parallel to cylinder axis
+
+  GGfloat b = position->x*direction->x + position->y*direction->y;
+  GGfloat c = position->x*position->x + position->y*position->y - radius*radius;
+  GGfloat delta = b*b - a*c;
+  if (delta < 0.0f) return;
+
+  GGfloat sqrt_delta = sqrt(delta);
+  *t_min = (-b - sqrt_delta) / a;
+  *t_max = (-b + sqrt_delta) / a;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+  \fn inline GGfloat ComputeDistanceToArcSide(GGfloat3 const* position, GGfloat3 const* direction, GGfloat const angle)
+  \param position - pointer on primary particle position
+  \param direction - pointer on primary particle direction
+  \param angle - angle of plane containing Z axis
+  \return distance to plane, OUT_OF_WORLD if ray is parallel to plane
+  \brief Compute the intersection between a ray and a plane containing the Z axis
+*/
+inline GGfloat ComputeDistanceToArcSide(GGfloat3 const* position, GGfloat3 const* direction, GGfloat const angle)
+{
+  // Normal of plane
+  GGfloat nx = -sin(angle);
+  GGfloat ny = cos(angle);
+
+  GGfloat denominator = nx*direction->x + ny*direction->y;
+  if (fabs(denominator) < EPSILON6) return OUT_OF_WORLD;
+
+  return -(nx*position->x + ny*position->y) / denominator;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+  \fn inline void ComputeArcIntersections(GGfloat3 const* position, GGfloat3 const* direction, global GGEMSArc const* arc_data, GGfloat* distances)
+  \param position - pointer on primary particle position in local arc frame
+  \param direction - pointer on primary particle direction in local arc frame
+  \param arc_data - arc data infos
+  \param distances - array of 8 distances to each surface bounding the arc
+  \brief Compute intersections between a ray and all surfaces (2 cylinders, 2 sides, 2 planes in Z) bounding a cylindrical arc
+*/
+inline void ComputeArcIntersections(GGfloat3 const* position, GGfloat3 const* direction, global GGEMSArc const* arc_data, GGfloat* distances)
+{
+  ComputeDistanceToCylinder(position, direction, arc_data->radius_min_, &distances[0], &distances[1]);
+  ComputeDistanceToCylinder(position, direction, arc_data->radius_max_, &distances[2], &distances[3]);
+
+  distances[4] = ComputeDistanceToArcSide(position, direction, arc_data->angle_min_);
+  distances[5] = ComputeDistanceToArcSide(position, direction, arc_data->angle_max_);
+
+  if (fabs(direction->z) < EPSILON6) {
+    distances[6] = OUT_OF_WORLD;
+    distances[7] = OUT_OF_WORLD;
+  }
+  else {
+    distances[6] = (arc_data->z_min_ - position->z) / direction->z;
+    distances[7] = (arc_data->z_max_ - position->z) / direction->z;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+  \fn inline GGfloat ComputeDistanceToArc(GGfloat3 const* position, GGfloat3 const* direction, global GGEMSArc const* arc_data)
+  \param position - pointer on primary particle position in local arc frame, particle outside arc
+  \param direction - pointer on primary particle direction in local arc frame
+  \param arc_data - arc data infos
+  \return distance to arc solid, OUT_OF_WORLD if arc is not crossed
+  \brief Compute the distance between a particle outside a cylindrical arc and the arc
+*/
+inline GGfloat ComputeDistanceToArc(GGfloat3 const* position, GGfloat3 const* direction, global GGEMSArc const* arc_data)
+{
+  GGfloat distances[8];
+  ComputeArcIntersections(position, direction, arc_data, distances);
+
+  // Closest intersection leading inside arc
+  GGfloat distance = OUT_OF_WORLD;
+  for (GGint i = 0; i < 8; ++i) {
+    if (distances[i] < 0.0f || distances[i] >= distance) continue;
+
+    GGfloat3 entry_position = *position + *direction * (distances[i] + GEOMETRY_TOLERANCE);
+    if (IsParticleInArc(&entry_position, arc_data, 0.0f)) distance = distances[i];
+  }
+
+  return distance;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+  \fn inline GGfloat ComputeDistanceToArcBoundary(GGfloat3 const* position, GGfloat3 const* direction, global GGEMSArc const* arc_data)
+  \param position - pointer on primary particle position in local arc frame, particle inside arc
+  \param direction - pointer on primary particle direction in local arc frame
+  \param arc_data - arc data infos
+  \return distance to arc boundary
+  \brief Compute the distance between a particle inside a cylindrical arc and its boundary, arc aperture has to be inferior to PI
+*/
+inline GGfloat ComputeDistanceToArcBoundary(GGfloat3 const* position, GGfloat3 const* direction, global GGEMSArc const* arc_data)
+{
+  GGfloat distances[8];
+  ComputeArcIntersections(position, direction, arc_data, distances);
+
+  // Arc is the intersection of all regions bounded by each surface, first surface crossed is the exit
+  GGfloat distance = OUT_OF_WORLD;
+  for (GGint i = 0; i < 8; ++i) {
+    if (distances[i] > 0.0f && distances[i] < distance) distance = distances[i];
+  }
+
+  return distance;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+  \fn inline GGfloat ComputeDistanceToTriangle(GGfloat3 const* position, GGfloat3 const* direction, global GGEMSMeshTriangle const* triangle)
+  \param position - pointer on primary particle position in local mesh frame
+  \param direction - pointer on primary particle direction in local mesh frame
+  \param triangle - triangle of mesh
+  \return distance to triangle, OUT_OF_WORLD if triangle is not crossed
+  \brief Compute the distance between particle and a triangle using Moller-Trumbore algorithm
+*/
+inline GGfloat ComputeDistanceToTriangle(GGfloat3 const* position, GGfloat3 const* direction, global GGEMSMeshTriangle const* triangle)
+{
+  GGfloat3 edge_1 = triangle->edge_1_;
+  GGfloat3 edge_2 = triangle->edge_2_;
+
+  // Particle parallel to triangle
+  GGfloat3 p = cross(*direction, edge_2);
+  GGfloat determinant = dot(edge_1, p);
+  if (fabs(determinant) < EPSILON6*EPSILON6) return OUT_OF_WORLD;
+
+  GGfloat inverse_determinant = 1.0f / determinant;
+
+  // Barycentric coordinates of intersection
+  GGfloat3 s = *position - triangle->vertex_;
+  GGfloat u = dot(s, p) * inverse_determinant;
+  if (u < 0.0f || u > 1.0f) return OUT_OF_WORLD;
+
+  GGfloat3 q = cross(s, edge_1);
+  GGfloat v = dot(*direction, q) * inverse_determinant;
+  if (v < 0.0f || u + v > 1.0f) return OUT_OF_WORLD;
+
+  // Only triangles in front of particle
+  GGfloat distance = dot(edge_2, q) * inverse_determinant;
+  return distance > EPSILON6 ? distance : OUT_OF_WORLD;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+  \fn inline GGfloat ComputeDistanceToBVHNode(GGfloat3 const* position, GGfloat3 const* inverse_direction, global GGEMSMeshBVHNode const* node)
+  \param position - pointer on primary particle position in local mesh frame
+  \param inverse_direction - pointer on inverse of primary particle direction in local mesh frame
+  \param node - node of BVH
+  \return distance to entrance of node, 0 if particle inside node, OUT_OF_WORLD if node is not crossed
+  \brief Compute the distance between particle and the box of a BVH node (slab method), flat boxes are crossed
+*/
+inline GGfloat ComputeDistanceToBVHNode(GGfloat3 const* position, GGfloat3 const* inverse_direction, global GGEMSMeshBVHNode const* node)
+{
+  GGfloat3 t_border_min = (node->border_min_xyz_ - *position) * *inverse_direction;
+  GGfloat3 t_border_max = (node->border_max_xyz_ - *position) * *inverse_direction;
+
+  GGfloat3 t_near = fmin(t_border_min, t_border_max);
+  GGfloat3 t_far = fmax(t_border_min, t_border_max);
+
+  GGfloat t_min = fmax(fmax(t_near.x, t_near.y), fmax(t_near.z, 0.0f));
+  GGfloat t_max = fmin(fmin(t_far.x, t_far.y), t_far.z);
+
+  return t_min <= t_max ? t_min : OUT_OF_WORLD;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+  \fn inline GGfloat ComputeDistanceToMesh(GGfloat3 const* position, GGfloat3 const* direction, global GGEMSMeshBVHNode const* bvh_nodes, global GGEMSMeshTriangle const* triangles, GGint* triangle_id)
+  \param position - pointer on primary particle position in local mesh frame
+  \param direction - pointer on primary particle direction in local mesh frame
+  \param bvh_nodes - nodes of BVH in depth first order
+  \param triangles - triangles of mesh sorted by leaf of BVH
+  \param triangle_id - index of closest triangle crossed by particle, -1 if no triangle
+  \return distance to closest triangle crossed by particle, OUT_OF_WORLD if no triangle
+  \brief Compute the distance between particle and the closest triangle of mesh traversing BVH, nodes farther than the closest triangle found are skipped
+*/
+inline GGfloat ComputeDistanceToMesh(GGfloat3 const* position, GGfloat3 const* direction, global GGEMSMeshBVHNode const* bvh_nodes, global GGEMSMeshTriangle const* triangles, GGint* triangle_id)
+{
+  // Inverse of direction, null components are replaced by a small value (no infinity with relaxed math)
+  GGfloat3 inverse_direction = {
+    1.0f / (fabs(direction->x) < EPSILON6 ? copysign(EPSILON6, direction->x) : direction->x),
+    1.0f / (fabs(direction->y) < EPSILON6 ? copysign(EPSILON6, direction->y) : direction->y),
+    1.0f / (fabs(direction->z) < EPSILON6 ? copysign(EPSILON6, direction->z) : direction->z)
+  };
+
+  GGfloat distance = OUT_OF_WORLD;
+  *triangle_id = -1;
+
+  // Stack of nodes to visit, root node first
+  GGint stack[MESH_BVH_STACK_SIZE];
+  GGint stack_size = 0;
+  stack[stack_size++] = 0;
+
+  while (stack_size > 0) {
+    GGint node_id = stack[--stack_size];
+    global GGEMSMeshBVHNode const* node = &bvh_nodes[node_id];
+
+    // Node not crossed or farther than closest triangle
+    if (ComputeDistanceToBVHNode(position, &inverse_direction, node) >= distance) continue;
+
+    if (node->number_of_triangles_ > 0) {
+      for (GGint i = node->index_; i < node->index_ + node->number_of_triangles_; ++i) {
+        GGfloat distance_to_triangle = ComputeDistanceToTriangle(position, direction, &triangles[i]);
+        if (distance_to_triangle < distance) {
+          distance = distance_to_triangle;
+          *triangle_id = i;
+        }
+      }
+    }
+    else {
+      // Left child (next node) is visited first
+      stack[stack_size++] = node->index_;
+      stack[stack_size++] = node_id + 1;
+    }
+  }
+
+  return distance;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+  \fn inline GGchar IsParticleInPrimitive(GGfloat3 const* position, global GGEMSSolidPrimitiveData const* primitive_data, GGfloat const tolerance)
+  \param position - pointer on primary particle position in local primitive frame
+  \param primitive_data - primitive data infos
+  \param tolerance - tolerance for geometry
+  \return false if particle outside primitive, and true if particle inside primitive
+  \brief Check if particle is inside or outside an analytic primitive, primitive is shrunk by tolerance
+*/
+inline GGchar IsParticleInPrimitive(GGfloat3 const* position, global GGEMSSolidPrimitiveData const* primitive_data, GGfloat const tolerance)
+{
+  GGfloat3 half_size = primitive_data->half_size_xyz_ - tolerance;
+
+  if (primitive_data->primitive_type_ == CYLINDER_PRIMITIVE) {
+    if (fabs(position->z) > half_size.z) return FALSE;
+    GGfloat3 scaled_position = {position->x/half_size.x, position->y/half_size.y, 0.0f};
+    return dot(scaled_position, scaled_position) < 1.0f ? TRUE : FALSE;
+  }
+
+  GGfloat3 scaled_position = *position / half_size;
+  return dot(scaled_position, scaled_position) < 1.0f ? TRUE : FALSE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+  \fn inline void ComputePrimitiveIntersections(GGfloat3 const* position, GGfloat3 const* direction, global GGEMSSolidPrimitiveData const* primitive_data, GGfloat* t_min, GGfloat* t_max)
+  \param position - pointer on primary particle position in local primitive frame
+  \param direction - pointer on primary particle direction in local primitive frame
+  \param primitive_data - primitive data infos
+  \param t_min - distance to entrance of primitive along particle line, can be negative
+  \param t_max - distance to exit of primitive along particle line, inferior to t_min if primitive is not crossed
+  \brief Compute the intersections between the particle line and a convex quadric, quadric is scaled to a unit sphere or a unit cylinder
+*/
+inline void ComputePrimitiveIntersections(GGfloat3 const* position, GGfloat3 const* direction, global GGEMSSolidPrimitiveData const* primitive_data, GGfloat* t_min, GGfloat* t_max)
+{
+  GGfloat3 half_size = primitive_data->half_size_xyz_;
+  GGfloat3 scaled_position = *position / half_size;
+  GGfloat3 scaled_direction = *direction / half_size;
+
+  // Cylinder: quadric in XY plane only
+  if (primitive_data->primitive_type_ == CYLINDER_PRIMITIVE) {
+    scaled_position.z = 0.0f;
+    scaled_direction.z = 0.0f;
+  }
+
+  GGfloat a = dot(scaled_direction, scaled_direction);
+  GGfloat b = dot(scaled_position, scaled_direction);
+  GGfloat c = dot(scaled_position, scaled_position) - 1.0f;
+
+  *t_min = -OUT_OF_WORLD;
+  *t_max = OUT_OF_WORLD;
+
+  if (a < EPSILON6) {
+    // Particle parallel to cylinder axis
+    if (c > 0.0f) *t_min = OUT_OF_WORLD;
+  }
+  else {
+    GGfloat discriminant = b*b - a*c;
+    if (discriminant < 0.0f) {
+      *t_min = OUT_OF_WORLD;
+      *t_max = -OUT_OF_WORLD;
+      return;
+    }
+
+    GGfloat square_root = sqrt(discriminant);
+    *t_min = (-b - square_root) / a;
+    *t_max = (-b + square_root) / a;
+  }
+
+  // Cylinder: caps along Z
+  if (primitive_data->primitive_type_ == CYLINDER_PRIMITIVE) {
+    if (fabs(direction->z) < EPSILON6) {
+      if (fabs(position->z) > half_size.z) *t_min = OUT_OF_WORLD;
+    }
+    else {
+      GGfloat t_cap_0 = (-half_size.z - position->z) / direction->z;
+      GGfloat t_cap_1 = (half_size.z - position->z) / direction->z;
+      *t_min = fmax(*t_min, fmin(t_cap_0, t_cap_1));
+      *t_max = fmin(*t_max, fmax(t_cap_0, t_cap_1));
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+  \fn inline GGfloat ComputeDistanceToPrimitive(GGfloat3 const* position, GGfloat3 const* direction, global GGEMSSolidPrimitiveData const* primitive_data)
+  \param position - pointer on primary particle position in local primitive frame, particle outside primitive
+  \param direction - pointer on primary particle direction in local primitive frame
+  \param primitive_data - primitive data infos
+  \return distance to primitive, OUT_OF_WORLD if primitive is not crossed sufficiently
+  \brief Compute the distance between a particle outside an analytic primitive and the primitive
+*/
+inline GGfloat ComputeDistanceToPrimitive(GGfloat3 const* position, GGfloat3 const* direction, global GGEMSSolidPrimitiveData const* primitive_data)
+{
+  GGfloat t_min = 0.0f;
+  GGfloat t_max = 0.0f;
+  ComputePrimitiveIntersections(position, direction, primitive_data, &t_min, &t_max);
+
+  // Checking if particle cross primitive sufficiently, in front of particle
+  t_min = fmax(t_min, 0.0f);
+  if (t_max - t_min < 2.0f*GEOMETRY_TOLERANCE) return OUT_OF_WORLD;
+
+  return t_min;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+  \fn inline GGfloat ComputeDistanceToPrimitiveBoundary(GGfloat3 const* position, GGfloat3 const* direction, global GGEMSSolidPrimitiveData const* primitive_data)
+  \param position - pointer on primary particle position in local primitive frame, particle inside primitive
+  \param direction - pointer on primary particle direction in local primitive frame
+  \param primitive_data - primitive data infos
+  \return distance to primitive boundary
+  \brief Compute the distance between a particle inside an analytic primitive and its boundary
+*/
+inline GGfloat ComputeDistanceToPrimitiveBoundary(GGfloat3 const* position, GGfloat3 const* direction, global GGEMSSolidPrimitiveData const* primitive_data)
+{
+  GGfloat t_min = 0.0f;
+  GGfloat t_max = 0.0f;
+  ComputePrimitiveIntersections(position, direction, primitive_data, &t_min, &t_max);
+
+  return fmax(t_max, 0.0f);
+}
+
 #endif
 
 #endif // End of GUARD_GGEMS_GEOMETRIES_GGEMSRAYTRACING_HH
@@ -32,11 +32,14 @@
 */
 
 #include <limits>
+#include <vector>
 
 #include "GGEMS/io/GGEMSTextReader.hh"
 #include "GGEMS/io/GGEMSHistogramMode.hh"
 #include "GGEMS/tools/GGEMSRAMManager.hh"
 #include "GGEMS/navigators/GGEMSNavigatorManager.hh"
+#include "GGEMS/geometries/GGEMSAntiScatterGrid.hh"
+#include "GGEMS/geometries/GGEMSModuleLayers.hh"
 
 class GGEMSGeometryTransformation;
 class GGEMSOpenGLVolume;
@@ -195,6 +198,36 @@ class GGEMS_EXPORT GGEMSSolid
     */
     virtual void EnableScatter(void) = 0;
 
+    /*!
+      \fn void EnableAntiScatterGrid(GGEMSAntiScatterGrid const& anti_scatter_grid)
+      \param anti_scatter_grid - parameters of anti-scatter grid
+      \brief Activate an analytic anti-scatter grid on the entrance face of solid, has to be called before initialization of kernels
+    */
+    virtual void EnableAntiScatterGrid(GGEMSAntiScatterGrid const& anti_scatter_grid);
+
+    /*!
+      \fn void EnableModuleLayers(GGEMSModuleLayers const& module_layers)
+      \param module_layers - layers of module along local Z axis
+      \brief Activate a stack of material layers in solid, all layers are tracked in one kernel call, has to be called before initialization of kernels
+    */
+    virtual void EnableModuleLayers(GGEMSModuleLayers const& module_layers);
+
+    /*!
+      \fn void SetNeighbourSolids(std::vector<GGint> const& neighbour_solid_ids)
+      \param neighbour_solid_ids - solid index of neighbours
+      \brief Set the neighbours of solid, a particle exiting the solid tests its neighbours before other solids
+    */
+    virtual void SetNeighbourSolids(std::vector<GGint> const& neighbour_solid_ids);
+
+    /*!
+      \fn void SetSearchPass(GGsize const& thread_index, GGint const& search_pass, cl::Buffer* fallback_search)
+      \param thread_index - index of activated device (thread index)
+      \param search_pass - CANDIDATE_SEARCH or FALLBACK_SEARCH
+      \param fallback_search - flag set by kernel if a fallback pass is needed, nullptr if not checked
+      \brief Set the search pass of the kernel computing distance between particles and solid, nothing is done for solids without neighbours
+    */
+    virtual void SetSearchPass(GGsize const& thread_index, GGint const& search_pass, cl::Buffer* fallback_search);
+
     /*!
       \fn void PrintInfos(void) const
       \brief printing infos about solid
@@ -244,7 +277,7 @@ class GGEMS_EXPORT GGEMSSolid
       \fn GGEMSHistogramMode* GetScatterHistogram(GGsize const& thread_index)
       \param thread_index - index of activated device (thread index)
       \return pointer on scatter histogram
-      \brief return the point on scatter histogram
+      \brief return the point on scatter histogram, one channel of histogram size per scatter category
     */
     inline cl::Buffer* GetScatterHistogram(GGsize const& thread_index) const {return histogram_.scatter_[thread_index];}
 
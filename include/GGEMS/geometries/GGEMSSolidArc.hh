@@ -0,0 +1,130 @@
+#ifndef GUARD_GGEMS_GEOMETRIES_GGEMSSOLIDARC_HH
+#define GUARD_GGEMS_GEOMETRIES_GGEMSSOLIDARC_HH
+
+// ************************************************************************
+// * This file is part of GGEMS.                                          *
+// *                                                                      *
+// * GGEMS is free software: you can redistribute it and/or modify        *
+// * it under the terms of the GNU General Public License as published by *
+// * the Free Software Foundation, either version 3 of the License, or    *
+// * (at your option) any later version.                                  *
+// *                                                                      *
+// * GGEMS is distributed in the hope that it will be useful,             *
+// * but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+// * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+// * GNU General Public License for more details.                         *
+// *                                                                      *
+// * You should have received a copy of the GNU General Public License    *
+// * along with GGEMS.  If not, see <https://www.gnu.org/licenses/>.      *
+// *                                                                      *
+// ************************************************************************
+
+/*!
+  \file GGEMSSolidArc.hh
+
+  \brief GGEMS class for solid arc, a cylindrical arc used as curved detector
+
+  \author Julien BERT <julien.bert@univ-brest.fr>
+  \author Didier BENOIT <didier.benoit@inserm.fr>
+  \author LaTIM, INSERM - U1101, Brest, FRANCE
+  \version 1.0
+  \date Sunday October 18, 2026
+*/
+
+#include "GGEMS/geometries/GGEMSSolid.hh"
+
+/*!
+  \class GGEMSSolidArc
+  \brief GGEMS class for solid arc. The origin of the local frame is the center of the cylinder (x-ray source for a CT system), the cylinder axis is along local Z and the arc is centered on local X
+*/
+class GGEMS_EXPORT GGEMSSolidArc : public GGEMSSolid
+{
+  public:
+    /*!
+      \param virtual_element_number_x - virtual element number along cylinder axis (rows)
+      \param virtual_element_number_y - virtual element number along angle (columns)
+      \param virtual_element_number_z - virtual element number in depth
+      \param inner_radius - inner radius of arc
+      \param thickness - thickness of arc
+      \param arc_angle - aperture angle of arc
+      \param arc_length - length of arc along cylinder axis
+      \param data_reg_type - type of registration "HISTOGRAM"
+      \brief GGEMSSolidArc constructor
+    */
+    GGEMSSolidArc(GGsize const& virtual_element_number_x, GGsize const& virtual_element_number_y, GGsize const& virtual_element_number_z, GGfloat const& inner_radius, GGfloat const& thickness, GGfloat const& arc_angle, GGfloat const& arc_length, std::string const& data_reg_type);
+
+    /*!
+      \brief GGEMSSolidArc destructor
+    */
+    ~GGEMSSolidArc(void) override;
+
+    /*!
+      \fn GGEMSSolidArc(GGEMSSolidArc const& solid_arc) = delete
+      \param solid_arc - reference on the GGEMS solid arc
+      \brief Avoid copy by reference
+    */
+    GGEMSSolidArc(GGEMSSolidArc const& solid_arc) = delete;
+
+    /*!
+      \fn GGEMSSolidArc& operator=(GGEMSSolidArc const& solid_arc) = delete
+      \param solid_arc - reference on the GGEMS solid arc
+      \brief Avoid assignement by reference
+    */
+    GGEMSSolidArc& operator=(GGEMSSolidArc const& solid_arc) = delete;
+
+    /*!
+      \fn GGEMSSolidArc(GGEMSSolidArc const&& solid_arc) = delete
+      \param solid_arc - rvalue reference on the GGEMS solid arc
+      \brief Avoid copy by rvalue reference
+    */
+    GGEMSSolidArc(GGEMSSolidArc const&& solid_arc) = delete;
+
+    /*!
+      \fn GGEMSSolidArc& operator=(GGEMSSolidArc const&& solid_arc) = delete
+      \param solid_arc - rvalue reference on the GGEMS solid arc
+      \brief Avoid copy by rvalue reference
+    */
+    GGEMSSolidArc& operator=(GGEMSSolidArc const&& solid_arc) = delete;
+
+    /*!
+      \fn void Initialize(GGEMSMaterials* materials)
+      \param materials - pointer on materials
+      \brief Initialize solid for geometric navigation
+    */
+    void Initialize(GGEMSMaterials* materials) override;
+
+    /*!
+      \fn void EnableScatter(void)
+      \brief Activate scatter registration
+    */
+    void EnableScatter(void) override;
+
+    /*!
+      \fn void EnableAntiScatterGrid(GGEMSAntiScatterGrid const& anti_scatter_grid)
+      \param anti_scatter_grid - parameters of anti-scatter grid
+      \brief Activate an analytic anti-scatter grid on the entrance face of solid arc
+    */
+    void EnableAntiScatterGrid(GGEMSAntiScatterGrid const& anti_scatter_grid) override;
+
+    /*!
+      \fn void PrintInfos(void) const
+      \brief printing infos about solid arc
+    */
+    void PrintInfos(void) const override;
+
+    /*!
+      \fn void UpdateTransformationMatrix(GGsize const& thread_index)
+      \param thread_index - index of the thread (= activated device index)
+      \brief Update transformation matrix for solid arc object
+    */
+    void UpdateTransformationMatrix(GGsize const& thread_index) override;
+
+  private:
+    /*!
+      \fn void InitializeKernel(void)
+      \brief Initialize kernel for particle solid distance
+    */
+    void InitializeKernel(void) override;
+};
+
+#endif // End of GUARD_GGEMS_GEOMETRIES_GGEMSSOLIDARC_HH
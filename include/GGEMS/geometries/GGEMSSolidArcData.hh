@@ -0,0 +1,50 @@
+#ifndef GUARD_GGEMS_GEOMETRIES_GGEMSSOLIDARCDATA_HH
+#define GUARD_GGEMS_GEOMETRIES_GGEMSSOLIDARCDATA_HH
+
+// ************************************************************************
+// * This file is part of GGEMS.                                          *
+// *                                                                      *
+// * GGEMS is free software: you can redistribute it and/or modify        *
+// * it under the terms of the GNU General Public License as published by *
+// * the Free Software Foundation, either version 3 of the License, or    *
+// * (at your option) any later version.                                  *
+// *                                                                      *
+// * GGEMS is distributed in the hope that it will be useful,             *
+// * but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+// * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+// * GNU General Public License for more details.                         *
+// *                                                                      *
+// * You should have received a copy of the GNU General Public License    *
+// * along with GGEMS.  If not, see <https://www.gnu.org/licenses/>.      *
+// *                                                                      *
+// ************************************************************************
+
+/*!
+  \file GGEMSSolidArcData.hh
+
+  \brief Structure storing the data for solid arc (curved detector)
+
+  \author Julien BERT <julien.bert@univ-brest.fr>
+  \author Didier BENOIT <didier.benoit@inserm.fr>
+  \author LaTIM, INSERM - U1101, Brest, FRANCE
+  \version 1.0
+  \date Sunday October 18, 2026
+*/
+
+#include "GGEMS/geometries/GGEMSPrimitiveGeometries.hh"
+#include "GGEMS/geometries/GGEMSAntiScatterGrid.hh"
+
+/*!
+  \struct GGEMSSolidArcData_t
+  \brief Structure storing the stack of data for solid arc
+*/
+typedef struct GGEMSSolidArcData_t
+{
+  GGEMSArc arc_geometry_; /*!< Arc storing borders of curved detector and matrix of transformation */
+  GGsize virtual_element_number_xyz_[3]; /*!< Number of virtual element in arc, X: along cylinder axis (row), Y: along angle (column), Z: depth */
+  GGfloat element_size_xyz_[3]; /*!< Size of virtual element, X: row length in mm, Y: angular pitch in rad, Z: depth in mm */
+  GGEMSAntiScatterGrid anti_scatter_grid_; /*!< Anti-scatter grid on entrance face, used only if ANTI_SCATTER_GRID option is activated */
+  GGint solid_id_; /*!< Navigator index */
+} GGEMSSolidArcData; /*!< Using C convention name of struct to C++ (_t deletion) */
+
+#endif // GUARD_GGEMS_GEOMETRIES_GGEMSSOLIDARCDATA_HH
@@ -98,6 +98,36 @@ class GGEMS_EXPORT GGEMSSolidBox : public GGEMSSolid
     */
     void EnableScatter(void) override;
 
+    /*!
+      \fn void EnableAntiScatterGrid(GGEMSAntiScatterGrid const& anti_scatter_grid)
+      \param anti_scatter_grid - parameters of anti-scatter grid
+      \brief Activate an analytic anti-scatter grid on the entrance face of solid box
+    */
+    void EnableAntiScatterGrid(GGEMSAntiScatterGrid const& anti_scatter_grid) override;
+
+    /*!
+      \fn void EnableModuleLayers(GGEMSModuleLayers const& module_layers)
+      \param module_layers - layers of module along local Z axis
+      \brief Activate a stack of material layers in solid box
+    */
+    void EnableModuleLayers(GGEMSModuleLayers const& module_layers) override;
+
+    /*!
+      \fn void SetNeighbourSolids(std::vector<GGint> const& neighbour_solid_ids)
+      \param neighbour_solid_ids - solid index of neighbours
+      \brief Set the neighbours of solid box, a particle exiting the box tests its neighbours before other solids
+    */
+    void SetNeighbourSolids(std::vector<GGint> const& neighbour_solid_ids) override;
+
+    /*!
+      \fn void SetSearchPass(GGsize const& thread_index, GGint const& search_pass, cl::Buffer* fallback_search)
+      \param thread_index - index of activated device (thread index)
+      \param search_pass - CANDIDATE_SEARCH or FALLBACK_SEARCH
+      \param fallback_search - flag set by kernel if a fallback pass is needed, nullptr if not checked
+      \brief Set the search pass of the kernel computing distance between particles and solid box
+    */
+    void SetSearchPass(GGsize const& thread_index, GGint const& search_pass, cl::Buffer* fallback_search) override;
+
     /*!
       \fn void PrintInfos(void) const
       \brief printing infos about voxelized solid
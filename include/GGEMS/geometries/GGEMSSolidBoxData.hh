@@ -32,6 +32,13 @@
 */
 
 #include "GGEMS/geometries/GGEMSPrimitiveGeometries.hh"
+#include "GGEMS/geometries/GGEMSAntiScatterGrid.hh"
+#include "GGEMS/geometries/GGEMSModuleLayers.hh"
+
+#define MAXIMUM_NEIGHBOUR_SOLIDS 8 /*!< Maximum number of neighbour solids of a solid box, 8 for a grid of modules */
+
+__constant GGint CANDIDATE_SEARCH = 0; /*!< Search pass testing neighbours of exited solid only */
+__constant GGint FALLBACK_SEARCH = 1; /*!< Search pass testing other solids if no neighbour is hit */
 
 /*!
   \struct GGEMSSolidBoxData_t
@@ -42,6 +49,10 @@ typedef struct GGEMSSolidBoxData_t
   GGEMSOBB obb_geometry_; /*!< OBB storing border of voxelized solid and matrix of transformation */
   GGsize virtual_element_number_xyz_[3]; /*!< Number of virtual element in box */
   GGfloat box_size_xyz_[3]; /*!< Length of box in X, Y and Z */
+  GGEMSAntiScatterGrid anti_scatter_grid_; /*!< Anti-scatter grid on entrance face, used only if ANTI_SCATTER_GRID option is activated */
+  GGEMSModuleLayers module_layers_; /*!< Layers of module along local Z, used only if MODULE_LAYERS option is activated */
+  GGint neighbour_solid_id_[MAXIMUM_NEIGHBOUR_SOLIDS]; /*!< Solid index of neighbours, first solids reached by a particle exiting this solid */
+  GGint number_of_neighbour_solids_; /*!< Number of neighbour solids, 0 if no candidate search */
   GGint solid_id_; /*!< Navigator index */
 } GGEMSSolidBoxData; /*!< Using C convention name of struct to C++ (_t deletion) */
 
@@ -0,0 +1,162 @@
+#ifndef GUARD_GGEMS_GEOMETRIES_GGEMSSOLIDMESH_HH
+#define GUARD_GGEMS_GEOMETRIES_GGEMSSOLIDMESH_HH
+
+// ************************************************************************
+// * This file is part of GGEMS.                                          *
+// *                                                                      *
+// * GGEMS is free software: you can redistribute it and/or modify        *
+// * it under the terms of the GNU General Public License as published by *
+// * the Free Software Foundation, either version 3 of the License, or    *
+// * (at your option) any later version.                                  *
+// *                                                                      *
+// * GGEMS is distributed in the hope that it will be useful,             *
+// * but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+// * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+// * GNU General Public License for more details.                         *
+// *                                                                      *
+// * You should have received a copy of the GNU General Public License    *
+// * along with GGEMS.  If not, see <https://www.gnu.org/licenses/>.      *
+// *                                                                      *
+// ************************************************************************
+
+/*!
+  \file GGEMSSolidMesh.hh
+
+  \brief GGEMS class for solid mesh, a closed triangle mesh (STL or OBJ file) filled with one material
+
+  \author Julien BERT <julien.bert@univ-brest.fr>
+  \author Didier BENOIT <didier.benoit@inserm.fr>
+  \author LaTIM, INSERM - U1101, Brest, FRANCE
+  \version 1.0
+  \date Sunday October 18, 2026
+*/
+
+#include "GGEMS/geometries/GGEMSSolid.hh"
+#include "GGEMS/geometries/GGEMSSolidMeshData.hh"
+
+/*!
+  \class GGEMSSolidMesh
+  \brief GGEMS class for solid mesh. Local frame is the frame of mesh file, a BVH of triangles is built on host and traversed on OpenCL device. Space between mesh and its bounding box is vacuum
+*/
+class GGEMS_EXPORT GGEMSSolidMesh : public GGEMSSolid
+{
+  public:
+    /*!
+      \param mesh_filename - name of mesh file (binary or ASCII STL, OBJ)
+      \brief GGEMSSolidMesh constructor
+    */
+    explicit GGEMSSolidMesh(std::string const& mesh_filename);
+
+    /*!
+      \brief GGEMSSolidMesh destructor
+    */
+    ~GGEMSSolidMesh(void) override;
+
+    /*!
+      \fn GGEMSSolidMesh(GGEMSSolidMesh const& solid_mesh) = delete
+      \param solid_mesh - reference on the GGEMS solid mesh
+      \brief Avoid copy by reference
+    */
+    GGEMSSolidMesh(GGEMSSolidMesh const& solid_mesh) = delete;
+
+    /*!
+      \fn GGEMSSolidMesh& operator=(GGEMSSolidMesh const& solid_mesh) = delete
+      \param solid_mesh - reference on the GGEMS solid mesh
+      \brief Avoid assignement by reference
+    */
+    GGEMSSolidMesh& operator=(GGEMSSolidMesh const& solid_mesh) = delete;
+
+    /*!
+      \fn GGEMSSolidMesh(GGEMSSolidMesh const&& solid_mesh) = delete
+      \param solid_mesh - rvalue reference on the GGEMS solid mesh
+      \brief Avoid copy by rvalue reference
+    */
+    GGEMSSolidMesh(GGEMSSolidMesh const&& solid_mesh) = delete;
+
+    /*!
+      \fn GGEMSSolidMesh& operator=(GGEMSSolidMesh const&& solid_mesh) = delete
+      \param solid_mesh - rvalue reference on the GGEMS solid mesh
+      \brief Avoid copy by rvalue reference
+    */
+    GGEMSSolidMesh& operator=(GGEMSSolidMesh const&& solid_mesh) = delete;
+
+    /*!
+      \fn void Initialize(GGEMSMaterials* materials)
+      \param materials - pointer on materials
+      \brief Initialize solid for geometric navigation
+    */
+    void Initialize(GGEMSMaterials* materials) override;
+
+    /*!
+      \fn void EnableScatter(void)
+      \brief Activate scatter registration, no registration in solid mesh
+    */
+    void EnableScatter(void) override {}
+
+    /*!
+      \fn void PrintInfos(void) const
+      \brief printing infos about solid mesh
+    */
+    void PrintInfos(void) const override;
+
+    /*!
+      \fn void UpdateTransformationMatrix(GGsize const& thread_index)
+      \param thread_index - index of the thread (= activated device index)
+      \brief Update transformation matrix for solid mesh object
+    */
+    void UpdateTransformationMatrix(GGsize const& thread_index) override;
+
+  private:
+    /*!
+      \fn void InitializeKernel(void)
+      \brief Initialize kernel for particle solid distance
+    */
+    void InitializeKernel(void) override;
+
+    /*!
+      \fn void LoadMesh(std::vector<GGfloat>& vertices) const
+      \param vertices - coordinates of vertices, 9 values per triangle
+      \brief load triangles from mesh file, format is given by extension of file
+    */
+    void LoadMesh(std::vector<GGfloat>& vertices) const;
+
+    /*!
+      \fn void LoadSTL(std::vector<GGfloat>& vertices) const
+      \param vertices - coordinates of vertices, 9 values per triangle
+      \brief load triangles from binary or ASCII STL file
+    */
+    void LoadSTL(std::vector<GGfloat>& vertices) const;
+
+    /*!
+      \fn void LoadOBJ(std::vector<GGfloat>& vertices) const
+      \param vertices - coordinates of vertices, 9 values per triangle
+      \brief load triangles from OBJ file, polygonal faces are split in triangle fans
+    */
+    void LoadOBJ(std::vector<GGfloat>& vertices) const;
+
+    /*!
+      \fn void CheckClosedMesh(std::vector<GGfloat> const& vertices) const
+      \param vertices - coordinates of vertices, 9 values per triangle
+      \brief check each edge of mesh is shared by 2 triangles, particle inside mesh is found from orientation of closest triangle
+    */
+    void CheckClosedMesh(std::vector<GGfloat> const& vertices) const;
+
+    /*!
+      \fn GGsize BuildBVH(std::vector<GGEMSMeshTriangle>& triangles, std::vector<GGfloat3>& centroids, GGsize const& first, GGsize const& last, GGsize const& depth, std::vector<GGEMSMeshBVHNode>& bvh_nodes) const
+      \param triangles - triangles of mesh, sorted by leaf of BVH
+      \param centroids - centroids of triangles, sorted with triangles
+      \param first - index of first triangle of node
+      \param last - index after last triangle of node
+      \param depth - depth of node in BVH
+      \param bvh_nodes - nodes of BVH in depth first order
+      \return maximum depth of BVH under node
+      \brief build recursively a node of BVH, triangles are split at median of centroids along largest axis
+    */
+    GGsize BuildBVH(std::vector<GGEMSMeshTriangle>& triangles, std::vector<GGfloat3>& centroids, GGsize const& first, GGsize const& last, GGsize const& depth, std::vector<GGEMSMeshBVHNode>& bvh_nodes) const;
+
+  private:
+    std::string mesh_filename_; /*!< Name of mesh file */
+    GGsize mesh_data_size_; /*!< Size in bytes of BVH nodes and triangles stored in label buffer */
+};
+
+#endif // End of GUARD_GGEMS_GEOMETRIES_GGEMSSOLIDMESH_HH
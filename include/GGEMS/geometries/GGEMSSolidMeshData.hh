@@ -0,0 +1,74 @@
+#ifndef GUARD_GGEMS_GEOMETRIES_GGEMSSOLIDMESHDATA_HH
+#define GUARD_GGEMS_GEOMETRIES_GGEMSSOLIDMESHDATA_HH
+
+// ************************************************************************
+// * This file is part of GGEMS.                                          *
+// *                                                                      *
+// * GGEMS is free software: you can redistribute it and/or modify        *
+// * it under the terms of the GNU General Public License as published by *
+// * the Free Software Foundation, either version 3 of the License, or    *
+// * (at your option) any later version.                                  *
+// *                                                                      *
+// * GGEMS is distributed in the hope that it will be useful,             *
+// * but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+// * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+// * GNU General Public License for more details.                         *
+// *                                                                      *
+// * You should have received a copy of the GNU General Public License    *
+// * along with GGEMS.  If not, see <https://www.gnu.org/licenses/>.      *
+// *                                                                      *
+// ************************************************************************
+
+/*!
+  \file GGEMSSolidMeshData.hh
+
+  \brief Structure storing the data for solid mesh (closed triangle mesh) and its BVH
+
+  \author Julien BERT <julien.bert@univ-brest.fr>
+  \author Didier BENOIT <didier.benoit@inserm.fr>
+  \author LaTIM, INSERM - U1101, Brest, FRANCE
+  \version 1.0
+  \date Sunday October 18, 2026
+*/
+
+#include "GGEMS/geometries/GGEMSPrimitiveGeometries.hh"
+
+#define MESH_BVH_LEAF_SIZE 4 /*!< Maximum number of triangles in a leaf of BVH */
+#define MESH_BVH_STACK_SIZE 64 /*!< Size of stack traversing BVH on OpenCL device, maximum depth of BVH */
+
+/*!
+  \struct GGEMSMeshTriangle_t
+  \brief Structure storing a triangle of mesh, edges are precomputed for ray/triangle intersection
+*/
+typedef struct GGEMSMeshTriangle_t
+{
+  GGfloat3 vertex_; /*!< First vertex of triangle */
+  GGfloat3 edge_1_; /*!< Edge from first to second vertex */
+  GGfloat3 edge_2_; /*!< Edge from first to third vertex, cross(edge_1_, edge_2_) is the outward normal */
+} GGEMSMeshTriangle; /*!< Using C convention name of struct to C++ (_t deletion) */
+
+/*!
+  \struct GGEMSMeshBVHNode_t
+  \brief Structure storing a node of BVH in depth first order, left child of an inner node is the next node
+*/
+typedef struct GGEMSMeshBVHNode_t
+{
+  GGfloat3 border_min_xyz_; /*!< Min. of border of node in X, Y and Z */
+  GGfloat3 border_max_xyz_; /*!< Max. of border of node in X, Y and Z */
+  GGint index_; /*!< Index of right child for inner node, index of first triangle for leaf */
+  GGint number_of_triangles_; /*!< Number of triangles in leaf, 0 for inner node */
+} GGEMSMeshBVHNode; /*!< Using C convention name of struct to C++ (_t deletion) */
+
+/*!
+  \struct GGEMSSolidMeshData_t
+  \brief Structure storing the stack of data for solid mesh, BVH nodes followed by triangles are stored in the label buffer of solid
+*/
+typedef struct GGEMSSolidMeshData_t
+{
+  GGEMSOBB obb_geometry_; /*!< OBB storing bounding box of mesh and matrix of transformation */
+  GGint number_of_triangles_; /*!< Number of triangles in mesh */
+  GGint number_of_bvh_nodes_; /*!< Number of nodes in BVH */
+  GGint solid_id_; /*!< Navigator index */
+} GGEMSSolidMeshData; /*!< Using C convention name of struct to C++ (_t deletion) */
+
+#endif // GUARD_GGEMS_GEOMETRIES_GGEMSSOLIDMESHDATA_HH
@@ -0,0 +1,117 @@
+#ifndef GUARD_GGEMS_GEOMETRIES_GGEMSSOLIDPRIMITIVE_HH
+#define GUARD_GGEMS_GEOMETRIES_GGEMSSOLIDPRIMITIVE_HH
+
+// ************************************************************************
+// * This file is part of GGEMS.                                          *
+// *                                                                      *
+// * GGEMS is free software: you can redistribute it and/or modify        *
+// * it under the terms of the GNU General Public License as published by *
+// * the Free Software Foundation, either version 3 of the License, or    *
+// * (at your option) any later version.                                  *
+// *                                                                      *
+// * GGEMS is distributed in the hope that it will be useful,             *
+// * but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+// * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+// * GNU General Public License for more details.                         *
+// *                                                                      *
+// * You should have received a copy of the GNU General Public License    *
+// * along with GGEMS.  If not, see <https://www.gnu.org/licenses/>.      *
+// *                                                                      *
+// ************************************************************************
+
+/*!
+  \file GGEMSSolidPrimitive.hh
+
+  \brief GGEMS class for analytic primitive solid (ellipsoid, sphere or cylinder) filled with one material
+
+  \author Julien BERT <julien.bert@univ-brest.fr>
+  \author Didier BENOIT <didier.benoit@inserm.fr>
+  \author LaTIM, INSERM - U1101, Brest, FRANCE
+  \version 1.0
+  \date Sunday October 18, 2026
+*/
+
+#include "GGEMS/geometries/GGEMSSolid.hh"
+
+/*!
+  \class GGEMSSolidPrimitive
+  \brief GGEMS class for analytic primitive solid. Primitive is centered on origin of local frame, cylinder axis is along local Z. Intersections are computed exactly, without voxelization
+*/
+class GGEMS_EXPORT GGEMSSolidPrimitive : public GGEMSSolid
+{
+  public:
+    /*!
+      \param primitive_type - type of primitive (ELLIPSOID_PRIMITIVE or CYLINDER_PRIMITIVE)
+      \param half_size_xyz - semi-axes of ellipsoid, or radii of cylinder in X and Y and half height in Z
+      \brief GGEMSSolidPrimitive constructor
+    */
+    GGEMSSolidPrimitive(GGint const& primitive_type, GGfloat3 const& half_size_xyz);
+
+    /*!
+      \brief GGEMSSolidPrimitive destructor
+    */
+    ~GGEMSSolidPrimitive(void) override;
+
+    /*!
+      \fn GGEMSSolidPrimitive(GGEMSSolidPrimitive const& solid_primitive) = delete
+      \param solid_primitive - reference on the GGEMS solid primitive
+      \brief Avoid copy by reference
+    */
+    GGEMSSolidPrimitive(GGEMSSolidPrimitive const& solid_primitive) = delete;
+
+    /*!
+      \fn GGEMSSolidPrimitive& operator=(GGEMSSolidPrimitive const& solid_primitive) = delete
+      \param solid_primitive - reference on the GGEMS solid primitive
+      \brief Avoid assignement by reference
+    */
+    GGEMSSolidPrimitive& operator=(GGEMSSolidPrimitive const& solid_primitive) = delete;
+
+    /*!
+      \fn GGEMSSolidPrimitive(GGEMSSolidPrimitive const&& solid_primitive) = delete
+      \param solid_primitive - rvalue reference on the GGEMS solid primitive
+      \brief Avoid copy by rvalue reference
+    */
+    GGEMSSolidPrimitive(GGEMSSolidPrimitive const&& solid_primitive) = delete;
+
+    /*!
+      \fn GGEMSSolidPrimitive& operator=(GGEMSSolidPrimitive const&& solid_primitive) = delete
+      \param solid_primitive - rvalue reference on the GGEMS solid primitive
+      \brief Avoid copy by rvalue reference
+    */
+    GGEMSSolidPrimitive& operator=(GGEMSSolidPrimitive const&& solid_primitive) = delete;
+
+    /*!
+      \fn void Initialize(GGEMSMaterials* materials)
+      \param materials - pointer on materials
+      \brief Initialize solid for geometric navigation
+    */
+    void Initialize(GGEMSMaterials* materials) override;
+
+    /*!
+      \fn void EnableScatter(void)
+      \brief Activate scatter registration, no registration in solid primitive
+    */
+    void EnableScatter(void) override {}
+
+    /*!
+      \fn void PrintInfos(void) const
+      \brief printing infos about solid primitive
+    */
+    void PrintInfos(void) const override;
+
+    /*!
+      \fn void UpdateTransformationMatrix(GGsize const& thread_index)
+      \param thread_index - index of the thread (= activated device index)
+      \brief Update transformation matrix for solid primitive object
+    */
+    void UpdateTransformationMatrix(GGsize const& thread_index) override;
+
+  private:
+    /*!
+      \fn void InitializeKernel(void)
+      \brief Initialize kernel for particle solid distance
+    */
+    void InitializeKernel(void) override;
+};
+
+#endif // End of GUARD_GGEMS_GEOMETRIES_GGEMSSOLIDPRIMITIVE_HH
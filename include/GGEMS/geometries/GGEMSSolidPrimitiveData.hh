@@ -0,0 +1,51 @@
+#ifndef GUARD_GGEMS_GEOMETRIES_GGEMSSOLIDPRIMITIVEDATA_HH
+#define GUARD_GGEMS_GEOMETRIES_GGEMSSOLIDPRIMITIVEDATA_HH
+
+// ************************************************************************
+// * This file is part of GGEMS.                                          *
+// *                                                                      *
+// * GGEMS is free software: you can redistribute it and/or modify        *
+// * it under the terms of the GNU General Public License as published by *
+// * the Free Software Foundation, either version 3 of the License, or    *
+// * (at your option) any later version.                                  *
+// *                                                                      *
+// * GGEMS is distributed in the hope that it will be useful,             *
+// * but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+// * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+// * GNU General Public License for more details.                         *
+// *                                                                      *
+// * You should have received a copy of the GNU General Public License    *
+// * along with GGEMS.  If not, see <https://www.gnu.org/licenses/>.      *
+// *                                                                      *
+// ************************************************************************
+
+/*!
+  \file GGEMSSolidPrimitiveData.hh
+
+  \brief Structure storing the data for analytic primitive solid (ellipsoid, sphere or cylinder)
+
+  \author Julien BERT <julien.bert@univ-brest.fr>
+  \author Didier BENOIT <didier.benoit@inserm.fr>
+  \author LaTIM, INSERM - U1101, Brest, FRANCE
+  \version 1.0
+  \date Sunday October 18, 2026
+*/
+
+#include "GGEMS/geometries/GGEMSPrimitiveGeometries.hh"
+
+#define ELLIPSOID_PRIMITIVE 0 /*!< Ellipsoid centered on origin, a sphere is an ellipsoid with equal semi-axes */
+#define CYLINDER_PRIMITIVE 1 /*!< Elliptic cylinder centered on origin, axis along Z */
+
+/*!
+  \struct GGEMSSolidPrimitiveData_t
+  \brief Structure storing the stack of data for analytic primitive solid
+*/
+typedef struct GGEMSSolidPrimitiveData_t
+{
+  GGEMSOBB obb_geometry_; /*!< OBB storing bounding box of primitive and matrix of transformation */
+  GGfloat3 half_size_xyz_; /*!< Semi-axes of ellipsoid, or radii of cylinder in X and Y and half height in Z */
+  GGint primitive_type_; /*!< Type of primitive (ELLIPSOID_PRIMITIVE or CYLINDER_PRIMITIVE) */
+  GGint solid_id_; /*!< Navigator index */
+} GGEMSSolidPrimitiveData; /*!< Using C convention name of struct to C++ (_t deletion) */
+
+#endif // GUARD_GGEMS_GEOMETRIES_GGEMSSOLIDPRIMITIVEDATA_HH
@@ -34,6 +34,10 @@
 #include "GGEMS/geometries/GGEMSVoxelizedSolidData.hh"
 #include "GGEMS/geometries/GGEMSSolid.hh"
 
+class GGEMSMHDImage;
+
+#define LABEL_BRICK_SIZE 4096 /*!< Number of consecutive voxels in a brick of label, unit of deduplication between motion phases */
+
 /*!
   \class GGEMSVoxelizedSolid
   \brief GGEMS class for voxelized solid
@@ -131,17 +135,65 @@ class GGEMS_EXPORT GGEMSVoxelizedSolid : public GGEMSSolid
     */
     GGEMSOBB GetOBBGeometry(GGsize const& thread_index) const;
 
+    /*!
+      \fn void AddMotionPhase(std::string const& volume_header_filename, GGfloat3 const& translation_xyz)
+      \param volume_header_filename - header file for volume of the motion phase
+      \param translation_xyz - translation of the motion phase relative to the first phase
+      \brief add a motion phase (4D phantom), volume must have the same dimension and voxel sizes than first phase and use the same range file
+    */
+    void AddMotionPhase(std::string const& volume_header_filename, GGfloat3 const& translation_xyz);
+
+    /*!
+      \fn inline GGsize GetNumberOfMotionPhases(void) const
+      \return number of motion phases, first phase included
+      \brief get the number of motion phases
+    */
+    inline GGsize GetNumberOfMotionPhases(void) const {return motion_phase_translations_.size();}
+
+    /*!
+      \fn void SetMotionPhase(GGsize const& motion_phase, GGsize const& thread_index)
+      \param motion_phase - index of motion phase
+      \param thread_index - index of the thread (= activated device index)
+      \brief select the motion phase on a device, only bricks of label differing between current and new phase are written
+    */
+    void SetMotionPhase(GGsize const& motion_phase, GGsize const& thread_index);
+
   private:
     /*!
-      \fn template <typename T> void ConvertImageToLabel(std::string const& raw_data_filename, std::string const& range_data_filename, GGEMSMaterials* materials)
+      \fn template <typename T> void ConvertImageToLabel(std::string const& raw_data_filename, std::string const& range_data_filename, GGEMSMaterials* materials, std::vector<GGuchar>& labels)
       \tparam T - type of data
       \param raw_data_filename - raw data filename from mhd
       \param range_data_filename - name of the file containing the range to material data
-      \param materials - pointer on material for a phantom
+      \param materials - pointer on material for a phantom, nullptr if materials are already registered
+      \param labels - label data on host
       \brief convert image data to label data
     */
     template <typename T>
-    void ConvertImageToLabel(std::string const& raw_data_filename, std::string const& range_data_filename, GGEMSMaterials* materials);
+    void ConvertImageToLabel(std::string const& raw_data_filename, std::string const& range_data_filename, GGEMSMaterials* materials, std::vector<GGuchar>& labels);
+
+    /*!
+      \fn void ConvertMHDImageToLabel(GGEMSMHDImage const& mhd_image, GGEMSMaterials* materials, std::vector<GGuchar>& labels)
+      \param mhd_image - MHD image with header already read
+      \param materials - pointer on material for a phantom, nullptr if materials are already registered
+      \param labels - label data on host
+      \brief convert raw data of a MHD image to label data on host depending on MHD data type
+    */
+    void ConvertMHDImageToLabel(GGEMSMHDImage const& mhd_image, GGEMSMaterials* materials, std::vector<GGuchar>& labels);
+
+    /*!
+      \fn void LoadMotionPhases(void)
+      \brief read the motion phases and keep only bricks of label differing from the first phase
+    */
+    void LoadMotionPhases(void);
+
+    /*!
+      \fn void WriteLabelBrick(GGsize const& brick_index, GGuchar const* brick_labels, GGsize const& thread_index)
+      \param brick_index - index of the brick in label buffer
+      \param brick_labels - label data of the brick on host
+      \param thread_index - index of the thread (= activated device index)
+      \brief write a brick of label on OpenCL device
+    */
+    void WriteLabelBrick(GGsize const& brick_index, GGuchar const* brick_labels, GGsize const& thread_index);
 
     /*!
       \fn void InitializeKernel(void)
@@ -152,6 +204,13 @@ class GGEMS_EXPORT GGEMSVoxelizedSolid : public GGEMSSolid
   private:
     std::string volume_header_filename_; /*!< Filename of MHD file for phantom */
     std::string range_filename_; /*!< Filename of file for range data */
+
+    std::vector<std::string> motion_phase_filenames_; /*!< Filename of MHD file for each motion phase, first phase is volume_header_filename_ */
+    std::vector<GGfloat3> motion_phase_translations_; /*!< Translation of each motion phase relative to first phase */
+    std::vector<GGuchar> reference_labels_; /*!< Labels of first phase on host, only kept with several motion phases */
+    std::vector<std::vector<GGsize>> motion_phase_bricks_; /*!< Index of bricks differing from first phase for each motion phase */
+    std::vector<std::vector<GGuchar>> motion_phase_brick_labels_; /*!< Labels of bricks differing from first phase for each motion phase */
+    std::vector<GGsize> current_motion_phases_; /*!< Current motion phase on each device */
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -159,100 +218,77 @@ class GGEMS_EXPORT GGEMSVoxelizedSolid : public GGEMSSolid
 ////////////////////////////////////////////////////////////////////////////////
 
 template <typename T>
-void GGEMSVoxelizedSolid::ConvertImageToLabel(std::string const& raw_data_filename, std::string const& range_data_filename, GGEMSMaterials* materials)
+void GGEMSVoxelizedSolid::ConvertImageToLabel(std::string const& raw_data_filename, std::string const& range_data_filename, GGEMSMaterials* materials, std::vector<GGuchar>& labels)
 {
   GGcout("GGEMSVoxelizedSolid", "ConvertImageToLabel", 3) << "Converting image material data to label data..." << GGendl;
 
-  // Get the OpenCL manager
-  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
-
-  for (GGsize d = 0; d < number_activated_devices_; ++d) {
-    // Get pointer on OpenCL device
-    GGEMSVoxelizedSolidData* solid_data_device = opencl_manager.GetDeviceBuffer<GGEMSVoxelizedSolidData>(solid_data_[d], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSVoxelizedSolidData), d);
-
-    // Get information about mhd file
-    number_of_voxels_ = static_cast<GGsize>(solid_data_device->number_of_voxels_);
-
-    // Release the pointer
-    opencl_manager.ReleaseDeviceBuffer(solid_data_[d], solid_data_device, d);
-
-    // Checking if file exists
-    std::ifstream in_raw_stream(raw_data_filename, std::ios::in | std::ios::binary);
-    GGEMSFileStream::CheckInputStream(in_raw_stream, raw_data_filename);
-
-    // Reading data to a tmp buffer
-    std::vector<T> tmp_raw_data;
-    tmp_raw_data.resize(number_of_voxels_);
-    in_raw_stream.read(reinterpret_cast<char*>(&tmp_raw_data[0]), static_cast<std::streamsize>(number_of_voxels_ * sizeof(T)));
-
-    // Closing file
-    in_raw_stream.close();
+  // Checking if file exists
+  std::ifstream in_raw_stream(raw_data_filename, std::ios::in | std::ios::binary);
+  GGEMSFileStream::CheckInputStream(in_raw_stream, raw_data_filename);
 
-    // Allocating memory on OpenCL device
-    label_data_[d] = opencl_manager.Allocate(nullptr, number_of_voxels_ * sizeof(GGuchar), d, CL_MEM_READ_WRITE, "GGEMSVoxelizedSolid");
+  // Reading data to a tmp buffer
+  std::vector<T> tmp_raw_data;
+  tmp_raw_data.resize(number_of_voxels_);
+  in_raw_stream.read(reinterpret_cast<char*>(&tmp_raw_data[0]), static_cast<std::streamsize>(number_of_voxels_ * sizeof(T)));
 
-    // Get pointer on OpenCL device
-    GGuchar* label_data_device = opencl_manager.GetDeviceBuffer<GGuchar>(label_data_[d], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, number_of_voxels_ * sizeof(GGuchar), d);
+  // Closing file
+  in_raw_stream.close();
 
-    // Set value to max of GGuchar
-    std::fill(label_data_device, label_data_device + number_of_voxels_, std::numeric_limits<GGuchar>::max());
+  // Set value to max of GGuchar
+  labels.assign(number_of_voxels_, std::numeric_limits<GGuchar>::max());
 
-    // Opening range data file
-    std::ifstream in_range_stream(range_data_filename, std::ios::in);
-    GGEMSFileStream::CheckInputStream(in_range_stream, range_data_filename);
+  // Opening range data file
+  std::ifstream in_range_stream(range_data_filename, std::ios::in);
+  GGEMSFileStream::CheckInputStream(in_range_stream, range_data_filename);
 
-    // Values in the range file
-    GGfloat first_label_value = 0.0f;
-    GGfloat last_label_value = 0.0f;
-    GGuchar label_index = 0;
-    std::string material_name("");
+  // Values in the range file
+  GGfloat first_label_value = 0.0f;
+  GGfloat last_label_value = 0.0f;
+  GGuchar label_index = 0;
+  std::string material_name("");
 
-    // Reading range file
-    std::string line("");
-    while (std::getline(in_range_stream, line)) {
-      // Check if blank line
-      if (GGEMSTextReader::IsBlankLine(line)) continue;
+  // Reading range file
+  std::string line("");
+  while (std::getline(in_range_stream, line)) {
+    // Check if blank line
+    if (GGEMSTextReader::IsBlankLine(line)) continue;
 
-      // Getting the value in string stream
-      std::istringstream iss = GGEMSRangeReader::ReadRangeMaterial(line);
-      iss >> first_label_value >> last_label_value >> material_name;
+    // Getting the value in string stream
+    std::istringstream iss = GGEMSRangeReader::ReadRangeMaterial(line);
+    iss >> first_label_value >> last_label_value >> material_name;
 
-      // Adding the material only once
-      if (d == 0) materials->AddMaterial(material_name);
+    // Adding the material only once, motion phases share the materials of first phase
+    if (materials) materials->AddMaterial(material_name);
 
-      // Setting the label
-      for (GGsize i = 0; i < number_of_voxels_; ++i) {
-        // Getting the value of phantom
-        GGfloat value = static_cast<GGfloat>(tmp_raw_data[i]);
-        if (((value == first_label_value) && (value == last_label_value)) || ((value >= first_label_value) && (value < last_label_value))) {
-          label_data_device[i] = label_index;
-        }
+    // Setting the label
+    for (GGsize i = 0; i < number_of_voxels_; ++i) {
+      // Getting the value of phantom
+      GGfloat value = static_cast<GGfloat>(tmp_raw_data[i]);
+      if (((value == first_label_value) && (value == last_label_value)) || ((value >= first_label_value) && (value < last_label_value))) {
+        labels[i] = label_index;
       }
-
-      // Increment the label index
-      ++label_index;
     }
 
-    // Final loop checking if a value is still max of GGuchar
-    bool all_converted = true;
-    for (GGsize i = 0; i < number_of_voxels_; ++i) {
-      if (label_data_device[i] == std::numeric_limits<GGuchar>::max()) all_converted = false;
-    }
+    // Increment the label index
+    ++label_index;
+  }
 
-    // Closing file
-    in_range_stream.close();
-    tmp_raw_data.clear();
+  // Final loop checking if a value is still max of GGuchar
+  bool all_converted = true;
+  for (GGsize i = 0; i < number_of_voxels_; ++i) {
+    if (labels[i] == std::numeric_limits<GGuchar>::max()) all_converted = false;
+  }
 
-    // Release the pointer
-    opencl_manager.ReleaseDeviceBuffer(label_data_[d], label_data_device, d);
+  // Closing file
+  in_range_stream.close();
+  tmp_raw_data.clear();
 
-    // Checking if all voxels converted
-    if (all_converted) {
-      GGcout("GGEMSVoxelizedSolid", "ConvertImageToLabel", 2) << "All your voxels are converted to label..." << GGendl;
-    }
-    else {
-      GGEMSMisc::ThrowException("GGEMSVoxelizedSolid", "ConvertImageToLabel", "Errors(s) in the range data file!!!");
-    }
+  // Checking if all voxels converted
+  if (all_converted) {
+    GGcout("GGEMSVoxelizedSolid", "ConvertImageToLabel", 2) << "All your voxels are converted to label..." << GGendl;
+  }
+  else {
+    GGEMSMisc::ThrowException("GGEMSVoxelizedSolid", "ConvertImageToLabel", "Errors(s) in the range data file!!!");
   }
 }
 
@@ -32,6 +32,11 @@
 */
 
 #include <unordered_map>
+#include <future>
+#include <mutex>
+#include <deque>
+#include <thread>
+#include <condition_variable>
 #include "GGEMS/tools/GGEMSPrint.hh"
 
 #ifdef _MSC_VER
@@ -45,6 +50,8 @@
 typedef std::unordered_map<std::string, std::string> VendorUMap; /*!< Alias to OpenCL vendors */
 
 #define KERNEL_NOT_COMPILED 0x100000000 /*!< value if OpenCL kernel is not compiled */
+#define NUMBER_OF_NAVIGATION_QUEUES 4 /*!< Number of in-order queues for navigator kernels if out-of-order queue is not supported by device */
+#define MAXIMUM_BUILD_THREADS 4 /*!< Maximum number of threads building OpenCL programs in background */
 
 /*!
   \struct ComputingDevice_t
@@ -55,6 +62,7 @@ typedef struct ComputingDevice_t
   GGsize index_; /*!< Index of computing device */
   cl::Context* context_; /*!< Context associated to computing device */
   cl::CommandQueue* queue_; /*!< Queue associated to computing device */
+  std::vector<cl::CommandQueue*> navigation_queues_; /*!< Queues for independent navigator kernels, a single out-of-order queue or several in-order queues */
 
   /*!
     \fn void Clean(void)
@@ -71,9 +79,23 @@ typedef struct ComputingDevice_t
       delete queue_;
       queue_ = nullptr;
     }
+
+    for (cl::CommandQueue* q : navigation_queues_) delete q;
+    navigation_queues_.clear();
   }
 } ComputingDevice; /*!< Using C convention name of struct to C++ (_t deletion) */
 
+/*!
+  \struct LazyKernel_t
+  \brief Kernel registered by CompileKernel, created at its first launch once its program is built
+*/
+typedef struct LazyKernel_t
+{
+  std::string kernel_name_; /*!< Name of the kernel */
+  std::string program_key_; /*!< Key of the program, kernel file and compilation options */
+  GGsize thread_index_; /*!< Index of activated device */
+} LazyKernel; /*!< Using C convention name of struct to C++ (_t deletion) */
+
 /*!
   \class GGEMSOpenCLManager
   \brief Singleton class storing all informations about OpenCL and managing GPU/CPU devices, contexts, kernels, command queues and events. In GGEMS the strategy is 1 context = 1 device.
@@ -179,6 +201,14 @@ class GGEMS_EXPORT GGEMSOpenCLManager
     */
     inline std::string GetDeviceName(GGsize const& device_index) const {return device_name_[device_index];}
 
+    /*!
+      \fn GGuint GetMemBaseAddrAlign(GGsize const& device_index) const
+      \param device_index - index of device
+      \return alignment of base address of buffers in bits
+      \brief Get the alignment of base address of buffers, sub-buffers have to respect it
+    */
+    inline GGuint GetMemBaseAddrAlign(GGsize const& device_index) const {return device_mem_base_addr_align_[device_index];}
+
     /*!
       \fn cl_device_type GetDeviceType(GGsize const& device_index) const
       \param device_index - index of device
@@ -256,6 +286,22 @@ class GGEMS_EXPORT GGEMSOpenCLManager
     */
     inline cl::CommandQueue* GetCommandQueue(GGsize const& thread_index) const {return computing_devices_[thread_index].queue_;}
 
+    /*!
+      \fn cl::CommandQueue* GetNavigationQueue(GGsize const& thread_index, GGsize const& navigator_index) const
+      \param thread_index - index of the thread (= activated device index)
+      \param navigator_index - index of the navigator
+      \return the pointer on queue of navigator kernels
+      \brief Return the queue launching kernels of a navigator, kernels of different navigators can run concurrently on this queue
+    */
+    inline cl::CommandQueue* GetNavigationQueue(GGsize const& thread_index, GGsize const& navigator_index) const {return computing_devices_[thread_index].navigation_queues_[navigator_index % computing_devices_[thread_index].navigation_queues_.size()];}
+
+    /*!
+      \fn void FinishNavigationQueues(GGsize const& thread_index) const
+      \param thread_index - index of the thread (= activated device index)
+      \brief Barrier waiting all the navigator kernels launched on the navigation queues
+    */
+    void FinishNavigationQueues(GGsize const& thread_index) const;
+
     /*!
       \fn void DeviceToActivate(GGsize const& device_id)
       \param device_id - device index
@@ -313,10 +359,17 @@ class GGEMS_EXPORT GGEMSOpenCLManager
       \param kernel_list - list of kernel by device
       \param custom_options - new compilation option for the kernel
       \param additional_options - additionnal compilation option
-      \brief Compile the OpenCL kernel on the activated device
+      \brief Register the OpenCL kernel on the activated devices, its program is built in background from its first launch and the kernel is created at this launch (PrepareKernel)
     */
     void CompileKernel(std::string const& kernel_filename, std::string const& kernel_name, cl::Kernel** kernel_list, char* const custom_options = nullptr, char* const additional_options = nullptr);
 
+    /*!
+      \fn void PrepareKernel(cl::Kernel* kernel)
+      \param kernel - kernel registered by CompileKernel
+      \brief Submit the build of the program of the kernel to the build threads if not submitted yet, wait for it building other submitted programs meanwhile, and create the kernel, to call before setting arguments of kernel. Nothing is done if kernel is already created
+    */
+    void PrepareKernel(cl::Kernel* kernel);
+
     /*!
       \return the pointer on host memory on write/read mode
       \brief Get the device pointer on host to write on it. ReleaseDeviceBuffer must be used after this method!!!
@@ -362,6 +415,25 @@ class GGEMS_EXPORT GGEMSOpenCLManager
     */
     void Deallocate(cl::Buffer* buffer, GGsize size, GGsize const& thread_index, std::string const& class_name = "Undefined");
 
+    /*!
+      \fn cl::Buffer* AllocateSubBuffer(cl::Buffer* buffer, GGsize const& origin, GGsize const& size, GGsize const& thread_index, cl_mem_flags flags)
+      \param buffer - pointer to parent buffer
+      \param origin - offset of the sub-buffer in parent buffer in bytes
+      \param size - size of the sub-buffer in bytes
+      \param thread_index - index of the thread (= activated device index)
+      \param flags - mode to open the buffer
+      \brief Creating a sub-buffer sharing memory of a parent buffer, no memory is allocated
+      \return an pointer to an OpenCL buffer
+    */
+    cl::Buffer* AllocateSubBuffer(cl::Buffer* buffer, GGsize const& origin, GGsize const& size, GGsize const& thread_index, cl_mem_flags flags);
+
+    /*!
+      \fn void DeallocateSubBuffer(cl::Buffer* buffer)
+      \param buffer - pointer to sub-buffer
+      \brief Deleting a sub-buffer, memory is released with parent buffer
+    */
+    void DeallocateSubBuffer(cl::Buffer* buffer);
+
     /*!
       \fn void CleanBuffer(cl::Buffer* buffer, GGsize const& size, GGsize const& thread_index)
       \param buffer - pointer to buffer in host memory
@@ -427,6 +499,95 @@ class GGEMS_EXPORT GGEMSOpenCLManager
     */
     GGsize CheckKernel(std::string const& kernel_name, std::string const& compilation_options) const;
 
+    /*!
+      \fn std::vector<cl::Program> BuildProgram(std::string const& kernel_filename, char const* compilation_options)
+      \param kernel_filename - filename of kernel source
+      \param compilation_options - arguments of compilation
+      \return a program built for each activated device
+      \brief build an OpenCL program from a kernel file, all kernels of the file are created from this program. A kernel file including photon navigator is compiled alone and linked to physics library
+    */
+    std::vector<cl::Program> BuildProgram(std::string const& kernel_filename, char const* compilation_options);
+
+    /*!
+      \fn std::vector<cl::Program> GetPhysicsLibrary(std::string const& compilation_options)
+      \param compilation_options - arguments of compilation
+      \return physics library compiled for each activated device, empty program if device has no linker
+      \brief compile physics library (GGEMSPhysicsLibrary.cl) at the first call for these options, other calls wait for it and share it
+    */
+    std::vector<cl::Program> GetPhysicsLibrary(std::string const& compilation_options);
+
+    /*!
+      \fn std::string GetLinkOptions(std::string const& compilation_options) const
+      \param compilation_options - arguments of compilation
+      \return options of compilation accepted by OpenCL linker
+      \brief select the math options of compilation, other options are rejected by linker
+    */
+    std::string GetLinkOptions(std::string const& compilation_options) const;
+
+    /*!
+      \fn bool IsLinkerAvailable(GGsize const& thread_index) const
+      \param thread_index - index of the thread (= activated device index)
+      \return true if programs can be compiled and linked separately on device
+      \brief checking linker of OpenCL device
+    */
+    bool IsLinkerAvailable(GGsize const& thread_index) const;
+
+    /*!
+      \fn void CheckProgramBuild(cl::Program const& program, GGint const& build_status, GGsize const& thread_index, std::string const& method_name) const
+      \param program - program built, compiled or linked
+      \param build_status - status returned by build, compilation or link
+      \param thread_index - index of the thread (= activated device index)
+      \param method_name - name of method building program
+      \brief throw an exception with build log if program is not built
+    */
+    void CheckProgramBuild(cl::Program const& program, GGint const& build_status, GGsize const& thread_index, std::string const& method_name) const;
+
+    /*!
+      \fn void SubmitProgramBuild(std::packaged_task<std::vector<cl::Program>()>&& program_build)
+      \param program_build - build of a program
+      \brief push a build of program in queue of build threads, threads are started at the first submission
+    */
+    void SubmitProgramBuild(std::packaged_task<std::vector<cl::Program>()>&& program_build);
+
+    /*!
+      \fn bool RunProgramBuild(std::unique_lock<std::mutex>& lock)
+      \param lock - lock on build mutex, released while building
+      \return true if a build was taken from the queue and run
+      \brief run the first build of program in queue, called by build threads and by threads waiting for a program
+    */
+    bool RunProgramBuild(std::unique_lock<std::mutex>& lock);
+
+    /*!
+      \fn void BuildWorker(void)
+      \brief loop of a build thread, running builds of program until the build threads are stopped
+    */
+    void BuildWorker(void);
+
+    /*!
+      \fn void StopBuildWorkers(void)
+      \brief stop and join the build threads, builds still in queue are run before
+    */
+    void StopBuildWorkers(void);
+
+    /*!
+      \fn std::string GetSPIRVFilename(std::string const& kernel_filename, std::string const& compilation_options) const
+      \param kernel_filename - filename of kernel source
+      \param compilation_options - arguments of compilation
+      \return filename of the SPIR-V kernel precompiled at build time for these options
+      \brief name of SPIR-V kernel, built from the kernel file name and the sorted macros (-D) of compilation options
+    */
+    std::string GetSPIRVFilename(std::string const& kernel_filename, std::string const& compilation_options) const;
+
+    /*!
+      \fn bool CreateProgramFromSPIRV(std::string const& spirv_filename, GGsize const& thread_index, cl::Program& program) const
+      \param spirv_filename - filename of SPIR-V kernel
+      \param thread_index - index of the thread (= activated device index)
+      \param program - OpenCL program created from SPIR-V
+      \return true if the program is created from SPIR-V, false if the source has to be compiled
+      \brief create an OpenCL program from a SPIR-V kernel precompiled at build time
+    */
+    bool CreateProgramFromSPIRV(std::string const& spirv_filename, GGsize const& thread_index, cl::Program& program) const;
+
     /*!
       \fn bool IsDoublePrecision(GGsize const& device_index) const
       \param device_index - index of the device
@@ -525,6 +686,7 @@ class GGEMS_EXPORT GGEMSOpenCLManager
     std::vector<cl_device_affinity_domain> device_partition_affinity_domain_; /*!< Partition affinity domain */
     std::vector<GGuint> device_partition_max_sub_devices_; /*!< Partition affinity domain */
     std::vector<GGsize> device_profiling_timer_resolution_; /*!< Timer resolution */
+    std::vector<cl_command_queue_properties> device_queue_properties_; /*!< Properties of command queue supported by device */
     std::vector<GGfloat> device_balancing_; /*!< Device balancing */
 
     // Custom OpenCL members
@@ -539,7 +701,21 @@ class GGEMS_EXPORT GGEMSOpenCLManager
 
     // OpenCL kernels
     std::vector<cl::Kernel*> kernels_; /*!< List of kernels for each device */
+    std::vector<std::string> kernel_names_; /*!< List of names of kernels */
+    std::unordered_map<std::string, std::shared_future<std::vector<cl::Program>>> programs_; /*!< Programs for each device built from first launch of one of their kernels, key is kernel file and compilation options */
+    std::unordered_map<std::string, std::packaged_task<std::vector<cl::Program>()>> registered_builds_; /*!< Builds of program registered but not submitted yet, none of their kernels is launched */
+    std::unordered_map<std::string, std::shared_future<std::vector<cl::Program>>> physics_libraries_; /*!< Physics library compiled for each device, key is compilation options */
+    std::mutex library_mutex_; /*!< Mutex protecting physics libraries, not held while compiling */
     std::vector<std::string> kernel_compilation_options_; /*!< List of compilation options for kernel */
+    std::unordered_map<cl::Kernel*, LazyKernel> lazy_kernels_; /*!< Registered kernels not created yet */
+    std::mutex kernel_mutex_; /*!< Mutex protecting programs and lazy kernels, kernels are created by threads of devices, not held while building programs */
+
+    // Threads building OpenCL programs
+    std::deque<std::packaged_task<std::vector<cl::Program>()>> build_queue_; /*!< Builds of program submitted and not started */
+    std::vector<std::thread> build_workers_; /*!< Threads building programs, at most MAXIMUM_BUILD_THREADS */
+    std::mutex build_mutex_; /*!< Mutex protecting build queue */
+    std::condition_variable build_condition_; /*!< Notified when a build is submitted or finished */
+    bool is_build_stopped_; /*!< Build threads are stopped */
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -42,7 +42,7 @@
 typedef struct GGEMSHistogramMode_t
 {
   cl::Buffer** histogram_; /*!< Buffer storing histogram counting */
-  cl::Buffer** scatter_; /*!< Buffer storing scattered photon */
+  cl::Buffer** scatter_; /*!< Buffer storing scattered photon, one channel per scatter category (single Compton, single Rayleigh and multiple) */
   GGsize number_of_elements_; /*!< Number of elements in hit buffer */
 } GGEMSHistogramMode; /*!< Using C convention name of struct to C++ (_t deletion) */
 
@@ -0,0 +1,183 @@
+#ifndef GUARD_GGEMS_IO_GGEMSPHASESPACE_HH
+#define GUARD_GGEMS_IO_GGEMSPHASESPACE_HH
+
+// ************************************************************************
+// * This file is part of GGEMS.                                          *
+// *                                                                      *
+// * GGEMS is free software: you can redistribute it and/or modify        *
+// * it under the terms of the GNU General Public License as published by *
+// * the Free Software Foundation, either version 3 of the License, or    *
+// * (at your option) any later version.                                  *
+// *                                                                      *
+// * GGEMS is distributed in the hope that it will be useful,             *
+// * but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+// * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+// * GNU General Public License for more details.                         *
+// *                                                                      *
+// * You should have received a copy of the GNU General Public License    *
+// * along with GGEMS.  If not, see <https://www.gnu.org/licenses/>.      *
+// *                                                                      *
+// ************************************************************************
+
+/*!
+  \file GGEMSPhaseSpace.hh
+
+  \brief I/O class storing particles exiting a phantom in a phase space file and loading them for a replay
+
+  \author Julien BERT <julien.bert@univ-brest.fr>
+  \author Didier BENOIT <didier.benoit@inserm.fr>
+  \author LaTIM, INSERM - U1101, Brest, FRANCE
+  \version 1.0
+  \date Sunday October 18, 2026
+*/
+
+#ifdef _MSC_VER
+#pragma warning(disable: 4251) // Deleting warning exporting STL members!!!
+#endif
+
+#include <fstream>
+#include <mutex>
+
+#include "GGEMS/global/GGEMSOpenCLManager.hh"
+
+/*!
+  \struct GGEMSPhaseSpaceHeader_t
+  \brief Header at the beginning of phase space file
+*/
+typedef struct GGEMSPhaseSpaceHeader_t
+{
+  GGchar magic_[8]; /*!< Magic word 'GGEMSPHS' */
+  GGuint version_; /*!< Version of file format */
+  GGuint padding_; /*!< Padding for 8 bytes alignment */
+  GGulong number_of_particles_; /*!< Number of particles stored in file */
+} GGEMSPhaseSpaceHeader; /*!< Using C convention name of struct to C++ (_t deletion) */
+
+/*!
+  \struct GGEMSPhaseSpaceRecord_t
+  \brief Particle stored in phase space file
+*/
+typedef struct GGEMSPhaseSpaceRecord_t
+{
+  GGfloat E_; /*!< Energy of particle */
+  GGfloat position_[3]; /*!< Global position of particle */
+  GGfloat direction_[3]; /*!< Global direction of particle */
+  GGuchar scatter_history_; /*!< Scatter history code of particle */
+  GGuchar padding_[3]; /*!< Padding for 4 bytes alignment */
+} GGEMSPhaseSpaceRecord; /*!< Using C convention name of struct to C++ (_t deletion) */
+
+/*!
+  \class GGEMSPhaseSpace
+  \brief I/O class for phase space. In writing mode, particles recorded on OpenCL device at the exit of a phantom are appended to the file after each batch. In reading mode, particles are loaded batch by batch on OpenCL device to be replayed by a phase space source
+*/
+class GGEMS_EXPORT GGEMSPhaseSpace
+{
+  public:
+    /*!
+      \brief GGEMSPhaseSpace constructor
+    */
+    GGEMSPhaseSpace(void);
+
+    /*!
+      \brief GGEMSPhaseSpace destructor
+    */
+    ~GGEMSPhaseSpace(void);
+
+  public:
+    /*!
+      \fn GGEMSPhaseSpace(GGEMSPhaseSpace const& phase_space) = delete
+      \param phase_space - reference on the phase space
+      \brief Avoid copy of the class by reference
+    */
+    GGEMSPhaseSpace(GGEMSPhaseSpace const& phase_space) = delete;
+
+    /*!
+      \fn GGEMSPhaseSpace& operator=(GGEMSPhaseSpace const& phase_space) = delete
+      \param phase_space - reference on the phase space
+      \brief Avoid assignement of the class by reference
+    */
+    GGEMSPhaseSpace& operator=(GGEMSPhaseSpace const& phase_space) = delete;
+
+    /*!
+      \fn GGEMSPhaseSpace(GGEMSPhaseSpace const&& phase_space) = delete
+      \param phase_space - rvalue reference on the phase space
+      \brief Avoid copy of the class by rvalue reference
+    */
+    GGEMSPhaseSpace(GGEMSPhaseSpace const&& phase_space) = delete;
+
+    /*!
+      \fn GGEMSPhaseSpace& operator=(GGEMSPhaseSpace const&& phase_space) = delete
+      \param phase_space - rvalue reference on the phase space
+      \brief Avoid copy of the class by rvalue reference
+    */
+    GGEMSPhaseSpace& operator=(GGEMSPhaseSpace const&& phase_space) = delete;
+
+    /*!
+      \fn void OpenForWriting(std::string const& filename)
+      \param filename - name of phase space file
+      \brief create the phase space file and allocate the recording buffers on OpenCL devices
+    */
+    void OpenForWriting(std::string const& filename);
+
+    /*!
+      \fn void OpenForReading(std::string const& filename)
+      \param filename - name of phase space file
+      \brief open an existing phase space file and allocate the replay buffers on OpenCL devices
+    */
+    void OpenForReading(std::string const& filename);
+
+    /*!
+      \fn void StoreParticles(GGsize const& thread_index, GGsize const& number_of_particles)
+      \param thread_index - index of activated device (thread index)
+      \param number_of_particles - number of particles in batch
+      \brief append the particles recorded during the batch to the file and reset the recording buffer
+    */
+    void StoreParticles(GGsize const& thread_index, GGsize const& number_of_particles);
+
+    /*!
+      \fn void LoadParticles(GGsize const& thread_index, GGsize const& number_of_particles)
+      \param thread_index - index of activated device (thread index)
+      \param number_of_particles - number of particles in batch
+      \brief read the next particles of the file and copy them on OpenCL device
+    */
+    void LoadParticles(GGsize const& thread_index, GGsize const& number_of_particles);
+
+    /*!
+      \fn void Close(void)
+      \brief update the header in writing mode and close the file
+    */
+    void Close(void);
+
+    /*!
+      \fn inline cl::Buffer* GetPhaseSpaceParticles(GGsize const& thread_index) const
+      \param thread_index - index of activated device (thread index)
+      \return pointer on phase space particles buffer
+      \brief get the phase space particles buffer on OpenCL device
+    */
+    inline cl::Buffer* GetPhaseSpaceParticles(GGsize const& thread_index) const {return particles_[thread_index];}
+
+    /*!
+      \fn inline GGsize GetNumberOfParticles(void) const
+      \return number of particles in file
+      \brief get the number of particles written in file, or stored in file in reading mode
+    */
+    inline GGsize GetNumberOfParticles(void) const {return number_of_particles_;}
+
+  private:
+    /*!
+      \fn void AllocateParticles(void)
+      \brief allocate and clean the phase space particles buffer on each OpenCL device
+    */
+    void AllocateParticles(void);
+
+  private:
+    std::string filename_; /*!< Name of phase space file */
+    std::fstream stream_; /*!< Stream on phase space file */
+    bool is_writing_; /*!< True in writing mode, false in reading mode */
+    GGsize number_of_particles_; /*!< Number of particles written, or stored in file in reading mode */
+    GGsize number_of_read_particles_; /*!< Number of particles already read */
+    std::mutex mutex_; /*!< Mutex protecting the file shared by all the devices */
+    cl::Buffer** particles_; /*!< Phase space particles on each OpenCL device */
+    GGsize number_activated_devices_; /*!< Number of activated devices */
+};
+
+#endif // End of GUARD_GGEMS_IO_GGEMSPHASESPACE_HH
@@ -0,0 +1,54 @@
+#ifndef GUARD_GGEMS_IO_GGEMSPHASESPACEPARTICLES_HH
+#define GUARD_GGEMS_IO_GGEMSPHASESPACEPARTICLES_HH
+
+// ************************************************************************
+// * This file is part of GGEMS.                                          *
+// *                                                                      *
+// * GGEMS is free software: you can redistribute it and/or modify        *
+// * it under the terms of the GNU General Public License as published by *
+// * the Free Software Foundation, either version 3 of the License, or    *
+// * (at your option) any later version.                                  *
+// *                                                                      *
+// * GGEMS is distributed in the hope that it will be useful,             *
+// * but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+// * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+// * GNU General Public License for more details.                         *
+// *                                                                      *
+// * You should have received a copy of the GNU General Public License    *
+// * along with GGEMS.  If not, see <https://www.gnu.org/licenses/>.      *
+// *                                                                      *
+// ************************************************************************
+
+/*!
+  \file GGEMSPhaseSpaceParticles.hh
+
+  \brief Structure storing particles exiting a phantom, recorded in phase space or replayed by a phase space source
+
+  \author Julien BERT <julien.bert@univ-brest.fr>
+  \author Didier BENOIT <didier.benoit@inserm.fr>
+  \author LaTIM, INSERM - U1101, Brest, FRANCE
+  \version 1.0
+  \date Sunday October 18, 2026
+*/
+
+#include "GGEMS/global/GGEMSConfiguration.hh"
+#include "GGEMS/tools/GGEMSTypes.hh"
+
+/*!
+  \struct GGEMSPhaseSpaceParticles_t
+  \brief Structure storing phase space particles for a batch, a slot per particle of the primary particle stack
+*/
+typedef struct GGEMSPhaseSpaceParticles_t
+{
+  GGfloat E_[MAXIMUM_PARTICLES]; /*!< Energies of particles */
+  GGfloat px_[MAXIMUM_PARTICLES]; /*!< Global position of the particle in x */
+  GGfloat py_[MAXIMUM_PARTICLES]; /*!< Global position of the particle in y */
+  GGfloat pz_[MAXIMUM_PARTICLES]; /*!< Global position of the particle in z */
+  GGfloat dx_[MAXIMUM_PARTICLES]; /*!< Global direction of the particle in x */
+  GGfloat dy_[MAXIMUM_PARTICLES]; /*!< Global direction of the particle in y */
+  GGfloat dz_[MAXIMUM_PARTICLES]; /*!< Global direction of the particle in z */
+  GGuchar scatter_history_[MAXIMUM_PARTICLES]; /*!< Scatter history code of particle */
+  GGchar is_recorded_[MAXIMUM_PARTICLES]; /*!< TRUE if the particle exited the phantom during the batch */
+} GGEMSPhaseSpaceParticles; /*!< Using C convention name of struct to C++ (_t deletion) */
+
+#endif // End of GUARD_GGEMS_IO_GGEMSPHASESPACEPARTICLES_HH
@@ -0,0 +1,226 @@
+#ifndef GUARD_GGEMS_IO_GGEMSSINOGRAM_HH
+#define GUARD_GGEMS_IO_GGEMSSINOGRAM_HH
+
+// ************************************************************************
+// * This file is part of GGEMS.                                          *
+// *                                                                      *
+// * GGEMS is free software: you can redistribute it and/or modify        *
+// * it under the terms of the GNU General Public License as published by *
+// * the Free Software Foundation, either version 3 of the License, or    *
+// * (at your option) any later version.                                  *
+// *                                                                      *
+// * GGEMS is distributed in the hope that it will be useful,             *
+// * but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+// * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+// * GNU General Public License for more details.                         *
+// *                                                                      *
+// * You should have received a copy of the GNU General Public License    *
+// * along with GGEMS.  If not, see <https://www.gnu.org/licenses/>.      *
+// *                                                                      *
+// ************************************************************************
+
+/*!
+  \file GGEMSSinogram.hh
+
+  \brief I/O class writing all the views of an acquisition in a single memory mapped file
+
+  \author Julien BERT <julien.bert@univ-brest.fr>
+  \author Didier BENOIT <didier.benoit@inserm.fr>
+  \author LaTIM, INSERM - U1101, Brest, FRANCE
+  \version 1.0
+  \date Sunday October 18, 2026
+*/
+
+#ifdef _MSC_VER
+#pragma warning(disable: 4251) // Deleting warning exporting STL members!!!
+#endif
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <queue>
+
+#include "GGEMS/global/GGEMSOpenCLManager.hh"
+
+/*!
+  \struct GGEMSSinogramHeader_t
+  \brief Header at the beginning of sinogram file
+*/
+typedef struct GGEMSSinogramHeader_t
+{
+  GGchar magic_[8]; /*!< Magic word 'GGEMSSIN' */
+  GGuint version_; /*!< Version of file format */
+  GGuint number_of_scatter_channels_; /*!< Number of scatter histograms stored after histogram in each view, 0 if no scatter */
+  GGulong number_of_views_; /*!< Number of preallocated views */
+  GGulong dimensions_[2]; /*!< Number of detection elements in X and Y */
+  GGfloat element_sizes_[3]; /*!< Size of detection elements in X, Y and Z */
+  GGfloat padding_; /*!< Padding for 8 bytes alignment */
+  GGulong view_chunk_size_; /*!< Size in bytes of a view chunk, aligned on page size */
+  GGulong data_offset_; /*!< Offset in bytes of first view chunk */
+} GGEMSSinogramHeader; /*!< Using C convention name of struct to C++ (_t deletion) */
+
+/*!
+  \struct GGEMSSinogramIndex_t
+  \brief Index entry describing a view in sinogram file
+*/
+typedef struct GGEMSSinogramIndex_t
+{
+  GGfloat view_angle_; /*!< Angle of view in rad */
+  GGfloat table_position_; /*!< Table position in mm */
+  GGuint is_written_; /*!< 1 if the view chunk is written */
+  GGuint padding_; /*!< Padding for 8 bytes alignment */
+} GGEMSSinogramIndex; /*!< Using C convention name of struct to C++ (_t deletion) */
+
+/*!
+  \struct GGEMSSinogramView_t
+  \brief View waiting to be written by the writer thread
+*/
+typedef struct GGEMSSinogramView_t
+{
+  GGsize view_id_; /*!< Index of view in sinogram */
+  GGfloat view_angle_; /*!< Angle of view in rad */
+  GGfloat table_position_; /*!< Table position in mm */
+  GGint* histogram_; /*!< Histogram of view, deleted after writing */
+  GGint* scatter_; /*!< Scatter histograms of view (one channel after the other), deleted after writing */
+} GGEMSSinogramView; /*!< Using C convention name of struct to C++ (_t deletion) */
+
+/*!
+  \class GGEMSSinogram
+  \brief I/O class writing views in a single preallocated file. The file is memory mapped, it stores a header, an index of views (angle, table position) and a chunk per view (histogram then scatter channels). Views are copied in file by a writer thread, so the simulation is not waiting for disk
+*/
+class GGEMS_EXPORT GGEMSSinogram
+{
+  public:
+    /*!
+      \brief GGEMSSinogram constructor
+    */
+    GGEMSSinogram(void);
+
+    /*!
+      \brief GGEMSSinogram destructor
+    */
+    ~GGEMSSinogram(void);
+
+  public:
+    /*!
+      \fn GGEMSSinogram(GGEMSSinogram const& sinogram) = delete
+      \param sinogram - reference on the sinogram
+      \brief Avoid copy of the class by reference
+    */
+    GGEMSSinogram(GGEMSSinogram const& sinogram) = delete;
+
+    /*!
+      \fn GGEMSSinogram& operator=(GGEMSSinogram const& sinogram) = delete
+      \param sinogram - reference on the sinogram
+      \brief Avoid assignement of the class by reference
+    */
+    GGEMSSinogram& operator=(GGEMSSinogram const& sinogram) = delete;
+
+    /*!
+      \fn GGEMSSinogram(GGEMSSinogram const&& sinogram) = delete
+      \param sinogram - rvalue reference on the sinogram
+      \brief Avoid copy of the class by rvalue reference
+    */
+    GGEMSSinogram(GGEMSSinogram const&& sinogram) = delete;
+
+    /*!
+      \fn GGEMSSinogram& operator=(GGEMSSinogram const&& sinogram) = delete
+      \param sinogram - rvalue reference on the sinogram
+      \brief Avoid copy of the class by rvalue reference
+    */
+    GGEMSSinogram& operator=(GGEMSSinogram const&& sinogram) = delete;
+
+    /*!
+      \fn void Open(std::string const& filename, GGsize const& number_of_views, GGsize2 const& dimensions, GGfloat3 const& element_sizes, GGsize const& number_of_scatter_channels)
+      \param filename - name of sinogram file
+      \param number_of_views - number of views to preallocate
+      \param dimensions - number of detection elements in X and Y
+      \param element_sizes - size of detection elements
+      \param number_of_scatter_channels - number of scatter histograms stored for each view, 0 if no scatter
+      \brief create and preallocate the sinogram file, map it in memory and start the writer thread
+    */
+    void Open(std::string const& filename, GGsize const& number_of_views, GGsize2 const& dimensions, GGfloat3 const& element_sizes, GGsize const& number_of_scatter_channels);
+
+    /*!
+      \fn void AppendView(GGfloat const& view_angle, GGfloat const& table_position, GGint* histogram, GGint* scatter)
+      \param view_angle - angle of view in rad
+      \param table_position - table position in mm
+      \param histogram - histogram of view allocated with new[], owned by sinogram after the call
+      \param scatter - scatter histograms of view (one channel after the other) allocated with new[] (or nullptr), owned by sinogram after the call
+      \brief queue a view, the view is written asynchronously
+    */
+    void AppendView(GGfloat const& view_angle, GGfloat const& table_position, GGint* histogram, GGint* scatter);
+
+    /*!
+      \fn void Close(void)
+      \brief wait for the pending views, flush and unmap the file
+    */
+    void Close(void);
+
+    /*!
+      \fn inline bool IsOpen(void) const
+      \return true if sinogram file is open
+      \brief check if sinogram file is open
+    */
+    inline bool IsOpen(void) const {return mapped_file_ != nullptr;}
+
+    /*!
+      \fn inline GGsize GetNumberOfAppendedViews(void) const
+      \return number of views appended
+      \brief get the number of views appended (written or pending)
+    */
+    inline GGsize GetNumberOfAppendedViews(void) const {return number_of_appended_views_;}
+
+  private:
+    /*!
+      \fn void MapFile(GGsize const& file_size)
+      \param file_size - size of file in bytes
+      \brief create the file with its final size and map it in memory
+    */
+    void MapFile(GGsize const& file_size);
+
+    /*!
+      \fn bool UnmapFile(void)
+      \return false if the mapped file can not be flushed to disk
+      \brief flush and unmap the file
+    */
+    bool UnmapFile(void);
+
+    /*!
+      \fn GGsize GetPageSize(void) const
+      \return size of a memory page of the system in bytes
+      \brief get the alignment of view chunks in file, so a chunk can be flushed without touching its neighbours
+    */
+    GGsize GetPageSize(void) const;
+
+    /*!
+      \fn void WriteViews(void)
+      \brief loop of writer thread, copying pending views in mapped file
+    */
+    void WriteViews(void);
+
+  private:
+    std::string filename_; /*!< Name of sinogram file */
+    GGchar* mapped_file_; /*!< Pointer on mapped file */
+    GGsize file_size_; /*!< Size of file in bytes */
+    GGEMSSinogramHeader* header_; /*!< Pointer on header in mapped file */
+    GGEMSSinogramIndex* index_; /*!< Pointer on view index in mapped file */
+    GGsize number_of_elements_; /*!< Number of detection elements in a view */
+    GGsize number_of_appended_views_; /*!< Number of views appended */
+
+    #ifdef _MSC_VER
+    void* file_handle_; /*!< Handle of file */
+    void* mapping_handle_; /*!< Handle of file mapping */
+    #else
+    GGint file_descriptor_; /*!< File descriptor */
+    #endif
+
+    std::thread writer_thread_; /*!< Thread writing views */
+    std::mutex mutex_; /*!< Mutex protecting pending views */
+    std::condition_variable condition_; /*!< Condition waking up writer thread */
+    std::queue<GGEMSSinogramView> pending_views_; /*!< Views waiting to be written */
+    bool is_closing_; /*!< Flag stopping writer thread */
+    bool is_flush_failed_; /*!< Flag set by writer thread if a view chunk can not be flushed to disk */
+};
+
+#endif // End of GUARD_GGEMS_IO_GGEMSSINOGRAM_HH
@@ -33,6 +33,7 @@
 
 #include "GGEMS/global/GGEMSConfiguration.hh"
 #include "GGEMS/tools/GGEMSTypes.hh"
+#include "GGEMS/physics/GGEMSProcessConstants.hh"
 
 /*!
   \struct GGEMSMaterialTables_t
@@ -68,6 +69,7 @@ typedef struct GGEMSMaterialTables_t
   GGfloat photon_energy_cut_[255]; /*!< Photon energy cut */
   GGfloat electron_energy_cut_[255]; /*!< Electron energy cut */
   GGfloat positron_energy_cut_[255]; /*!< Positron energy cut */
+  GGfloat electron_csda_range_[255*CSDA_RANGE_TABLE_NUMBER_BINS]; /*!< Electron CSDA range in mm by material, log binning in energy */
 
   // Infos by chemical elements by materials
   GGsize index_of_chemical_elements_[255]; /*!< Index to chemical element by material */
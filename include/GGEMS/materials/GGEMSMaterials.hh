@@ -123,6 +123,14 @@ class GGEMS_EXPORT GGEMSMaterials
     */
     GGfloat GetEnergyCut(std::string const& material_name, std::string const& particle_type, GGfloat const& distance, std::string const& unit, GGsize const& thread_index = 0);
 
+    /*!
+      \fn GGfloat GetMinimumPhotonEnergyCut(GGsize const& thread_index = 0) const
+      \param thread_index - index of activated device (thread index)
+      \return minimum of photon energy cut over all materials
+      \brief get the minimum of photon energy cut over all materials
+    */
+    GGfloat GetMinimumPhotonEnergyCut(GGsize const& thread_index = 0) const;
+
     /*!
       \fn inline std::string GetMaterialName(GGsize i) const
       \param i - index of the material
@@ -170,20 +170,27 @@ class GGEMS_EXPORT GGEMSGeometryTransformation
     inline GGfloat33 GetLocalAxis(void) const {return local_axis_;}
 
     /*!
-      \fn Matrix::float4x4 GetTransformationMatrix(GGsize const& index) const
+      \fn inline cl::Buffer* GetTransformationMatrix(GGsize const& index) const
       \param index - index of device
-      \return the transformation matrix
+      \return the transformation matrix (GGEMSTransformationMatrix), in both directions
       \brief return the transformation matrix
     */
     inline cl::Buffer* GetTransformationMatrix(GGsize const& index) const {return matrix_transformation_[index];}
 
   private:
+    /*!
+      \fn void UploadTransformationMatrix(void)
+      \brief compute the global to local matrix and the type of transformation, then copy the transformation on each device
+    */
+    void UploadTransformationMatrix(void);
+
     GGfloat3 position_; /*!< Position of the source/detector */
     GGfloat3 rotation_; /*!< Rotation of the source/detector */
     GGfloat33 local_axis_; /*!< Matrix of local axis */
     GGfloat44 matrix_translation_; /*!< Matrix of translation */
     GGfloat44 matrix_rotation_; /*!< Matrix of rotation */
     GGfloat44 matrix_orthographic_projection_; /*!< Matrix of orthographic projection */
+    GGfloat44 matrix_local_to_global_; /*!< Composition of transformations, from local to global frame */
     cl::Buffer** matrix_transformation_; /*!< OpenCL buffer storing the matrix transformation */
     GGsize number_activated_devices_; /*!< Number of activated device */
 };
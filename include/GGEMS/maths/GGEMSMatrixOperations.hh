@@ -42,30 +42,18 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 /*!
-  \fn inline GGfloat3 GGfloat44MultGGfloat3(global GGfloat44 const* matrix, GGfloat3 const* point)
-  \param matrix - A matrix (4x4)
+  \fn inline GGfloat3 GGfloat34MultGGfloat3(global GGfloat34 const* matrix, GGfloat3 const* point)
+  \param matrix - A matrix (3x4)
   \param point - Point in 3D (x, y, z)
   \return a vector 3x1
-  \brief Compute the multiplication of matrix 4x4 and a point 3x1
+  \brief Compute the multiplication of affine matrix 3x4 and a point 3x1
 */
-inline GGfloat3 GGfloat44MultGGfloat3(global GGfloat44 const* matrix, GGfloat3 const* point)
+inline GGfloat3 GGfloat34MultGGfloat3(global GGfloat34 const* matrix, GGfloat3 const* point)
 {
-  GGfloat4 point4D;
-  point4D.x = point->x; point4D.y = point->y; point4D.z = point->z; point4D.w = 1.0f;
-
-  GGfloat4 row0;
-  row0.x = matrix->m0_[0]; row0.y = matrix->m0_[1]; row0.z = matrix->m0_[2]; row0.w = matrix->m0_[3];
-
-  GGfloat4 row1;
-  row1.x = matrix->m1_[0]; row1.y = matrix->m1_[1]; row1.z = matrix->m1_[2]; row1.w = matrix->m1_[3];
-
-  GGfloat4 row2;
-  row2.x = matrix->m2_[0]; row2.y = matrix->m2_[1]; row2.z = matrix->m2_[2]; row2.w = matrix->m2_[3];
-
   GGfloat3 vector = {
-    dot(row0, point4D),
-    dot(row1, point4D),
-    dot(row2, point4D)
+    matrix->m0_[0]*point->x + matrix->m0_[1]*point->y + matrix->m0_[2]*point->z + matrix->m0_[3],
+    matrix->m1_[0]*point->x + matrix->m1_[1]*point->y + matrix->m1_[2]*point->z + matrix->m1_[3],
+    matrix->m2_[0]*point->x + matrix->m2_[1]*point->y + matrix->m2_[2]*point->z + matrix->m2_[3]
   };
 
   return vector;
@@ -76,64 +64,18 @@ inline GGfloat3 GGfloat44MultGGfloat3(global GGfloat44 const* matrix, GGfloat3 c
 ////////////////////////////////////////////////////////////////////////////////
 
 /*!
-  \fn inline GGfloat3 GGfloat33MultGGfloat3(global GGfloat44 const* matrix, GGfloat3 const* point)
-  \param matrix - A matrix (3x3)
+  \fn inline GGfloat3 GGfloat33MultGGfloat3(global GGfloat34 const* matrix, GGfloat3 const* point)
+  \param matrix - A matrix (3x4), only the 3x3 part is used
   \param point - Point in 3D (x, y, z)
   \return a vector 3x1
   \brief Compute the multiplication of matrix 3x3 and a point 3x1
 */
-inline GGfloat3 GGfloat33MultGGfloat3(global GGfloat44 const* matrix, GGfloat3 const* point)
-{
-  GGfloat3 point3D;
-  point3D.x = point->x; point3D.y = point->y; point3D.z = point->z;
-
-  GGfloat3 row0;
-  row0.x = matrix->m0_[0]; row0.y = matrix->m0_[1]; row0.z = matrix->m0_[2];
-
-  GGfloat3 row1;
-  row1.x = matrix->m1_[0]; row1.y = matrix->m1_[1]; row1.z = matrix->m1_[2];
-
-  GGfloat3 row2;
-  row2.x = matrix->m2_[0]; row2.y = matrix->m2_[1]; row2.z = matrix->m2_[2];
-
-  GGfloat3 vector = {
-    dot(row0, point3D),
-    dot(row1, point3D),
-    dot(row2, point3D)
-  };
-
-  return vector;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////////////////////////
-
-/*!
-  \fn inline GGfloat3 GGfloat33TransposeMultGGfloat3(global GGfloat44 const* matrix, GGfloat3 const* point)
-  \param matrix - A matrix (3x3)
-  \param point - Point in 3D (x, y, z)
-  \return a vector 3x1
-  \brief Compute the multiplication of matrix 3x3 transpose and a point 3x1
-*/
-inline GGfloat3 GGfloat33TransposeMultGGfloat3(global GGfloat44 const* matrix, GGfloat3 const* point)
+inline GGfloat3 GGfloat33MultGGfloat3(global GGfloat34 const* matrix, GGfloat3 const* point)
 {
-  GGfloat3 point3D;
-  point3D.x = point->x; point3D.y = point->y; point3D.z = point->z;
-
-  GGfloat3 row0;
-  row0.x = matrix->m0_[0]; row0.y = matrix->m1_[0]; row0.z = matrix->m2_[0];
-
-  GGfloat3 row1;
-  row1.x = matrix->m0_[1]; row1.y = matrix->m1_[1]; row1.z = matrix->m2_[1];
-
-  GGfloat3 row2;
-  row2.x = matrix->m0_[2]; row2.y = matrix->m1_[2]; row2.z = matrix->m2_[2];
-
   GGfloat3 vector = {
-    dot(row0, point3D),
-    dot(row1, point3D),
-    dot(row2, point3D)
+    matrix->m0_[0]*point->x + matrix->m0_[1]*point->y + matrix->m0_[2]*point->z,
+    matrix->m1_[0]*point->x + matrix->m1_[1]*point->y + matrix->m1_[2]*point->z,
+    matrix->m2_[0]*point->x + matrix->m2_[1]*point->y + matrix->m2_[2]*point->z
   };
 
   return vector;
@@ -183,4 +125,40 @@ inline GGfloat44 GGfloat44MultGGfloat44(GGfloat44 const* mat1, GGfloat44 const*
   return tmp;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+  \fn inline void ComputeGlobalToLocalMatrix(GGEMSTransformationMatrix* matrix)
+  \param matrix - transformation, local to global matrix is already filled
+  \brief Compute the global to local matrix (transpose of rotation, rotation is orthogonal) and the type of transformation
+*/
+inline void ComputeGlobalToLocalMatrix(GGEMSTransformationMatrix* matrix)
+{
+  GGfloat34 const* l2g = &matrix->local_to_global_;
+  GGfloat34* g2l = &matrix->global_to_local_;
+
+  // Transpose of rotation
+  g2l->m0_[0] = l2g->m0_[0]; g2l->m0_[1] = l2g->m1_[0]; g2l->m0_[2] = l2g->m2_[0];
+  g2l->m1_[0] = l2g->m0_[1]; g2l->m1_[1] = l2g->m1_[1]; g2l->m1_[2] = l2g->m2_[1];
+  g2l->m2_[0] = l2g->m0_[2]; g2l->m2_[1] = l2g->m1_[2]; g2l->m2_[2] = l2g->m2_[2];
+
+  // Inverse translation, -R^T.t
+  g2l->m0_[3] = -(g2l->m0_[0]*l2g->m0_[3] + g2l->m0_[1]*l2g->m1_[3] + g2l->m0_[2]*l2g->m2_[3]);
+  g2l->m1_[3] = -(g2l->m1_[0]*l2g->m0_[3] + g2l->m1_[1]*l2g->m1_[3] + g2l->m1_[2]*l2g->m2_[3]);
+  g2l->m2_[3] = -(g2l->m2_[0]*l2g->m0_[3] + g2l->m2_[1]*l2g->m1_[3] + g2l->m2_[2]*l2g->m2_[3]);
+
+  // Type of transformation
+  bool is_rotation =
+    l2g->m0_[0] != 1.0f || l2g->m0_[1] != 0.0f || l2g->m0_[2] != 0.0f ||
+    l2g->m1_[0] != 0.0f || l2g->m1_[1] != 1.0f || l2g->m1_[2] != 0.0f ||
+    l2g->m2_[0] != 0.0f || l2g->m2_[1] != 0.0f || l2g->m2_[2] != 1.0f;
+  bool is_translation = l2g->m0_[3] != 0.0f || l2g->m1_[3] != 0.0f || l2g->m2_[3] != 0.0f;
+
+  if (is_rotation) matrix->type_ = RIGID_TRANSFORMATION;
+  else if (is_translation) matrix->type_ = TRANSLATION_TRANSFORMATION;
+  else matrix->type_ = IDENTITY_TRANSFORMATION;
+}
+
 #endif // End of GUARD_GGEMS_MATHS_MATRIX_FUNCTIONS_HH
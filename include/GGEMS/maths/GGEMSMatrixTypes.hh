@@ -33,6 +33,11 @@
 
 #include "GGEMS/global/GGEMSConfiguration.hh"
 #include "GGEMS/tools/GGEMSTypes.hh"
+#include "GGEMS/tools/GGEMSSystemOfUnits.hh"
+
+__constant GGint IDENTITY_TRANSFORMATION = 0; /*!< No rotation and no translation */
+__constant GGint TRANSLATION_TRANSFORMATION = 1; /*!< Translation only */
+__constant GGint RIGID_TRANSFORMATION = 2; /*!< Rotation (or axis transformation) and translation */
 
 /*!
   \struct GGfloat33_t
@@ -57,4 +62,26 @@ typedef struct GGfloat44_t
   GGfloat m3_[4]; /*!< Row 3 of matrix */
 } GGfloat44; /*!< Using C convention name of struct to C++ (_t deletion) */
 
+/*!
+  \struct GGfloat34_t
+  \brief Structure storing float 3 x 4 matrix, last row (0, 0, 0, 1) of an affine matrix is implicit
+*/
+typedef struct GGfloat34_t
+{
+  GGfloat m0_[4]; /*!< Row 0 of matrix */
+  GGfloat m1_[4]; /*!< Row 1 of matrix */
+  GGfloat m2_[4]; /*!< Row 2 of matrix */
+} GGfloat34; /*!< Using C convention name of struct to C++ (_t deletion) */
+
+/*!
+  \struct GGEMSTransformationMatrix_t
+  \brief Structure storing a transformation in both directions, inverse is precomputed on host
+*/
+typedef struct GGEMSTransformationMatrix_t
+{
+  GGfloat34 local_to_global_; /*!< Matrix from local to global frame */
+  GGfloat34 global_to_local_; /*!< Matrix from global to local frame */
+  GGint type_; /*!< Type of transformation, identity and translation are computed without matrix product */
+} GGEMSTransformationMatrix; /*!< Using C convention name of struct to C++ (_t deletion) */
+
 #endif // End of GUARD_GGEMS_MATHS_GGEMSMATRIXTYPES_HH
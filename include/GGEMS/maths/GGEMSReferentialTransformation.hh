@@ -74,22 +74,26 @@ inline GGfloat3 RotateUnitZ(GGfloat3* vector, GGfloat3 const* new_uz)
 ////////////////////////////////////////////////////////////////////////////////
 
 /*!
- \fn inline GGfloat3 GlobalToLocalPosition(global GGfloat44 const* matrix, GGfloat3 const* point)
- \param matrix - A matrix (4x4)
+ \fn inline GGfloat3 GlobalToLocalPosition(global GGEMSTransformationMatrix const* matrix, GGfloat3 const* point)
+ \param matrix - Transformation with precomputed inverse
  \param point - Point in 3D (x, y, z)
  \return The point expresses in the local frame
- \brief Transform a 3D point from local to global frame
+ \brief Transform a 3D point from global to local frame
 */
-inline GGfloat3 GlobalToLocalPosition(global GGfloat44 const* matrix, GGfloat3 const* point)
+inline GGfloat3 GlobalToLocalPosition(global GGEMSTransformationMatrix const* matrix, GGfloat3 const* point)
 {
-  // Current point minus translation
-  GGfloat3 new_point = {
-    point->x - matrix->m0_[3],
-    point->y - matrix->m1_[3],
-    point->z - matrix->m2_[3]
-  };
-
-  return GGfloat33TransposeMultGGfloat3(matrix, &new_point);
+  if (matrix->type_ == IDENTITY_TRANSFORMATION) return *point;
+
+  if (matrix->type_ == TRANSLATION_TRANSFORMATION) {
+    GGfloat3 new_point = {
+      point->x + matrix->global_to_local_.m0_[3],
+      point->y + matrix->global_to_local_.m1_[3],
+      point->z + matrix->global_to_local_.m2_[3]
+    };
+    return new_point;
+  }
+
+  return GGfloat34MultGGfloat3(&matrix->global_to_local_, point);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -97,15 +101,26 @@ inline GGfloat3 GlobalToLocalPosition(global GGfloat44 const* matrix, GGfloat3 c
 ////////////////////////////////////////////////////////////////////////////////
 
 /*!
- \fn inline GGfloat3 LocalToGlobalPosition(global GGfloat44* matrix, GGfloat3 const* point)
- \param matrix - A matrix (4x4)
+ \fn inline GGfloat3 LocalToGlobalPosition(global GGEMSTransformationMatrix const* matrix, GGfloat3 const* point)
+ \param matrix - Transformation with precomputed inverse
  \param point - Point in 3D (x, y, z)
  \return The point expresses in the global frame
  \brief Transform a 3D point from local to global frame
 */
-inline GGfloat3 LocalToGlobalPosition(global GGfloat44 const* matrix, GGfloat3 const* point)
+inline GGfloat3 LocalToGlobalPosition(global GGEMSTransformationMatrix const* matrix, GGfloat3 const* point)
 {
-  return GGfloat44MultGGfloat3(matrix, point);
+  if (matrix->type_ == IDENTITY_TRANSFORMATION) return *point;
+
+  if (matrix->type_ == TRANSLATION_TRANSFORMATION) {
+    GGfloat3 new_point = {
+      point->x + matrix->local_to_global_.m0_[3],
+      point->y + matrix->local_to_global_.m1_[3],
+      point->z + matrix->local_to_global_.m2_[3]
+    };
+    return new_point;
+  }
+
+  return GGfloat34MultGGfloat3(&matrix->local_to_global_, point);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -113,15 +128,17 @@ inline GGfloat3 LocalToGlobalPosition(global GGfloat44 const* matrix, GGfloat3 c
 ////////////////////////////////////////////////////////////////////////////////
 
 /*!
- \fn inline GGfloat3 GlobalToLocalDirection(global GGfloat44 const* matrix, GGfloat3 const* point)
- \param matrix - A matrix (4x4)
- \param point - Point in 3D (x, y, z)
- \return The direction expresses in the global frame
- \brief Transform a 3D direction from global to local frame
+ \fn inline GGfloat3 GlobalToLocalDirection(global GGEMSTransformationMatrix const* matrix, GGfloat3 const* point)
+ \param matrix - Transformation with precomputed inverse
+ \param point - Direction in 3D (x, y, z)
+ \return The direction expresses in the local frame
+ \brief Transform a 3D direction from global to local frame, direction is unchanged by a translation
 */
-inline GGfloat3 GlobalToLocalDirection(global GGfloat44 const* matrix, GGfloat3 const* point)
+inline GGfloat3 GlobalToLocalDirection(global GGEMSTransformationMatrix const* matrix, GGfloat3 const* point)
 {
-  return normalize(GGfloat33TransposeMultGGfloat3(matrix, point));
+  if (matrix->type_ != RIGID_TRANSFORMATION) return *point;
+
+  return normalize(GGfloat33MultGGfloat3(&matrix->global_to_local_, point));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -129,15 +146,17 @@ inline GGfloat3 GlobalToLocalDirection(global GGfloat44 const* matrix, GGfloat3
 ////////////////////////////////////////////////////////////////////////////////
 
 /*!
- \fn inline GGfloat3 LocalToGlobalDirection(global GGfloat44 const* matrix, GGfloat3 const* point)
- \param matrix - A matrix (4x4)
- \param point - Point in 3D (x, y, z)
- \return The direction expresses in the local frame
- \brief Transform a 3D direction from local to global frame
+ \fn inline GGfloat3 LocalToGlobalDirection(global GGEMSTransformationMatrix const* matrix, GGfloat3 const* point)
+ \param matrix - Transformation with precomputed inverse
+ \param point - Direction in 3D (x, y, z)
+ \return The direction expresses in the global frame
+ \brief Transform a 3D direction from local to global frame, direction is unchanged by a translation
 */
-inline GGfloat3 LocalToGlobalDirection(global GGfloat44 const* matrix, GGfloat3 const* point)
+inline GGfloat3 LocalToGlobalDirection(global GGEMSTransformationMatrix const* matrix, GGfloat3 const* point)
 {
-  return normalize(GGfloat33MultGGfloat3(matrix, point));
+  if (matrix->type_ != RIGID_TRANSFORMATION) return *point;
+
+  return normalize(GGfloat33MultGGfloat3(&matrix->local_to_global_, point));
 }
 
 #endif
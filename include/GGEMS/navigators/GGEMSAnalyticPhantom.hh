@@ -0,0 +1,199 @@
+#ifndef GUARD_GGEMS_NAVIGATORS_GGEMSANALYTICPHANTOM_HH
+#define GUARD_GGEMS_NAVIGATORS_GGEMSANALYTICPHANTOM_HH
+
+// ************************************************************************
+// * This file is part of GGEMS.                                          *
+// *                                                                      *
+// * GGEMS is free software: you can redistribute it and/or modify        *
+// * it under the terms of the GNU General Public License as published by *
+// * the Free Software Foundation, either version 3 of the License, or    *
+// * (at your option) any later version.                                  *
+// *                                                                      *
+// * GGEMS is distributed in the hope that it will be useful,             *
+// * but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+// * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+// * GNU General Public License for more details.                         *
+// *                                                                      *
+// * You should have received a copy of the GNU General Public License    *
+// * along with GGEMS.  If not, see <https://www.gnu.org/licenses/>.      *
+// *                                                                      *
+// ************************************************************************
+
+/*!
+  \file GGEMSAnalyticPhantom.hh
+
+  \brief Child GGEMS class handling analytic phantom, a sphere, a cylinder or an ellipsoid filled with one material
+
+  \author Julien BERT <julien.bert@univ-brest.fr>
+  \author Didier BENOIT <didier.benoit@inserm.fr>
+  \author LaTIM, INSERM - U1101, Brest, FRANCE
+  \date Sunday October 18, 2026
+*/
+
+#include "GGEMS/navigators/GGEMSNavigator.hh"
+
+/*!
+  \class GGEMSAnalyticPhantom
+  \brief Child GGEMS class handling analytic phantom, intersections with the primitive are computed exactly without voxelization
+*/
+class GGEMS_EXPORT GGEMSAnalyticPhantom : public GGEMSNavigator
+{
+  public:
+    /*!
+      \param analytic_phantom_name - name of the analytic phantom
+      \brief GGEMSAnalyticPhantom constructor
+    */
+    explicit GGEMSAnalyticPhantom(std::string const& analytic_phantom_name);
+
+    /*!
+      \brief GGEMSAnalyticPhantom destructor
+    */
+    ~GGEMSAnalyticPhantom(void) override;
+
+    /*!
+      \fn GGEMSAnalyticPhantom(GGEMSAnalyticPhantom const& analytic_phantom) = delete
+      \param analytic_phantom - reference on the GGEMS analytic phantom
+      \brief Avoid copy by reference
+    */
+    GGEMSAnalyticPhantom(GGEMSAnalyticPhantom const& analytic_phantom) = delete;
+
+    /*!
+      \fn GGEMSAnalyticPhantom& operator=(GGEMSAnalyticPhantom const& analytic_phantom) = delete
+      \param analytic_phantom - reference on the GGEMS analytic phantom
+      \brief Avoid assignement by reference
+    */
+    GGEMSAnalyticPhantom& operator=(GGEMSAnalyticPhantom const& analytic_phantom) = delete;
+
+    /*!
+      \fn GGEMSAnalyticPhantom(GGEMSAnalyticPhantom const&& analytic_phantom) = delete
+      \param analytic_phantom - rvalue reference on the GGEMS analytic phantom
+      \brief Avoid copy by rvalue reference
+    */
+    GGEMSAnalyticPhantom(GGEMSAnalyticPhantom const&& analytic_phantom) = delete;
+
+    /*!
+      \fn GGEMSAnalyticPhantom& operator=(GGEMSAnalyticPhantom const&& analytic_phantom) = delete
+      \param analytic_phantom - rvalue reference on the GGEMS analytic phantom
+      \brief Avoid copy by rvalue reference
+    */
+    GGEMSAnalyticPhantom& operator=(GGEMSAnalyticPhantom const&& analytic_phantom) = delete;
+
+    /*!
+      \fn void SetSphere(GGfloat const& radius, std::string const& material_name, std::string const& unit = "mm")
+      \param radius - radius of sphere
+      \param material_name - material filling the sphere
+      \param unit - unit of the distance
+      \brief set a sphere centered on phantom position
+    */
+    void SetSphere(GGfloat const& radius, std::string const& material_name, std::string const& unit = "mm");
+
+    /*!
+      \fn void SetCylinder(GGfloat const& radius, GGfloat const& height, std::string const& material_name, std::string const& unit = "mm")
+      \param radius - radius of cylinder
+      \param height - height of cylinder along local Z axis
+      \param material_name - material filling the cylinder
+      \param unit - unit of the distance
+      \brief set a cylinder centered on phantom position
+    */
+    void SetCylinder(GGfloat const& radius, GGfloat const& height, std::string const& material_name, std::string const& unit = "mm");
+
+    /*!
+      \fn void SetEllipsoid(GGfloat const& radius_x, GGfloat const& radius_y, GGfloat const& radius_z, std::string const& material_name, std::string const& unit = "mm")
+      \param radius_x - semi-axis of ellipsoid in X
+      \param radius_y - semi-axis of ellipsoid in Y
+      \param radius_z - semi-axis of ellipsoid in Z
+      \param material_name - material filling the ellipsoid
+      \param unit - unit of the distance
+      \brief set an ellipsoid centered on phantom position
+    */
+    void SetEllipsoid(GGfloat const& radius_x, GGfloat const& radius_y, GGfloat const& radius_z, std::string const& material_name, std::string const& unit = "mm");
+
+    /*!
+      \fn void Initialize(void) override
+      \brief Initialize the analytic phantom
+    */
+    void Initialize(void) override;
+
+    /*!
+      \fn void SaveResults
+      \brief save all results from solid, no result for analytic phantom
+    */
+    void SaveResults(void) override {}
+
+  private:
+    /*!
+      \fn void CheckParameters(void) const override
+      \brief checking parameters
+    */
+    void CheckParameters(void) const override;
+
+  private:
+    GGint primitive_type_; /*!< Type of primitive, ELLIPSOID_PRIMITIVE or CYLINDER_PRIMITIVE */
+    GGfloat3 half_size_xyz_; /*!< Semi-axes of ellipsoid, or radii and half height of cylinder */
+    std::string material_name_; /*!< Material filling the primitive */
+};
+
+/*!
+  \fn GGEMSAnalyticPhantom* create_ggems_analytic_phantom(char const* analytic_phantom_name)
+  \param analytic_phantom_name - name of analytic phantom
+  \return the pointer on the analytic phantom
+  \brief Get the GGEMSAnalyticPhantom pointer for python user.
+*/
+extern "C" GGEMS_EXPORT GGEMSAnalyticPhantom* create_ggems_analytic_phantom(char const* analytic_phantom_name);
+
+/*!
+  \fn void set_sphere_ggems_analytic_phantom(GGEMSAnalyticPhantom* analytic_phantom, GGfloat const radius, char const* material_name, char const* unit)
+  \param analytic_phantom - pointer on analytic phantom
+  \param radius - radius of sphere
+  \param material_name - material filling the sphere
+  \param unit - unit of the distance
+  \brief set a sphere in analytic phantom
+*/
+extern "C" GGEMS_EXPORT void set_sphere_ggems_analytic_phantom(GGEMSAnalyticPhantom* analytic_phantom, GGfloat const radius, char const* material_name, char const* unit);
+
+/*!
+  \fn void set_cylinder_ggems_analytic_phantom(GGEMSAnalyticPhantom* analytic_phantom, GGfloat const radius, GGfloat const height, char const* material_name, char const* unit)
+  \param analytic_phantom - pointer on analytic phantom
+  \param radius - radius of cylinder
+  \param height - height of cylinder
+  \param material_name - material filling the cylinder
+  \param unit - unit of the distance
+  \brief set a cylinder in analytic phantom
+*/
+extern "C" GGEMS_EXPORT void set_cylinder_ggems_analytic_phantom(GGEMSAnalyticPhantom* analytic_phantom, GGfloat const radius, GGfloat const height, char const* material_name, char const* unit);
+
+/*!
+  \fn void set_ellipsoid_ggems_analytic_phantom(GGEMSAnalyticPhantom* analytic_phantom, GGfloat const radius_x, GGfloat const radius_y, GGfloat const radius_z, char const* material_name, char const* unit)
+  \param analytic_phantom - pointer on analytic phantom
+  \param radius_x - semi-axis of ellipsoid in X
+  \param radius_y - semi-axis of ellipsoid in Y
+  \param radius_z - semi-axis of ellipsoid in Z
+  \param material_name - material filling the ellipsoid
+  \param unit - unit of the distance
+  \brief set an ellipsoid in analytic phantom
+*/
+extern "C" GGEMS_EXPORT void set_ellipsoid_ggems_analytic_phantom(GGEMSAnalyticPhantom* analytic_phantom, GGfloat const radius_x, GGfloat const radius_y, GGfloat const radius_z, char const* material_name, char const* unit);
+
+/*!
+  \fn void set_position_ggems_analytic_phantom(GGEMSAnalyticPhantom* analytic_phantom, GGfloat const position_x, GGfloat const position_y, GGfloat const position_z, char const* unit)
+  \param analytic_phantom - pointer on analytic phantom
+  \param position_x - offset in X
+  \param position_y - offset in Y
+  \param position_z - offset in Z
+  \param unit - unit of the distance
+  \brief set the position of the analytic phantom in X, Y and Z
+*/
+extern "C" GGEMS_EXPORT void set_position_ggems_analytic_phantom(GGEMSAnalyticPhantom* analytic_phantom, GGfloat const position_x, GGfloat const position_y, GGfloat const position_z, char const* unit);
+
+/*!
+  \fn void set_rotation_ggems_analytic_phantom(GGEMSAnalyticPhantom* analytic_phantom, GGfloat const rx, GGfloat const ry, GGfloat const rz, char const* unit)
+  \param analytic_phantom - pointer on analytic phantom
+  \param rx - Rotation around X along local axis
+  \param ry - Rotation around Y along local axis
+  \param rz - Rotation around Z along local axis
+  \param unit - unit of the angle
+  \brief Set the rotation of the analytic phantom around local axis
+*/
+extern "C" GGEMS_EXPORT void set_rotation_ggems_analytic_phantom(GGEMSAnalyticPhantom* analytic_phantom, GGfloat const rx, GGfloat const ry, GGfloat const rz, char const* unit);
+
+#endif // End of GUARD_GGEMS_NAVIGATORS_GGEMSANALYTICPHANTOM_HH
@@ -30,7 +30,11 @@
   \date Monday October 19, 2020
 */
 
+#include <vector>
+
 #include "GGEMS/navigators/GGEMSSystem.hh"
+#include "GGEMS/geometries/GGEMSAntiScatterGrid.hh"
+#include "GGEMS/geometries/GGEMSModuleLayers.hh"
 
 /*!
   \class GGEMSCTSystem
@@ -107,6 +111,35 @@ class GGEMS_EXPORT GGEMSCTSystem : public GGEMSSystem
     */
     void SetSourceDetectorDistance(GGfloat const& source_detector_distance, std::string const& unit = "mm");
 
+    /*!
+      \fn void SetAntiScatterGrid(GGfloat const& lamella_pitch, GGfloat const& lamella_thickness, GGfloat const& lamella_height, GGfloat const& focus_distance, std::string const& unit)
+      \param lamella_pitch - distance between center of two lamellae
+      \param lamella_thickness - thickness of a lamella
+      \param lamella_height - height of lamellae
+      \param focus_distance - distance between focus and entrance face of detector, 0 for a grid focused on the source
+      \param unit - distance unit
+      \brief set an analytic linear anti-scatter grid on the entrance face of detector, lamellae are parallel to rows of detector
+    */
+    void SetAntiScatterGrid(GGfloat const& lamella_pitch, GGfloat const& lamella_thickness, GGfloat const& lamella_height, GGfloat const& focus_distance, std::string const& unit = "mm");
+
+    /*!
+      \fn void SetAntiScatterGridMaterial(std::string const& lamella_material, std::string const& interspace_material)
+      \param lamella_material - material of lamellae
+      \param interspace_material - material between lamellae
+      \brief set the materials of anti-scatter grid
+    */
+    void SetAntiScatterGridMaterial(std::string const& lamella_material, std::string const& interspace_material = "Air");
+
+    /*!
+      \fn void AddModuleLayer(std::string const& material_name, GGfloat const& thickness, std::string const& unit = "mm", bool const& is_sensitive = false)
+      \param material_name - material of layer
+      \param thickness - thickness of layer along module normal
+      \param unit - distance unit
+      \param is_sensitive - true if interactions are counted in this layer
+      \brief add a layer to the stack of each module (scintillator, reflector, substrate...), first layer is on the entrance face, all layers are tracked in the same navigator
+    */
+    void AddModuleLayer(std::string const& material_name, GGfloat const& thickness, std::string const& unit = "mm", bool const& is_sensitive = false);
+
   private:
     /*!
       \fn void CheckParameters(void) const override
@@ -126,10 +159,44 @@ class GGEMS_EXPORT GGEMSCTSystem : public GGEMSSystem
     */
     void InitializeFlatGeometry(void);
 
+    /*!
+      \fn void InitializeAntiScatterGrid(void)
+      \brief Register anti-scatter grid materials and enable grid in each solid
+    */
+    void InitializeAntiScatterGrid(void);
+
+    /*!
+      \fn void InitializeModuleLayers(void)
+      \brief Register layer materials and enable layers in each solid
+    */
+    void InitializeModuleLayers(void);
+
+    /*!
+      \fn GGint RegisterMaterial(std::string const& material_name)
+      \param material_name - name of material
+      \return index of material in navigator
+      \brief Add a material to navigator if not already registered, the detector material stays the first one
+    */
+    GGint RegisterMaterial(std::string const& material_name);
+
+    /*!
+      \fn GGfloat GetModuleThickness(void) const
+      \return thickness of a module
+      \brief Get thickness of module, sum of layers if module is layered
+    */
+    GGfloat GetModuleThickness(void) const;
+
   private:
     std::string ct_system_type_; /*!< Type of CT scanner, here: flat or curved */
     GGfloat source_isocenter_distance_; /*!< Distance from source to isocenter (SID) */
     GGfloat source_detector_distance_; /*!< Distance from source to detector (SDD) */
+    bool is_anti_scatter_grid_; /*!< Boolean activating anti-scatter grid */
+    GGEMSAntiScatterGrid anti_scatter_grid_; /*!< Parameters of anti-scatter grid */
+    std::string lamella_material_; /*!< Material of anti-scatter grid lamellae */
+    std::string interspace_material_; /*!< Material between anti-scatter grid lamellae */
+    std::vector<std::string> layer_materials_; /*!< Material of each layer of module */
+    std::vector<GGfloat> layer_thicknesses_; /*!< Thickness of each layer of module */
+    GGint sensitive_layer_; /*!< Index of sensitive layer of module, -1 if not set */
 };
 
 /*!
@@ -204,6 +271,38 @@ extern "C" GGEMS_EXPORT void set_source_isocenter_distance_ggems_ct_system(GGEMS
 */
 extern "C" GGEMS_EXPORT void set_source_detector_distance_ggems_ct_system(GGEMSCTSystem* ct_system, GGfloat const source_detector_distance, char const* unit);
 
+/*!
+  \fn void set_anti_scatter_grid_ggems_ct_system(GGEMSCTSystem* ct_system, GGfloat const lamella_pitch, GGfloat const lamella_thickness, GGfloat const lamella_height, GGfloat const focus_distance, char const* unit)
+  \param ct_system - pointer on ct system
+  \param lamella_pitch - distance between center of two lamellae
+  \param lamella_thickness - thickness of a lamella
+  \param lamella_height - height of lamellae
+  \param focus_distance - distance between focus and entrance face of detector
+  \param unit - unit of the distance
+  \brief set an analytic anti-scatter grid on the entrance face of detector
+*/
+extern "C" GGEMS_EXPORT void set_anti_scatter_grid_ggems_ct_system(GGEMSCTSystem* ct_system, GGfloat const lamella_pitch, GGfloat const lamella_thickness, GGfloat const lamella_height, GGfloat const focus_distance, char const* unit);
+
+/*!
+  \fn void set_anti_scatter_grid_material_ggems_ct_system(GGEMSCTSystem* ct_system, char const* lamella_material, char const* interspace_material)
+  \param ct_system - pointer on ct system
+  \param lamella_material - material of lamellae
+  \param interspace_material - material between lamellae
+  \brief set the materials of anti-scatter grid
+*/
+extern "C" GGEMS_EXPORT void set_anti_scatter_grid_material_ggems_ct_system(GGEMSCTSystem* ct_system, char const* lamella_material, char const* interspace_material);
+
+/*!
+  \fn void add_module_layer_ggems_ct_system(GGEMSCTSystem* ct_system, char const* material_name, GGfloat const thickness, char const* unit, bool const is_sensitive)
+  \param ct_system - pointer on ct system
+  \param material_name - material of layer
+  \param thickness - thickness of layer
+  \param unit - unit of the distance
+  \param is_sensitive - true if interactions are counted in this layer
+  \brief add a layer to the stack of each module
+*/
+extern "C" GGEMS_EXPORT void add_module_layer_ggems_ct_system(GGEMSCTSystem* ct_system, char const* material_name, GGfloat const thickness, char const* unit, bool const is_sensitive);
+
 /*!
   \fn void set_rotation_ggems_ct_system(GGEMSCTSystem* ct_system, GGfloat const rx, GGfloat const ry, GGfloat const rz, char const* unit)
   \param ct_system - pointer on ct system
@@ -232,6 +331,25 @@ extern "C" GGEMS_EXPORT void set_threshold_ggems_ct_system(GGEMSCTSystem* ct_sys
 */
 extern "C" GGEMS_EXPORT void set_save_ggems_ct_system(GGEMSCTSystem* ct_system, char const* basename);
 
+/*!
+  \fn void set_sinogram_ggems_ct_system(GGEMSCTSystem* ct_system, GGsize const number_of_views)
+  \param ct_system - pointer on ct system
+  \param number_of_views - number of views in acquisition
+  \brief store all the views in a single sinogram file
+*/
+extern "C" GGEMS_EXPORT void set_sinogram_ggems_ct_system(GGEMSCTSystem* ct_system, GGsize const number_of_views);
+
+/*!
+  \fn void set_view_ggems_ct_system(GGEMSCTSystem* ct_system, GGfloat const view_angle, GGfloat const table_position, char const* angle_unit, char const* distance_unit)
+  \param ct_system - pointer on ct system
+  \param view_angle - angle of gantry for the next view
+  \param table_position - table position for the next view
+  \param angle_unit - unit of the angle
+  \param distance_unit - unit of the distance
+  \brief set the parameters of the next view stored in sinogram
+*/
+extern "C" GGEMS_EXPORT void set_view_ggems_ct_system(GGEMSCTSystem* ct_system, GGfloat const view_angle, GGfloat const table_position, char const* angle_unit, char const* distance_unit);
+
 /*!
   \fn void store_scatter_ggems_ct_system(GGEMSCTSystem* ct_system, bool const is_scatter)
   \param ct_system - pointer on ct system
@@ -33,6 +33,8 @@
 
 #include "GGEMS/tools/GGEMSTypes.hh"
 
+#define MAXIMUM_DOSE_LEVELS 3 /*!< Maximum number of levels in dose pyramid (1x, 2x and 4x dosel size) */
+
 /*!
   \struct GGEMSDoseParams_t
   \brief Structure storing dosimetry infos
@@ -46,6 +48,11 @@ typedef struct GGEMSDoseParams_t
   GGint3 number_of_dosels_; /*!< Number of dosels per dimension */
   GGint total_number_of_dosels_; /*!< Total number of dosels */
   GGint slice_number_of_dosels_; /*!< Number of dosels per slice */
+  GGint number_of_levels_; /*!< Number of levels in dose pyramid, dosel size is doubled at each level */
+  GGint3 level_number_of_dosels_[MAXIMUM_DOSE_LEVELS]; /*!< Number of dosels per dimension for each level */
+  GGint level_offset_[MAXIMUM_DOSE_LEVELS+1]; /*!< Offset of each level in dose buffers, last offset is the number of dosels in pyramid */
+  GGint number_of_grids_; /*!< Number of dose grids scored in the same transport, only read in the first dose grid */
+  GGint dosel_offset_; /*!< Offset of dose grid in energy buffers shared by all dose grids */
 } GGEMSDoseParams; /*!< Using C convention name of struct to C++ (_t deletion) */
 
 #endif // End of GUARD_GGEMS_NAVIGATORS_GGEMSDOSEPARAMS_HH
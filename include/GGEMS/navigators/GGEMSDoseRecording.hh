@@ -42,11 +42,17 @@
 typedef struct GGEMSDoseRecording_t
 {
   cl::Buffer** edep_; /*!< Buffer storing energy deposit on OpenCL device */
-  cl::Buffer** edep_squared_; /*!< Buffer storing energy deposit squared on OpenCL device */
+  cl::Buffer** edep_squared_; /*!< Buffer storing energy deposit squared on OpenCL device, history by history */
+  cl::Buffer** edep_history_; /*!< Buffer storing energy deposit of the last history in dosel, not yet squared */
+  cl::Buffer** last_history_id_; /*!< Buffer storing id of the last history depositing energy in dosel */
   cl::Buffer** hit_; /*!< Buffer storing hit on OpenCL device */
   cl::Buffer** photon_tracking_; /*!< Buffer storing photon tracking on OpenCL device */
   cl::Buffer** dose_; /*!< Buffer storing dose in gray (Gy) */
   cl::Buffer** uncertainty_dose_; /*!< Buffer storing uncertainty dose */
+  cl::Buffer** adaptive_dose_; /*!< Buffer storing dose from the finest level of pyramid reaching the target uncertainty */
+  cl::Buffer** dose_level_; /*!< Buffer storing level of pyramid selected for each dosel */
+  cl::Buffer** label_edep_; /*!< Buffer storing energy deposit for each label of phantom */
+  cl::Buffer** label_mass_; /*!< Buffer storing mass for each label of phantom */
 } GGEMSDoseRecording; /*!< Using C convention name of struct to C++ (_t deletion) */
 
 #endif
@@ -55,6 +61,7 @@ typedef struct GGEMSDoseRecording_t
 
 #include "GGEMS/navigators/GGEMSDoseParams.hh"
 #include "GGEMS/geometries/GGEMSGeometryConstants.hh"
+#include "GGEMS/materials/GGEMSMaterialTables.hh"
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
@@ -84,12 +91,94 @@ inline void dose_photon_tracking(global GGEMSDoseParams* dose_params, global GGi
 ////////////////////////////////////////////////////////////////////////////////
 
 /*!
-  \fn void dose_record_standard(global GGEMSDoseParams* dose_params, global GGDosiType* edep_tracking, global GGDosiType* edep_squared_tracking, global GGint* hit_tracking, GGfloat edep, GGfloat3 const* position)
+  \fn void dose_record_dosel(global GGDosiType* edep_tracking, global GGDosiType* edep_squared_tracking, global GGDosiType* edep_history_tracking, global GGulong* last_history_id, GGulong const history_id, global GGint* hit_tracking, GGfloat edep, GGint const global_dosel_id)
+  \param edep_tracking - energy deposit in dosels
+  \param edep_squared_tracking - sum of squared energy deposit of each history in dosels
+  \param edep_history_tracking - energy deposit of the last history in dosels
+  \param last_history_id - id of the last history depositing energy in dosels
+  \param history_id - id of the current history
+  \param hit_tracking - number of hits in dosels
+  \param edep - energy deposit
+  \param global_dosel_id - index of dosel in dose map
+  \brief Recording energy deposit in a dosel. Squared energy is computed history by history with the lazy method: deposits of a history are summed in a temporary dosel, the sum is squared only when a new history reaches the dosel, the remaining sums are squared by the dose computation kernel. Total energy is always exact. Only deposits racing with the exchanges are misassigned: if two histories hit the same dosel at the same time their deposits are summed together, and a deposit b of the new history made between the exchange of the id and the exchange of the energy is squared with the previous history e, the squared energy is then wrong by the cross term 2*b*(e - e_new + b) at most, e_new being the energy of the new history in the dosel. Squared recording needs 64-bit atomics (cl_khr_int64_base_atomics), checked by the dosimetry calculator
+*/
+inline void dose_record_dosel(global GGDosiType* edep_tracking, global GGDosiType* edep_squared_tracking, global GGDosiType* edep_history_tracking, global GGulong* last_history_id, GGulong const history_id, global GGint* hit_tracking, GGfloat edep, GGint const global_dosel_id)
+{
+  if (hit_tracking) atomic_add(&hit_tracking[global_dosel_id], 1);
+  #ifdef DOSIMETRY_DOUBLE_PRECISION
+  AtomicAddDouble(&edep_tracking[global_dosel_id], (GGDosiType)edep);
+  #else
+  AtomicAddFloat(&edep_tracking[global_dosel_id], (GGDosiType)edep);
+  #endif
+
+  if (!edep_squared_tracking) return;
+
+  // New history in dosel, energy of the previous history is taken and reset in one exchange then squared
+  #if defined(cl_khr_int64_base_atomics)
+  if (atom_xchg(&last_history_id[global_dosel_id], history_id) != history_id) {
+    #ifdef DOSIMETRY_DOUBLE_PRECISION
+    GGDosiType edep_history = as_double(atom_xchg((volatile global GGulong*)&edep_history_tracking[global_dosel_id], 0UL));
+    AtomicAddDouble(&edep_squared_tracking[global_dosel_id], edep_history*edep_history);
+    #else
+    GGDosiType edep_history = atomic_xchg(&edep_history_tracking[global_dosel_id], 0.0f);
+    AtomicAddFloat(&edep_squared_tracking[global_dosel_id], edep_history*edep_history);
+    #endif
+  }
+  #endif
+
+  #ifdef DOSIMETRY_DOUBLE_PRECISION
+  AtomicAddDouble(&edep_history_tracking[global_dosel_id], (GGDosiType)edep);
+  #else
+  AtomicAddFloat(&edep_history_tracking[global_dosel_id], (GGDosiType)edep);
+  #endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+  \fn void dose_record_levels(global GGEMSDoseParams* dose_params, global GGDosiType* edep_tracking, global GGDosiType* edep_squared_tracking, global GGDosiType* edep_history_tracking, global GGulong* last_history_id, GGulong const history_id, GGfloat edep, GGint3 const* dosel_id)
+  \param dose_params - params associated to dosemap
+  \param edep_tracking - energy deposit in dosels
+  \param edep_squared_tracking - sum of squared energy deposit of each history in dosels
+  \param edep_history_tracking - energy deposit of the last history in dosels
+  \param last_history_id - id of the last history depositing energy in dosels
+  \param history_id - id of the current history
+  \param edep - energy deposit
+  \param dosel_id - index of dosel in finest level
+  \brief Recording energy deposit in coarse levels of dose pyramid, index of a coarse dosel is derived from index of the finest dosel
+*/
+inline void dose_record_levels(global GGEMSDoseParams* dose_params, global GGDosiType* edep_tracking, global GGDosiType* edep_squared_tracking, global GGDosiType* edep_history_tracking, global GGulong* last_history_id, GGulong const history_id, GGfloat edep, GGint3 const* dosel_id)
+{
+  for (GGint level = 1; level < dose_params->number_of_levels_; ++level) {
+    GGint3 level_dosel_id = *dosel_id >> level;
+    GGint3 level_number_of_dosels = dose_params->level_number_of_dosels_[level];
+
+    GGint global_dosel_id = dose_params->level_offset_[level] + level_dosel_id.x + level_dosel_id.y * level_number_of_dosels.x + level_dosel_id.z * level_number_of_dosels.x * level_number_of_dosels.y;
+
+    dose_record_dosel(edep_tracking, edep_squared_tracking, edep_history_tracking, last_history_id, history_id, (global GGint*)0, edep, global_dosel_id);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+  \fn void dose_record_grid_standard(global GGEMSDoseParams* dose_params, global GGDosiType* edep_tracking, global GGDosiType* edep_squared_tracking, global GGDosiType* edep_history_tracking, global GGulong* last_history_id, GGulong const history_id, global GGint* hit_tracking, GGfloat edep, GGfloat3 const* position)
   \param dose_params - params associated to dosemap
-  \param
-  \brief Recording data for dosimetry
+  \param edep_tracking - energy deposit in dosels
+  \param edep_squared_tracking - sum of squared energy deposit of each history in dosels
+  \param edep_history_tracking - energy deposit of the last history in dosels
+  \param last_history_id - id of the last history depositing energy in dosels
+  \param history_id - id of the current history
+  \param hit_tracking - number of hits in dosels
+  \param edep - energy deposit
+  \param position - position of the deposit in local coordinate
+  \brief Recording data for dosimetry at a position in one dose grid
 */
-inline void dose_record_standard(global GGEMSDoseParams* dose_params, global GGDosiType* edep_tracking, global GGDosiType* edep_squared_tracking, global GGint* hit_tracking, GGfloat edep, GGfloat3 const* position)
+inline void dose_record_grid_standard(global GGEMSDoseParams* dose_params, global GGDosiType* edep_tracking, global GGDosiType* edep_squared_tracking, global GGDosiType* edep_history_tracking, global GGulong* last_history_id, GGulong const history_id, global GGint* hit_tracking, GGfloat edep, GGfloat3 const* position)
 {
   // Check position of photon inside dosemap limits
   if (position->x < dose_params->border_min_xyz_.x + EPSILON6 || position->x > dose_params->border_max_xyz_.x - EPSILON6) return;
@@ -105,14 +194,237 @@ inline void dose_record_standard(global GGEMSDoseParams* dose_params, global GGD
   if (dosel_id.y < 0 || dosel_id.y >= dose_params->number_of_dosels_.y) return;
   if (dosel_id.z < 0 || dosel_id.z >= dose_params->number_of_dosels_.z) return;
 
-  if (hit_tracking) atomic_add(&hit_tracking[global_dosel_id], 1);
-  #ifdef DOSIMETRY_DOUBLE_PRECISION
-  AtomicAddDouble(&edep_tracking[global_dosel_id], (GGDosiType)edep);
-  if (edep_squared_tracking) AtomicAddDouble(&edep_squared_tracking[global_dosel_id], (GGDosiType)edep*(GGDosiType)edep);
-  #else
-  AtomicAddFloat(&edep_tracking[global_dosel_id], (GGDosiType)edep);
-  if (edep_squared_tracking) AtomicAddFloat(&edep_squared_tracking[global_dosel_id], (GGDosiType)edep*(GGDosiType)edep);
-  #endif
+  dose_record_dosel(edep_tracking, edep_squared_tracking, edep_history_tracking, last_history_id, history_id, hit_tracking, edep, global_dosel_id);
+  dose_record_levels(dose_params, edep_tracking, edep_squared_tracking, edep_history_tracking, last_history_id, history_id, edep, &dosel_id);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+  \fn void dose_record_grid_track_length(global GGEMSDoseParams* dose_params, global GGDosiType* edep_tracking, global GGDosiType* edep_squared_tracking, global GGDosiType* edep_history_tracking, global GGulong* last_history_id, GGulong const history_id, global GGint* hit_tracking, GGfloat const edep_per_length, GGfloat3 const* position, GGfloat3 const* direction, GGfloat const length)
+  \param dose_params - params associated to dosemap
+  \param edep_tracking - energy deposit in dosels
+  \param edep_squared_tracking - sum of squared energy deposit of each history in dosels
+  \param edep_history_tracking - energy deposit of the last history in dosels
+  \param last_history_id - id of the last history depositing energy in dosels
+  \param history_id - id of the current history
+  \param hit_tracking - number of hits in dosels
+  \param edep_per_length - energy deposit by unit of length (track length estimator)
+  \param position - start of the step in local coordinate
+  \param direction - direction of the step in local coordinate
+  \param length - length of the step
+  \brief Recording energy deposit of a step in all crossed dosels, each dosel receives energy proportionally to the length of the step inside it. Dosels are crossed with an exact traversal of the dose map (Amanatides and Woo), so dosels and voxels can have different sizes
+*/
+inline void dose_record_grid_track_length(global GGEMSDoseParams* dose_params, global GGDosiType* edep_tracking, global GGDosiType* edep_squared_tracking, global GGDosiType* edep_history_tracking, global GGulong* last_history_id, GGulong const history_id, global GGint* hit_tracking, GGfloat const edep_per_length, GGfloat3 const* position, GGfloat3 const* direction, GGfloat const length)
+{
+  GGfloat p[3] = {position->x, position->y, position->z};
+  GGfloat d[3] = {direction->x, direction->y, direction->z};
+  GGfloat border_min[3] = {dose_params->border_min_xyz_.x, dose_params->border_min_xyz_.y, dose_params->border_min_xyz_.z};
+  GGfloat border_max[3] = {dose_params->border_max_xyz_.x, dose_params->border_max_xyz_.y, dose_params->border_max_xyz_.z};
+  GGfloat size[3] = {dose_params->size_of_dosels_.x, dose_params->size_of_dosels_.y, dose_params->size_of_dosels_.z};
+  GGfloat inv_size[3] = {dose_params->inv_size_of_dosels_.x, dose_params->inv_size_of_dosels_.y, dose_params->inv_size_of_dosels_.z};
+  GGint number_of_dosels[3] = {dose_params->number_of_dosels_.x, dose_params->number_of_dosels_.y, dose_params->number_of_dosels_.z};
+
+  // Clipping step to dose map
+  GGfloat t_in = 0.0f, t_out = length;
+  for (GGint i = 0; i < 3; ++i) {
+    if (fabs(d[i]) < EPSILON6) {
+      if (p[i] < border_min[i] || p[i] > border_max[i]) return;
+    }
+    else {
+      GGfloat t0 = (border_min[i] - p[i]) / d[i];
+      GGfloat t1 = (border_max[i] - p[i]) / d[i];
+      t_in = fmax(t_in, fmin(t0, t1));
+      t_out = fmin(t_out, fmax(t0, t1));
+    }
+  }
+
+  if (t_in >= t_out) return;
+
+  // First dosel and distances to next dosel borders along each axis
+  GGint dosel_id[3];
+  GGint dosel_step[3];
+  GGfloat t_next[3];
+  GGfloat t_delta[3];
+  for (GGint i = 0; i < 3; ++i) {
+    dosel_id[i] = (GGint)((p[i] + d[i]*t_in - border_min[i]) * inv_size[i]);
+    dosel_id[i] = clamp(dosel_id[i], 0, number_of_dosels[i] - 1);
+
+    if (d[i] > EPSILON6) {
+      dosel_step[i] = 1;
+      t_next[i] = (border_min[i] + (dosel_id[i] + 1)*size[i] - p[i]) / d[i];
+      t_delta[i] = size[i] / d[i];
+    }
+    else if (d[i] < -EPSILON6) {
+      dosel_step[i] = -1;
+      t_next[i] = (border_min[i] + dosel_id[i]*size[i] - p[i]) / d[i];
+      t_delta[i] = -size[i] / d[i];
+    }
+    else {
+      dosel_step[i] = 0;
+      t_next[i] = FLT_MAX;
+      t_delta[i] = FLT_MAX;
+    }
+  }
+
+  // Walking along the step, dosel by dosel
+  GGfloat t = t_in;
+  while (t < t_out) {
+    GGint axis = (t_next[0] < t_next[1]) ? (t_next[0] < t_next[2] ? 0 : 2) : (t_next[1] < t_next[2] ? 1 : 2);
+    GGfloat t_exit = fmin(t_next[axis], t_out);
+
+    GGint global_dosel_id = dosel_id[0] + dosel_id[1] * number_of_dosels[0] + dosel_id[2] * number_of_dosels[0] * number_of_dosels[1];
+    if (t_exit > t) {
+      GGint3 fine_dosel_id = {dosel_id[0], dosel_id[1], dosel_id[2]};
+      dose_record_dosel(edep_tracking, edep_squared_tracking, edep_history_tracking, last_history_id, history_id, hit_tracking, edep_per_length*(t_exit - t), global_dosel_id);
+      dose_record_levels(dose_params, edep_tracking, edep_squared_tracking, edep_history_tracking, last_history_id, history_id, edep_per_length*(t_exit - t), &fine_dosel_id);
+    }
+
+    t = t_exit;
+    dosel_id[axis] += dosel_step[axis];
+    if (dosel_id[axis] < 0 || dosel_id[axis] >= number_of_dosels[axis]) break;
+    t_next[axis] += t_delta[axis];
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+  \fn void dose_record_standard(global GGEMSDoseParams* dose_params, global GGDosiType* edep_tracking, global GGDosiType* edep_squared_tracking, global GGDosiType* edep_history_tracking, global GGulong* last_history_id, GGulong const history_id, global GGint* hit_tracking, GGfloat edep, GGfloat3 const* position)
+  \param dose_params - params associated to dose grids, first dose grid stores the number of dose grids
+  \param edep_tracking - energy deposit in dosels of all dose grids
+  \param edep_squared_tracking - sum of squared energy deposit of each history in dosels of all dose grids
+  \param edep_history_tracking - energy deposit of the last history in dosels of all dose grids
+  \param last_history_id - id of the last history depositing energy in dosels of all dose grids
+  \param history_id - id of the current history
+  \param hit_tracking - number of hits in dosels of first dose grid
+  \param edep - energy deposit
+  \param position - position of the deposit in local coordinate
+  \brief Recording data for dosimetry at a position in all dose grids attached to navigator, position in local coordinate is computed once for all dose grids
+*/
+inline void dose_record_standard(global GGEMSDoseParams* dose_params, global GGDosiType* edep_tracking, global GGDosiType* edep_squared_tracking, global GGDosiType* edep_history_tracking, global GGulong* last_history_id, GGulong const history_id, global GGint* hit_tracking, GGfloat edep, GGfloat3 const* position)
+{
+  for (GGint grid = 0; grid < dose_params->number_of_grids_; ++grid) {
+    GGint dosel_offset = dose_params[grid].dosel_offset_;
+    dose_record_grid_standard(
+      &dose_params[grid],
+      edep_tracking + dosel_offset,
+      edep_squared_tracking ? edep_squared_tracking + dosel_offset : edep_squared_tracking,
+      edep_history_tracking ? edep_history_tracking + dosel_offset : edep_history_tracking,
+      last_history_id ? last_history_id + dosel_offset : last_history_id,
+      history_id,
+      grid == 0 ? hit_tracking : (global GGint*)0,
+      edep,
+      position
+    );
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+  \fn void dose_record_track_length(global GGEMSDoseParams* dose_params, global GGDosiType* edep_tracking, global GGDosiType* edep_squared_tracking, global GGDosiType* edep_history_tracking, global GGulong* last_history_id, GGulong const history_id, global GGint* hit_tracking, GGfloat const edep_per_length, GGfloat3 const* position, GGfloat3 const* direction, GGfloat const length)
+  \param dose_params - params associated to dose grids, first dose grid stores the number of dose grids
+  \param edep_tracking - energy deposit in dosels of all dose grids
+  \param edep_squared_tracking - sum of squared energy deposit of each history in dosels of all dose grids
+  \param edep_history_tracking - energy deposit of the last history in dosels of all dose grids
+  \param last_history_id - id of the last history depositing energy in dosels of all dose grids
+  \param history_id - id of the current history
+  \param hit_tracking - number of hits in dosels of first dose grid
+  \param edep_per_length - energy deposit by unit of length (track length estimator)
+  \param position - start of the step in local coordinate
+  \param direction - direction of the step in local coordinate
+  \param length - length of the step
+  \brief Recording energy deposit of a step in all dose grids attached to navigator
+*/
+inline void dose_record_track_length(global GGEMSDoseParams* dose_params, global GGDosiType* edep_tracking, global GGDosiType* edep_squared_tracking, global GGDosiType* edep_history_tracking, global GGulong* last_history_id, GGulong const history_id, global GGint* hit_tracking, GGfloat const edep_per_length, GGfloat3 const* position, GGfloat3 const* direction, GGfloat const length)
+{
+  for (GGint grid = 0; grid < dose_params->number_of_grids_; ++grid) {
+    GGint dosel_offset = dose_params[grid].dosel_offset_;
+    dose_record_grid_track_length(
+      &dose_params[grid],
+      edep_tracking + dosel_offset,
+      edep_squared_tracking ? edep_squared_tracking + dosel_offset : edep_squared_tracking,
+      edep_history_tracking ? edep_history_tracking + dosel_offset : edep_history_tracking,
+      last_history_id ? last_history_id + dosel_offset : last_history_id,
+      history_id,
+      grid == 0 ? hit_tracking : (global GGint*)0,
+      edep_per_length,
+      position,
+      direction,
+      length
+    );
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+  \fn GGfloat electron_csda_range(global GGEMSMaterialTables const* materials, GGuchar const material_id, GGfloat const energy)
+  \param materials - table of materials
+  \param material_id - index of material
+  \param energy - kinetic energy of electron
+  \return CSDA range of electron in mm
+  \brief Get CSDA range of electron in material, linear interpolation in log of energy
+*/
+inline GGfloat electron_csda_range(global GGEMSMaterialTables const* materials, GGuchar const material_id, GGfloat const energy)
+{
+  global GGfloat const* range = &materials->electron_csda_range_[material_id*CSDA_RANGE_TABLE_NUMBER_BINS];
+
+  GGfloat log_energy_min = log(CSDA_RANGE_ENERGY_MIN);
+  GGfloat bin = (log(energy) - log_energy_min) * (GGfloat)(CSDA_RANGE_TABLE_NUMBER_BINS - 1) / (log(CSDA_RANGE_ENERGY_MAX) - log_energy_min);
+
+  if (bin <= 0.0f) return range[0] * energy / CSDA_RANGE_ENERGY_MIN;
+  if (bin >= (GGfloat)(CSDA_RANGE_TABLE_NUMBER_BINS - 1)) return range[CSDA_RANGE_TABLE_NUMBER_BINS - 1];
+
+  GGint index = (GGint)bin;
+  GGfloat fraction = bin - (GGfloat)index;
+
+  return range[index] + fraction * (range[index+1] - range[index]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+  \fn void dose_record_csda(global GGEMSDoseParams* dose_params, global GGDosiType* edep_tracking, global GGDosiType* edep_squared_tracking, global GGDosiType* edep_history_tracking, global GGulong* last_history_id, GGulong const history_id, global GGint* hit_tracking, global GGEMSMaterialTables const* materials, GGuchar const material_id, GGfloat const edep, GGfloat3 const* position, GGfloat3 const* direction)
+  \param dose_params - params associated to dose grids, first dose grid stores the number of dose grids
+  \param edep_tracking - energy deposit in dosels of all dose grids
+  \param edep_squared_tracking - sum of squared energy deposit of each history in dosels of all dose grids
+  \param edep_history_tracking - energy deposit of the last history in dosels of all dose grids
+  \param last_history_id - id of the last history depositing energy in dosels of all dose grids
+  \param history_id - id of the current history
+  \param hit_tracking - number of hits in dosels of first dose grid
+  \param materials - table of materials
+  \param material_id - index of material at the interaction
+  \param edep - kinetic energy of the secondary electron
+  \param position - position of the interaction in local coordinate
+  \param direction - direction of the secondary electron in local coordinate
+  \brief Recording energy of a secondary electron uniformly along a straight segment of length its CSDA range, energy is deposited locally if range is below the size of a dosel
+*/
+inline void dose_record_csda(global GGEMSDoseParams* dose_params, global GGDosiType* edep_tracking, global GGDosiType* edep_squared_tracking, global GGDosiType* edep_history_tracking, global GGulong* last_history_id, GGulong const history_id, global GGint* hit_tracking, global GGEMSMaterialTables const* materials, GGuchar const material_id, GGfloat const edep, GGfloat3 const* position, GGfloat3 const* direction)
+{
+  if (edep <= 0.0f) return;
+
+  GGfloat range = electron_csda_range(materials, material_id, edep);
+
+  // Electron stops in its dosel, no need to traverse dose map
+  GGfloat min_dosel_size = fmin(dose_params->size_of_dosels_.x, fmin(dose_params->size_of_dosels_.y, dose_params->size_of_dosels_.z));
+  if (range < 0.5f*min_dosel_size) {
+    dose_record_standard(dose_params, edep_tracking, edep_squared_tracking, edep_history_tracking, last_history_id, history_id, hit_tracking, edep, position);
+    return;
+  }
+
+  dose_record_track_length(dose_params, edep_tracking, edep_squared_tracking, edep_history_tracking, last_history_id, history_id, hit_tracking, edep/range, position, direction, range);
 }
 
 #endif
@@ -34,9 +34,12 @@
 #pragma warning(disable: 4251) // Deleting warning exporting STL members!!!
 #endif
 
+#include <vector>
+
 #include "GGEMS/global/GGEMSExport.hh"
 #include "GGEMS/tools/GGEMSTypes.hh"
 #include "GGEMS/navigators/GGEMSDoseRecording.hh"
+#include "GGEMS/io/GGEMSMHDImage.hh"
 
 class GGEMSNavigator;
 
@@ -157,6 +160,20 @@ class GGEMS_EXPORT GGEMSDosimetryCalculator
     */
     void SetUncertainty(bool const& is_activated);
 
+    /*!
+      \fn void SetLabelDose(bool const& is_activated)
+      \param is_activated - boolean activating dose by label
+      \brief activating reduction of dose by label of phantom on OpenCL device, energy, mass and mean dose are stored in a table
+    */
+    void SetLabelDose(bool const& is_activated);
+
+    /*!
+      \fn void SetDoseMap(bool const& is_activated)
+      \param is_activated - boolean activating dose map output
+      \brief activating dose map output, activated by default
+    */
+    void SetDoseMap(bool const& is_activated);
+
     /*!
       \fn void SetWaterReference(bool const& is_activated)
       \param is_activated - boolean activating water reference
@@ -179,6 +196,41 @@ class GGEMS_EXPORT GGEMSDosimetryCalculator
     */
     void SetTLE(bool const& is_activated);
 
+    /*!
+      \fn void SetCSDA(bool const& is_activated)
+      \param is_activated - boolean activating CSDA deposition
+      \brief activating deposition of photoelectric and Compton electrons along a straight segment of length their CSDA range
+    */
+    void SetCSDA(bool const& is_activated);
+
+    /*!
+      \fn void SetAdaptiveDosels(GGsize const& number_of_levels, GGfloat const& target_uncertainty)
+      \param number_of_levels - number of levels in dose pyramid (1 to 3), dosel size is doubled at each level
+      \param target_uncertainty - target relative uncertainty
+      \brief scoring dose in a pyramid of dose maps in one simulation, for each dosel the finest level reaching the target uncertainty is selected
+    */
+    void SetAdaptiveDosels(GGsize const& number_of_levels, GGfloat const& target_uncertainty);
+
+    /*!
+      \fn void SetDoseRegion(GGfloat const& x_min, GGfloat const& x_max, GGfloat const& y_min, GGfloat const& y_max, GGfloat const& z_min, GGfloat const& z_max, std::string const& unit = "mm")
+      \param x_min - min. border of dose map in X axis of phantom
+      \param x_max - max. border of dose map in X axis of phantom
+      \param y_min - min. border of dose map in Y axis of phantom
+      \param y_max - max. border of dose map in Y axis of phantom
+      \param z_min - min. border of dose map in Z axis of phantom
+      \param z_max - max. border of dose map in Z axis of phantom
+      \param unit - unit of the distance
+      \brief restricting dose map to a region of phantom, borders are given relatively to the center of phantom
+    */
+    void SetDoseRegion(GGfloat const& x_min, GGfloat const& x_max, GGfloat const& y_min, GGfloat const& y_max, GGfloat const& z_min, GGfloat const& z_max, std::string const& unit = "mm");
+
+    /*!
+      \fn void AddDoseGrid(GGEMSDosimetryCalculator* dose_grid)
+      \param dose_grid - pointer on another dosimetry calculator attached to the same navigator
+      \brief adding a dose grid scored during the same transport, energy buffers of the dose grid are sub-buffers of energy buffers of this calculator
+    */
+    void AddDoseGrid(GGEMSDosimetryCalculator* dose_grid);
+
     /*!
       \fn inline cl::Buffer* GetPhotonTrackingBuffer(GGsize const& thread_index) const
       \param thread_index - index of activated device (thread index)
@@ -211,6 +263,38 @@ class GGEMS_EXPORT GGEMSDosimetryCalculator
     */
     inline cl::Buffer* GetEdepSquaredBuffer(GGsize const& thread_index) const {return dose_recording_.edep_squared_[thread_index];}
 
+    /*!
+      \fn inline cl::Buffer* GetEdepHistoryBuffer(GGsize const& thread_index) const
+      \param thread_index - index of activated device (thread index)
+      \return OpenCL buffer storing energy deposit of the last history in dosels
+      \brief get the buffer storing energy deposit of the last history in dosels
+    */
+    inline cl::Buffer* GetEdepHistoryBuffer(GGsize const& thread_index) const {return dose_recording_.edep_history_[thread_index];}
+
+    /*!
+      \fn inline cl::Buffer* GetLastHistoryIDBuffer(GGsize const& thread_index) const
+      \param thread_index - index of activated device (thread index)
+      \return OpenCL buffer storing id of the last history in dosels
+      \brief get the buffer storing id of the last history in dosels
+    */
+    inline cl::Buffer* GetLastHistoryIDBuffer(GGsize const& thread_index) const {return dose_recording_.last_history_id_[thread_index];}
+
+    /*!
+      \fn inline GGulong GetHistoryOffset(GGsize const& thread_index) const
+      \param thread_index - index of activated device (thread index)
+      \return id of the first history in current batch
+      \brief get the id of the first history in current batch
+    */
+    inline GGulong GetHistoryOffset(GGsize const& thread_index) const {return static_cast<GGulong>(number_of_histories_[thread_index]);}
+
+    /*!
+      \fn void CountHistories(GGsize const& thread_index, GGsize const& number_of_histories)
+      \param thread_index - index of activated device (thread index)
+      \param number_of_histories - number of histories simulated in batch
+      \brief count the histories simulated on a device, called at the end of each batch
+    */
+    void CountHistories(GGsize const& thread_index, GGsize const& number_of_histories);
+
     /*!
       \fn inline cl::Buffer* GetDoseParams(GGsize const& thread_index) const
       \param thread_index - index of activated device (thread index)
@@ -246,44 +330,59 @@ class GGEMS_EXPORT GGEMSDosimetryCalculator
     void InitializeKernel(void);
 
     /*!
-      \fn void SavePhotonTracking(void) const
-      \brief save photon tracking
+      \fn void SaveDoseMaps(void) const
+      \brief packing all requested dose maps in one staging buffer on each device with one kernel, reading staging buffers without blocking and writing outputs in parallel
     */
-    void SavePhotonTracking(void) const;
+    void SaveDoseMaps(void) const;
 
     /*!
-      \fn void SaveHit(void) const
-      \brief save hits in dose map
+      \fn template <typename T> void WriteOutput(std::string const& output_filename, std::string const& data_type, GGsize3 const& dimensions, GGfloat3 const& element_sizes, T* data) const
+      \tparam T - type of the data
+      \param output_filename - name of output MHD file
+      \param data_type - MHD type of the data
+      \param dimensions - number of dosels per dimension
+      \param element_sizes - size of dosels
+      \param data - data to write
+      \brief write a dose map in MHD format
     */
-    void SaveHit(void) const;
+    template <typename T>
+    void WriteOutput(std::string const& output_filename, std::string const& data_type, GGsize3 const& dimensions, GGfloat3 const& element_sizes, T* data) const;
 
     /*!
-      \fn void SaveEdep(void) const
-      \brief save energy deposit
+      \fn void SelectDoseLevel(GGsize const& thread_index)
+      \param thread_index - index of activated device (thread index)
+      \brief selecting finest level of dose pyramid reaching target uncertainty
     */
-    void SaveEdep(void) const;
+    void SelectDoseLevel(GGsize const& thread_index);
 
     /*!
-      \fn void SaveDose(void) const
-      \brief save dose
+      \fn void InitializeDoseGrids(void)
+      \brief Initialize dose grids and allocate energy buffers shared by all dose grids
     */
-    void SaveDose(void) const;
+    void InitializeDoseGrids(void);
 
     /*!
-      \fn void SaveEdepSquared(void) const
-      \brief save energy squared deposit
+      \fn void ReduceDoseByLabel(GGsize const& thread_index)
+      \param thread_index - index of activated device (thread index)
+      \brief summing energy deposit and mass of dosels for each label of phantom
     */
-    void SaveEdepSquared(void) const;
+    void ReduceDoseByLabel(GGsize const& thread_index);
 
     /*!
-      \fn void SaveUncertainty(void) const
-      \brief save uncertainty values
+      \fn void SaveLabelDose(void) const
+      \brief save table of dose by label
     */
-    void SaveUncertainty(void) const;
+    void SaveLabelDose(void) const;
 
   private:
     GGfloat3 dosel_sizes_; /*!< Sizes of dosel */
     GGsize total_number_of_dosels_; /*!< Total number of dosels in image */
+    GGsize number_of_pyramid_dosels_; /*!< Total number of dosels in all levels of dose pyramid */
+    GGsize number_of_dose_levels_; /*!< Number of levels in dose pyramid */
+    GGfloat target_uncertainty_; /*!< Target uncertainty selecting level of dose pyramid */
+    bool is_dose_region_; /*!< Boolean checking if dose map is restricted to a region of phantom */
+    GGfloat3 dose_region_min_xyz_; /*!< Min. border of dose region */
+    GGfloat3 dose_region_max_xyz_; /*!< Max. border of dose region */
     std::string dosimetry_output_filename_; /*!< Output filename for dosimetry results */
     GGEMSNavigator* navigator_; /*!< Navigator pointer associated to dosimetry object */
 
@@ -295,14 +394,48 @@ class GGEMS_EXPORT GGEMSDosimetryCalculator
     bool is_hit_tracking_; /*!< Boolean for hit tracking */
     bool is_edep_squared_; /*!< Boolean for energy squared deposit */
     bool is_uncertainty_; /*!< Boolean for uncertainty computation */
+    bool is_label_dose_; /*!< Boolean for dose by label */
+    bool is_dose_map_; /*!< Boolean for dose map output */
+    GGsize number_of_labels_; /*!< Number of labels in phantom */
     GGfloat scale_factor_; /*!< Scale factor */
     GGchar is_water_reference_; /*!< Water reference for dose computation */
     GGfloat minimum_density_; /*!< Minimum density value for dose computation */
+    GGsize* number_of_histories_; /*!< Number of simulated histories for each device */
+
+    // Dose grids scored during the same transport
+    std::vector<GGEMSDosimetryCalculator*> dose_grids_; /*!< Other dosimetry calculators attached to the same navigator */
+    bool is_dose_grid_; /*!< Boolean checking if calculator is a dose grid of another calculator */
+    bool is_squared_recording_; /*!< Boolean checking if energy squared is recorded during transport */
+    GGsize number_of_shared_dosels_; /*!< Number of dosels in energy buffers shared by all dose grids */
 
     cl::Kernel** kernel_compute_dose_; /*!< OpenCL kernel computing dose in voxelized solid */
+    cl::Kernel** kernel_select_dose_level_; /*!< OpenCL kernel selecting level of dose pyramid */
+    cl::Kernel** kernel_reduce_dose_by_label_; /*!< OpenCL kernel reducing dose by label */
+    cl::Kernel** kernel_finalize_dose_; /*!< OpenCL kernel packing outputs in staging buffer */
     GGsize number_activated_devices_; /*!< Number of activated device */
 };
 
+/*!
+  \fn template <typename T> void GGEMSDosimetryCalculator::WriteOutput(std::string const& output_filename, std::string const& data_type, GGsize3 const& dimensions, GGfloat3 const& element_sizes, T* data) const
+  \tparam T - type of the data
+  \param output_filename - name of output MHD file
+  \param data_type - MHD type of the data
+  \param dimensions - number of dosels per dimension
+  \param element_sizes - size of dosels
+  \param data - data to write
+  \brief write a dose map in MHD format
+*/
+template <typename T>
+void GGEMSDosimetryCalculator::WriteOutput(std::string const& output_filename, std::string const& data_type, GGsize3 const& dimensions, GGfloat3 const& element_sizes, T* data) const
+{
+  GGEMSMHDImage mhdImage;
+  mhdImage.SetOutputFileName(output_filename);
+  mhdImage.SetDataType(data_type);
+  mhdImage.SetDimensions(dimensions);
+  mhdImage.SetElementSizes(element_sizes);
+  mhdImage.Write<T>(data);
+}
+
 /*!
   \fn GGEMSDosimetryCalculator* create_ggems_dosimetry_calculator(void)
   \return the pointer on the dosimetry calculator
@@ -401,6 +534,22 @@ extern "C" GGEMS_EXPORT void dose_edep_squared_dosimetry_calculator(GGEMSDosimet
 */
 extern "C" GGEMS_EXPORT void dose_uncertainty_dosimetry_calculator(GGEMSDosimetryCalculator* dose_calculator, bool const is_activated);
 
+/*!
+  \fn void dose_label_dosimetry_calculator(GGEMSDosimetryCalculator* dose_calculator, bool const is_activated)
+  \param dose_calculator - pointer on dose calculator
+  \param is_activated - boolean activating dose by label output
+  \brief storing table of dose by label
+*/
+extern "C" GGEMS_EXPORT void dose_label_dosimetry_calculator(GGEMSDosimetryCalculator* dose_calculator, bool const is_activated);
+
+/*!
+  \fn void dose_map_dosimetry_calculator(GGEMSDosimetryCalculator* dose_calculator, bool const is_activated)
+  \param dose_calculator - pointer on dose calculator
+  \param is_activated - boolean activating dose map output
+  \brief storing dose map
+*/
+extern "C" GGEMS_EXPORT void dose_map_dosimetry_calculator(GGEMSDosimetryCalculator* dose_calculator, bool const is_activated);
+
 /*!
   \fn void dose_tle_navigator(GGEMSDosimetryCalculator* dose_calculator, bool const is_activated)
   \param dose_calculator - pointer on dose calculator
@@ -409,6 +558,37 @@ extern "C" GGEMS_EXPORT void dose_uncertainty_dosimetry_calculator(GGEMSDosimetr
 */
 extern "C" GGEMS_EXPORT void dose_tle_navigator(GGEMSDosimetryCalculator* dose_calculator, bool const is_activated);
 
+/*!
+  \fn void dose_csda_navigator(GGEMSDosimetryCalculator* dose_calculator, bool const is_activated)
+  \param dose_calculator - pointer on dose calculator
+  \param is_activated - boolean the use of CSDA deposition
+  \brief activates CSDA deposition of secondary electrons on the navigator
+*/
+extern "C" GGEMS_EXPORT void dose_csda_navigator(GGEMSDosimetryCalculator* dose_calculator, bool const is_activated);
+
+/*!
+  \fn void adaptive_dosels_dosimetry_calculator(GGEMSDosimetryCalculator* dose_calculator, GGsize const number_of_levels, GGfloat const target_uncertainty)
+  \param dose_calculator - pointer on dose calculator
+  \param number_of_levels - number of levels in dose pyramid
+  \param target_uncertainty - target relative uncertainty
+  \brief scoring dose in a pyramid of dose maps and selecting finest level reaching target uncertainty
+*/
+extern "C" GGEMS_EXPORT void adaptive_dosels_dosimetry_calculator(GGEMSDosimetryCalculator* dose_calculator, GGsize const number_of_levels, GGfloat const target_uncertainty);
+
+/*!
+  \fn void set_dose_region_dosimetry_calculator(GGEMSDosimetryCalculator* dose_calculator, GGfloat const x_min, GGfloat const x_max, GGfloat const y_min, GGfloat const y_max, GGfloat const z_min, GGfloat const z_max, char const* unit)
+  \param dose_calculator - pointer on dose calculator
+  \param x_min - min. border of dose map in X axis of phantom
+  \param x_max - max. border of dose map in X axis of phantom
+  \param y_min - min. border of dose map in Y axis of phantom
+  \param y_max - max. border of dose map in Y axis of phantom
+  \param z_min - min. border of dose map in Z axis of phantom
+  \param z_max - max. border of dose map in Z axis of phantom
+  \param unit - unit of the distance
+  \brief restricting dose map to a region of phantom
+*/
+extern "C" GGEMS_EXPORT void set_dose_region_dosimetry_calculator(GGEMSDosimetryCalculator* dose_calculator, GGfloat const x_min, GGfloat const x_max, GGfloat const y_min, GGfloat const y_max, GGfloat const z_min, GGfloat const z_max, char const* unit);
+
 /*!
   \fn void attach_to_navigator_dosimetry_calculator(GGEMSDosimetryCalculator* dose_calculator, char const* navigator)
   \param dose_calculator - pointer on dose calculator
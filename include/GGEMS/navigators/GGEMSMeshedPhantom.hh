@@ -0,0 +1,152 @@
+#ifndef GUARD_GGEMS_NAVIGATORS_GGEMSMESHEDPHANTOM_HH
+#define GUARD_GGEMS_NAVIGATORS_GGEMSMESHEDPHANTOM_HH
+
+// ************************************************************************
+// * This file is part of GGEMS.                                          *
+// *                                                                      *
+// * GGEMS is free software: you can redistribute it and/or modify        *
+// * it under the terms of the GNU General Public License as published by *
+// * the Free Software Foundation, either version 3 of the License, or    *
+// * (at your option) any later version.                                  *
+// *                                                                      *
+// * GGEMS is distributed in the hope that it will be useful,             *
+// * but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+// * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+// * GNU General Public License for more details.                         *
+// *                                                                      *
+// * You should have received a copy of the GNU General Public License    *
+// * along with GGEMS.  If not, see <https://www.gnu.org/licenses/>.      *
+// *                                                                      *
+// ************************************************************************
+
+/*!
+  \file GGEMSMeshedPhantom.hh
+
+  \brief Child GGEMS class handling meshed phantom, a closed triangle mesh filled with one material
+
+  \author Julien BERT <julien.bert@univ-brest.fr>
+  \author Didier BENOIT <didier.benoit@inserm.fr>
+  \author LaTIM, INSERM - U1101, Brest, FRANCE
+  \date Sunday October 18, 2026
+*/
+
+#include "GGEMS/navigators/GGEMSNavigator.hh"
+
+/*!
+  \class GGEMSMeshedPhantom
+  \brief Child GGEMS class handling meshed phantom (collimator, shielding, housing...) without voxelization
+*/
+class GGEMS_EXPORT GGEMSMeshedPhantom : public GGEMSNavigator
+{
+  public:
+    /*!
+      \param meshed_phantom_name - name of the meshed phantom
+      \brief GGEMSMeshedPhantom constructor
+    */
+    explicit GGEMSMeshedPhantom(std::string const& meshed_phantom_name);
+
+    /*!
+      \brief GGEMSMeshedPhantom destructor
+    */
+    ~GGEMSMeshedPhantom(void) override;
+
+    /*!
+      \fn GGEMSMeshedPhantom(GGEMSMeshedPhantom const& meshed_phantom) = delete
+      \param meshed_phantom - reference on the GGEMS meshed phantom
+      \brief Avoid copy by reference
+    */
+    GGEMSMeshedPhantom(GGEMSMeshedPhantom const& meshed_phantom) = delete;
+
+    /*!
+      \fn GGEMSMeshedPhantom& operator=(GGEMSMeshedPhantom const& meshed_phantom) = delete
+      \param meshed_phantom - reference on the GGEMS meshed phantom
+      \brief Avoid assignement by reference
+    */
+    GGEMSMeshedPhantom& operator=(GGEMSMeshedPhantom const& meshed_phantom) = delete;
+
+    /*!
+      \fn GGEMSMeshedPhantom(GGEMSMeshedPhantom const&& meshed_phantom) = delete
+      \param meshed_phantom - rvalue reference on the GGEMS meshed phantom
+      \brief Avoid copy by rvalue reference
+    */
+    GGEMSMeshedPhantom(GGEMSMeshedPhantom const&& meshed_phantom) = delete;
+
+    /*!
+      \fn GGEMSMeshedPhantom& operator=(GGEMSMeshedPhantom const&& meshed_phantom) = delete
+      \param meshed_phantom - rvalue reference on the GGEMS meshed phantom
+      \brief Avoid copy by rvalue reference
+    */
+    GGEMSMeshedPhantom& operator=(GGEMSMeshedPhantom const&& meshed_phantom) = delete;
+
+    /*!
+      \fn void SetMeshFile(std::string const& mesh_filename, std::string const& material_name)
+      \param mesh_filename - STL (binary or ASCII) or OBJ file, coordinates in mm
+      \param material_name - material filling the mesh
+      \brief set the mesh file and its material
+    */
+    void SetMeshFile(std::string const& mesh_filename, std::string const& material_name);
+
+    /*!
+      \fn void Initialize(void) override
+      \brief Initialize the meshed phantom
+    */
+    void Initialize(void) override;
+
+    /*!
+      \fn void SaveResults
+      \brief save all results from solid, no result for meshed phantom
+    */
+    void SaveResults(void) override {}
+
+  private:
+    /*!
+      \fn void CheckParameters(void) const override
+      \brief checking parameters
+    */
+    void CheckParameters(void) const override;
+
+  private:
+    std::string mesh_filename_; /*!< Mesh file storing the phantom */
+    std::string material_name_; /*!< Material filling the mesh */
+};
+
+/*!
+  \fn GGEMSMeshedPhantom* create_ggems_meshed_phantom(char const* meshed_phantom_name)
+  \param meshed_phantom_name - name of meshed phantom
+  \return the pointer on the meshed phantom
+  \brief Get the GGEMSMeshedPhantom pointer for python user.
+*/
+extern "C" GGEMS_EXPORT GGEMSMeshedPhantom* create_ggems_meshed_phantom(char const* meshed_phantom_name);
+
+/*!
+  \fn void set_mesh_file_ggems_meshed_phantom(GGEMSMeshedPhantom* meshed_phantom, char const* mesh_filename, char const* material_name)
+  \param meshed_phantom - pointer on meshed phantom
+  \param mesh_filename - filename of the mesh
+  \param material_name - material filling the mesh
+  \brief set the mesh file and its material
+*/
+extern "C" GGEMS_EXPORT void set_mesh_file_ggems_meshed_phantom(GGEMSMeshedPhantom* meshed_phantom, char const* mesh_filename, char const* material_name);
+
+/*!
+  \fn void set_position_ggems_meshed_phantom(GGEMSMeshedPhantom* meshed_phantom, GGfloat const position_x, GGfloat const position_y, GGfloat const position_z, char const* unit)
+  \param meshed_phantom - pointer on meshed phantom
+  \param position_x - offset in X
+  \param position_y - offset in Y
+  \param position_z - offset in Z
+  \param unit - unit of the distance
+  \brief set the position of the meshed phantom in X, Y and Z
+*/
+extern "C" GGEMS_EXPORT void set_position_ggems_meshed_phantom(GGEMSMeshedPhantom* meshed_phantom, GGfloat const position_x, GGfloat const position_y, GGfloat const position_z, char const* unit);
+
+/*!
+  \fn void set_rotation_ggems_meshed_phantom(GGEMSMeshedPhantom* meshed_phantom, GGfloat const rx, GGfloat const ry, GGfloat const rz, char const* unit)
+  \param meshed_phantom - pointer on meshed phantom
+  \param rx - Rotation around X along local axis
+  \param ry - Rotation around Y along local axis
+  \param rz - Rotation around Z along local axis
+  \param unit - unit of the angle
+  \brief Set the rotation of the meshed phantom around local axis
+*/
+extern "C" GGEMS_EXPORT void set_rotation_ggems_meshed_phantom(GGEMSMeshedPhantom* meshed_phantom, GGfloat const rx, GGfloat const ry, GGfloat const rz, char const* unit);
+
+#endif // End of GUARD_GGEMS_NAVIGATORS_GGEMSMESHEDPHANTOM_HH
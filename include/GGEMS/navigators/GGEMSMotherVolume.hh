@@ -0,0 +1,274 @@
+#ifndef GUARD_GGEMS_NAVIGATORS_GGEMSMOTHERVOLUME_HH
+#define GUARD_GGEMS_NAVIGATORS_GGEMSMOTHERVOLUME_HH
+
+// ************************************************************************
+// * This file is part of GGEMS.                                          *
+// *                                                                      *
+// * GGEMS is free software: you can redistribute it and/or modify        *
+// * it under the terms of the GNU General Public License as published by *
+// * the Free Software Foundation, either version 3 of the License, or    *
+// * (at your option) any later version.                                  *
+// *                                                                      *
+// * GGEMS is distributed in the hope that it will be useful,             *
+// * but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+// * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+// * GNU General Public License for more details.                         *
+// *                                                                      *
+// * You should have received a copy of the GNU General Public License    *
+// * along with GGEMS.  If not, see <https://www.gnu.org/licenses/>.      *
+// *                                                                      *
+// ************************************************************************
+
+/*!
+  \file GGEMSMotherVolume.hh
+
+  \brief GGEMS class handling mother volume, a box of world medium containing daughter navigators or mother volumes
+
+  \author Julien BERT <julien.bert@univ-brest.fr>
+  \author Didier BENOIT <didier.benoit@inserm.fr>
+  \author LaTIM, INSERM - U1101, Brest, FRANCE
+  \version 1.0
+  \date Sunday October 18, 2026
+*/
+
+#ifdef _MSC_VER
+#pragma warning(disable: 4251) // Deleting warning exporting STL members!!!
+#endif
+
+#include <string>
+
+#include "GGEMS/global/GGEMSExport.hh"
+#include "GGEMS/tools/GGEMSTypes.hh"
+
+class GGEMSGeometryTransformation;
+
+/*!
+  \class GGEMSMotherVolume
+  \brief GGEMS class handling mother volume. A particle in a mother volume is only tested against daughters of this mother volume and against its boundary, there is no interaction in mother volume (world medium)
+*/
+class GGEMS_EXPORT GGEMSMotherVolume
+{
+  public:
+    /*!
+      \param mother_volume_name - name of the mother volume
+      \brief GGEMSMotherVolume constructor
+    */
+    explicit GGEMSMotherVolume(std::string const& mother_volume_name);
+
+    /*!
+      \brief GGEMSMotherVolume destructor
+    */
+    ~GGEMSMotherVolume(void);
+
+    /*!
+      \fn GGEMSMotherVolume(GGEMSMotherVolume const& mother_volume) = delete
+      \param mother_volume - reference on the GGEMS mother volume
+      \brief Avoid copy by reference
+    */
+    GGEMSMotherVolume(GGEMSMotherVolume const& mother_volume) = delete;
+
+    /*!
+      \fn GGEMSMotherVolume& operator=(GGEMSMotherVolume const& mother_volume) = delete
+      \param mother_volume - reference on the GGEMS mother volume
+      \brief Avoid assignement by reference
+    */
+    GGEMSMotherVolume& operator=(GGEMSMotherVolume const& mother_volume) = delete;
+
+    /*!
+      \fn GGEMSMotherVolume(GGEMSMotherVolume const&& mother_volume) = delete
+      \param mother_volume - rvalue reference on the GGEMS mother volume
+      \brief Avoid copy by rvalue reference
+    */
+    GGEMSMotherVolume(GGEMSMotherVolume const&& mother_volume) = delete;
+
+    /*!
+      \fn GGEMSMotherVolume& operator=(GGEMSMotherVolume const&& mother_volume) = delete
+      \param mother_volume - rvalue reference on the GGEMS mother volume
+      \brief Avoid copy by rvalue reference
+    */
+    GGEMSMotherVolume& operator=(GGEMSMotherVolume const&& mother_volume) = delete;
+
+    /*!
+      \fn void SetSize(GGfloat const& size_x, GGfloat const& size_y, GGfloat const& size_z, std::string const& unit = "mm")
+      \param size_x - size of mother volume along X
+      \param size_y - size of mother volume along Y
+      \param size_z - size of mother volume along Z
+      \param unit - unit of the distance
+      \brief set the size of the box of mother volume
+    */
+    void SetSize(GGfloat const& size_x, GGfloat const& size_y, GGfloat const& size_z, std::string const& unit = "mm");
+
+    /*!
+      \fn void SetPosition(GGfloat const& position_x, GGfloat const& position_y, GGfloat const& position_z, std::string const& unit = "mm")
+      \param position_x - position in X
+      \param position_y - position in Y
+      \param position_z - position in Z
+      \param unit - unit of the distance
+      \brief set the position of the center of mother volume in global frame
+    */
+    void SetPosition(GGfloat const& position_x, GGfloat const& position_y, GGfloat const& position_z, std::string const& unit = "mm");
+
+    /*!
+      \fn void SetRotation(GGfloat const& rx, GGfloat const& ry, GGfloat const& rz, std::string const& unit = "deg")
+      \param rx - Rotation around X along local axis
+      \param ry - Rotation around Y along local axis
+      \param rz - Rotation around Z along local axis
+      \param unit - unit of the angle
+      \brief set the rotation of mother volume around local axis
+    */
+    void SetRotation(GGfloat const& rx, GGfloat const& ry, GGfloat const& rz, std::string const& unit = "deg");
+
+    /*!
+      \fn void AddDaughter(std::string const& daughter_name)
+      \param daughter_name - name of a navigator or of another mother volume
+      \brief nest a navigator or a mother volume in this mother volume, daughter has to be inside the box of mother volume
+    */
+    void AddDaughter(std::string const& daughter_name);
+
+    /*!
+      \fn void SetMotherVolume(GGEMSMotherVolume* mother_volume)
+      \param mother_volume - pointer on mother volume containing this mother volume
+      \brief set the mother volume containing this mother volume
+    */
+    void SetMotherVolume(GGEMSMotherVolume* mother_volume);
+
+    /*!
+      \fn inline GGEMSMotherVolume* GetMotherVolume(void) const
+      \return pointer on mother volume containing this mother volume, nullptr if world
+      \brief get the mother volume containing this mother volume
+    */
+    inline GGEMSMotherVolume* GetMotherVolume(void) const {return mother_volume_;}
+
+    /*!
+      \fn inline std::string GetMotherVolumeName(void) const
+      \return name of mother volume
+      \brief get the name of mother volume
+    */
+    inline std::string GetMotherVolumeName(void) const {return mother_volume_name_;}
+
+    /*!
+      \fn void SetSolidID(GGint const& solid_id)
+      \param solid_id - solid index of mother volume
+      \brief set the solid index of mother volume, mother volumes are indexed after solids of navigators
+    */
+    void SetSolidID(GGint const& solid_id);
+
+    /*!
+      \fn inline GGint GetSolidID(void) const
+      \return solid index of mother volume
+      \brief get the solid index of mother volume
+    */
+    inline GGint GetSolidID(void) const {return solid_id_;}
+
+    /*!
+      \fn void EnableTracking(void)
+      \brief Enable tracking during simulation
+    */
+    void EnableTracking(void);
+
+    /*!
+      \fn void Initialize(void)
+      \brief Initialize mother volume data and kernels
+    */
+    void Initialize(void);
+
+    /*!
+      \fn void ParticleSolidDistance(GGsize const& thread_index)
+      \param thread_index - index of activated device (thread index)
+      \brief compute distance to enter or to exit the mother volume
+    */
+    void ParticleSolidDistance(GGsize const& thread_index);
+
+    /*!
+      \fn void ProjectToSolid(GGsize const& thread_index)
+      \param thread_index - index of activated device (thread index)
+      \brief move particles selecting the mother volume across its boundary
+    */
+    void ProjectToSolid(GGsize const& thread_index);
+
+    /*!
+      \fn void PrintInfos(void) const
+      \brief printing infos about mother volume
+    */
+    void PrintInfos(void) const;
+
+  private:
+    /*!
+      \fn void CheckParameters(void) const
+      \brief checking parameters
+    */
+    void CheckParameters(void) const;
+
+    /*!
+      \fn void InitializeKernel(void)
+      \brief Initialize kernels of mother volume
+    */
+    void InitializeKernel(void);
+
+  private:
+    std::string mother_volume_name_; /*!< Name of mother volume */
+    GGfloat3 size_xyz_; /*!< Size of box of mother volume */
+    GGfloat3 position_xyz_; /*!< Position of mother volume in X, Y and Z */
+    GGfloat3 rotation_xyz_; /*!< Rotation of mother volume in X, Y and Z */
+    bool is_update_pos_; /*!< Updating mother volume position */
+    bool is_update_rot_; /*!< Updating mother volume rotation */
+    GGint solid_id_; /*!< Solid index of mother volume */
+    GGEMSMotherVolume* mother_volume_; /*!< Mother volume containing this mother volume, nullptr if world */
+    GGEMSGeometryTransformation* geometry_transformation_; /*!< Position and rotation of mother volume */
+    cl::Buffer** mother_volume_data_; /*!< Data of mother volume on each OpenCL device */
+    cl::Kernel** kernel_particle_solid_distance_; /*!< Kernel computing distance to mother volume */
+    cl::Kernel** kernel_project_to_solid_; /*!< Kernel moving particles across boundary of mother volume */
+    std::string kernel_option_; /*!< Options for kernel compilation */
+    GGsize number_activated_devices_; /*!< Number of activated device */
+};
+
+/*!
+  \fn GGEMSMotherVolume* create_ggems_mother_volume(char const* mother_volume_name)
+  \param mother_volume_name - name of mother volume
+  \return the pointer on the mother volume
+  \brief Get the GGEMSMotherVolume pointer for python user.
+*/
+extern "C" GGEMS_EXPORT GGEMSMotherVolume* create_ggems_mother_volume(char const* mother_volume_name);
+
+/*!
+  \fn void set_size_ggems_mother_volume(GGEMSMotherVolume* mother_volume, GGfloat const size_x, GGfloat const size_y, GGfloat const size_z, char const* unit)
+  \param mother_volume - pointer on mother volume
+  \param size_x - size of mother volume along X
+  \param size_y - size of mother volume along Y
+  \param size_z - size of mother volume along Z
+  \param unit - unit of the distance
+  \brief set the size of the box of mother volume
+*/
+extern "C" GGEMS_EXPORT void set_size_ggems_mother_volume(GGEMSMotherVolume* mother_volume, GGfloat const size_x, GGfloat const size_y, GGfloat const size_z, char const* unit);
+
+/*!
+  \fn void set_position_ggems_mother_volume(GGEMSMotherVolume* mother_volume, GGfloat const position_x, GGfloat const position_y, GGfloat const position_z, char const* unit)
+  \param mother_volume - pointer on mother volume
+  \param position_x - offset in X
+  \param position_y - offset in Y
+  \param position_z - offset in Z
+  \param unit - unit of the distance
+  \brief set the position of the mother volume in X, Y and Z
+*/
+extern "C" GGEMS_EXPORT void set_position_ggems_mother_volume(GGEMSMotherVolume* mother_volume, GGfloat const position_x, GGfloat const position_y, GGfloat const position_z, char const* unit);
+
+/*!
+  \fn void set_rotation_ggems_mother_volume(GGEMSMotherVolume* mother_volume, GGfloat const rx, GGfloat const ry, GGfloat const rz, char const* unit)
+  \param mother_volume - pointer on mother volume
+  \param rx - Rotation around X along local axis
+  \param ry - Rotation around Y along local axis
+  \param rz - Rotation around Z along local axis
+  \param unit - unit of the angle
+  \brief Set the rotation of the mother volume around local axis
+*/
+extern "C" GGEMS_EXPORT void set_rotation_ggems_mother_volume(GGEMSMotherVolume* mother_volume, GGfloat const rx, GGfloat const ry, GGfloat const rz, char const* unit);
+
+/*!
+  \fn void add_daughter_ggems_mother_volume(GGEMSMotherVolume* mother_volume, char const* daughter_name)
+  \param mother_volume - pointer on mother volume
+  \param daughter_name - name of navigator or mother volume
+  \brief nest a navigator or a mother volume in mother volume
+*/
+extern "C" GGEMS_EXPORT void add_daughter_ggems_mother_volume(GGEMSMotherVolume* mother_volume, char const* daughter_name);
+
+#endif // End of GUARD_GGEMS_NAVIGATORS_GGEMSMOTHERVOLUME_HH
@@ -46,6 +46,8 @@ class GGEMSSolid;
 class GGEMSMaterials;
 class GGEMSCrossSections;
 class GGEMSDosimetryCalculator;
+class GGEMSPhaseSpace;
+class GGEMSMotherVolume;
 
 /*!
   \class GGEMSNavigator
@@ -174,14 +176,14 @@ class GGEMS_EXPORT GGEMSNavigator
     /*!
       \fn void ProjectToSolid(GGsize const& thread_index)
       \param thread_index - index of activated device (thread index)
-      \brief Project particle to entry of closest solid
+      \brief Project particle to entry of closest solid, kernels are launched on navigation queue without waiting
     */
     void ProjectToSolid(GGsize const& thread_index);
 
     /*!
       \fn void TrackThroughSolid(GGsize const& thread_index)
       \param thread_index - index of activated device (thread index)
-      \brief Move particle through solid
+      \brief Move particle through solid, kernels are launched on navigation queue without waiting
     */
     void TrackThroughSolid(GGsize const& thread_index);
 
@@ -203,6 +205,22 @@ class GGEMS_EXPORT GGEMSNavigator
     */
     virtual void SaveResults(void) = 0;
 
+    /*!
+      \fn GGfloat GetMinimumEnergyCut(void) const
+      \return minimum energy of a photon tracked by navigator
+      \brief get the energy under which every photon is killed by navigator, energy threshold by default
+    */
+    virtual GGfloat GetMinimumEnergyCut(void) const;
+
+    /*!
+      \fn void UpdateMotionPhase(GGsize const& thread_index, GGsize const& batch_index, GGsize const& number_of_batchs)
+      \param thread_index - index of activated device (thread index)
+      \param batch_index - index of the batch in the run, counted over all sources
+      \param number_of_batchs - number of batchs of all sources on the device
+      \brief select the geometry of the navigator for a batch, nothing done by default
+    */
+    virtual void UpdateMotionPhase(GGsize const&, GGsize const&, GGsize const&) {}
+
     /*!
       \fn void ComputeDose(GGsize const& thread_index)
       \param thread_index - index of activated device (thread index)
@@ -210,6 +228,21 @@ class GGEMS_EXPORT GGEMSNavigator
     */
     void ComputeDose(GGsize const& thread_index);
 
+    /*!
+      \fn void CountHistories(GGsize const& thread_index, GGsize const& number_of_histories)
+      \param thread_index - index of activated device (thread index)
+      \param number_of_histories - number of histories simulated in batch
+      \brief Count histories simulated in batch, useful for history by history uncertainty
+    */
+    void CountHistories(GGsize const& thread_index, GGsize const& number_of_histories);
+
+    /*!
+      \fn void StorePhaseSpace(GGsize const& thread_index)
+      \param thread_index - index of activated device (thread index)
+      \brief Store particles exiting the navigator during the batch in phase space file, if phase space is activated
+    */
+    void StorePhaseSpace(GGsize const& thread_index);
+
     /*!
       \fn void StoreOutput(std::string basename)
       \param basename - basename of the output file
@@ -224,6 +257,20 @@ class GGEMS_EXPORT GGEMSNavigator
     */
     void SetDosimetryCalculator(GGEMSDosimetryCalculator* dosimetry_calculator);
 
+    /*!
+      \fn void SetMotherVolume(GGEMSMotherVolume* mother_volume)
+      \param mother_volume - pointer on mother volume containing the navigator
+      \brief set the mother volume of navigator, solids of navigator are only tested by particles in this mother volume
+    */
+    void SetMotherVolume(GGEMSMotherVolume* mother_volume);
+
+    /*!
+      \fn inline GGEMSMotherVolume* GetMotherVolume(void) const
+      \return pointer on mother volume, nullptr if navigator is in world
+      \brief get the mother volume of navigator
+    */
+    inline GGEMSMotherVolume* GetMotherVolume(void) const {return mother_volume_;}
+
     /*!
       \fn void EnableTracking(void)
       \brief Enable tracking during simulation
@@ -237,6 +284,13 @@ class GGEMS_EXPORT GGEMSNavigator
     */
     void EnableTLE(bool const& is_activated);
 
+    /*!
+      \fn void EnableCSDA(bool const& is_activated)
+      \param is_activated - bool activating or not CSDA deposition of secondary electrons
+      \brief Enable deposition of secondary electrons along their CSDA range during particle navigation
+    */
+    void EnableCSDA(bool const& is_activated);
+
     /*!
       \fn void SetVisible(bool const& is_visible)
       \param is_visible - true if navigator is drawn using OpenGL
@@ -303,8 +357,17 @@ class GGEMS_EXPORT GGEMSNavigator
     GGEMSDosimetryCalculator* dose_calculator_; /*!< Dose calculator pointer */
     bool is_dosimetry_mode_; /*!< Boolean checking if dosimetry mode is activated */
     bool is_tle_;  /*!< Boolean checking if tle mode is activated */
+    bool is_csda_; /*!< Boolean checking if CSDA deposition of secondary electrons is activated */
     GGsize number_activated_devices_; /*!< Number of activated device */
 
+    // Phase space
+    GGEMSPhaseSpace* phase_space_; /*!< Phase space recording particles exiting the navigator, nullptr if not activated */
+
+    // Geometry tree
+    GGEMSMotherVolume* mother_volume_; /*!< Mother volume containing the navigator, nullptr if world */
+    bool is_candidate_search_; /*!< Solids of navigator have neighbours, neighbours of exited solid are tested first (solid box only) */
+    cl::Buffer** fallback_search_; /*!< Flag set on device if a particle hit no neighbour of its exited solid, fallback pass is launched only in this case */
+
     // OpenGL
     bool is_visible_; /*!< flag for opengl */
     MaterialRGBColorUMap custom_material_rgb_; /*!< Custom color for material */
@@ -33,6 +33,7 @@
 
 #include "GGEMS/navigators/GGEMSNavigator.hh"
 #include "GGEMS/navigators/GGEMSWorld.hh"
+#include "GGEMS/navigators/GGEMSMotherVolume.hh"
 
 /*!
   \class GGEMSNavigatorManager
@@ -106,11 +107,34 @@ class GGEMS_EXPORT GGEMSNavigatorManager
     void StoreWorld(GGEMSWorld* world);
 
     /*!
-      \fn void Initialize(bool const& is_tracking = false) const
+      \fn void StoreMotherVolume(GGEMSMotherVolume* mother_volume)
+      \param mother_volume - pointer to GGEMS mother volume
+      \brief storing the mother volume pointer to navigator manager
+    */
+    void StoreMotherVolume(GGEMSMotherVolume* mother_volume);
+
+    /*!
+      \fn void Initialize(bool const& is_tracking = false)
       \param is_tracking - flag activating tracking
       \brief Initialize a GGEMS navigators
     */
-    void Initialize(bool const& is_tracking = false) const;
+    void Initialize(bool const& is_tracking = false);
+
+    /*!
+      \fn GGfloat GetMinimumEnergyCut(void) const
+      \return minimum energy cut of the scene
+      \brief get the minimum of energy cut over all navigators, a photon under this energy is killed by any navigator
+    */
+    GGfloat GetMinimumEnergyCut(void) const;
+
+    /*!
+      \fn void UpdateMotionPhase(GGsize const& thread_index, GGsize const& batch_index, GGsize const& number_of_batchs) const
+      \param thread_index - index of activated device (thread index)
+      \param batch_index - index of the batch in the run, counted over all sources
+      \param number_of_batchs - number of batchs of all sources on the device
+      \brief select the motion phase of each navigator for the batch
+    */
+    void UpdateMotionPhase(GGsize const& thread_index, GGsize const& batch_index, GGsize const& number_of_batchs) const;
 
     /*!
       \fn void PrintInfos(void)
@@ -150,6 +174,23 @@ class GGEMS_EXPORT GGEMSNavigatorManager
       return nullptr;
     }
 
+    /*!
+      \fn inline GGEMSMotherVolume* GetMotherVolume(std::string const& mother_volume_name) const
+      \param mother_volume_name - name of the mother volume
+      \return the mother volume by the name, nullptr if the name is unknown
+      \brief get the mother volume by the name
+    */
+    inline GGEMSMotherVolume* GetMotherVolume(std::string const& mother_volume_name) const
+    {
+      // Loop over the mother volumes
+      for (GGsize i = 0; i < number_of_mother_volumes_; ++i) {
+        if (mother_volume_name == mother_volumes_[i]->GetMotherVolumeName()) {
+          return mother_volumes_[i];
+        }
+      }
+      return nullptr;
+    }
+
     /*!
       \fn inline GGsize GetNumberOfRegisteredSolids(void) const
       \brief get the number of current registered solid
@@ -176,7 +217,7 @@ class GGEMS_EXPORT GGEMSNavigatorManager
     /*!
       \fn void ProjectToSolid(GGsize const& thread_index) const
       \param thread_index - index of activated device (thread index)
-      \brief Project particle to selected solid
+      \brief Project particle to selected solid, particles without solid are killed once before projection kernels of navigators
     */
     void ProjectToSolid(GGsize const& thread_index) const;
 
@@ -207,6 +248,21 @@ class GGEMS_EXPORT GGEMSNavigatorManager
     */
     void ComputeDose(GGsize const& thread_index);
 
+    /*!
+      \fn void CountHistories(GGsize const& thread_index, GGsize const& number_of_histories)
+      \param thread_index - index of activated device (thread index)
+      \param number_of_histories - number of histories simulated in batch
+      \brief Count histories simulated in batch for each navigator
+    */
+    void CountHistories(GGsize const& thread_index, GGsize const& number_of_histories);
+
+    /*!
+      \fn void StorePhaseSpace(GGsize const& thread_index) const
+      \param thread_index - index of activated device (thread index)
+      \brief Store particles exiting navigators in phase space after a batch
+    */
+    void StorePhaseSpace(GGsize const& thread_index) const;
+
     /*!
       \fn void Clean(void)
       \brief clean OpenCL data if necessary
@@ -217,6 +273,9 @@ class GGEMS_EXPORT GGEMSNavigatorManager
     GGEMSNavigator** navigators_; /*!< Pointer on the navigators */
     GGsize number_of_navigators_; /*!< Number of navigators */
     GGEMSWorld* world_; /*!< Pointer on world volume */
+    GGEMSMotherVolume** mother_volumes_; /*!< Pointer on the mother volumes */
+    GGsize number_of_mother_volumes_; /*!< Number of mother volumes */
+    cl::Kernel** kernel_prepare_project_to_solid_; /*!< OpenCL kernel killing particles without solid, launched once before projection kernels of navigators */
 };
 
 #endif // End of GUARD_GGEMS_NAVIGATORS_GGEMSNAVIGATORMANAGER_HH
@@ -37,6 +37,14 @@
 
 #include "GGEMS/randoms/GGEMSKissEngine.hh"
 
+#ifdef PHYSICS_LIBRARY
+
+// Photon navigation and physics models are compiled once in physics library (GGEMSPhysicsLibrary.cl) and linked to kernel
+void GetPhotonNextInteraction(global GGEMSPrimaryParticles* primary_particle, global GGEMSRandom* random, global GGEMSParticleCrossSections const* particle_cross_sections, GGuchar const index_material, GGint const particle_id);
+void PhotonDiscreteProcess(global GGEMSPrimaryParticles* primary_particle, global GGEMSRandom* random, global GGEMSMaterialTables const* materials, global GGEMSParticleCrossSections const* particle_cross_sections, GGuchar const material_id, GGint const particle_id);
+
+#else
+
 #include "GGEMS/physics/GGEMSComptonScatteringModels.hh"
 #include "GGEMS/physics/GGEMSRayleighScatteringModels.hh"
 #include "GGEMS/physics/GGEMSPhotoElectricEffectModels.hh"
@@ -132,4 +140,6 @@ inline void PhotonDiscreteProcess(
 
 #endif
 
+#endif
+
 #endif // GUARD_GGEMS_NAVIGATORS_GGEMSPHOTONNAVIGATOR_HH
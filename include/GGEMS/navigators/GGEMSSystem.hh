@@ -36,6 +36,8 @@
 
 #include "GGEMS/navigators/GGEMSNavigator.hh"
 
+class GGEMSSinogram;
+
 /*!
   \class GGEMSSystem
   \brief Child GGEMS class managing detector system in GGEMS
@@ -133,6 +135,23 @@ class GGEMS_EXPORT GGEMSSystem : public GGEMSNavigator
     */
     void SetGlobalSystemPosition(GGfloat const& global_system_position_x, GGfloat const& global_system_position_y, GGfloat const& global_system_position_z, std::string const& unit = "mm");
 
+    /*!
+      \fn void SetSinogram(GGsize const& number_of_views)
+      \param number_of_views - number of views in acquisition
+      \brief store each saved view in a single sinogram file (basename.sino) instead of a MHD file per view
+    */
+    void SetSinogram(GGsize const& number_of_views);
+
+    /*!
+      \fn void SetView(GGfloat const& view_angle, GGfloat const& table_position, std::string const& angle_unit = "deg", std::string const& distance_unit = "mm")
+      \param view_angle - angle of gantry for the next saved view
+      \param table_position - position of table for the next saved view
+      \param angle_unit - unit of the angle
+      \param distance_unit - unit of the distance
+      \brief set the parameters of the next view stored in sinogram index
+    */
+    void SetView(GGfloat const& view_angle, GGfloat const& table_position, std::string const& angle_unit = "deg", std::string const& distance_unit = "mm");
+
     /*!
       \fn void SaveResults(void) override
       \brief save all results from solid
@@ -146,12 +165,34 @@ class GGEMS_EXPORT GGEMSSystem : public GGEMSNavigator
     */
     virtual void CheckParameters(void) const override;
 
+  private:
+    /*!
+      \fn void GetDetectorCounts(GGint* output, bool const& is_scatter_counts, bool const& is_reset)
+      \param output - host buffer (X*Y elements, or X*Y elements per scatter category for scatter) where counts of all solids and devices are added
+      \param is_scatter_counts - true to read scatter histograms of all scatter categories
+      \param is_reset - true to reset histograms on device after reading
+      \brief get the counts of detector from all the solids and all the OpenCL devices
+    */
+    void GetDetectorCounts(GGint* output, bool const& is_scatter_counts, bool const& is_reset);
+
+    /*!
+      \fn void WriteDetectorImage(GGint* counts, std::string const& suffix) const
+      \param counts - counts of detector (X*Y*Z elements)
+      \param suffix - suffix added to output basename, empty for the output basename
+      \brief write counts of detector in a MHD file
+    */
+    void WriteDetectorImage(GGint* counts, std::string const& suffix) const;
+
   protected:
     GGsize2 number_of_modules_xy_; /*!< Number of the detection modules */
     GGsize3 number_of_detection_elements_inside_module_xyz_; /*!< Number of virtual elements (X,Y,Z) in a module */
     GGfloat3 size_of_detection_elements_xyz_; /*!< Size of pixel in each direction */
     bool is_scatter_; /*!< Boolean storing scatter infos */
     GGfloat3 global_system_position_xyz_; /*!< Global position of the system in X, Y and Z */
+    GGEMSSinogram* sinogram_; /*!< Sinogram storing all the views, nullptr if a MHD file is written */
+    GGsize number_of_views_; /*!< Number of views in sinogram */
+    GGfloat view_angle_; /*!< Angle of next saved view */
+    GGfloat table_position_; /*!< Table position of next saved view */
 };
 
 #endif // End of GUARD_GGEMS_SYSTEMS_GGEMSSYSTEM_HH
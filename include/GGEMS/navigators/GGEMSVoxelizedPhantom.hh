@@ -86,6 +86,47 @@ class GGEMS_EXPORT GGEMSVoxelizedPhantom : public GGEMSNavigator
     */
     void SetPhantomFile(std::string const& voxelized_phantom_filename, std::string const& range_data_filename);
 
+    /*!
+      \fn void SetPhaseSpace(std::string const& phase_space_filename)
+      \param phase_space_filename - name of phase space file
+      \brief record particles exiting the phantom in a phase space file, the file can be replayed by a GGEMSPhaseSpaceSource. Phantom has to be simulated without detector, so particles do not come back in phantom
+    */
+    void SetPhaseSpace(std::string const& phase_space_filename);
+
+    /*!
+      \fn void AddMotionPhase(std::string const& voxelized_phantom_filename, GGfloat const& tx, GGfloat const& ty, GGfloat const& tz, std::string const& unit = "mm")
+      \param voxelized_phantom_filename - MHD filename of the motion phase
+      \param tx - translation in X of the motion phase relative to first phase
+      \param ty - translation in Y of the motion phase relative to first phase
+      \param tz - translation in Z of the motion phase relative to first phase
+      \param unit - unit of the distance
+      \brief add a motion phase to the phantom (4D phantom), first phase is the phantom file. Phase has the same grid and range data file than first phase
+    */
+    void AddMotionPhase(std::string const& voxelized_phantom_filename, GGfloat const& tx, GGfloat const& ty, GGfloat const& tz, std::string const& unit = "mm");
+
+    /*!
+      \fn void SetMotionPhase(GGsize const& motion_phase)
+      \param motion_phase - index of motion phase, 0 for the phantom file
+      \brief select the motion phase used by the next run
+    */
+    void SetMotionPhase(GGsize const& motion_phase);
+
+    /*!
+      \fn void SetMotionCycles(GGfloat const& number_of_cycles)
+      \param number_of_cycles - number of motion cycles during a run, 0 to keep the selected phase
+      \brief motion phase is selected per batch from its time in the run, all phases are crossed number_of_cycles times
+    */
+    void SetMotionCycles(GGfloat const& number_of_cycles);
+
+    /*!
+      \fn void UpdateMotionPhase(GGsize const& thread_index, GGsize const& batch_index, GGsize const& number_of_batchs) override
+      \param thread_index - index of activated device (thread index)
+      \param batch_index - index of the batch in the run, counted over all sources
+      \param number_of_batchs - number of batchs of all sources on the device
+      \brief select the motion phase of the batch if motion cycles are set
+    */
+    void UpdateMotionPhase(GGsize const& thread_index, GGsize const& batch_index, GGsize const& number_of_batchs) override;
+
     /*!
       \fn void Initialize(void) override
       \brief Initialize the voxelized phantom
@@ -98,6 +139,13 @@ class GGEMS_EXPORT GGEMSVoxelizedPhantom : public GGEMSNavigator
     */
     void SaveResults(void) override;
 
+    /*!
+      \fn GGfloat GetMinimumEnergyCut(void) const override
+      \return minimum energy of a photon tracked by voxelized phantom
+      \brief get the minimum of photon energy cut over materials of phantom
+    */
+    GGfloat GetMinimumEnergyCut(void) const override;
+
   private:
     /*!
       \fn void CheckParameters(void) const override
@@ -108,6 +156,11 @@ class GGEMS_EXPORT GGEMSVoxelizedPhantom : public GGEMSNavigator
   private:
     std::string voxelized_phantom_filename_; /*!< MHD file storing the voxelized phantom */
     std::string range_data_filename_; /*!< File for label to material matching */
+    std::string phase_space_filename_; /*!< Phase space file storing particles exiting phantom, empty if no phase space */
+    std::vector<std::string> motion_phase_filenames_; /*!< MHD files of motion phases after first phase */
+    std::vector<GGfloat3> motion_phase_translations_; /*!< Translation of motion phases after first phase */
+    GGsize motion_phase_; /*!< Motion phase selected by user */
+    GGfloat number_of_motion_cycles_; /*!< Number of motion cycles during a run, 0 if phase is selected by user */
 };
 
 /*!
@@ -127,6 +180,42 @@ extern "C" GGEMS_EXPORT GGEMSVoxelizedPhantom* create_ggems_voxelized_phantom(ch
 */
 extern "C" GGEMS_EXPORT void set_phantom_file_ggems_voxelized_phantom(GGEMSVoxelizedPhantom* voxelized_phantom, char const* phantom_filename, char const* range_data_filename);
 
+/*!
+  \fn void set_phase_space_ggems_voxelized_phantom(GGEMSVoxelizedPhantom* voxelized_phantom, char const* phase_space_filename)
+  \param voxelized_phantom - pointer on voxelized phantom
+  \param phase_space_filename - name of phase space file
+  \brief record particles exiting the voxelized phantom in a phase space file
+*/
+extern "C" GGEMS_EXPORT void set_phase_space_ggems_voxelized_phantom(GGEMSVoxelizedPhantom* voxelized_phantom, char const* phase_space_filename);
+
+/*!
+  \fn void add_motion_phase_ggems_voxelized_phantom(GGEMSVoxelizedPhantom* voxelized_phantom, char const* phantom_filename, GGfloat const tx, GGfloat const ty, GGfloat const tz, char const* unit)
+  \param voxelized_phantom - pointer on voxelized phantom
+  \param phantom_filename - filename of the motion phase
+  \param tx - translation in X of the motion phase
+  \param ty - translation in Y of the motion phase
+  \param tz - translation in Z of the motion phase
+  \param unit - unit of the distance
+  \brief add a motion phase to the voxelized phantom
+*/
+extern "C" GGEMS_EXPORT void add_motion_phase_ggems_voxelized_phantom(GGEMSVoxelizedPhantom* voxelized_phantom, char const* phantom_filename, GGfloat const tx, GGfloat const ty, GGfloat const tz, char const* unit);
+
+/*!
+  \fn void set_motion_phase_ggems_voxelized_phantom(GGEMSVoxelizedPhantom* voxelized_phantom, GGsize const motion_phase)
+  \param voxelized_phantom - pointer on voxelized phantom
+  \param motion_phase - index of motion phase
+  \brief select the motion phase of the voxelized phantom
+*/
+extern "C" GGEMS_EXPORT void set_motion_phase_ggems_voxelized_phantom(GGEMSVoxelizedPhantom* voxelized_phantom, GGsize const motion_phase);
+
+/*!
+  \fn void set_motion_cycles_ggems_voxelized_phantom(GGEMSVoxelizedPhantom* voxelized_phantom, GGfloat const number_of_cycles)
+  \param voxelized_phantom - pointer on voxelized phantom
+  \param number_of_cycles - number of motion cycles during a run
+  \brief select the motion phase per batch from its time in the run
+*/
+extern "C" GGEMS_EXPORT void set_motion_cycles_ggems_voxelized_phantom(GGEMSVoxelizedPhantom* voxelized_phantom, GGfloat const number_of_cycles);
+
 /*!
   \fn void set_position_ggems_voxelized_phantom(GGEMSVoxelizedPhantom* voxelized_phantom, GGfloat const position_x, GGfloat const position_y, GGfloat const position_z, char const* unit)
   \param voxelized_phantom - pointer on voxelized phantom
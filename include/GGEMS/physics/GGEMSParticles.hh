@@ -115,11 +115,18 @@ class GGEMS_EXPORT GGEMSParticles
     */
     inline GGsize GetNumberOfParticles(GGsize const& thread_index) const {return number_of_particles_[thread_index];}
 
+    /*!
+      \fn void SetEnergyCut(GGfloat const& energy_cut)
+      \param energy_cut - minimum energy cut of the scene
+      \brief Set the energy under which alive photons are killed before transport
+    */
+    void SetEnergyCut(GGfloat const& energy_cut);
+
     /*!
       \fn bool IsAlive(GGsize const& thread_index) const
       \param thread_index - index of activated device (thread index)
       \return true if source is still alive, otherwize false
-      \brief check if some particles are alive in OpenCL particle buffer
+      \brief check if some particles are alive in OpenCL particle buffer, photons under energy cut are killed
     */
     bool IsAlive(GGsize const& thread_index) const;
 
@@ -149,6 +156,7 @@ class GGEMS_EXPORT GGEMSParticles
     cl::Buffer** status_; /*!< Buffer storing status of particle */
     GGsize number_activated_devices_; /*!< Number of activated device */
     cl::Kernel** kernel_alive_; /*!< Kernel checking if particles are alive */
+    GGfloat energy_cut_; /*!< Minimum energy cut of the scene, photons under this energy are killed */
 };
 
 #endif // End of GUARD_GGEMS_PHYSICS_GGEMSPARTICLES_HH
@@ -50,10 +50,13 @@ typedef struct GGEMSPrimaryParticles_t
   GGfloat px_[MAXIMUM_PARTICLES]; /*!< Position of the particle in x */
   GGfloat py_[MAXIMUM_PARTICLES]; /*!< Position of the particle in y */
   GGfloat pz_[MAXIMUM_PARTICLES]; /*!< Position of the particle in z */
-  GGchar scatter_[MAXIMUM_PARTICLES]; /*!< Index of scattered photon */
+  GGuchar scatter_history_[MAXIMUM_PARTICLES]; /*!< Scatter history code of photon, Compton count in low 4 bits and Rayleigh count in high 4 bits */
 
   GGint E_index_[MAXIMUM_PARTICLES]; /*!< Energy index within CS and Mat tables */
   GGint solid_id_[MAXIMUM_PARTICLES]; /*!< current solid crossed by the particle */
+  GGint mother_id_[MAXIMUM_PARTICLES]; /*!< Solid index of mother volume containing the particle, -1 if world */
+  GGint exited_solid_id_[MAXIMUM_PARTICLES]; /*!< Solid exited at last step, its neighbours are candidates of next closest solid search, -1 if none */
+  GGchar is_candidate_hit_[MAXIMUM_PARTICLES]; /*!< Flag set if a candidate solid is hit, other solids are not tested */
 
   GGfloat particle_solid_distance_[MAXIMUM_PARTICLES]; /*!< Distance from previous position to next position, OUT_OF_WORLD if no next position */
   GGfloat next_interaction_distance_[MAXIMUM_PARTICLES]; /*!< Distance to the next interaction */
@@ -63,6 +63,11 @@ __constant GGfloat ATTENUATION_ENERGY_MIN = 0.001f; /*!< Min energy for attenuat
 __constant GGfloat ATTENUATION_ENERGY_MAX = 1.0f; /*!< Max energy for attenuation is 1 MeV */
 #define ATTENUATION_TABLE_NUMBER_BINS 220 /*!< Number of bins in attenuation table */
 
+// CSDA RANGE
+__constant GGfloat CSDA_RANGE_ENERGY_MIN = 990.0f*1.e-6f; /*!< Min energy in the electron CSDA range table, 990 eV */
+__constant GGfloat CSDA_RANGE_ENERGY_MAX = 250.0f*1.0f; /*!< Max energy in the electron CSDA range table, 250 MeV */
+#define CSDA_RANGE_TABLE_NUMBER_BINS 64 /*!< Number of bins in electron CSDA range table */
+
 // CUTS
 __constant GGfloat PHOTON_DISTANCE_CUT = 1.e-3f; /*!< Photon cut, 1 um */
 __constant GGfloat ELECTRON_DISTANCE_CUT = 1.e-3f; /*!< Electron cut, 1 um */
@@ -193,6 +193,14 @@ class GGEMS_EXPORT GGEMSRangeCuts
     */
     void BuildMaterialLossTable(GGEMSMaterialTables* material_table, GGushort const& index_mat);
 
+    /*!
+      \fn void StoreElectronCSDARange(GGEMSMaterialTables* material_table, GGushort const& index_mat) const
+      \param material_table - material table on OpenCL device
+      \param index_mat - index of the material
+      \brief Store the electron CSDA range table of material, computed from electron loss table, on OpenCL device
+    */
+    void StoreElectronCSDARange(GGEMSMaterialTables* material_table, GGushort const& index_mat) const;
+
     /*!
       \fn GGfloat ComputePhotonCrossSection(GGuchar const& atomic_number, GGfloat const& energy) const
       \param atomic_number - atomic number of the elements
@@ -0,0 +1,83 @@
+#ifndef GUARD_GGEMS_PHYSICS_GGEMSSCATTERHISTORY_HH
+#define GUARD_GGEMS_PHYSICS_GGEMSSCATTERHISTORY_HH
+
+// ************************************************************************
+// * This file is part of GGEMS.                                          *
+// *                                                                      *
+// * GGEMS is free software: you can redistribute it and/or modify        *
+// * it under the terms of the GNU General Public License as published by *
+// * the Free Software Foundation, either version 3 of the License, or    *
+// * (at your option) any later version.                                  *
+// *                                                                      *
+// * GGEMS is distributed in the hope that it will be useful,             *
+// * but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+// * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+// * GNU General Public License for more details.                         *
+// *                                                                      *
+// * You should have received a copy of the GNU General Public License    *
+// * along with GGEMS.  If not, see <https://www.gnu.org/licenses/>.      *
+// *                                                                      *
+// ************************************************************************
+
+/*!
+  \file GGEMSScatterHistory.hh
+
+  \brief Compact scatter history code of photon, number of Compton scatterings in low 4 bits and number of Rayleigh scatterings in high 4 bits
+
+  \author Julien BERT <julien.bert@univ-brest.fr>
+  \author Didier BENOIT <didier.benoit@inserm.fr>
+  \author LaTIM, INSERM - U1101, Brest, FRANCE
+  \version 1.0
+  \date Sunday October 18, 2026
+*/
+
+#include "GGEMS/physics/GGEMSProcessConstants.hh"
+
+#define NUMBER_OF_SCATTER_CATEGORIES 3 /*!< Number of scatter categories scored in detector */
+__constant GGchar SINGLE_COMPTON = 0; /*!< Photon scattered once by Compton */
+__constant GGchar SINGLE_RAYLEIGH = 1; /*!< Photon scattered once by Rayleigh */
+__constant GGchar MULTIPLE_SCATTER = 2; /*!< Photon scattered more than once */
+
+__constant GGuchar NO_SCATTER = 0; /*!< Scatter history of a primary photon */
+__constant GGuchar SCATTER_COUNT_MAX = 15; /*!< Saturation of scatter counts on 4 bits */
+
+#ifdef __OPENCL_C_VERSION__
+
+/*!
+  \fn inline GGuchar UpdateScatterHistory(GGuchar const scatter_history, GGchar const process)
+  \param scatter_history - current scatter history code
+  \param process - discrete process resolved
+  \return updated scatter history code
+  \brief increment Compton or Rayleigh count in scatter history code, counts saturate to 15
+*/
+inline GGuchar UpdateScatterHistory(GGuchar const scatter_history, GGchar const process)
+{
+  GGuchar compton_count = scatter_history & 0x0F;
+  GGuchar rayleigh_count = scatter_history >> 4;
+
+  if (process == COMPTON_SCATTERING && compton_count < SCATTER_COUNT_MAX) ++compton_count;
+  if (process == RAYLEIGH_SCATTERING && rayleigh_count < SCATTER_COUNT_MAX) ++rayleigh_count;
+
+  return (GGuchar)(compton_count | (rayleigh_count << 4));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+/*!
+  \fn inline GGchar GetScatterCategory(GGuchar const scatter_history)
+  \param scatter_history - scatter history code of a scattered photon
+  \return scatter category (SINGLE_COMPTON, SINGLE_RAYLEIGH or MULTIPLE_SCATTER)
+  \brief get the scatter category from scatter history code, history code has to be different of NO_SCATTER
+*/
+inline GGchar GetScatterCategory(GGuchar const scatter_history)
+{
+  if (scatter_history == 0x01) return SINGLE_COMPTON;
+  if (scatter_history == 0x10) return SINGLE_RAYLEIGH;
+  return MULTIPLE_SCATTER;
+}
+
+#endif
+
+#endif // End of GUARD_GGEMS_PHYSICS_GGEMSSCATTERHISTORY_HH
@@ -0,0 +1,176 @@
+#ifndef GUARD_GGEMS_SOURCES_GGEMSPHASESPACESOURCE_HH
+#define GUARD_GGEMS_SOURCES_GGEMSPHASESPACESOURCE_HH
+
+// ************************************************************************
+// * This file is part of GGEMS.                                          *
+// *                                                                      *
+// * GGEMS is free software: you can redistribute it and/or modify        *
+// * it under the terms of the GNU General Public License as published by *
+// * the Free Software Foundation, either version 3 of the License, or    *
+// * (at your option) any later version.                                  *
+// *                                                                      *
+// * GGEMS is distributed in the hope that it will be useful,             *
+// * but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+// * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+// * GNU General Public License for more details.                         *
+// *                                                                      *
+// * You should have received a copy of the GNU General Public License    *
+// * along with GGEMS.  If not, see <https://www.gnu.org/licenses/>.      *
+// *                                                                      *
+// ************************************************************************
+
+/*!
+  \file GGEMSPhaseSpaceSource.hh
+
+  \brief This class define a source replaying particles stored in a GGEMS phase space file
+
+  \author Julien BERT <julien.bert@univ-brest.fr>
+  \author Didier BENOIT <didier.benoit@inserm.fr>
+  \author LaTIM, INSERM - U1101, Brest, FRANCE
+  \version 1.0
+  \date Sunday October 18, 2026
+*/
+
+#include "GGEMS/sources/GGEMSSource.hh"
+
+class GGEMSPhaseSpace;
+
+/*!
+  \class GGEMSPhaseSpaceSource
+  \brief This class define a source replaying particles stored in a GGEMS phase space file. Particles recorded at the exit of a phantom are read in file order and sent to the navigators, position and direction are transformed by the source position and rotation
+*/
+class GGEMS_EXPORT GGEMSPhaseSpaceSource : public GGEMSSource
+{
+  public:
+    /*!
+      \param source_name - name of the source
+      \brief GGEMSPhaseSpaceSource constructor
+    */
+    explicit GGEMSPhaseSpaceSource(std::string const& source_name);
+
+    /*!
+      \brief GGEMSPhaseSpaceSource destructor
+    */
+    ~GGEMSPhaseSpaceSource(void) override;
+
+    /*!
+      \fn GGEMSPhaseSpaceSource(GGEMSPhaseSpaceSource const& phase_space_source) = delete
+      \param phase_space_source - reference on the GGEMS phase space source
+      \brief Avoid copy by reference
+    */
+    GGEMSPhaseSpaceSource(GGEMSPhaseSpaceSource const& phase_space_source) = delete;
+
+    /*!
+      \fn GGEMSPhaseSpaceSource& operator=(GGEMSPhaseSpaceSource const& phase_space_source) = delete
+      \param phase_space_source - reference on the GGEMS phase space source
+      \brief Avoid assignement by reference
+    */
+    GGEMSPhaseSpaceSource& operator=(GGEMSPhaseSpaceSource const& phase_space_source) = delete;
+
+    /*!
+      \fn GGEMSPhaseSpaceSource(GGEMSPhaseSpaceSource const&& phase_space_source) = delete
+      \param phase_space_source - rvalue reference on the GGEMS phase space source
+      \brief Avoid copy by rvalue reference
+    */
+    GGEMSPhaseSpaceSource(GGEMSPhaseSpaceSource const&& phase_space_source) = delete;
+
+    /*!
+      \fn GGEMSPhaseSpaceSource& operator=(GGEMSPhaseSpaceSource const&& phase_space_source) = delete
+      \param phase_space_source - rvalue reference on the GGEMS phase space source
+      \brief Avoid copy by rvalue reference
+    */
+    GGEMSPhaseSpaceSource& operator=(GGEMSPhaseSpaceSource const&& phase_space_source) = delete;
+
+    /*!
+      \fn void SetPhaseSpaceFile(std::string const& phase_space_filename)
+      \param phase_space_filename - name of phase space file
+      \brief set the phase space file to replay
+    */
+    void SetPhaseSpaceFile(std::string const& phase_space_filename);
+
+    /*!
+      \fn void Initialize(bool const& is_tracking = false)
+      \param is_tracking - flag activating tracking
+      \brief Initialize a GGEMS source
+    */
+    void Initialize(bool const& is_tracking = false) override;
+
+    /*!
+      \fn void PrintInfos(void) const
+      \brief Printing infos about the source
+    */
+    void PrintInfos(void) const override;
+
+    /*!
+      \fn void GetPrimaries(GGsize const& thread_index, GGsize const& number_of particles)
+      \param thread_index - index of activated device (thread index)
+      \param number_of_particles - number of particles to generate
+      \brief Generate primary particles
+    */
+    void GetPrimaries(GGsize const& thread_index, GGsize const& number_of_particles) override;
+
+  private:
+    /*!
+      \fn void InitializeKernel(void)
+      \brief Initialize kernel for specific source in OpenCL
+    */
+    void InitializeKernel(void) override;
+
+    /*!
+      \fn void CheckParameters(void) const
+      \brief Check mandatory parameters for a source
+    */
+    void CheckParameters(void) const override;
+
+  private: // Specific members for GGEMSPhaseSpaceSource
+    std::string phase_space_filename_; /*!< Name of phase space file */
+    GGEMSPhaseSpace* phase_space_; /*!< Phase space read batch by batch */
+};
+
+/*!
+  \fn GGEMSPhaseSpaceSource* create_ggems_phase_space_source(char const* source_name)
+  \return the pointer on the source
+  \param source_name - name of the source
+  \brief Get the GGEMSPhaseSpaceSource pointer for python user.
+*/
+extern "C" GGEMS_EXPORT GGEMSPhaseSpaceSource* create_ggems_phase_space_source(char const* source_name);
+
+/*!
+  \fn void set_position_ggems_phase_space_source(GGEMSPhaseSpaceSource* phase_space_source, GGfloat const pos_x, GGfloat const pos_y, GGfloat const pos_z, char const* unit)
+  \param phase_space_source - pointer on the source
+  \param pos_x - Position of the source in X
+  \param pos_y - Position of the source in Y
+  \param pos_z - Position of the source in Z
+  \param unit - unit of the distance
+  \brief Set the position of the source in the global coordinates
+*/
+extern "C" GGEMS_EXPORT void set_position_ggems_phase_space_source(GGEMSPhaseSpaceSource* phase_space_source, GGfloat const pos_x, GGfloat const pos_y, GGfloat const pos_z, char const* unit);
+
+/*!
+  \fn void set_rotation_ggems_phase_space_source(GGEMSPhaseSpaceSource* phase_space_source, GGfloat const rx, GGfloat const ry, GGfloat const rz, char const* unit)
+  \param phase_space_source - pointer on the source
+  \param rx - Rotation around X along global axis
+  \param ry - Rotation around Y along global axis
+  \param rz - Rotation around Z along global axis
+  \param unit - unit of the degree
+  \brief Set the rotation of the source around global axis
+*/
+extern "C" GGEMS_EXPORT void set_rotation_ggems_phase_space_source(GGEMSPhaseSpaceSource* phase_space_source, GGfloat const rx, GGfloat const ry, GGfloat const rz, char const* unit);
+
+/*!
+  \fn void set_number_of_particles_phase_space_source(GGEMSPhaseSpaceSource* phase_space_source, GGsize const number_of_particles)
+  \param phase_space_source - pointer on the source
+  \param number_of_particles - number of particles to replay, all particles in file by default
+  \brief Set the number of particles to simulate during the simulation
+*/
+extern "C" GGEMS_EXPORT void set_number_of_particles_phase_space_source(GGEMSPhaseSpaceSource* phase_space_source, GGsize const number_of_particles);
+
+/*!
+  \fn void set_phase_space_file_ggems_phase_space_source(GGEMSPhaseSpaceSource* phase_space_source, char const* phase_space_filename)
+  \param phase_space_source - pointer on the source
+  \param phase_space_filename - name of phase space file
+  \brief Set the phase space file to replay
+*/
+extern "C" GGEMS_EXPORT void set_phase_space_file_ggems_phase_space_source(GGEMSPhaseSpaceSource* phase_space_source, char const* phase_space_filename);
+
+#endif // End of GUARD_GGEMS_SOURCES_GGEMSPHASESPACESOURCE_HH
@@ -137,6 +137,10 @@
 
 #else
 #define GGDosiType GGfloat /*!< define GGDositype as a float, useful for dosimetry computation */
+
+#if defined(cl_khr_int64_base_atomics)
+#pragma OPENCL EXTENSION cl_khr_int64_base_atomics : enable
+#endif
 #endif
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -308,6 +312,10 @@ typedef struct GGsize3_t {
 #define GGDosiType GGdouble /*!< define GGDositype as a double, useful for dosimetry computation */
 #else
 #define GGDosiType GGfloat /*!< define GGDositype as a float, useful for dosimetry computation */
+
+#if defined(cl_khr_int64_base_atomics)
+#pragma OPENCL EXTENSION cl_khr_int64_base_atomics : enable
+#endif
 #endif
 
 #endif
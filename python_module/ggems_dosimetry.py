@@ -45,9 +45,24 @@ class GGEMSDosimetryCalculator(object):
         ggems_lib.dose_uncertainty_dosimetry_calculator.argtypes = [ctypes.c_void_p, ctypes.c_bool]
         ggems_lib.dose_uncertainty_dosimetry_calculator.restype = ctypes.c_void_p
 
+        ggems_lib.dose_label_dosimetry_calculator.argtypes = [ctypes.c_void_p, ctypes.c_bool]
+        ggems_lib.dose_label_dosimetry_calculator.restype = ctypes.c_void_p
+
+        ggems_lib.dose_map_dosimetry_calculator.argtypes = [ctypes.c_void_p, ctypes.c_bool]
+        ggems_lib.dose_map_dosimetry_calculator.restype = ctypes.c_void_p
+
         ggems_lib.dose_tle_navigator.argtypes = [ctypes.c_void_p, ctypes.c_bool]
         ggems_lib.dose_tle_navigator.restype = ctypes.c_void_p
 
+        ggems_lib.dose_csda_navigator.argtypes = [ctypes.c_void_p, ctypes.c_bool]
+        ggems_lib.dose_csda_navigator.restype = ctypes.c_void_p
+
+        ggems_lib.adaptive_dosels_dosimetry_calculator.argtypes = [ctypes.c_void_p, ctypes.c_size_t, ctypes.c_float]
+        ggems_lib.adaptive_dosels_dosimetry_calculator.restype = ctypes.c_void_p
+
+        ggems_lib.set_dose_region_dosimetry_calculator.argtypes = [ctypes.c_void_p, ctypes.c_float, ctypes.c_float, ctypes.c_float, ctypes.c_float, ctypes.c_float, ctypes.c_float, ctypes.c_char_p]
+        ggems_lib.set_dose_region_dosimetry_calculator.restype = ctypes.c_void_p
+
         ggems_lib.delete_dosimetry_calculator.argtypes = [ctypes.c_void_p]
         ggems_lib.delete_dosimetry_calculator.restype = ctypes.c_void_p
 
@@ -89,9 +104,24 @@ class GGEMSDosimetryCalculator(object):
     def uncertainty(self, activate):
         ggems_lib.dose_uncertainty_dosimetry_calculator(self.obj, activate)
 
+    def label_dose(self, activate):
+        ggems_lib.dose_label_dosimetry_calculator(self.obj, activate)
+
+    def dose_map(self, activate):
+        ggems_lib.dose_map_dosimetry_calculator(self.obj, activate)
+
     def set_tle(self, activate):
         ggems_lib.dose_tle_navigator(self.obj, activate)
 
+    def set_csda(self, activate):
+        ggems_lib.dose_csda_navigator(self.obj, activate)
+
+    def set_adaptive_dosels(self, number_of_levels, target_uncertainty):
+        ggems_lib.adaptive_dosels_dosimetry_calculator(self.obj, number_of_levels, target_uncertainty)
+
+    def set_dose_region(self, x_min, x_max, y_min, y_max, z_min, z_max, unit):
+        ggems_lib.set_dose_region_dosimetry_calculator(self.obj, x_min, x_max, y_min, y_max, z_min, z_max, unit.encode('ASCII'))
+
     def scale_factor(self, scale):
         ggems_lib.scale_factor_dosimetry_calculator(self.obj, scale)
 
@@ -27,6 +27,18 @@ class GGEMSVoxelizedPhantom(object):
         ggems_lib.set_phantom_file_ggems_voxelized_phantom.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_char_p]
         ggems_lib.set_phantom_file_ggems_voxelized_phantom.restype = ctypes.c_void_p
 
+        ggems_lib.set_phase_space_ggems_voxelized_phantom.argtypes = [ctypes.c_void_p, ctypes.c_char_p]
+        ggems_lib.set_phase_space_ggems_voxelized_phantom.restype = ctypes.c_void_p
+
+        ggems_lib.add_motion_phase_ggems_voxelized_phantom.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_float, ctypes.c_float, ctypes.c_float, ctypes.c_char_p]
+        ggems_lib.add_motion_phase_ggems_voxelized_phantom.restype = ctypes.c_void_p
+
+        ggems_lib.set_motion_phase_ggems_voxelized_phantom.argtypes = [ctypes.c_void_p, ctypes.c_size_t]
+        ggems_lib.set_motion_phase_ggems_voxelized_phantom.restype = ctypes.c_void_p
+
+        ggems_lib.set_motion_cycles_ggems_voxelized_phantom.argtypes = [ctypes.c_void_p, ctypes.c_float]
+        ggems_lib.set_motion_cycles_ggems_voxelized_phantom.restype = ctypes.c_void_p
+
         ggems_lib.set_position_ggems_voxelized_phantom.argtypes = [ctypes.c_void_p, ctypes.c_float, ctypes.c_float, ctypes.c_float, ctypes.c_char_p]
         ggems_lib.set_position_ggems_voxelized_phantom.restype = ctypes.c_void_p
 
@@ -50,6 +62,18 @@ class GGEMSVoxelizedPhantom(object):
     def set_phantom(self, phantom_filename, range_data_filename):
         ggems_lib.set_phantom_file_ggems_voxelized_phantom(self.obj, phantom_filename.encode('ASCII'), range_data_filename.encode('ASCII'))
 
+    def set_phase_space(self, phase_space_filename):
+        ggems_lib.set_phase_space_ggems_voxelized_phantom(self.obj, phase_space_filename.encode('ASCII'))
+
+    def add_motion_phase(self, phantom_filename, tx=0.0, ty=0.0, tz=0.0, unit='mm'):
+        ggems_lib.add_motion_phase_ggems_voxelized_phantom(self.obj, phantom_filename.encode('ASCII'), tx, ty, tz, unit.encode('ASCII'))
+
+    def set_motion_phase(self, motion_phase):
+        ggems_lib.set_motion_phase_ggems_voxelized_phantom(self.obj, motion_phase)
+
+    def set_motion_cycles(self, number_of_cycles):
+        ggems_lib.set_motion_cycles_ggems_voxelized_phantom(self.obj, number_of_cycles)
+
     def set_material_visible(self, material_name, flag):
         ggems_lib.set_material_visible_ggems_voxelized_phantom(self.obj, material_name.encode('ASCII'), flag)
 
@@ -69,6 +93,105 @@ class GGEMSVoxelizedPhantom(object):
         ggems_lib.set_rotation_ggems_voxelized_phantom(self.obj, rx, ry, rz, unit.encode('ASCII'))
 
 
+class GGEMSMeshedPhantom(object):
+    """Class for meshed phantom (closed triangle mesh) for GGEMS simulation
+    """
+    def __init__(self, meshed_phantom_name):
+        ggems_lib.create_ggems_meshed_phantom.restype = ctypes.c_void_p
+
+        ggems_lib.set_mesh_file_ggems_meshed_phantom.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_char_p]
+        ggems_lib.set_mesh_file_ggems_meshed_phantom.restype = ctypes.c_void_p
+
+        ggems_lib.set_position_ggems_meshed_phantom.argtypes = [ctypes.c_void_p, ctypes.c_float, ctypes.c_float, ctypes.c_float, ctypes.c_char_p]
+        ggems_lib.set_position_ggems_meshed_phantom.restype = ctypes.c_void_p
+
+        ggems_lib.set_rotation_ggems_meshed_phantom.argtypes = [ctypes.c_void_p, ctypes.c_float, ctypes.c_float, ctypes.c_float, ctypes.c_char_p]
+        ggems_lib.set_rotation_ggems_meshed_phantom.restype = ctypes.c_void_p
+
+        self.obj = ggems_lib.create_ggems_meshed_phantom(meshed_phantom_name.encode('ASCII'))
+
+    def set_mesh(self, mesh_filename, material_name):
+        ggems_lib.set_mesh_file_ggems_meshed_phantom(self.obj, mesh_filename.encode('ASCII'), material_name.encode('ASCII'))
+
+    def set_position(self, pos_x, pos_y, pos_z, unit):
+        ggems_lib.set_position_ggems_meshed_phantom(self.obj, pos_x, pos_y, pos_z, unit.encode('ASCII'))
+
+    def set_rotation(self, rx, ry, rz, unit):
+        ggems_lib.set_rotation_ggems_meshed_phantom(self.obj, rx, ry, rz, unit.encode('ASCII'))
+
+
+class GGEMSAnalyticPhantom(object):
+    """Class for analytic phantom (sphere, cylinder or ellipsoid) for GGEMS simulation
+    """
+    def __init__(self, analytic_phantom_name):
+        ggems_lib.create_ggems_analytic_phantom.restype = ctypes.c_void_p
+
+        ggems_lib.set_sphere_ggems_analytic_phantom.argtypes = [ctypes.c_void_p, ctypes.c_float, ctypes.c_char_p, ctypes.c_char_p]
+        ggems_lib.set_sphere_ggems_analytic_phantom.restype = ctypes.c_void_p
+
+        ggems_lib.set_cylinder_ggems_analytic_phantom.argtypes = [ctypes.c_void_p, ctypes.c_float, ctypes.c_float, ctypes.c_char_p, ctypes.c_char_p]
+        ggems_lib.set_cylinder_ggems_analytic_phantom.restype = ctypes.c_void_p
+
+        ggems_lib.set_ellipsoid_ggems_analytic_phantom.argtypes = [ctypes.c_void_p, ctypes.c_float, ctypes.c_float, ctypes.c_float, ctypes.c_char_p, ctypes.c_char_p]
+        ggems_lib.set_ellipsoid_ggems_analytic_phantom.restype = ctypes.c_void_p
+
+        ggems_lib.set_position_ggems_analytic_phantom.argtypes = [ctypes.c_void_p, ctypes.c_float, ctypes.c_float, ctypes.c_float, ctypes.c_char_p]
+        ggems_lib.set_position_ggems_analytic_phantom.restype = ctypes.c_void_p
+
+        ggems_lib.set_rotation_ggems_analytic_phantom.argtypes = [ctypes.c_void_p, ctypes.c_float, ctypes.c_float, ctypes.c_float, ctypes.c_char_p]
+        ggems_lib.set_rotation_ggems_analytic_phantom.restype = ctypes.c_void_p
+
+        self.obj = ggems_lib.create_ggems_analytic_phantom(analytic_phantom_name.encode('ASCII'))
+
+    def set_sphere(self, radius, material_name, unit):
+        ggems_lib.set_sphere_ggems_analytic_phantom(self.obj, radius, material_name.encode('ASCII'), unit.encode('ASCII'))
+
+    def set_cylinder(self, radius, height, material_name, unit):
+        ggems_lib.set_cylinder_ggems_analytic_phantom(self.obj, radius, height, material_name.encode('ASCII'), unit.encode('ASCII'))
+
+    def set_ellipsoid(self, radius_x, radius_y, radius_z, material_name, unit):
+        ggems_lib.set_ellipsoid_ggems_analytic_phantom(self.obj, radius_x, radius_y, radius_z, material_name.encode('ASCII'), unit.encode('ASCII'))
+
+    def set_position(self, pos_x, pos_y, pos_z, unit):
+        ggems_lib.set_position_ggems_analytic_phantom(self.obj, pos_x, pos_y, pos_z, unit.encode('ASCII'))
+
+    def set_rotation(self, rx, ry, rz, unit):
+        ggems_lib.set_rotation_ggems_analytic_phantom(self.obj, rx, ry, rz, unit.encode('ASCII'))
+
+
+class GGEMSMotherVolume(object):
+    """Class for mother volume, box of world medium containing navigators or other mother volumes
+    """
+    def __init__(self, mother_volume_name):
+        ggems_lib.create_ggems_mother_volume.restype = ctypes.c_void_p
+
+        ggems_lib.set_size_ggems_mother_volume.argtypes = [ctypes.c_void_p, ctypes.c_float, ctypes.c_float, ctypes.c_float, ctypes.c_char_p]
+        ggems_lib.set_size_ggems_mother_volume.restype = ctypes.c_void_p
+
+        ggems_lib.set_position_ggems_mother_volume.argtypes = [ctypes.c_void_p, ctypes.c_float, ctypes.c_float, ctypes.c_float, ctypes.c_char_p]
+        ggems_lib.set_position_ggems_mother_volume.restype = ctypes.c_void_p
+
+        ggems_lib.set_rotation_ggems_mother_volume.argtypes = [ctypes.c_void_p, ctypes.c_float, ctypes.c_float, ctypes.c_float, ctypes.c_char_p]
+        ggems_lib.set_rotation_ggems_mother_volume.restype = ctypes.c_void_p
+
+        ggems_lib.add_daughter_ggems_mother_volume.argtypes = [ctypes.c_void_p, ctypes.c_char_p]
+        ggems_lib.add_daughter_ggems_mother_volume.restype = ctypes.c_void_p
+
+        self.obj = ggems_lib.create_ggems_mother_volume(mother_volume_name.encode('ASCII'))
+
+    def set_size(self, size_x, size_y, size_z, unit):
+        ggems_lib.set_size_ggems_mother_volume(self.obj, size_x, size_y, size_z, unit.encode('ASCII'))
+
+    def set_position(self, pos_x, pos_y, pos_z, unit):
+        ggems_lib.set_position_ggems_mother_volume(self.obj, pos_x, pos_y, pos_z, unit.encode('ASCII'))
+
+    def set_rotation(self, rx, ry, rz, unit):
+        ggems_lib.set_rotation_ggems_mother_volume(self.obj, rx, ry, rz, unit.encode('ASCII'))
+
+    def add_daughter(self, daughter_name):
+        ggems_lib.add_daughter_ggems_mother_volume(self.obj, daughter_name.encode('ASCII'))
+
+
 class GGEMSWorld(object):
     """Class for world volume for GGEMS simulation
     """
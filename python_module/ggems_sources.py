@@ -101,3 +101,37 @@ class GGEMSXRaySource(object):
 
   def set_polyenergy(self, file):
       ggems_lib.set_polyenergy_ggems_xray_source(self.obj, file.encode('ASCII'))
+
+
+class GGEMSPhaseSpaceSource(object):
+  """GGEMS phase space source class replaying particles stored by a phantom
+  """
+  def __init__(self, source_name):
+      ggems_lib.create_ggems_phase_space_source.argtypes = [ctypes.c_char_p]
+      ggems_lib.create_ggems_phase_space_source.restype = ctypes.c_void_p
+
+      ggems_lib.set_position_ggems_phase_space_source.argtypes = [ctypes.c_void_p, ctypes.c_float, ctypes.c_float, ctypes.c_float, ctypes.c_char_p]
+      ggems_lib.set_position_ggems_phase_space_source.restype = ctypes.c_void_p
+
+      ggems_lib.set_rotation_ggems_phase_space_source.argtypes = [ctypes.c_void_p, ctypes.c_float, ctypes.c_float, ctypes.c_float, ctypes.c_char_p]
+      ggems_lib.set_rotation_ggems_phase_space_source.restype = ctypes.c_void_p
+
+      ggems_lib.set_number_of_particles_phase_space_source.argtypes = [ctypes.c_void_p, ctypes.c_size_t]
+      ggems_lib.set_number_of_particles_phase_space_source.restype = ctypes.c_void_p
+
+      ggems_lib.set_phase_space_file_ggems_phase_space_source.argtypes = [ctypes.c_void_p, ctypes.c_char_p]
+      ggems_lib.set_phase_space_file_ggems_phase_space_source.restype = ctypes.c_void_p
+
+      self.obj = ggems_lib.create_ggems_phase_space_source(source_name.encode('ASCII'))
+
+  def set_position(self, x, y, z, unit):
+      ggems_lib.set_position_ggems_phase_space_source(self.obj, x, y, z, unit.encode('ASCII'))
+
+  def set_rotation(self, rx, ry, rz, unit):
+      ggems_lib.set_rotation_ggems_phase_space_source(self.obj, rx, ry, rz, unit.encode('ASCII'))
+
+  def set_number_of_particles(self, number_of_particles):
+      ggems_lib.set_number_of_particles_phase_space_source(self.obj, number_of_particles)
+
+  def set_phase_space_file(self, file):
+      ggems_lib.set_phase_space_file_ggems_phase_space_source(self.obj, file.encode('ASCII'))
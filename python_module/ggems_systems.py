@@ -45,6 +45,15 @@ class GGEMSCTSystem(object):
         ggems_lib.set_source_detector_distance_ggems_ct_system.argtypes = [ctypes.c_void_p, ctypes.c_float, ctypes.c_char_p]
         ggems_lib.set_source_detector_distance_ggems_ct_system.restype = ctypes.c_void_p
 
+        ggems_lib.set_anti_scatter_grid_ggems_ct_system.argtypes = [ctypes.c_void_p, ctypes.c_float, ctypes.c_float, ctypes.c_float, ctypes.c_float, ctypes.c_char_p]
+        ggems_lib.set_anti_scatter_grid_ggems_ct_system.restype = ctypes.c_void_p
+
+        ggems_lib.set_anti_scatter_grid_material_ggems_ct_system.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_char_p]
+        ggems_lib.set_anti_scatter_grid_material_ggems_ct_system.restype = ctypes.c_void_p
+
+        ggems_lib.add_module_layer_ggems_ct_system.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_float, ctypes.c_char_p, ctypes.c_bool]
+        ggems_lib.add_module_layer_ggems_ct_system.restype = ctypes.c_void_p
+
         ggems_lib.set_rotation_ggems_ct_system.argtypes = [ctypes.c_void_p, ctypes.c_float, ctypes.c_float, ctypes.c_float, ctypes.c_char_p]
         ggems_lib.set_rotation_ggems_ct_system.restype = ctypes.c_void_p
 
@@ -72,6 +81,12 @@ class GGEMSCTSystem(object):
         ggems_lib.store_scatter_ggems_ct_system.argtypes = [ctypes.c_void_p, ctypes.c_bool]
         ggems_lib.store_scatter_ggems_ct_system.restype = ctypes.c_void_p
 
+        ggems_lib.set_sinogram_ggems_ct_system.argtypes = [ctypes.c_void_p, ctypes.c_size_t]
+        ggems_lib.set_sinogram_ggems_ct_system.restype = ctypes.c_void_p
+
+        ggems_lib.set_view_ggems_ct_system.argtypes = [ctypes.c_void_p, ctypes.c_float, ctypes.c_float, ctypes.c_char_p, ctypes.c_char_p]
+        ggems_lib.set_view_ggems_ct_system.restype = ctypes.c_void_p
+
         self.obj = ggems_lib.create_ggems_ct_system(ct_system_name.encode('ASCII'))
 
     def set_number_of_modules(self, module_x, module_y):
@@ -95,6 +110,15 @@ class GGEMSCTSystem(object):
     def set_source_isocenter_distance(self, sid, unit):
         ggems_lib.set_source_isocenter_distance_ggems_ct_system(self.obj, sid, unit.encode('ASCII'))
 
+    def set_anti_scatter_grid(self, lamella_pitch, lamella_thickness, lamella_height, focus_distance, unit):
+        ggems_lib.set_anti_scatter_grid_ggems_ct_system(self.obj, lamella_pitch, lamella_thickness, lamella_height, focus_distance, unit.encode('ASCII'))
+
+    def set_anti_scatter_grid_material(self, lamella_material, interspace_material='Air'):
+        ggems_lib.set_anti_scatter_grid_material_ggems_ct_system(self.obj, lamella_material.encode('ASCII'), interspace_material.encode('ASCII'))
+
+    def add_module_layer(self, material_name, thickness, unit, is_sensitive=False):
+        ggems_lib.add_module_layer_ggems_ct_system(self.obj, material_name.encode('ASCII'), thickness, unit.encode('ASCII'), is_sensitive)
+
     def set_rotation(self, rx, ry, rz, unit):
         ggems_lib.set_rotation_ggems_ct_system(self.obj, rx, ry, rz, unit.encode('ASCII'))
 
@@ -121,3 +145,9 @@ class GGEMSCTSystem(object):
 
     def store_scatter(self, flag):
         ggems_lib.store_scatter_ggems_ct_system(self.obj, flag)
+
+    def set_sinogram(self, number_of_views):
+        ggems_lib.set_sinogram_ggems_ct_system(self.obj, number_of_views)
+
+    def set_view(self, view_angle, table_position, angle_unit='deg', distance_unit='mm'):
+        ggems_lib.set_view_ggems_ct_system(self.obj, view_angle, table_position, angle_unit.encode('ASCII'), distance_unit.encode('ASCII'))
@@ -126,6 +126,7 @@ void GGEMSBox::Draw(void)
   cl::NDRange local_wi(work_group_size);
 
   // Set parameters for kernel
+  opencl_manager.PrepareKernel(kernel_draw_volume_[0]);
   kernel_draw_volume_[0]->setArg(0, number_of_elements);
   kernel_draw_volume_[0]->setArg(1, voxel_sizes);
   kernel_draw_volume_[0]->setArg(2, phantom_dimensions);
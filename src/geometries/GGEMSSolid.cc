@@ -135,7 +135,49 @@ void GGEMSSolid::EnableTracking(void)
 
 void GGEMSSolid::AddKernelOption(std::string const& option)
 {
-  kernel_option_ += " -DTLE";
+  kernel_option_ += option;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSolid::EnableAntiScatterGrid(GGEMSAntiScatterGrid const&)
+{
+  std::ostringstream oss(std::ostringstream::out);
+  oss << "Anti-scatter grid is not available for this solid!!!";
+  GGEMSMisc::ThrowException("GGEMSSolid", "EnableAntiScatterGrid", oss.str());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSolid::EnableModuleLayers(GGEMSModuleLayers const&)
+{
+  std::ostringstream oss(std::ostringstream::out);
+  oss << "Module layers are not available for this solid!!!";
+  GGEMSMisc::ThrowException("GGEMSSolid", "EnableModuleLayers", oss.str());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSolid::SetNeighbourSolids(std::vector<GGint> const&)
+{
+  std::ostringstream oss(std::ostringstream::out);
+  oss << "Neighbour solids are not available for this solid!!!";
+  GGEMSMisc::ThrowException("GGEMSSolid", "SetNeighbourSolids", oss.str());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSolid::SetSearchPass(GGsize const&, GGint const&, cl::Buffer*)
+{
+  ;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
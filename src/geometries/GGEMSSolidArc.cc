@@ -0,0 +1,293 @@
+// ************************************************************************
+// * This file is part of GGEMS.                                          *
+// *                                                                      *
+// * GGEMS is free software: you can redistribute it and/or modify        *
+// * it under the terms of the GNU General Public License as published by *
+// * the Free Software Foundation, either version 3 of the License, or    *
+// * (at your option) any later version.                                  *
+// *                                                                      *
+// * GGEMS is distributed in the hope that it will be useful,             *
+// * but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+// * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+// * GNU General Public License for more details.                         *
+// *                                                                      *
+// * You should have received a copy of the GNU General Public License    *
+// * along with GGEMS.  If not, see <https://www.gnu.org/licenses/>.      *
+// *                                                                      *
+// ************************************************************************
+
+/*!
+  \file GGEMSSolidArc.cc
+
+  \brief GGEMS class for solid arc, a cylindrical arc used as curved detector
+
+  \author Julien BERT <julien.bert@univ-brest.fr>
+  \author Didier BENOIT <didier.benoit@inserm.fr>
+  \author LaTIM, INSERM - U1101, Brest, FRANCE
+  \version 1.0
+  \date Sunday October 18, 2026
+*/
+
+#include "GGEMS/geometries/GGEMSSolidArc.hh"
+#include "GGEMS/geometries/GGEMSSolidArcData.hh"
+#include "GGEMS/physics/GGEMSScatterHistory.hh"
+#include "GGEMS/global/GGEMSConstants.hh"
+#include "GGEMS/maths/GGEMSGeometryTransformation.hh"
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+GGEMSSolidArc::GGEMSSolidArc(GGsize const& virtual_element_number_x, GGsize const& virtual_element_number_y, GGsize const& virtual_element_number_z, GGfloat const& inner_radius, GGfloat const& thickness, GGfloat const& arc_angle, GGfloat const& arc_length, std::string const& data_reg_type)
+: GGEMSSolid()
+{
+  GGcout("GGEMSSolidArc", "GGEMSSolidArc", 3) << "GGEMSSolidArc creating..." << GGendl;
+
+  // Checking aperture of arc, distance to boundary is computed for a convex angular sector only
+  if (arc_angle <= 0.0f || arc_angle >= PI) {
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "Aperture angle of solid arc has to be in ]0, PI[ rad!!!";
+    GGEMSMisc::ThrowException("GGEMSSolidArc", "GGEMSSolidArc", oss.str());
+  }
+
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  // Loop over the device
+  for (GGsize d = 0; d < number_activated_devices_; ++d) {
+    // Creating a label, but this label is not used in case of GGEMSSolidArc
+    label_data_[d] = nullptr;
+
+    // Allocating memory on OpenCL device and getting pointer on it
+    solid_data_[d] = opencl_manager.Allocate(nullptr, sizeof(GGEMSSolidArcData), d, CL_MEM_READ_WRITE, "GGEMSSolidArc");
+    GGEMSSolidArcData* solid_data_device = opencl_manager.GetDeviceBuffer<GGEMSSolidArcData>(solid_data_[d], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSSolidArcData), d);
+
+    solid_data_device->virtual_element_number_xyz_[0] = virtual_element_number_x;
+    solid_data_device->virtual_element_number_xyz_[1] = virtual_element_number_y;
+    solid_data_device->virtual_element_number_xyz_[2] = virtual_element_number_z;
+
+    solid_data_device->element_size_xyz_[0] = arc_length / static_cast<GGfloat>(virtual_element_number_x);
+    solid_data_device->element_size_xyz_[1] = arc_angle / static_cast<GGfloat>(virtual_element_number_y);
+    solid_data_device->element_size_xyz_[2] = thickness / static_cast<GGfloat>(virtual_element_number_z);
+
+    solid_data_device->arc_geometry_.radius_min_ = inner_radius;
+    solid_data_device->arc_geometry_.radius_max_ = inner_radius + thickness;
+    solid_data_device->arc_geometry_.angle_min_ = -arc_angle*0.5f;
+    solid_data_device->arc_geometry_.angle_max_ = arc_angle*0.5f;
+    solid_data_device->arc_geometry_.z_min_ = -arc_length*0.5f;
+    solid_data_device->arc_geometry_.z_max_ = arc_length*0.5f;
+
+    // Releasing pointer
+    opencl_manager.ReleaseDeviceBuffer(solid_data_[d], solid_data_device, d);
+  }
+
+  // Solid arc associated at hit collection
+  data_reg_type_ = data_reg_type;
+  if (data_reg_type == "HISTOGRAM") {
+    // Histogram is a projection of arc: rows x columns
+    histogram_.number_of_elements_ = virtual_element_number_x*virtual_element_number_y;
+
+    // Allocating memory storing data
+    histogram_.histogram_ = new cl::Buffer*[number_activated_devices_];
+    histogram_.scatter_ = new cl::Buffer*[number_activated_devices_];
+
+    // Loop over number of device
+    for (GGsize d = 0; d < number_activated_devices_; ++d) {
+      histogram_.histogram_[d] = opencl_manager.Allocate(nullptr, histogram_.number_of_elements_*sizeof(GGint), d, CL_MEM_READ_WRITE, "GGEMSSolidArc");
+      histogram_.scatter_[d] = nullptr;
+
+      if (d == 0) kernel_option_ += " -DHISTOGRAM";
+
+      // Initialize value to 0
+      opencl_manager.CleanBuffer(histogram_.histogram_[d], histogram_.number_of_elements_*sizeof(GGint), d);
+    }
+  }
+  else {
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "False registration type name!!!" << std::endl;
+    oss << "Registration type is :" << std::endl;
+    oss << "    - HISTOGRAM" << std::endl;
+    GGEMSMisc::ThrowException("GGEMSSolidArc", "GGEMSSolidArc", oss.str());
+  }
+
+  GGcout("GGEMSSolidArc", "GGEMSSolidArc", 3) << "GGEMSSolidArc created!!!" << GGendl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+GGEMSSolidArc::~GGEMSSolidArc(void)
+{
+  GGcout("GGEMSSolidArc", "~GGEMSSolidArc", 3) << "GGEMSSolidArc erasing..." << GGendl;
+
+  // Get the opencl manager
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  if (data_reg_type_ == "HISTOGRAM") {
+    if (histogram_.histogram_) {
+      for (GGsize i = 0; i < number_activated_devices_; ++i) {
+        opencl_manager.Deallocate(histogram_.histogram_[i], histogram_.number_of_elements_*sizeof(GGint), i);
+      }
+      delete[] histogram_.histogram_;
+      histogram_.histogram_ = nullptr;
+    }
+
+    if (is_scatter_) {
+      if (histogram_.scatter_) {
+        for (GGsize i = 0; i < number_activated_devices_; ++i) {
+          opencl_manager.Deallocate(histogram_.scatter_[i], NUMBER_OF_SCATTER_CATEGORIES*histogram_.number_of_elements_*sizeof(GGint), i);
+        }
+        delete[] histogram_.scatter_;
+        histogram_.scatter_ = nullptr;
+      }
+    }
+  }
+
+  // Solid data is deleted here, size is different from GGEMSSolidBoxData
+  if (solid_data_) {
+    for (GGsize i = 0; i < number_activated_devices_; ++i) {
+      opencl_manager.Deallocate(solid_data_[i], sizeof(GGEMSSolidArcData), i);
+    }
+    delete[] solid_data_;
+    solid_data_ = nullptr;
+  }
+
+  GGcout("GGEMSSolidArc", "~GGEMSSolidArc", 3) << "GGEMSSolidArc erased!!!" << GGendl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSolidArc::InitializeKernel(void)
+{
+  GGcout("GGEMSSolidArc", "InitializeKernel", 3) << "Initializing kernel for solid arc..." << GGendl;
+
+  // Getting the OpenCLManager singleton
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  // Getting the path to kernel
+  std::string openCL_kernel_path = OPENCL_KERNEL_PATH;
+  std::string particle_solid_distance_filename = openCL_kernel_path + "/ParticleSolidDistanceGGEMSSolidArc.cl";
+  std::string project_to_filename = openCL_kernel_path + "/ProjectToGGEMSSolidArc.cl";
+  std::string track_through_filename = openCL_kernel_path + "/TrackThroughGGEMSSolidArc.cl";
+
+  // Compiling the kernels
+  opencl_manager.CompileKernel(particle_solid_distance_filename, "particle_solid_distance_ggems_solid_arc", kernel_particle_solid_distance_, nullptr, const_cast<char*>(kernel_option_.c_str()));
+  opencl_manager.CompileKernel(project_to_filename, "project_to_ggems_solid_arc", kernel_project_to_solid_, nullptr, const_cast<char*>(kernel_option_.c_str()));
+  opencl_manager.CompileKernel(track_through_filename, "track_through_ggems_solid_arc", kernel_track_through_solid_, nullptr, const_cast<char*>(kernel_option_.c_str()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSolidArc::Initialize(GGEMSMaterials*)
+{
+  GGcout("GGEMSSolidArc", "Initialize", 3) << "Initializing solid arc..." << GGendl;
+
+  // Initializing kernels
+  InitializeKernel();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSolidArc::EnableScatter(void)
+{
+  // Getting the OpenCLManager singleton
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  is_scatter_ = true;
+
+  // Loop over number of device
+  for (GGsize d = 0; d < number_activated_devices_; ++d) {
+    histogram_.scatter_[d] = opencl_manager.Allocate(nullptr, NUMBER_OF_SCATTER_CATEGORIES*histogram_.number_of_elements_*sizeof(GGint), d, CL_MEM_READ_WRITE, "GGEMSSolidArc");
+
+    // Initialize value to 0
+    opencl_manager.CleanBuffer(histogram_.scatter_[d], NUMBER_OF_SCATTER_CATEGORIES*histogram_.number_of_elements_*sizeof(GGint), d);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSolidArc::EnableAntiScatterGrid(GGEMSAntiScatterGrid const& anti_scatter_grid)
+{
+  // Getting the OpenCLManager singleton
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  // Loop over number of device
+  for (GGsize d = 0; d < number_activated_devices_; ++d) {
+    GGEMSSolidArcData* solid_data_device = opencl_manager.GetDeviceBuffer<GGEMSSolidArcData>(solid_data_[d], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSSolidArcData), d);
+
+    solid_data_device->anti_scatter_grid_ = anti_scatter_grid;
+
+    // Releasing pointer
+    opencl_manager.ReleaseDeviceBuffer(solid_data_[d], solid_data_device, d);
+  }
+
+  kernel_option_ += " -DANTI_SCATTER_GRID";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSolidArc::PrintInfos(void) const
+{
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  // Loop over the device
+  for (GGsize d = 0; d < number_activated_devices_; ++d) {
+    // Getting pointer on OpenCL device
+    GGEMSSolidArcData* solid_data_device = opencl_manager.GetDeviceBuffer<GGEMSSolidArcData>(solid_data_[d], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSSolidArcData), d);
+
+    // Get the index of device
+    GGsize device_index = opencl_manager.GetIndexOfActivatedDevice(d);
+
+    GGcout("GGEMSSolidArc", "PrintInfos", 0) << GGendl;
+    GGcout("GGEMSSolidArc", "PrintInfos", 0) << "GGEMSSolidArc Infos:" << GGendl;
+    GGcout("GGEMSSolidArc", "PrintInfos", 0) << "--------------------------" << GGendl;
+    GGcout("GGEMSSolidArc", "PrintInfos", 0) << "Material on device: " << opencl_manager.GetDeviceName(device_index) << GGendl;
+    GGcout("GGEMSSolidArc", "PrintInfos", 0) << "* Virtual elements (rows x columns x depth): " << solid_data_device->virtual_element_number_xyz_[0] << "x" << solid_data_device->virtual_element_number_xyz_[1] << "x" << solid_data_device->virtual_element_number_xyz_[2] << GGendl;
+    GGcout("GGEMSSolidArc", "PrintInfos", 0) << "* Element size: " << solid_data_device->element_size_xyz_[0] << " mm, " << solid_data_device->element_size_xyz_[1] << " rad, " << solid_data_device->element_size_xyz_[2] << " mm" << GGendl;
+    GGcout("GGEMSSolidArc", "PrintInfos", 0) << "* Arc in local position:" << GGendl;
+    GGcout("GGEMSSolidArc", "PrintInfos", 0) << "    - Radius: " << solid_data_device->arc_geometry_.radius_min_ << " <-> " << solid_data_device->arc_geometry_.radius_max_ << GGendl;
+    GGcout("GGEMSSolidArc", "PrintInfos", 0) << "    - Angle: " << solid_data_device->arc_geometry_.angle_min_ << " <-> " << solid_data_device->arc_geometry_.angle_max_ << GGendl;
+    GGcout("GGEMSSolidArc", "PrintInfos", 0) << "    - Z: " << solid_data_device->arc_geometry_.z_min_ << " <-> " << solid_data_device->arc_geometry_.z_max_ << GGendl;
+    GGcout("GGEMSSolidArc", "PrintInfos", 0) << "    - Transformation matrix:" << GGendl;
+    GGcout("GGEMSSolidArc", "PrintInfos", 0) << "    [" << GGendl;
+    GGcout("GGEMSSolidArc", "PrintInfos", 0) << "        " << solid_data_device->arc_geometry_.matrix_transformation_.local_to_global_.m0_[0] << " " << solid_data_device->arc_geometry_.matrix_transformation_.local_to_global_.m0_[1] << " " << solid_data_device->arc_geometry_.matrix_transformation_.local_to_global_.m0_[2] << " " << solid_data_device->arc_geometry_.matrix_transformation_.local_to_global_.m0_[3] << GGendl;
+    GGcout("GGEMSSolidArc", "PrintInfos", 0) << "        " << solid_data_device->arc_geometry_.matrix_transformation_.local_to_global_.m1_[0] << " " << solid_data_device->arc_geometry_.matrix_transformation_.local_to_global_.m1_[1] << " " << solid_data_device->arc_geometry_.matrix_transformation_.local_to_global_.m1_[2] << " " << solid_data_device->arc_geometry_.matrix_transformation_.local_to_global_.m1_[3] << GGendl;
+    GGcout("GGEMSSolidArc", "PrintInfos", 0) << "        " << solid_data_device->arc_geometry_.matrix_transformation_.local_to_global_.m2_[0] << " " << solid_data_device->arc_geometry_.matrix_transformation_.local_to_global_.m2_[1] << " " << solid_data_device->arc_geometry_.matrix_transformation_.local_to_global_.m2_[2] << " " << solid_data_device->arc_geometry_.matrix_transformation_.local_to_global_.m2_[3] << GGendl;
+    GGcout("GGEMSSolidArc", "PrintInfos", 0) << "    ]" << GGendl;
+    GGcout("GGEMSSolidArc", "PrintInfos", 0) << "* Solid index: " << solid_data_device->solid_id_ << GGendl;
+    GGcout("GGEMSSolidArc", "PrintInfos", 0) << GGendl;
+
+    // Releasing the pointer
+    opencl_manager.ReleaseDeviceBuffer(solid_data_[d], solid_data_device, d);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSolidArc::UpdateTransformationMatrix(GGsize const& thread_index)
+{
+  // Get the OpenCL manager
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  // Copy information to arc
+  GGEMSSolidArcData* solid_data_device = opencl_manager.GetDeviceBuffer<GGEMSSolidArcData>(solid_data_[thread_index], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSSolidArcData), thread_index);
+  GGEMSTransformationMatrix* transformation_matrix_device = opencl_manager.GetDeviceBuffer<GGEMSTransformationMatrix>(geometry_transformation_->GetTransformationMatrix(thread_index), CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSTransformationMatrix), thread_index);
+
+  solid_data_device->arc_geometry_.matrix_transformation_ = *transformation_matrix_device;
+
+  // Release the pointer
+  opencl_manager.ReleaseDeviceBuffer(solid_data_[thread_index], solid_data_device, thread_index);
+  opencl_manager.ReleaseDeviceBuffer(geometry_transformation_->GetTransformationMatrix(thread_index), transformation_matrix_device, thread_index);
+}
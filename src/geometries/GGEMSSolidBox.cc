@@ -30,6 +30,7 @@
 
 #include "GGEMS/geometries/GGEMSSolidBox.hh"
 #include "GGEMS/geometries/GGEMSSolidBoxData.hh"
+#include "GGEMS/physics/GGEMSScatterHistory.hh"
 #include "GGEMS/maths/GGEMSGeometryTransformation.hh"
 #include "GGEMS/graphics/GGEMSOpenGLParaGrid.hh"
 
@@ -69,6 +70,8 @@ GGEMSSolidBox::GGEMSSolidBox(GGsize const& virtual_element_number_x, GGsize cons
     solid_data_device->obb_geometry_.border_max_xyz_.s[1] = box_size_y*0.5f;
     solid_data_device->obb_geometry_.border_max_xyz_.s[2] = box_size_z*0.5f;
 
+    solid_data_device->number_of_neighbour_solids_ = 0;
+
     // Releasing pointer
     opencl_manager.ReleaseDeviceBuffer(solid_data_[d], solid_data_device, d);
   }
@@ -154,7 +157,7 @@ GGEMSSolidBox::~GGEMSSolidBox(void)
     if (is_scatter_) {
       if (histogram_.scatter_) {
         for (GGsize i = 0; i < number_activated_devices_; ++i) {
-          opencl_manager.Deallocate(histogram_.scatter_[i], histogram_.number_of_elements_*sizeof(GGint), i);
+          opencl_manager.Deallocate(histogram_.scatter_[i], NUMBER_OF_SCATTER_CATEGORIES*histogram_.number_of_elements_*sizeof(GGint), i);
         }
         delete[] histogram_.scatter_;
         histogram_.scatter_ = nullptr;
@@ -213,10 +216,10 @@ void GGEMSSolidBox::EnableScatter(void)
 
   // Loop over number of device
   for (GGsize d = 0; d < number_activated_devices_; ++d) {
-    histogram_.scatter_[d] = opencl_manager.Allocate(nullptr, histogram_.number_of_elements_*sizeof(GGint), d, CL_MEM_READ_WRITE, "GGEMSSolidBox");
+    histogram_.scatter_[d] = opencl_manager.Allocate(nullptr, NUMBER_OF_SCATTER_CATEGORIES*histogram_.number_of_elements_*sizeof(GGint), d, CL_MEM_READ_WRITE, "GGEMSSolidBox");
 
     // Initialize value to 0
-    opencl_manager.CleanBuffer(histogram_.scatter_[d], histogram_.number_of_elements_*sizeof(GGint), d);
+    opencl_manager.CleanBuffer(histogram_.scatter_[d], NUMBER_OF_SCATTER_CATEGORIES*histogram_.number_of_elements_*sizeof(GGint), d);
   }
 }
 
@@ -224,6 +227,90 @@ void GGEMSSolidBox::EnableScatter(void)
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+void GGEMSSolidBox::EnableAntiScatterGrid(GGEMSAntiScatterGrid const& anti_scatter_grid)
+{
+  // Getting the OpenCLManager singleton
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  // Loop over number of device
+  for (GGsize d = 0; d < number_activated_devices_; ++d) {
+    GGEMSSolidBoxData* solid_data_device = opencl_manager.GetDeviceBuffer<GGEMSSolidBoxData>(solid_data_[d], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSSolidBoxData), d);
+
+    solid_data_device->anti_scatter_grid_ = anti_scatter_grid;
+
+    // Releasing pointer
+    opencl_manager.ReleaseDeviceBuffer(solid_data_[d], solid_data_device, d);
+  }
+
+  kernel_option_ += " -DANTI_SCATTER_GRID";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSolidBox::EnableModuleLayers(GGEMSModuleLayers const& module_layers)
+{
+  // Getting the OpenCLManager singleton
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  // Loop over number of device
+  for (GGsize d = 0; d < number_activated_devices_; ++d) {
+    GGEMSSolidBoxData* solid_data_device = opencl_manager.GetDeviceBuffer<GGEMSSolidBoxData>(solid_data_[d], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSSolidBoxData), d);
+
+    solid_data_device->module_layers_ = module_layers;
+
+    // Releasing pointer
+    opencl_manager.ReleaseDeviceBuffer(solid_data_[d], solid_data_device, d);
+  }
+
+  kernel_option_ += " -DMODULE_LAYERS";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSolidBox::SetNeighbourSolids(std::vector<GGint> const& neighbour_solid_ids)
+{
+  if (neighbour_solid_ids.size() > MAXIMUM_NEIGHBOUR_SOLIDS) {
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "Number of neighbour solids (" << neighbour_solid_ids.size() << ") is greater than the maximum number of neighbour solids (" << MAXIMUM_NEIGHBOUR_SOLIDS << ")!!!";
+    GGEMSMisc::ThrowException("GGEMSSolidBox", "SetNeighbourSolids", oss.str());
+  }
+
+  // Getting the OpenCLManager singleton
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  // Loop over number of device
+  for (GGsize d = 0; d < number_activated_devices_; ++d) {
+    GGEMSSolidBoxData* solid_data_device = opencl_manager.GetDeviceBuffer<GGEMSSolidBoxData>(solid_data_[d], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSSolidBoxData), d);
+
+    solid_data_device->number_of_neighbour_solids_ = static_cast<GGint>(neighbour_solid_ids.size());
+    for (GGsize i = 0; i < neighbour_solid_ids.size(); ++i) {
+      solid_data_device->neighbour_solid_id_[i] = neighbour_solid_ids[i];
+    }
+
+    // Releasing pointer
+    opencl_manager.ReleaseDeviceBuffer(solid_data_[d], solid_data_device, d);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSolidBox::SetSearchPass(GGsize const& thread_index, GGint const& search_pass, cl::Buffer* fallback_search)
+{
+  kernel_particle_solid_distance_[thread_index]->setArg(4, search_pass);
+  if (!fallback_search) kernel_particle_solid_distance_[thread_index]->setArg(5, sizeof(cl_mem), nullptr);
+  else kernel_particle_solid_distance_[thread_index]->setArg(5, *fallback_search);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 void GGEMSSolidBox::PrintInfos(void) const
 {
   GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
@@ -248,12 +335,12 @@ void GGEMSSolidBox::PrintInfos(void) const
     GGcout("GGEMSVoxelizedSolid", "PrintInfos", 0) << "    - Z: " << solid_data_device->obb_geometry_.border_min_xyz_.s[2] << " <-> " << solid_data_device->obb_geometry_.border_max_xyz_.s[2] << GGendl;
     GGcout("GGEMSSolidBox", "PrintInfos", 0) << "    - Transformation matrix:" << GGendl;
     GGcout("GGEMSSolidBox", "PrintInfos", 0) << "    [" << GGendl;
-    GGcout("GGEMSSolidBox", "PrintInfos", 0) << "        " << solid_data_device->obb_geometry_.matrix_transformation_.m0_[0] << " " << solid_data_device->obb_geometry_.matrix_transformation_.m0_[1] << " " << solid_data_device->obb_geometry_.matrix_transformation_.m0_[2] << " " << solid_data_device->obb_geometry_.matrix_transformation_.m0_[3] << GGendl;
-    GGcout("GGEMSSolidBox", "PrintInfos", 0) << "        " << solid_data_device->obb_geometry_.matrix_transformation_.m1_[0] << " " << solid_data_device->obb_geometry_.matrix_transformation_.m1_[1] << " " << solid_data_device->obb_geometry_.matrix_transformation_.m1_[2] << " " << solid_data_device->obb_geometry_.matrix_transformation_.m1_[3] << GGendl;
-    GGcout("GGEMSSolidBox", "PrintInfos", 0) << "        " << solid_data_device->obb_geometry_.matrix_transformation_.m2_[0] << " " << solid_data_device->obb_geometry_.matrix_transformation_.m2_[1] << " " << solid_data_device->obb_geometry_.matrix_transformation_.m2_[2] << " " << solid_data_device->obb_geometry_.matrix_transformation_.m2_[3] << GGendl;
-    GGcout("GGEMSSolidBox", "PrintInfos", 0) << "        " << solid_data_device->obb_geometry_.matrix_transformation_.m3_[0] << " " << solid_data_device->obb_geometry_.matrix_transformation_.m3_[1] << " " << solid_data_device->obb_geometry_.matrix_transformation_.m3_[2] << " " << solid_data_device->obb_geometry_.matrix_transformation_.m3_[3] << GGendl;
+    GGcout("GGEMSSolidBox", "PrintInfos", 0) << "        " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m0_[0] << " " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m0_[1] << " " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m0_[2] << " " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m0_[3] << GGendl;
+    GGcout("GGEMSSolidBox", "PrintInfos", 0) << "        " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m1_[0] << " " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m1_[1] << " " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m1_[2] << " " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m1_[3] << GGendl;
+    GGcout("GGEMSSolidBox", "PrintInfos", 0) << "        " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m2_[0] << " " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m2_[1] << " " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m2_[2] << " " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m2_[3] << GGendl;
     GGcout("GGEMSSolidBox", "PrintInfos", 0) << "    ]" << GGendl;
     GGcout("GGEMSSolidBox", "PrintInfos", 0) << "* Solid index: " << solid_data_device->solid_id_ << GGendl;
+    GGcout("GGEMSSolidBox", "PrintInfos", 0) << "* Number of neighbour solids: " << solid_data_device->number_of_neighbour_solids_ << GGendl;
     GGcout("GGEMSSolidBox", "PrintInfos", 0) << GGendl;
 
     // Releasing the pointer
@@ -272,14 +359,9 @@ void GGEMSSolidBox::UpdateTransformationMatrix(GGsize const& thread_index)
 
   // Copy information to OBB
   GGEMSSolidBoxData* solid_data_device = opencl_manager.GetDeviceBuffer<GGEMSSolidBoxData>(solid_data_[thread_index], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSSolidBoxData), thread_index);
-  GGfloat44* transformation_matrix_device = opencl_manager.GetDeviceBuffer<GGfloat44>(geometry_transformation_->GetTransformationMatrix(thread_index), CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGfloat44), thread_index);
+  GGEMSTransformationMatrix* transformation_matrix_device = opencl_manager.GetDeviceBuffer<GGEMSTransformationMatrix>(geometry_transformation_->GetTransformationMatrix(thread_index), CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSTransformationMatrix), thread_index);
 
-  for (GGint i = 0; i < 4; ++i) {
-    solid_data_device->obb_geometry_.matrix_transformation_.m0_[i] = transformation_matrix_device->m0_[i];
-    solid_data_device->obb_geometry_.matrix_transformation_.m1_[i] = transformation_matrix_device->m1_[i];
-    solid_data_device->obb_geometry_.matrix_transformation_.m2_[i] = transformation_matrix_device->m2_[i];
-    solid_data_device->obb_geometry_.matrix_transformation_.m3_[i] = transformation_matrix_device->m3_[i];
-  }
+  solid_data_device->obb_geometry_.matrix_transformation_ = *transformation_matrix_device;
 
   // Release the pointer
   opencl_manager.ReleaseDeviceBuffer(solid_data_[thread_index], solid_data_device, thread_index);
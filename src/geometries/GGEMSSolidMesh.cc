@@ -0,0 +1,511 @@
+// ************************************************************************
+// * This file is part of GGEMS.                                          *
+// *                                                                      *
+// * GGEMS is free software: you can redistribute it and/or modify        *
+// * it under the terms of the GNU General Public License as published by *
+// * the Free Software Foundation, either version 3 of the License, or    *
+// * (at your option) any later version.                                  *
+// *                                                                      *
+// * GGEMS is distributed in the hope that it will be useful,             *
+// * but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+// * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+// * GNU General Public License for more details.                         *
+// *                                                                      *
+// * You should have received a copy of the GNU General Public License    *
+// * along with GGEMS.  If not, see <https://www.gnu.org/licenses/>.      *
+// *                                                                      *
+// ************************************************************************
+
+/*!
+  \file GGEMSSolidMesh.cc
+
+  \brief GGEMS class for solid mesh, a closed triangle mesh (STL or OBJ file) filled with one material
+
+  \author Julien BERT <julien.bert@univ-brest.fr>
+  \author Didier BENOIT <didier.benoit@inserm.fr>
+  \author LaTIM, INSERM - U1101, Brest, FRANCE
+  \version 1.0
+  \date Sunday October 18, 2026
+*/
+
+#include <map>
+#include <array>
+#include <numeric>
+
+#include "GGEMS/geometries/GGEMSSolidMesh.hh"
+#include "GGEMS/geometries/GGEMSGeometryConstants.hh"
+#include "GGEMS/maths/GGEMSGeometryTransformation.hh"
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+GGEMSSolidMesh::GGEMSSolidMesh(std::string const& mesh_filename)
+: GGEMSSolid(),
+  mesh_filename_(mesh_filename),
+  mesh_data_size_(0)
+{
+  GGcout("GGEMSSolidMesh", "GGEMSSolidMesh", 3) << "GGEMSSolidMesh creating..." << GGendl;
+
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  // Loop over the device
+  for (GGsize d = 0; d < number_activated_devices_; ++d) {
+    // BVH and triangles are stored in label buffer during initialization
+    label_data_[d] = nullptr;
+
+    // Allocating memory on OpenCL device
+    solid_data_[d] = opencl_manager.Allocate(nullptr, sizeof(GGEMSSolidMeshData), d, CL_MEM_READ_WRITE, "GGEMSSolidMesh");
+  }
+
+  GGcout("GGEMSSolidMesh", "GGEMSSolidMesh", 3) << "GGEMSSolidMesh created!!!" << GGendl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+GGEMSSolidMesh::~GGEMSSolidMesh(void)
+{
+  GGcout("GGEMSSolidMesh", "~GGEMSSolidMesh", 3) << "GGEMSSolidMesh erasing..." << GGendl;
+
+  // Get the opencl manager
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  // Mesh data is deleted here, size is different from number of voxels
+  if (label_data_) {
+    for (GGsize i = 0; i < number_activated_devices_; ++i) {
+      opencl_manager.Deallocate(label_data_[i], mesh_data_size_, i);
+    }
+    delete[] label_data_;
+    label_data_ = nullptr;
+  }
+
+  // Solid data is deleted here, size is different from GGEMSSolidBoxData
+  if (solid_data_) {
+    for (GGsize i = 0; i < number_activated_devices_; ++i) {
+      opencl_manager.Deallocate(solid_data_[i], sizeof(GGEMSSolidMeshData), i);
+    }
+    delete[] solid_data_;
+    solid_data_ = nullptr;
+  }
+
+  GGcout("GGEMSSolidMesh", "~GGEMSSolidMesh", 3) << "GGEMSSolidMesh erased!!!" << GGendl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSolidMesh::InitializeKernel(void)
+{
+  GGcout("GGEMSSolidMesh", "InitializeKernel", 3) << "Initializing kernel for solid mesh..." << GGendl;
+
+  // Getting the OpenCLManager singleton
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  // Getting the path to kernel
+  std::string openCL_kernel_path = OPENCL_KERNEL_PATH;
+  std::string particle_solid_distance_filename = openCL_kernel_path + "/ParticleSolidDistanceGGEMSSolidMesh.cl";
+  std::string project_to_filename = openCL_kernel_path + "/ProjectToGGEMSSolidMesh.cl";
+  std::string track_through_filename = openCL_kernel_path + "/TrackThroughGGEMSSolidMesh.cl";
+
+  // Compiling the kernels
+  opencl_manager.CompileKernel(particle_solid_distance_filename, "particle_solid_distance_ggems_solid_mesh", kernel_particle_solid_distance_, nullptr, const_cast<char*>(kernel_option_.c_str()));
+  opencl_manager.CompileKernel(project_to_filename, "project_to_ggems_solid_mesh", kernel_project_to_solid_, nullptr, const_cast<char*>(kernel_option_.c_str()));
+  opencl_manager.CompileKernel(track_through_filename, "track_through_ggems_solid_mesh", kernel_track_through_solid_, nullptr, const_cast<char*>(kernel_option_.c_str()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSolidMesh::Initialize(GGEMSMaterials*)
+{
+  GGcout("GGEMSSolidMesh", "Initialize", 3) << "Initializing solid mesh..." << GGendl;
+
+  // Initializing kernels
+  InitializeKernel();
+
+  // Loading triangles of mesh
+  std::vector<GGfloat> vertices;
+  LoadMesh(vertices);
+
+  GGsize number_of_triangles = vertices.size() / 9;
+  if (number_of_triangles == 0) {
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "No triangle in mesh file " << mesh_filename_ << "!!!";
+    GGEMSMisc::ThrowException("GGEMSSolidMesh", "Initialize", oss.str());
+  }
+
+  CheckClosedMesh(vertices);
+
+  // Orientation of mesh from its signed volume, triangles are flipped if normals point inward
+  GGdouble signed_volume = 0.0;
+  for (GGsize i = 0; i < number_of_triangles; ++i) {
+    GGfloat const* v = &vertices[9*i];
+    signed_volume += static_cast<GGdouble>(v[0]) * (static_cast<GGdouble>(v[4])*v[8] - static_cast<GGdouble>(v[5])*v[7])
+      - static_cast<GGdouble>(v[1]) * (static_cast<GGdouble>(v[3])*v[8] - static_cast<GGdouble>(v[5])*v[6])
+      + static_cast<GGdouble>(v[2]) * (static_cast<GGdouble>(v[3])*v[7] - static_cast<GGdouble>(v[4])*v[6]);
+  }
+  bool is_flipped = signed_volume < 0.0;
+
+  // Triangles with precomputed edges and their centroids
+  std::vector<GGEMSMeshTriangle> triangles(number_of_triangles);
+  std::vector<GGfloat3> centroids(number_of_triangles);
+  for (GGsize i = 0; i < number_of_triangles; ++i) {
+    GGfloat const* v = &vertices[9*i];
+    GGsize second_vertex = is_flipped ? 6 : 3;
+    GGsize third_vertex = is_flipped ? 3 : 6;
+    for (GGsize j = 0; j < 3; ++j) {
+      triangles[i].vertex_.s[j] = v[j];
+      triangles[i].edge_1_.s[j] = v[second_vertex+j] - v[j];
+      triangles[i].edge_2_.s[j] = v[third_vertex+j] - v[j];
+      centroids[i].s[j] = (v[j] + v[3+j] + v[6+j]) / 3.0f;
+    }
+  }
+
+  // Building BVH, root node bounds the whole mesh
+  std::vector<GGEMSMeshBVHNode> bvh_nodes;
+  bvh_nodes.reserve(2*number_of_triangles/MESH_BVH_LEAF_SIZE + 1);
+  GGsize bvh_depth = BuildBVH(triangles, centroids, 0, number_of_triangles, 0, bvh_nodes);
+
+  if (bvh_depth >= MESH_BVH_STACK_SIZE) {
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "Depth of BVH (" << bvh_depth << ") is too large, maximum depth is " << MESH_BVH_STACK_SIZE - 1 << "!!!";
+    GGEMSMisc::ThrowException("GGEMSSolidMesh", "Initialize", oss.str());
+  }
+
+  GGcout("GGEMSSolidMesh", "Initialize", 2) << "Mesh " << mesh_filename_ << ": " << number_of_triangles << " triangles, " << bvh_nodes.size() << " BVH nodes, BVH depth " << bvh_depth << GGendl;
+
+  // BVH nodes followed by triangles in label buffer
+  GGsize bvh_nodes_size = bvh_nodes.size() * sizeof(GGEMSMeshBVHNode);
+  GGsize triangles_size = number_of_triangles * sizeof(GGEMSMeshTriangle);
+  mesh_data_size_ = bvh_nodes_size + triangles_size;
+
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  // Loop over the device
+  for (GGsize d = 0; d < number_activated_devices_; ++d) {
+    label_data_[d] = opencl_manager.Allocate(nullptr, mesh_data_size_, d, CL_MEM_READ_WRITE, "GGEMSSolidMesh");
+    GGuchar* mesh_data_device = opencl_manager.GetDeviceBuffer<GGuchar>(label_data_[d], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, mesh_data_size_, d);
+
+    std::memcpy(mesh_data_device, bvh_nodes.data(), bvh_nodes_size);
+    std::memcpy(mesh_data_device + bvh_nodes_size, triangles.data(), triangles_size);
+
+    // Releasing pointer
+    opencl_manager.ReleaseDeviceBuffer(label_data_[d], mesh_data_device, d);
+
+    // Bounding box of mesh is the box of root node
+    GGEMSSolidMeshData* solid_data_device = opencl_manager.GetDeviceBuffer<GGEMSSolidMeshData>(solid_data_[d], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSSolidMeshData), d);
+
+    solid_data_device->obb_geometry_.border_min_xyz_ = bvh_nodes[0].border_min_xyz_;
+    solid_data_device->obb_geometry_.border_max_xyz_ = bvh_nodes[0].border_max_xyz_;
+    solid_data_device->number_of_triangles_ = static_cast<GGint>(number_of_triangles);
+    solid_data_device->number_of_bvh_nodes_ = static_cast<GGint>(bvh_nodes.size());
+
+    // Releasing pointer
+    opencl_manager.ReleaseDeviceBuffer(solid_data_[d], solid_data_device, d);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSolidMesh::LoadMesh(std::vector<GGfloat>& vertices) const
+{
+  GGcout("GGEMSSolidMesh", "LoadMesh", 3) << "Loading mesh file " << mesh_filename_ << "..." << GGendl;
+
+  // Format of mesh from extension of file
+  std::string extension = mesh_filename_.substr(mesh_filename_.find_last_of(".") + 1);
+  std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+
+  if (extension == "stl") {
+    LoadSTL(vertices);
+  }
+  else if (extension == "obj") {
+    LoadOBJ(vertices);
+  }
+  else {
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "Unknown format of mesh file " << mesh_filename_ << "!!!" << std::endl;
+    oss << "Available formats are:" << std::endl;
+    oss << "    - STL (binary or ASCII)" << std::endl;
+    oss << "    - OBJ" << std::endl;
+    GGEMSMisc::ThrowException("GGEMSSolidMesh", "LoadMesh", oss.str());
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSolidMesh::LoadSTL(std::vector<GGfloat>& vertices) const
+{
+  std::ifstream mesh_stream(mesh_filename_, std::ios::in | std::ios::binary);
+  GGEMSFileStream::CheckInputStream(mesh_stream, mesh_filename_);
+
+  // Size of file
+  mesh_stream.seekg(0, std::ios::end);
+  GGsize file_size = static_cast<GGsize>(mesh_stream.tellg());
+  mesh_stream.seekg(0, std::ios::beg);
+
+  // Binary STL: header of 80 bytes, number of triangles and 50 bytes per triangle
+  uint32_t number_of_triangles = 0;
+  if (file_size >= 84) {
+    mesh_stream.seekg(80, std::ios::beg);
+    mesh_stream.read(reinterpret_cast<char*>(&number_of_triangles), sizeof(uint32_t));
+  }
+
+  if (file_size >= 84 && file_size == 84 + 50 * static_cast<GGsize>(number_of_triangles)) {
+    vertices.resize(9 * static_cast<GGsize>(number_of_triangles));
+
+    char triangle_record[50];
+    for (GGsize i = 0; i < number_of_triangles; ++i) {
+      mesh_stream.read(triangle_record, 50);
+      // Normal (12 bytes) is skipped, orientation is given by order of vertices
+      std::memcpy(&vertices[9*i], triangle_record + 12, 9 * sizeof(GGfloat));
+    }
+  }
+  else {
+    // ASCII STL, only vertices are read
+    mesh_stream.close();
+    mesh_stream.open(mesh_filename_, std::ios::in);
+
+    std::string keyword;
+    while (mesh_stream >> keyword) {
+      if (keyword == "vertex") {
+        GGfloat x = 0.0f, y = 0.0f, z = 0.0f;
+        mesh_stream >> x >> y >> z;
+        vertices.push_back(x);
+        vertices.push_back(y);
+        vertices.push_back(z);
+      }
+    }
+
+    if (vertices.size() % 9 != 0) {
+      std::ostringstream oss(std::ostringstream::out);
+      oss << "Number of vertices in STL file " << mesh_filename_ << " is not a multiple of 3!!!";
+      GGEMSMisc::ThrowException("GGEMSSolidMesh", "LoadSTL", oss.str());
+    }
+  }
+
+  mesh_stream.close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSolidMesh::LoadOBJ(std::vector<GGfloat>& vertices) const
+{
+  std::ifstream mesh_stream(mesh_filename_, std::ios::in);
+  GGEMSFileStream::CheckInputStream(mesh_stream, mesh_filename_);
+
+  std::vector<GGfloat> obj_vertices;
+  std::string line;
+  while (std::getline(mesh_stream, line)) {
+    std::istringstream line_stream(line);
+    std::string keyword;
+    line_stream >> keyword;
+
+    if (keyword == "v") {
+      GGfloat x = 0.0f, y = 0.0f, z = 0.0f;
+      line_stream >> x >> y >> z;
+      obj_vertices.push_back(x);
+      obj_vertices.push_back(y);
+      obj_vertices.push_back(z);
+    }
+    else if (keyword == "f") {
+      // Index of vertex is before first '/', negative index is relative to last vertex
+      std::vector<GGsize> face;
+      std::string face_vertex;
+      while (line_stream >> face_vertex) {
+        GGlong index = std::stol(face_vertex.substr(0, face_vertex.find('/')));
+        GGlong number_of_vertices = static_cast<GGlong>(obj_vertices.size() / 3);
+        if (index < 0) index += number_of_vertices + 1;
+
+        if (index < 1 || index > number_of_vertices) {
+          std::ostringstream oss(std::ostringstream::out);
+          oss << "Vertex index " << face_vertex << " out of range in OBJ file " << mesh_filename_ << "!!!";
+          GGEMSMisc::ThrowException("GGEMSSolidMesh", "LoadOBJ", oss.str());
+        }
+        face.push_back(static_cast<GGsize>(index - 1));
+      }
+
+      // Polygonal face split in triangle fan
+      for (GGsize i = 1; i + 1 < face.size(); ++i) {
+        for (GGsize j = 0; j < 3; ++j) vertices.push_back(obj_vertices[3*face[0]+j]);
+        for (GGsize j = 0; j < 3; ++j) vertices.push_back(obj_vertices[3*face[i]+j]);
+        for (GGsize j = 0; j < 3; ++j) vertices.push_back(obj_vertices[3*face[i+1]+j]);
+      }
+    }
+  }
+
+  mesh_stream.close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSolidMesh::CheckClosedMesh(std::vector<GGfloat> const& vertices) const
+{
+  // Vertices shared by triangles are merged using their coordinates
+  std::map<std::array<GGfloat, 3>, GGsize> vertex_indices;
+  std::map<std::pair<GGsize, GGsize>, GGsize> edge_counts;
+
+  for (GGsize i = 0; i < vertices.size() / 9; ++i) {
+    GGsize triangle_vertices[3];
+    for (GGsize j = 0; j < 3; ++j) {
+      std::array<GGfloat, 3> vertex = {vertices[9*i+3*j], vertices[9*i+3*j+1], vertices[9*i+3*j+2]};
+      triangle_vertices[j] = vertex_indices.emplace(vertex, vertex_indices.size()).first->second;
+    }
+
+    for (GGsize j = 0; j < 3; ++j) {
+      GGsize a = triangle_vertices[j];
+      GGsize b = triangle_vertices[(j+1)%3];
+      ++edge_counts[std::make_pair(std::min(a, b), std::max(a, b))];
+    }
+  }
+
+  GGsize number_of_open_edges = 0;
+  for (auto&& edge : edge_counts) {
+    if (edge.second != 2) ++number_of_open_edges;
+  }
+
+  if (number_of_open_edges != 0) {
+    GGwarn("GGEMSSolidMesh", "CheckClosedMesh", 0) << "Mesh " << mesh_filename_ << " is not closed, " << number_of_open_edges << " edges are not shared by 2 triangles. Navigation inside mesh may be wrong!!!" << GGendl;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+GGsize GGEMSSolidMesh::BuildBVH(std::vector<GGEMSMeshTriangle>& triangles, std::vector<GGfloat3>& centroids, GGsize const& first, GGsize const& last, GGsize const& depth, std::vector<GGEMSMeshBVHNode>& bvh_nodes) const
+{
+  GGsize node_id = bvh_nodes.size();
+  bvh_nodes.push_back(GGEMSMeshBVHNode());
+
+  // Borders of triangles and of centroids in node
+  GGfloat border_min[3] = {std::numeric_limits<GGfloat>::max(), std::numeric_limits<GGfloat>::max(), std::numeric_limits<GGfloat>::max()};
+  GGfloat border_max[3] = {std::numeric_limits<GGfloat>::lowest(), std::numeric_limits<GGfloat>::lowest(), std::numeric_limits<GGfloat>::lowest()};
+  GGfloat centroid_min[3] = {border_min[0], border_min[1], border_min[2]};
+  GGfloat centroid_max[3] = {border_max[0], border_max[1], border_max[2]};
+
+  for (GGsize i = first; i < last; ++i) {
+    for (GGsize j = 0; j < 3; ++j) {
+      GGfloat vertex = triangles[i].vertex_.s[j];
+      border_min[j] = std::min({border_min[j], vertex, vertex + triangles[i].edge_1_.s[j], vertex + triangles[i].edge_2_.s[j]});
+      border_max[j] = std::max({border_max[j], vertex, vertex + triangles[i].edge_1_.s[j], vertex + triangles[i].edge_2_.s[j]});
+      centroid_min[j] = std::min(centroid_min[j], centroids[i].s[j]);
+      centroid_max[j] = std::max(centroid_max[j], centroids[i].s[j]);
+    }
+  }
+
+  // Borders of node are enlarged by geometry tolerance
+  for (GGsize j = 0; j < 3; ++j) {
+    bvh_nodes[node_id].border_min_xyz_.s[j] = border_min[j] - GEOMETRY_TOLERANCE;
+    bvh_nodes[node_id].border_max_xyz_.s[j] = border_max[j] + GEOMETRY_TOLERANCE;
+  }
+
+  // Leaf of BVH
+  if (last - first <= MESH_BVH_LEAF_SIZE) {
+    bvh_nodes[node_id].index_ = static_cast<GGint>(first);
+    bvh_nodes[node_id].number_of_triangles_ = static_cast<GGint>(last - first);
+    return depth;
+  }
+
+  // Triangles split at median of centroids along largest axis
+  GGsize axis = 0;
+  for (GGsize j = 1; j < 3; ++j) {
+    if (centroid_max[j] - centroid_min[j] > centroid_max[axis] - centroid_min[axis]) axis = j;
+  }
+
+  GGsize middle = first + (last - first) / 2;
+  std::vector<GGsize> order(last - first);
+  std::iota(order.begin(), order.end(), first);
+  std::nth_element(order.begin(), order.begin() + static_cast<std::ptrdiff_t>(middle - first), order.end(),
+    [&centroids, axis](GGsize const& a, GGsize const& b) {return centroids[a].s[axis] < centroids[b].s[axis];}
+  );
+
+  std::vector<GGEMSMeshTriangle> node_triangles(last - first);
+  std::vector<GGfloat3> node_centroids(last - first);
+  for (GGsize i = 0; i < order.size(); ++i) {
+    node_triangles[i] = triangles[order[i]];
+    node_centroids[i] = centroids[order[i]];
+  }
+  std::copy(node_triangles.begin(), node_triangles.end(), triangles.begin() + static_cast<std::ptrdiff_t>(first));
+  std::copy(node_centroids.begin(), node_centroids.end(), centroids.begin() + static_cast<std::ptrdiff_t>(first));
+
+  // Left child is the next node, index of right child is stored in node
+  GGsize left_depth = BuildBVH(triangles, centroids, first, middle, depth + 1, bvh_nodes);
+  bvh_nodes[node_id].index_ = static_cast<GGint>(bvh_nodes.size());
+  bvh_nodes[node_id].number_of_triangles_ = 0;
+  GGsize right_depth = BuildBVH(triangles, centroids, middle, last, depth + 1, bvh_nodes);
+
+  return std::max(left_depth, right_depth);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSolidMesh::PrintInfos(void) const
+{
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  // Loop over the device
+  for (GGsize d = 0; d < number_activated_devices_; ++d) {
+    // Getting pointer on OpenCL device
+    GGEMSSolidMeshData* solid_data_device = opencl_manager.GetDeviceBuffer<GGEMSSolidMeshData>(solid_data_[d], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSSolidMeshData), d);
+
+    // Get the index of device
+    GGsize device_index = opencl_manager.GetIndexOfActivatedDevice(d);
+
+    GGcout("GGEMSSolidMesh", "PrintInfos", 0) << GGendl;
+    GGcout("GGEMSSolidMesh", "PrintInfos", 0) << "GGEMSSolidMesh Infos:" << GGendl;
+    GGcout("GGEMSSolidMesh", "PrintInfos", 0) << "--------------------------" << GGendl;
+    GGcout("GGEMSSolidMesh", "PrintInfos", 0) << "Material on device: " << opencl_manager.GetDeviceName(device_index) << GGendl;
+    GGcout("GGEMSSolidMesh", "PrintInfos", 0) << "* Mesh file: " << mesh_filename_ << GGendl;
+    GGcout("GGEMSSolidMesh", "PrintInfos", 0) << "* Number of triangles: " << solid_data_device->number_of_triangles_ << GGendl;
+    GGcout("GGEMSSolidMesh", "PrintInfos", 0) << "* Number of BVH nodes: " << solid_data_device->number_of_bvh_nodes_ << GGendl;
+    GGcout("GGEMSSolidMesh", "PrintInfos", 0) << "* Bounding box in local position:" << GGendl;
+    GGcout("GGEMSSolidMesh", "PrintInfos", 0) << "    - X: " << solid_data_device->obb_geometry_.border_min_xyz_.s[0] << " <-> " << solid_data_device->obb_geometry_.border_max_xyz_.s[0] << GGendl;
+    GGcout("GGEMSSolidMesh", "PrintInfos", 0) << "    - Y: " << solid_data_device->obb_geometry_.border_min_xyz_.s[1] << " <-> " << solid_data_device->obb_geometry_.border_max_xyz_.s[1] << GGendl;
+    GGcout("GGEMSSolidMesh", "PrintInfos", 0) << "    - Z: " << solid_data_device->obb_geometry_.border_min_xyz_.s[2] << " <-> " << solid_data_device->obb_geometry_.border_max_xyz_.s[2] << GGendl;
+    GGcout("GGEMSSolidMesh", "PrintInfos", 0) << "    - Transformation matrix:" << GGendl;
+    GGcout("GGEMSSolidMesh", "PrintInfos", 0) << "    [" << GGendl;
+    GGcout("GGEMSSolidMesh", "PrintInfos", 0) << "        " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m0_[0] << " " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m0_[1] << " " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m0_[2] << " " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m0_[3] << GGendl;
+    GGcout("GGEMSSolidMesh", "PrintInfos", 0) << "        " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m1_[0] << " " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m1_[1] << " " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m1_[2] << " " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m1_[3] << GGendl;
+    GGcout("GGEMSSolidMesh", "PrintInfos", 0) << "        " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m2_[0] << " " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m2_[1] << " " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m2_[2] << " " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m2_[3] << GGendl;
+    GGcout("GGEMSSolidMesh", "PrintInfos", 0) << "    ]" << GGendl;
+    GGcout("GGEMSSolidMesh", "PrintInfos", 0) << "* Solid index: " << solid_data_device->solid_id_ << GGendl;
+    GGcout("GGEMSSolidMesh", "PrintInfos", 0) << GGendl;
+
+    // Releasing the pointer
+    opencl_manager.ReleaseDeviceBuffer(solid_data_[d], solid_data_device, d);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSolidMesh::UpdateTransformationMatrix(GGsize const& thread_index)
+{
+  // Get the OpenCL manager
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  // Copy information to OBB
+  GGEMSSolidMeshData* solid_data_device = opencl_manager.GetDeviceBuffer<GGEMSSolidMeshData>(solid_data_[thread_index], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSSolidMeshData), thread_index);
+  GGEMSTransformationMatrix* transformation_matrix_device = opencl_manager.GetDeviceBuffer<GGEMSTransformationMatrix>(geometry_transformation_->GetTransformationMatrix(thread_index), CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSTransformationMatrix), thread_index);
+
+  solid_data_device->obb_geometry_.matrix_transformation_ = *transformation_matrix_device;
+
+  // Release the pointer
+  opencl_manager.ReleaseDeviceBuffer(solid_data_[thread_index], solid_data_device, thread_index);
+  opencl_manager.ReleaseDeviceBuffer(geometry_transformation_->GetTransformationMatrix(thread_index), transformation_matrix_device, thread_index);
+}
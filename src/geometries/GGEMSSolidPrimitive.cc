@@ -0,0 +1,199 @@
+// ************************************************************************
+// * This file is part of GGEMS.                                          *
+// *                                                                      *
+// * GGEMS is free software: you can redistribute it and/or modify        *
+// * it under the terms of the GNU General Public License as published by *
+// * the Free Software Foundation, either version 3 of the License, or    *
+// * (at your option) any later version.                                  *
+// *                                                                      *
+// * GGEMS is distributed in the hope that it will be useful,             *
+// * but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+// * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+// * GNU General Public License for more details.                         *
+// *                                                                      *
+// * You should have received a copy of the GNU General Public License    *
+// * along with GGEMS.  If not, see <https://www.gnu.org/licenses/>.      *
+// *                                                                      *
+// ************************************************************************
+
+/*!
+  \file GGEMSSolidPrimitive.cc
+
+  \brief GGEMS class for analytic primitive solid (ellipsoid, sphere or cylinder) filled with one material
+
+  \author Julien BERT <julien.bert@univ-brest.fr>
+  \author Didier BENOIT <didier.benoit@inserm.fr>
+  \author LaTIM, INSERM - U1101, Brest, FRANCE
+  \version 1.0
+  \date Sunday October 18, 2026
+*/
+
+#include "GGEMS/geometries/GGEMSSolidPrimitive.hh"
+#include "GGEMS/geometries/GGEMSSolidPrimitiveData.hh"
+#include "GGEMS/maths/GGEMSGeometryTransformation.hh"
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+GGEMSSolidPrimitive::GGEMSSolidPrimitive(GGint const& primitive_type, GGfloat3 const& half_size_xyz)
+: GGEMSSolid()
+{
+  GGcout("GGEMSSolidPrimitive", "GGEMSSolidPrimitive", 3) << "GGEMSSolidPrimitive creating..." << GGendl;
+
+  if (primitive_type != ELLIPSOID_PRIMITIVE && primitive_type != CYLINDER_PRIMITIVE) {
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "Unknown type of primitive: " << primitive_type << "!!!";
+    GGEMSMisc::ThrowException("GGEMSSolidPrimitive", "GGEMSSolidPrimitive", oss.str());
+  }
+
+  if (half_size_xyz.s[0] <= 0.0f || half_size_xyz.s[1] <= 0.0f || half_size_xyz.s[2] <= 0.0f) {
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "Sizes of primitive have to be > 0!!!";
+    GGEMSMisc::ThrowException("GGEMSSolidPrimitive", "GGEMSSolidPrimitive", oss.str());
+  }
+
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  // Loop over the device
+  for (GGsize d = 0; d < number_activated_devices_; ++d) {
+    // No label for a primitive, solid is filled with one material
+    label_data_[d] = nullptr;
+
+    // Allocating memory on OpenCL device and getting pointer on it
+    solid_data_[d] = opencl_manager.Allocate(nullptr, sizeof(GGEMSSolidPrimitiveData), d, CL_MEM_READ_WRITE, "GGEMSSolidPrimitive");
+    GGEMSSolidPrimitiveData* solid_data_device = opencl_manager.GetDeviceBuffer<GGEMSSolidPrimitiveData>(solid_data_[d], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSSolidPrimitiveData), d);
+
+    solid_data_device->primitive_type_ = primitive_type;
+
+    // Bounding box of primitive
+    for (GGint i = 0; i < 3; ++i) {
+      solid_data_device->half_size_xyz_.s[i] = half_size_xyz.s[i];
+      solid_data_device->obb_geometry_.border_min_xyz_.s[i] = -half_size_xyz.s[i];
+      solid_data_device->obb_geometry_.border_max_xyz_.s[i] = half_size_xyz.s[i];
+    }
+
+    // Releasing pointer
+    opencl_manager.ReleaseDeviceBuffer(solid_data_[d], solid_data_device, d);
+  }
+
+  GGcout("GGEMSSolidPrimitive", "GGEMSSolidPrimitive", 3) << "GGEMSSolidPrimitive created!!!" << GGendl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+GGEMSSolidPrimitive::~GGEMSSolidPrimitive(void)
+{
+  GGcout("GGEMSSolidPrimitive", "~GGEMSSolidPrimitive", 3) << "GGEMSSolidPrimitive erasing..." << GGendl;
+
+  // Get the opencl manager
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  // Solid data is deleted here, size is different from GGEMSSolidBoxData
+  if (solid_data_) {
+    for (GGsize i = 0; i < number_activated_devices_; ++i) {
+      opencl_manager.Deallocate(solid_data_[i], sizeof(GGEMSSolidPrimitiveData), i);
+    }
+    delete[] solid_data_;
+    solid_data_ = nullptr;
+  }
+
+  GGcout("GGEMSSolidPrimitive", "~GGEMSSolidPrimitive", 3) << "GGEMSSolidPrimitive erased!!!" << GGendl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSolidPrimitive::InitializeKernel(void)
+{
+  GGcout("GGEMSSolidPrimitive", "InitializeKernel", 3) << "Initializing kernel for solid primitive..." << GGendl;
+
+  // Getting the OpenCLManager singleton
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  // Getting the path to kernel
+  std::string openCL_kernel_path = OPENCL_KERNEL_PATH;
+  std::string particle_solid_distance_filename = openCL_kernel_path + "/ParticleSolidDistanceGGEMSSolidPrimitive.cl";
+  std::string project_to_filename = openCL_kernel_path + "/ProjectToGGEMSSolidPrimitive.cl";
+  std::string track_through_filename = openCL_kernel_path + "/TrackThroughGGEMSSolidPrimitive.cl";
+
+  // Compiling the kernels
+  opencl_manager.CompileKernel(particle_solid_distance_filename, "particle_solid_distance_ggems_solid_primitive", kernel_particle_solid_distance_, nullptr, const_cast<char*>(kernel_option_.c_str()));
+  opencl_manager.CompileKernel(project_to_filename, "project_to_ggems_solid_primitive", kernel_project_to_solid_, nullptr, const_cast<char*>(kernel_option_.c_str()));
+  opencl_manager.CompileKernel(track_through_filename, "track_through_ggems_solid_primitive", kernel_track_through_solid_, nullptr, const_cast<char*>(kernel_option_.c_str()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSolidPrimitive::Initialize(GGEMSMaterials*)
+{
+  GGcout("GGEMSSolidPrimitive", "Initialize", 3) << "Initializing solid primitive..." << GGendl;
+
+  // Initializing kernels
+  InitializeKernel();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSolidPrimitive::PrintInfos(void) const
+{
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  // Loop over the device
+  for (GGsize d = 0; d < number_activated_devices_; ++d) {
+    // Getting pointer on OpenCL device
+    GGEMSSolidPrimitiveData* solid_data_device = opencl_manager.GetDeviceBuffer<GGEMSSolidPrimitiveData>(solid_data_[d], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSSolidPrimitiveData), d);
+
+    // Get the index of device
+    GGsize device_index = opencl_manager.GetIndexOfActivatedDevice(d);
+
+    GGcout("GGEMSSolidPrimitive", "PrintInfos", 0) << GGendl;
+    GGcout("GGEMSSolidPrimitive", "PrintInfos", 0) << "GGEMSSolidPrimitive Infos:" << GGendl;
+    GGcout("GGEMSSolidPrimitive", "PrintInfos", 0) << "--------------------------" << GGendl;
+    GGcout("GGEMSSolidPrimitive", "PrintInfos", 0) << "Material on device: " << opencl_manager.GetDeviceName(device_index) << GGendl;
+    GGcout("GGEMSSolidPrimitive", "PrintInfos", 0) << "* Primitive: " << (solid_data_device->primitive_type_ == ELLIPSOID_PRIMITIVE ? "ellipsoid" : "cylinder") << GGendl;
+    GGcout("GGEMSSolidPrimitive", "PrintInfos", 0) << "* Half size: " << solid_data_device->half_size_xyz_.s[0] << "x" << solid_data_device->half_size_xyz_.s[1] << "x" << solid_data_device->half_size_xyz_.s[2] << " mm" << GGendl;
+    GGcout("GGEMSSolidPrimitive", "PrintInfos", 0) << "* Bounding box in local position:" << GGendl;
+    GGcout("GGEMSSolidPrimitive", "PrintInfos", 0) << "    - X: " << solid_data_device->obb_geometry_.border_min_xyz_.s[0] << " <-> " << solid_data_device->obb_geometry_.border_max_xyz_.s[0] << GGendl;
+    GGcout("GGEMSSolidPrimitive", "PrintInfos", 0) << "    - Y: " << solid_data_device->obb_geometry_.border_min_xyz_.s[1] << " <-> " << solid_data_device->obb_geometry_.border_max_xyz_.s[1] << GGendl;
+    GGcout("GGEMSSolidPrimitive", "PrintInfos", 0) << "    - Z: " << solid_data_device->obb_geometry_.border_min_xyz_.s[2] << " <-> " << solid_data_device->obb_geometry_.border_max_xyz_.s[2] << GGendl;
+    GGcout("GGEMSSolidPrimitive", "PrintInfos", 0) << "    - Transformation matrix:" << GGendl;
+    GGcout("GGEMSSolidPrimitive", "PrintInfos", 0) << "    [" << GGendl;
+    GGcout("GGEMSSolidPrimitive", "PrintInfos", 0) << "        " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m0_[0] << " " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m0_[1] << " " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m0_[2] << " " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m0_[3] << GGendl;
+    GGcout("GGEMSSolidPrimitive", "PrintInfos", 0) << "        " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m1_[0] << " " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m1_[1] << " " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m1_[2] << " " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m1_[3] << GGendl;
+    GGcout("GGEMSSolidPrimitive", "PrintInfos", 0) << "        " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m2_[0] << " " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m2_[1] << " " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m2_[2] << " " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m2_[3] << GGendl;
+    GGcout("GGEMSSolidPrimitive", "PrintInfos", 0) << "    ]" << GGendl;
+    GGcout("GGEMSSolidPrimitive", "PrintInfos", 0) << "* Solid index: " << solid_data_device->solid_id_ << GGendl;
+    GGcout("GGEMSSolidPrimitive", "PrintInfos", 0) << GGendl;
+
+    // Releasing the pointer
+    opencl_manager.ReleaseDeviceBuffer(solid_data_[d], solid_data_device, d);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSolidPrimitive::UpdateTransformationMatrix(GGsize const& thread_index)
+{
+  // Get the OpenCL manager
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  // Copy information to OBB
+  GGEMSSolidPrimitiveData* solid_data_device = opencl_manager.GetDeviceBuffer<GGEMSSolidPrimitiveData>(solid_data_[thread_index], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSSolidPrimitiveData), thread_index);
+  GGEMSTransformationMatrix* transformation_matrix_device = opencl_manager.GetDeviceBuffer<GGEMSTransformationMatrix>(geometry_transformation_->GetTransformationMatrix(thread_index), CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSTransformationMatrix), thread_index);
+
+  solid_data_device->obb_geometry_.matrix_transformation_ = *transformation_matrix_device;
+
+  // Release the pointer
+  opencl_manager.ReleaseDeviceBuffer(solid_data_[thread_index], solid_data_device, thread_index);
+  opencl_manager.ReleaseDeviceBuffer(geometry_transformation_->GetTransformationMatrix(thread_index), transformation_matrix_device, thread_index);
+}
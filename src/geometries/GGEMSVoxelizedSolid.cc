@@ -28,9 +28,12 @@
   \date Wednesday June 10, 2020
 */
 
+#include <algorithm>
+
 #include "GGEMS/geometries/GGEMSVoxelizedSolid.hh"
 #include "GGEMS/io/GGEMSMHDImage.hh"
 #include "GGEMS/maths/GGEMSGeometryTransformation.hh"
+#include "GGEMS/maths/GGEMSMatrixOperations.hh"
 #include "GGEMS/graphics/GGEMSOpenGLParaGrid.hh"
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -40,7 +43,9 @@
 GGEMSVoxelizedSolid::GGEMSVoxelizedSolid(std::string const& volume_header_filename, std::string const& range_filename, std::string const& data_reg_type)
 : GGEMSSolid(),
   volume_header_filename_(volume_header_filename),
-  range_filename_(range_filename)
+  range_filename_(range_filename),
+  motion_phase_filenames_(1, volume_header_filename),
+  motion_phase_translations_(1, {{0.0f, 0.0f, 0.0f}})
 {
   GGcout("GGEMSVoxelizedSolid", "GGEMSVoxelizedSolid", 3) << "GGEMSVoxelizedSolid creating..." << GGendl;
 
@@ -52,6 +57,9 @@ GGEMSVoxelizedSolid::GGEMSVoxelizedSolid(std::string const& volume_header_filena
     solid_data_[d] = opencl_manager.Allocate(nullptr, sizeof(GGEMSVoxelizedSolidData), d, CL_MEM_READ_WRITE, "GGEMSVoxelizedSolid");
   }
 
+  // First motion phase on each device
+  current_motion_phases_.resize(number_activated_devices_, 0);
+
   // Local axis for phantom. Voxelized solid used only for phantom
   geometry_transformation_->SetAxisTransformation(
     {
@@ -167,14 +175,16 @@ void GGEMSVoxelizedSolid::UpdateTransformationMatrix(GGsize const& thread_index)
 
   // Copy information to OBB
   GGEMSVoxelizedSolidData* solid_data_device = opencl_manager.GetDeviceBuffer<GGEMSVoxelizedSolidData>(solid_data_[thread_index], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSVoxelizedSolidData), thread_index);
-  GGfloat44* transformation_matrix_device = opencl_manager.GetDeviceBuffer<GGfloat44>(geometry_transformation_->GetTransformationMatrix(thread_index), CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGfloat44), thread_index);
+  GGEMSTransformationMatrix* transformation_matrix_device = opencl_manager.GetDeviceBuffer<GGEMSTransformationMatrix>(geometry_transformation_->GetTransformationMatrix(thread_index), CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSTransformationMatrix), thread_index);
 
-  for (GGint i = 0; i < 4; ++i) {
-    solid_data_device->obb_geometry_.matrix_transformation_.m0_[i] = transformation_matrix_device->m0_[i];
-    solid_data_device->obb_geometry_.matrix_transformation_.m1_[i] = transformation_matrix_device->m1_[i];
-    solid_data_device->obb_geometry_.matrix_transformation_.m2_[i] = transformation_matrix_device->m2_[i];
-    solid_data_device->obb_geometry_.matrix_transformation_.m3_[i] = transformation_matrix_device->m3_[i];
-  }
+  solid_data_device->obb_geometry_.matrix_transformation_ = *transformation_matrix_device;
+
+  // Translation of the current motion phase
+  GGfloat3 motion_phase_translation = motion_phase_translations_[current_motion_phases_[thread_index]];
+  solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m0_[3] += motion_phase_translation.s[0];
+  solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m1_[3] += motion_phase_translation.s[1];
+  solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m2_[3] += motion_phase_translation.s[2];
+  ComputeGlobalToLocalMatrix(&solid_data_device->obb_geometry_.matrix_transformation_);
 
   // Release the pointer
   opencl_manager.ReleaseDeviceBuffer(solid_data_[thread_index], solid_data_device, thread_index);
@@ -247,10 +257,9 @@ void GGEMSVoxelizedSolid::PrintInfos(void) const
     GGcout("GGEMSVoxelizedSolid", "PrintInfos", 0) << "    - Z: " << solid_data_device->obb_geometry_.border_min_xyz_.s[2] << " <-> " << solid_data_device->obb_geometry_.border_max_xyz_.s[2] << GGendl;
     GGcout("GGEMSVoxelizedSolid", "PrintInfos", 0) << "    - Transformation matrix:" << GGendl;
     GGcout("GGEMSVoxelizedSolid", "PrintInfos", 0) << "    [" << GGendl;
-    GGcout("GGEMSVoxelizedSolid", "PrintInfos", 0) << "        " << solid_data_device->obb_geometry_.matrix_transformation_.m0_[0] << " " << solid_data_device->obb_geometry_.matrix_transformation_.m0_[1] << " " << solid_data_device->obb_geometry_.matrix_transformation_.m0_[2] << " " << solid_data_device->obb_geometry_.matrix_transformation_.m0_[3] << GGendl;
-    GGcout("GGEMSVoxelizedSolid", "PrintInfos", 0) << "        " << solid_data_device->obb_geometry_.matrix_transformation_.m1_[0] << " " << solid_data_device->obb_geometry_.matrix_transformation_.m1_[1] << " " << solid_data_device->obb_geometry_.matrix_transformation_.m1_[2] << " " << solid_data_device->obb_geometry_.matrix_transformation_.m1_[3] << GGendl;
-    GGcout("GGEMSVoxelizedSolid", "PrintInfos", 0) << "        " << solid_data_device->obb_geometry_.matrix_transformation_.m2_[0] << " " << solid_data_device->obb_geometry_.matrix_transformation_.m2_[1] << " " << solid_data_device->obb_geometry_.matrix_transformation_.m2_[2] << " " << solid_data_device->obb_geometry_.matrix_transformation_.m2_[3] << GGendl;
-    GGcout("GGEMSVoxelizedSolid", "PrintInfos", 0) << "        " << solid_data_device->obb_geometry_.matrix_transformation_.m3_[0] << " " << solid_data_device->obb_geometry_.matrix_transformation_.m3_[1] << " " << solid_data_device->obb_geometry_.matrix_transformation_.m3_[2] << " " << solid_data_device->obb_geometry_.matrix_transformation_.m3_[3] << GGendl;
+    GGcout("GGEMSVoxelizedSolid", "PrintInfos", 0) << "        " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m0_[0] << " " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m0_[1] << " " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m0_[2] << " " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m0_[3] << GGendl;
+    GGcout("GGEMSVoxelizedSolid", "PrintInfos", 0) << "        " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m1_[0] << " " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m1_[1] << " " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m1_[2] << " " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m1_[3] << GGendl;
+    GGcout("GGEMSVoxelizedSolid", "PrintInfos", 0) << "        " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m2_[0] << " " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m2_[1] << " " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m2_[2] << " " << solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m2_[3] << GGendl;
     GGcout("GGEMSVoxelizedSolid", "PrintInfos", 0) << "    ]" << GGendl;
     GGcout("GGEMSVoxelizedSolid", "PrintInfos", 0) << "* Solid index: " << solid_data_device->solid_id_ << GGendl;
     GGcout("GGEMSVoxelizedSolid", "PrintInfos", 0) << GGendl;
@@ -268,6 +277,9 @@ void GGEMSVoxelizedSolid::LoadVolumeImage(GGEMSMaterials* materials)
 {
   GGcout("GGEMSVoxelizedSolid", "LoadVolumeImage", 3) << "Loading volume image from mhd file..." << GGendl;
 
+  // Get the OpenCL manager
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
   // Read MHD input file
   GGEMSMHDImage mhd_input_phantom;
   // Loop over the device
@@ -275,33 +287,203 @@ void GGEMSVoxelizedSolid::LoadVolumeImage(GGEMSMaterials* materials)
     mhd_input_phantom.Read(volume_header_filename_, solid_data_[d], d);
   }
 
+  // Get information about mhd file
+  GGEMSVoxelizedSolidData* solid_data_device = opencl_manager.GetDeviceBuffer<GGEMSVoxelizedSolidData>(solid_data_[0], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSVoxelizedSolidData), 0);
+  number_of_voxels_ = static_cast<GGsize>(solid_data_device->number_of_voxels_);
+  opencl_manager.ReleaseDeviceBuffer(solid_data_[0], solid_data_device, 0);
+
+  // Convert raw data to material id data once, then copy it on each device
+  std::vector<GGuchar> labels;
+  ConvertMHDImageToLabel(mhd_input_phantom, materials, labels);
+
+  for (GGsize d = 0; d < number_activated_devices_; ++d) {
+    // Allocating memory on OpenCL device
+    label_data_[d] = opencl_manager.Allocate(nullptr, number_of_voxels_ * sizeof(GGuchar), d, CL_MEM_READ_WRITE, "GGEMSVoxelizedSolid");
+
+    // Get pointer on OpenCL device
+    GGuchar* label_data_device = opencl_manager.GetDeviceBuffer<GGuchar>(label_data_[d], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, number_of_voxels_ * sizeof(GGuchar), d);
+
+    std::copy(labels.begin(), labels.end(), label_data_device);
+
+    // Release the pointer
+    opencl_manager.ReleaseDeviceBuffer(label_data_[d], label_data_device, d);
+  }
+
+  // Labels of first phase are kept on host only for a 4D phantom
+  if (GetNumberOfMotionPhases() > 1) {
+    reference_labels_.swap(labels);
+    LoadMotionPhases();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSVoxelizedSolid::ConvertMHDImageToLabel(GGEMSMHDImage const& mhd_image, GGEMSMaterials* materials, std::vector<GGuchar>& labels)
+{
   // Get the name of raw file from mhd reader
-  std::string output_dir = mhd_input_phantom.GetOutputDirectory();
-  std::string raw_filename = output_dir + mhd_input_phantom.GetRawMDHfilename();
+  std::string output_dir = mhd_image.GetOutputDirectory();
+  std::string raw_filename = output_dir + mhd_image.GetRawMDHfilename();
 
   // Get the type
-  std::string const kDataType = mhd_input_phantom.GetDataMHDType();
+  std::string const kDataType = mhd_image.GetDataMHDType();
 
   // Convert raw data to material id data
   if (!kDataType.compare("MET_CHAR")) {
-    ConvertImageToLabel<GGchar>(raw_filename, range_filename_, materials);
+    ConvertImageToLabel<GGchar>(raw_filename, range_filename_, materials, labels);
   }
   else if (!kDataType.compare("MET_UCHAR")) {
-    ConvertImageToLabel<GGuchar>(raw_filename, range_filename_, materials);
+    ConvertImageToLabel<GGuchar>(raw_filename, range_filename_, materials, labels);
   }
   else if (!kDataType.compare("MET_SHORT")) {
-    ConvertImageToLabel<GGshort>(raw_filename, range_filename_, materials);
+    ConvertImageToLabel<GGshort>(raw_filename, range_filename_, materials, labels);
   }
   else if (!kDataType.compare("MET_USHORT")) {
-    ConvertImageToLabel<GGushort>(raw_filename, range_filename_, materials);
+    ConvertImageToLabel<GGushort>(raw_filename, range_filename_, materials, labels);
   }
   else if (!kDataType.compare("MET_INT")) {
-    ConvertImageToLabel<GGint>(raw_filename, range_filename_, materials);
+    ConvertImageToLabel<GGint>(raw_filename, range_filename_, materials, labels);
   }
   else if (!kDataType.compare("MET_UINT")) {
-    ConvertImageToLabel<GGuint>(raw_filename, range_filename_, materials);
+    ConvertImageToLabel<GGuint>(raw_filename, range_filename_, materials, labels);
   }
   else if (!kDataType.compare("MET_FLOAT")) {
-    ConvertImageToLabel<GGfloat>(raw_filename, range_filename_, materials);
+    ConvertImageToLabel<GGfloat>(raw_filename, range_filename_, materials, labels);
   }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSVoxelizedSolid::AddMotionPhase(std::string const& volume_header_filename, GGfloat3 const& translation_xyz)
+{
+  motion_phase_filenames_.push_back(volume_header_filename);
+  motion_phase_translations_.push_back(translation_xyz);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSVoxelizedSolid::LoadMotionPhases(void)
+{
+  GGcout("GGEMSVoxelizedSolid", "LoadMotionPhases", 3) << "Loading motion phases..." << GGendl;
+
+  // Get the OpenCL manager
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  // Dimension and voxel sizes of first phase
+  GGEMSVoxelizedSolidData* solid_data_device = opencl_manager.GetDeviceBuffer<GGEMSVoxelizedSolidData>(solid_data_[0], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSVoxelizedSolidData), 0);
+  GGint3 number_of_voxels_xyz = solid_data_device->number_of_voxels_xyz_;
+  GGfloat3 voxel_sizes_xyz = solid_data_device->voxel_sizes_xyz_;
+  opencl_manager.ReleaseDeviceBuffer(solid_data_[0], solid_data_device, 0);
+
+  // Temporary buffer for header of motion phases
+  cl::Buffer* phase_solid_data = opencl_manager.Allocate(nullptr, sizeof(GGEMSVoxelizedSolidData), 0, CL_MEM_READ_WRITE, "GGEMSVoxelizedSolid");
+
+  GGsize number_of_bricks = (number_of_voxels_ + LABEL_BRICK_SIZE - 1) / LABEL_BRICK_SIZE;
+  motion_phase_bricks_.assign(GetNumberOfMotionPhases(), std::vector<GGsize>());
+  motion_phase_brick_labels_.assign(GetNumberOfMotionPhases(), std::vector<GGuchar>());
+
+  std::vector<GGuchar> labels;
+  for (GGsize p = 1; p < GetNumberOfMotionPhases(); ++p) {
+    GGEMSMHDImage mhd_phase;
+    mhd_phase.Read(motion_phase_filenames_[p], phase_solid_data, 0);
+
+    // Motion phases share the grid of first phase
+    GGEMSVoxelizedSolidData* phase_solid_data_device = opencl_manager.GetDeviceBuffer<GGEMSVoxelizedSolidData>(phase_solid_data, CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSVoxelizedSolidData), 0);
+    bool is_same_grid = true;
+    for (GGint i = 0; i < 3; ++i) {
+      if (phase_solid_data_device->number_of_voxels_xyz_.s[i] != number_of_voxels_xyz.s[i]) is_same_grid = false;
+      if (phase_solid_data_device->voxel_sizes_xyz_.s[i] != voxel_sizes_xyz.s[i]) is_same_grid = false;
+    }
+    opencl_manager.ReleaseDeviceBuffer(phase_solid_data, phase_solid_data_device, 0);
+
+    if (!is_same_grid) {
+      opencl_manager.Deallocate(phase_solid_data, sizeof(GGEMSVoxelizedSolidData), 0);
+      std::ostringstream oss(std::ostringstream::out);
+      oss << "Motion phase " << motion_phase_filenames_[p] << " must have the same dimension and voxel sizes than " << volume_header_filename_ << "!!!";
+      GGEMSMisc::ThrowException("GGEMSVoxelizedSolid", "LoadMotionPhases", oss.str());
+    }
+
+    ConvertMHDImageToLabel(mhd_phase, nullptr, labels);
+
+    // Keeping only bricks differing from first phase
+    for (GGsize b = 0; b < number_of_bricks; ++b) {
+      GGsize first_voxel = b * LABEL_BRICK_SIZE;
+      GGsize last_voxel = std::min(first_voxel + LABEL_BRICK_SIZE, number_of_voxels_);
+      if (!std::equal(labels.begin() + first_voxel, labels.begin() + last_voxel, reference_labels_.begin() + first_voxel)) {
+        motion_phase_bricks_[p].push_back(b);
+        motion_phase_brick_labels_[p].insert(motion_phase_brick_labels_[p].end(), labels.begin() + first_voxel, labels.begin() + last_voxel);
+      }
+    }
+
+    GGcout("GGEMSVoxelizedSolid", "LoadMotionPhases", 2) << "Motion phase " << p << ": " << motion_phase_bricks_[p].size() << "/" << number_of_bricks << " bricks differing from first phase" << GGendl;
+  }
+
+  opencl_manager.Deallocate(phase_solid_data, sizeof(GGEMSVoxelizedSolidData), 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSVoxelizedSolid::WriteLabelBrick(GGsize const& brick_index, GGuchar const* brick_labels, GGsize const& thread_index)
+{
+  // Get the OpenCL manager
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+  cl::CommandQueue* queue = opencl_manager.GetCommandQueue(thread_index);
+
+  // Last brick may be incomplete
+  GGsize first_voxel = brick_index * LABEL_BRICK_SIZE;
+  GGsize brick_size = std::min(static_cast<GGsize>(LABEL_BRICK_SIZE), number_of_voxels_ - first_voxel);
+
+  GGint kernel_status = queue->enqueueWriteBuffer(*label_data_[thread_index], CL_FALSE, first_voxel * sizeof(GGuchar), brick_size * sizeof(GGuchar), brick_labels);
+  opencl_manager.CheckOpenCLError(kernel_status, "GGEMSVoxelizedSolid", "WriteLabelBrick");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSVoxelizedSolid::SetMotionPhase(GGsize const& motion_phase, GGsize const& thread_index)
+{
+  if (motion_phase >= GetNumberOfMotionPhases()) {
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "Motion phase " << motion_phase << " does not exist, number of motion phases: " << GetNumberOfMotionPhases() << "!!!";
+    GGEMSMisc::ThrowException("GGEMSVoxelizedSolid", "SetMotionPhase", oss.str());
+  }
+
+  GGsize current_motion_phase = current_motion_phases_[thread_index];
+  if (motion_phase == current_motion_phase) return;
+
+  std::vector<GGsize> const& current_bricks = motion_phase_bricks_[current_motion_phase];
+  std::vector<GGsize> const& new_bricks = motion_phase_bricks_[motion_phase];
+
+  // Restoring bricks of first phase not overwritten by new phase, brick indices are sorted
+  for (GGsize k = 0; k < current_bricks.size(); ++k) {
+    if (!std::binary_search(new_bricks.begin(), new_bricks.end(), current_bricks[k])) {
+      WriteLabelBrick(current_bricks[k], &reference_labels_[current_bricks[k] * LABEL_BRICK_SIZE], thread_index);
+    }
+  }
+
+  // Writing bricks of new phase
+  for (GGsize k = 0; k < new_bricks.size(); ++k) {
+    WriteLabelBrick(new_bricks[k], &motion_phase_brick_labels_[motion_phase][k * LABEL_BRICK_SIZE], thread_index);
+  }
+
+  // Translation of motion phase is applied on top of phantom position, writes are done before in the same queue
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+  GGEMSVoxelizedSolidData* solid_data_device = opencl_manager.GetDeviceBuffer<GGEMSVoxelizedSolidData>(solid_data_[thread_index], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSVoxelizedSolidData), thread_index);
+
+  solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m0_[3] += motion_phase_translations_[motion_phase].s[0] - motion_phase_translations_[current_motion_phase].s[0];
+  solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m1_[3] += motion_phase_translations_[motion_phase].s[1] - motion_phase_translations_[current_motion_phase].s[1];
+  solid_data_device->obb_geometry_.matrix_transformation_.local_to_global_.m2_[3] += motion_phase_translations_[motion_phase].s[2] - motion_phase_translations_[current_motion_phase].s[2];
+  ComputeGlobalToLocalMatrix(&solid_data_device->obb_geometry_.matrix_transformation_);
+
+  opencl_manager.ReleaseDeviceBuffer(solid_data_[thread_index], solid_data_device, thread_index);
+
+  current_motion_phases_[thread_index] = motion_phase;
+}
@@ -220,6 +220,11 @@ void GGEMS::Initialize(GGuint const& seed)
   // Initialization of the navigators (phantom + system)
   navigator_manager.Initialize(is_tracking_verbose_);
 
+  // Photons under the minimum energy cut of the scene are killed before transport
+  GGfloat minimum_energy_cut = navigator_manager.GetMinimumEnergyCut();
+  source_manager.GetParticles()->SetEnergyCut(minimum_energy_cut);
+  GGcout("GGEMS", "Initialize", 1) << "Minimum photon energy cut of the scene: " << BestEnergyUnit(minimum_energy_cut) << GGendl;
+
   // Printing infos about OpenCL
   if (is_opencl_verbose_) {
     opencl_manager.PrintPlatformInfos();
@@ -306,6 +311,13 @@ void GGEMS::RunOnDevice(GGsize const& thread_index)
   static GGEMSProgressBar progress_bar(source_manager.GetTotalNumberOfBatchs());
   mutex.unlock();
 
+  // Batchs of all sources are counted for 4D navigators, motion cycles run over the whole run and not restart with each source
+  GGsize number_of_batchs_in_run = 0;
+  for (GGsize i = 0; i < source_manager.GetNumberOfSources(); ++i) {
+    number_of_batchs_in_run += source_manager.GetNumberOfBatchs(i, thread_index);
+  }
+  GGsize batch_index_in_run = 0;
+
   // Loop over sources
   for (GGsize i = 0; i < source_manager.GetNumberOfSources(); ++i) {
     // Number of batch for a source
@@ -315,12 +327,17 @@ void GGEMS::RunOnDevice(GGsize const& thread_index)
     for (GGsize j = 0; j < number_of_batchs; ++j) {
       GGsize number_of_particles = source_manager.GetNumberOfParticlesInBatch(i, thread_index, j);
 
+      // Selecting geometry of 4D navigators for this batch
+      navigator_manager.UpdateMotionPhase(thread_index, batch_index_in_run, number_of_batchs_in_run);
+      ++batch_index_in_run;
+
       // Generating particles
       source_manager.GetPrimaries(i, thread_index, number_of_particles);
 
       // Loop until ALL particles are dead
+      // Step 1: Checking if some particles are alive, primaries under the energy cut of the scene are killed before transport
       GGint loop_counter = 0, max_loop = 100; // Prevent infinite loop
-      do {
+      while (source_manager.IsAlive(thread_index) && loop_counter < max_loop) {
         // Step 2: Find closest navigator (phantom, detector) before projection and track operation
         navigator_manager.FindSolid(thread_index);
 
@@ -334,7 +351,13 @@ void GGEMS::RunOnDevice(GGsize const& thread_index)
         navigator_manager.TrackThroughSolid(thread_index);
 
         loop_counter++;
-      } while (source_manager.IsAlive(thread_index) && loop_counter < max_loop); // Step 5: Checking if all particles are dead, otherwize go back to step 2
+      }
+
+      // Optional step: Storing particles exiting phantom in phase space
+      navigator_manager.StorePhaseSpace(thread_index);
+
+      // Counting histories for history by history uncertainty
+      navigator_manager.CountHistories(thread_index, number_of_particles);
 
       // Incrementing progress bar
       mutex.lock();
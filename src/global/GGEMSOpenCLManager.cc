@@ -40,6 +40,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 GGEMSOpenCLManager::GGEMSOpenCLManager(void)
+: is_build_stopped_(false)
 {
   GGcout("GGEMSOpenCLManager", "GGEMSOpenCLManager", 3) << "GGEMSOpenCLManager creating..." << GGendl;
 
@@ -55,6 +56,10 @@ GGEMSOpenCLManager::GGEMSOpenCLManager(void)
 GGEMSOpenCLManager::~GGEMSOpenCLManager(void)
 {
   GGcout("GGEMSOpenCLManager", "~GGEMSOpenCLManager", 3) << "GGEMSOpenCLManager erasing..." << GGendl;
+
+  // Build threads have to be joined even if manager is not cleaned
+  StopBuildWorkers();
+
   GGcout("GGEMSOpenCLManager", "~GGEMSOpenCLManager", 3) << "GGEMSOpenCLManager erased!!!" << GGendl;
 }
 
@@ -66,6 +71,9 @@ void GGEMSOpenCLManager::Clean(void)
 {
   GGcout("GGEMSOpenCLManager", "Clean", 3) << "GGEMSOpenCLManager cleaning..." << GGendl;
 
+  // Waiting programs still built in background before freeing contexts
+  StopBuildWorkers();
+
   // Freeing devices
   for (cl::Device* d : devices_) {
     delete d;
@@ -83,6 +91,13 @@ void GGEMSOpenCLManager::Clean(void)
     k = nullptr;
   }
   kernels_.clear();
+  kernel_names_.clear();
+  lazy_kernels_.clear();
+
+  // Deleting programs
+  registered_builds_.clear();
+  programs_.clear();
+  physics_libraries_.clear();
 
   GGcout("GGEMSOpenCLManager", "Clean", 3) << "GGEMSOpenCLManager cleaned!!!" << GGendl;
 }
@@ -195,6 +210,7 @@ void GGEMSOpenCLManager::GetOpenCLDevices(void)
   cl_device_mem_cache_type device_mem_cache_type;
   cl_device_local_mem_type device_local_mem_type;
   cl_device_affinity_domain device_affinity_domain;
+  cl_command_queue_properties device_queue_properties;
   GGuint info_uint;
   GGulong info_ulong;
   GGsize info_size;
@@ -393,6 +409,9 @@ void GGEMSOpenCLManager::GetOpenCLDevices(void)
 
     CheckOpenCLError(devices_[i]->getInfo(CL_DEVICE_PROFILING_TIMER_RESOLUTION, &info_size), "GGEMSOpenCLManager", "GetOpenCLDevices");
     device_profiling_timer_resolution_.push_back(info_size);
+
+    CheckOpenCLError(devices_[i]->getInfo(CL_DEVICE_QUEUE_PROPERTIES, &device_queue_properties), "GGEMSOpenCLManager", "GetOpenCLDevices");
+    device_queue_properties_.push_back(device_queue_properties);
   }
 
   // Custom work group size, 64 seems a good trade-off
@@ -552,6 +571,10 @@ void GGEMSOpenCLManager::PrintDeviceInfos(void) const
     partition_affinity += device_single_fp_config_[i] & CL_DEVICE_AFFINITY_DOMAIN_NEXT_PARTITIONABLE ? "NEXT_PARTITIONABLE " : "";
     GGcout("GGEMSOpenCLManager", "PrintDeviceInfos", 0) << "    + Partition Affinity: " << partition_affinity << GGendl;
     GGcout("GGEMSOpenCLManager", "PrintDeviceInfos", 0) << "    + Timer Resolution: " << device_profiling_timer_resolution_[i] << " ns" << GGendl;
+    std::string queue_properties("");
+    queue_properties += device_queue_properties_[i] & CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE ? "OUT_OF_ORDER_EXEC_MODE " : "";
+    queue_properties += device_queue_properties_[i] & CL_QUEUE_PROFILING_ENABLE ? "PROFILING " : "";
+    GGcout("GGEMSOpenCLManager", "PrintDeviceInfos", 0) << "    + Queue Properties: " << queue_properties << GGendl;
     GGcout("GGEMSOpenCLManager", "PrintDeviceInfos", 0) << "    + GGEMS Custom Work Group Size: " << work_group_size_ << GGendl;
   }
   GGcout("GGEMSOpenCLManager", "PrintDeviceInfos", 0) << GGendl;
@@ -741,6 +764,16 @@ void GGEMSOpenCLManager::DeviceToActivate(GGsize const& device_id)
   computing_device.context_ = new cl::Context(*devices_.at(device_id));
   computing_device.queue_ = new cl::CommandQueue(*computing_device.context_, *devices_.at(device_id), CL_QUEUE_PROFILING_ENABLE);
 
+  // Queues for navigator kernels, an out-of-order queue if supported by device, otherwise several in-order queues
+  if (device_queue_properties_[device_id] & CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE) {
+    computing_device.navigation_queues_.push_back(new cl::CommandQueue(*computing_device.context_, *devices_.at(device_id), CL_QUEUE_PROFILING_ENABLE | CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE));
+  }
+  else {
+    for (GGsize i = 0; i < NUMBER_OF_NAVIGATION_QUEUES; ++i) {
+      computing_device.navigation_queues_.push_back(new cl::CommandQueue(*computing_device.context_, *devices_.at(device_id), CL_QUEUE_PROFILING_ENABLE));
+    }
+  }
+
   // Storing computing device
   computing_devices_.push_back(computing_device);
 
@@ -752,6 +785,17 @@ void GGEMSOpenCLManager::DeviceToActivate(GGsize const& device_id)
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+void GGEMSOpenCLManager::FinishNavigationQueues(GGsize const& thread_index) const
+{
+  for (cl::CommandQueue* q : computing_devices_[thread_index].navigation_queues_) {
+    CheckOpenCLError(q->finish(), "GGEMSOpenCLManager", "FinishNavigationQueues");
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 void GGEMSOpenCLManager::DeviceBalancing(std::string const& device_balancing)
 {
   std::string tmp_device_load = device_balancing;
@@ -799,14 +843,9 @@ GGsize GGEMSOpenCLManager::CheckKernel(std::string const& kernel_name, std::stri
 {
   GGcout("GGEMSOpenCLManager","CheckKernel", 3) << "Checking if kernel has already been compiled..." << GGendl;
 
-  // Parameters for kernel infos
-  std::string registered_kernel_name("");
-
-  // Loop over registered kernels
+  // Loop over registered kernels, kernels may be not created yet so names are stored
   for (GGsize i = 0; i < kernels_.size(); ++i) {
-    CheckOpenCLError(kernels_.at(i)->getInfo(CL_KERNEL_FUNCTION_NAME, &registered_kernel_name), "GGEMSOpenCLManager", "CheckKernel");
-    registered_kernel_name.erase(std::remove(registered_kernel_name.begin(), registered_kernel_name.end(), '\0'), registered_kernel_name.end());
-    if (kernel_name == registered_kernel_name && compilation_options == kernel_compilation_options_.at(i)) return i;
+    if (kernel_name == kernel_names_.at(i) && compilation_options == kernel_compilation_options_.at(i)) return i;
   }
 
   return KERNEL_NOT_COMPILED;
@@ -855,6 +894,8 @@ void GGEMSOpenCLManager::CompileKernel(std::string const& kernel_filename, std::
     #endif
   }
 
+  std::lock_guard<std::mutex> lock(kernel_mutex_);
+
   // Checking if kernel already compiled
   GGsize kernel_index = CheckKernel(kernel_name, kernel_compilation_option);
 
@@ -865,42 +906,26 @@ void GGEMSOpenCLManager::CompileKernel(std::string const& kernel_filename, std::
     }
   }
   else {
-    // Check if the source kernel file exists
-    std::ifstream source_file_stream(kernel_filename.c_str(), std::ios::in);
-    GGEMSFileStream::CheckInputStream(source_file_stream, kernel_filename);
-
-    // Store kernel in a std::string buffer
-    std::string source_code(std::istreambuf_iterator<char>(source_file_stream), (std::istreambuf_iterator<char>()));
-
-    // Creating an OpenCL program
-    cl::Program::Sources program_source(1, std::make_pair(source_code.c_str(), source_code.length() + 1));
+    // Programs are built once for a kernel file and its options, the build is submitted at the first launch of one of their kernels, other kernels of the file are created from the same programs
+    std::string program_key = kernel_filename + " " + kernel_compilation_option;
+    if (programs_.find(program_key) == programs_.end()) {
+      std::string compilation_options(kernel_compilation_option);
+      std::packaged_task<std::vector<cl::Program>()> program_build([this, kernel_filename, compilation_options]() {
+        return BuildProgram(kernel_filename, compilation_options.c_str());
+      });
+      programs_.insert(std::make_pair(program_key, program_build.get_future().share()));
+      registered_builds_.insert(std::make_pair(program_key, std::move(program_build)));
+    }
 
     // Loop over activated device
     for (GGsize i = 0; i < computing_devices_.size(); ++i) {
-      // Make program from source code in context
-      cl::Program program = cl::Program(*computing_devices_[i].context_, program_source);
-
-      // Get device associated to context, in our case 1 context = 1 device
-      std::vector<cl::Device> device;
-      CheckOpenCLError(computing_devices_[i].context_->getInfo(CL_CONTEXT_DEVICES, &device), "GGEMSOpenCLManager", "CompileKernel");
-
-      GGcout("GGEMSOpenCLManager", "CompileKernel", 2) << "Compile a new kernel '" << kernel_name << "' from file: " << kernel_filename << " on device: " << GetDeviceName(computing_devices_[i].index_) << " with options: " << kernel_compilation_option << GGendl;
-
-      // Compile source code on device
-      GGint build_status = program.build(device, kernel_compilation_option);
-      if (build_status != CL_SUCCESS) {
-        std::ostringstream oss(std::ostringstream::out);
-        std::string log;
-        program.getBuildInfo(device[0], CL_PROGRAM_BUILD_LOG, &log);
-        oss << ErrorType(build_status) << std::endl;
-        oss << log;
-        GGEMSMisc::ThrowException("GGEMSOpenCLManager", "CompileKernel", oss.str());
-      }
+      GGcout("GGEMSOpenCLManager", "CompileKernel", 2) << "Register a new kernel '" << kernel_name << "' from file: " << kernel_filename << " on device: " << GetDeviceName(computing_devices_[i].index_) << GGendl;
 
-      // Storing the kernel in the singleton
-      kernels_.push_back(new cl::Kernel(program, kernel_name.c_str(), &build_status));
+      // Storing the kernel in the singleton, kernel is created at its first launch
+      kernels_.push_back(new cl::Kernel());
       kernel_list[i] = kernels_.back();
-      CheckOpenCLError(build_status, "GGEMSOpenCLManager", "CompileKernel");
+      kernel_names_.push_back(kernel_name);
+      lazy_kernels_.insert(std::make_pair(kernels_.back(), LazyKernel{kernel_name, program_key, i}));
 
       // Storing the compilation options
       kernel_compilation_options_.push_back(kernel_compilation_option);
@@ -912,6 +937,373 @@ void GGEMSOpenCLManager::CompileKernel(std::string const& kernel_filename, std::
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+void GGEMSOpenCLManager::PrepareKernel(cl::Kernel* kernel)
+{
+  std::shared_future<std::vector<cl::Program>> program_build;
+  std::packaged_task<std::vector<cl::Program>()> registered_build;
+  {
+    std::lock_guard<std::mutex> lock(kernel_mutex_);
+
+    // Kernel already created
+    auto lazy_kernel = lazy_kernels_.find(kernel);
+    if (lazy_kernel == lazy_kernels_.end()) return;
+
+    program_build = programs_.at(lazy_kernel->second.program_key_);
+
+    // First launch of a kernel of this program, its build is taken to be submitted
+    auto registered = registered_builds_.find(lazy_kernel->second.program_key_);
+    if (registered != registered_builds_.end()) {
+      registered_build = std::move(registered->second);
+      registered_builds_.erase(registered);
+    }
+  }
+
+  // Build is submitted to build threads, the lock is not held while building, kernels of other programs are prepared meanwhile
+  if (registered_build.valid()) SubmitProgramBuild(std::move(registered_build));
+
+  // While waiting for its program, thread builds other submitted programs
+  {
+    std::unique_lock<std::mutex> lock(build_mutex_);
+    while (program_build.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+      if (RunProgramBuild(lock)) continue;
+      build_condition_.wait(lock, [this, &program_build]() {
+        return !build_queue_.empty() || program_build.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+      });
+    }
+  }
+
+  // An error of compilation is thrown here
+  std::vector<cl::Program> const& programs = program_build.get();
+
+  std::lock_guard<std::mutex> lock(kernel_mutex_);
+
+  // Kernel created by another thread while waiting
+  auto lazy_kernel = lazy_kernels_.find(kernel);
+  if (lazy_kernel == lazy_kernels_.end()) return;
+
+  GGsize thread_index = lazy_kernel->second.thread_index_;
+  GGcout("GGEMSOpenCLManager", "PrepareKernel", 2) << "Create a new kernel '" << lazy_kernel->second.kernel_name_ << "' on device: " << GetDeviceName(computing_devices_[thread_index].index_) << GGendl;
+
+  GGint build_status = 0;
+  *kernel = cl::Kernel(programs[thread_index], lazy_kernel->second.kernel_name_.c_str(), &build_status);
+  CheckOpenCLError(build_status, "GGEMSOpenCLManager", "PrepareKernel");
+
+  lazy_kernels_.erase(lazy_kernel);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSOpenCLManager::SubmitProgramBuild(std::packaged_task<std::vector<cl::Program>()>&& program_build)
+{
+  std::lock_guard<std::mutex> lock(build_mutex_);
+
+  // Threads are started at the first submission, at most one by core
+  if (build_workers_.empty()) {
+    GGsize number_of_build_threads = std::min(static_cast<GGsize>(std::thread::hardware_concurrency()), static_cast<GGsize>(MAXIMUM_BUILD_THREADS));
+    if (number_of_build_threads == 0) number_of_build_threads = 1;
+    GGcout("GGEMSOpenCLManager", "SubmitProgramBuild", 2) << "Starting " << number_of_build_threads << " threads building OpenCL programs..." << GGendl;
+    for (GGsize i = 0; i < number_of_build_threads; ++i) build_workers_.push_back(std::thread(&GGEMSOpenCLManager::BuildWorker, this));
+  }
+
+  build_queue_.push_back(std::move(program_build));
+  build_condition_.notify_all();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+bool GGEMSOpenCLManager::RunProgramBuild(std::unique_lock<std::mutex>& lock)
+{
+  if (build_queue_.empty()) return false;
+
+  std::packaged_task<std::vector<cl::Program>()> program_build = std::move(build_queue_.front());
+  build_queue_.pop_front();
+
+  // Error of compilation is stored in future of program and thrown to threads launching its kernels
+  lock.unlock();
+  program_build();
+  lock.lock();
+
+  // Waking threads waiting for this program
+  build_condition_.notify_all();
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSOpenCLManager::BuildWorker(void)
+{
+  std::unique_lock<std::mutex> lock(build_mutex_);
+  while (true) {
+    if (RunProgramBuild(lock)) continue;
+    if (is_build_stopped_) break;
+    build_condition_.wait(lock, [this]() {return !build_queue_.empty() || is_build_stopped_;});
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSOpenCLManager::StopBuildWorkers(void)
+{
+  {
+    std::lock_guard<std::mutex> lock(build_mutex_);
+    is_build_stopped_ = true;
+    build_condition_.notify_all();
+  }
+
+  for (std::thread& t : build_workers_) t.join();
+  build_workers_.clear();
+
+  // Threads are started again if kernels are launched after cleaning
+  std::lock_guard<std::mutex> lock(build_mutex_);
+  is_build_stopped_ = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+std::vector<cl::Program> GGEMSOpenCLManager::BuildProgram(std::string const& kernel_filename, char const* compilation_options)
+{
+  // Check if the source kernel file exists
+  std::ifstream source_file_stream(kernel_filename.c_str(), std::ios::in);
+  GGEMSFileStream::CheckInputStream(source_file_stream, kernel_filename);
+
+  // Store kernel in a std::string buffer
+  std::string source_code(std::istreambuf_iterator<char>(source_file_stream), (std::istreambuf_iterator<char>()));
+
+  // Creating an OpenCL program
+  cl::Program::Sources program_source(1, std::make_pair(source_code.c_str(), source_code.length() + 1));
+
+  // Kernel precompiled at build time for these options
+  std::string spirv_filename = GetSPIRVFilename(kernel_filename, compilation_options);
+
+  // Kernel using photon navigator is linked to physics library, navigation and physics models are not compiled again for each kernel file
+  bool is_physics_linked = source_code.find("GGEMS/navigators/GGEMSPhotonNavigator.hh") != std::string::npos;
+  std::vector<cl::Program> physics_libraries;
+  std::string kernel_compilation_options = std::string(compilation_options) + " -DPHYSICS_LIBRARY";
+  std::string link_options = GetLinkOptions(compilation_options);
+
+  std::vector<cl::Program> programs(computing_devices_.size());
+
+  // Loop over activated device
+  for (GGsize i = 0; i < computing_devices_.size(); ++i) {
+    GGint build_status = 0;
+
+    // Make program from SPIR-V if available, otherwize from source code in context
+    if (CreateProgramFromSPIRV(spirv_filename, i, programs[i])) {
+      GGcout("GGEMSOpenCLManager", "BuildProgram", 2) << "Load a new program from SPIR-V file: " << spirv_filename << " on device: " << GetDeviceName(computing_devices_[i].index_) << GGendl;
+    }
+    else if (is_physics_linked && IsLinkerAvailable(i)) {
+      if (physics_libraries.empty()) physics_libraries = GetPhysicsLibrary(compilation_options);
+
+      GGcout("GGEMSOpenCLManager", "BuildProgram", 2) << "Compile a new program from file: " << kernel_filename << " on device: " << GetDeviceName(computing_devices_[i].index_) << " with options: " << kernel_compilation_options << " and link it to physics library" << GGendl;
+
+      // Compile source code on device, then link it with physics library
+      cl::Program kernel_program(*computing_devices_[i].context_, program_source);
+      build_status = kernel_program.compile(kernel_compilation_options.c_str());
+      CheckProgramBuild(kernel_program, build_status, i, "BuildProgram");
+
+      programs[i] = cl::linkProgram(kernel_program, physics_libraries[i], link_options.c_str(), nullptr, nullptr, &build_status);
+      CheckProgramBuild(programs[i], build_status, i, "BuildProgram");
+      continue;
+    }
+    else {
+      programs[i] = cl::Program(*computing_devices_[i].context_, program_source);
+      GGcout("GGEMSOpenCLManager", "BuildProgram", 2) << "Compile a new program from file: " << kernel_filename << " on device: " << GetDeviceName(computing_devices_[i].index_) << " with options: " << compilation_options << GGendl;
+    }
+
+    // Get device associated to context, in our case 1 context = 1 device
+    std::vector<cl::Device> device;
+    CheckOpenCLError(computing_devices_[i].context_->getInfo(CL_CONTEXT_DEVICES, &device), "GGEMSOpenCLManager", "BuildProgram");
+
+    // Compile source code on device
+    build_status = programs[i].build(device, compilation_options);
+    CheckProgramBuild(programs[i], build_status, i, "BuildProgram");
+  }
+
+  return programs;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+std::vector<cl::Program> GGEMSOpenCLManager::GetPhysicsLibrary(std::string const& compilation_options)
+{
+  std::promise<std::vector<cl::Program>> library_compilation;
+  std::shared_future<std::vector<cl::Program>> physics_library;
+  bool is_compiled_here = false;
+  {
+    std::lock_guard<std::mutex> lock(library_mutex_);
+
+    // Library compiled once for these options, by the first thread needing it
+    auto library = physics_libraries_.find(compilation_options);
+    if (library == physics_libraries_.end()) {
+      physics_library = library_compilation.get_future().share();
+      physics_libraries_.insert(std::make_pair(compilation_options, physics_library));
+      is_compiled_here = true;
+    }
+    else {
+      physics_library = library->second;
+    }
+  }
+
+  if (is_compiled_here) {
+    try {
+      std::string library_filename = std::string(OPENCL_KERNEL_PATH) + "/GGEMSPhysicsLibrary.cl";
+      std::ifstream source_file_stream(library_filename.c_str(), std::ios::in);
+      GGEMSFileStream::CheckInputStream(source_file_stream, library_filename);
+      std::string source_code(std::istreambuf_iterator<char>(source_file_stream), (std::istreambuf_iterator<char>()));
+      cl::Program::Sources program_source(1, std::make_pair(source_code.c_str(), source_code.length() + 1));
+
+      std::vector<cl::Program> libraries(computing_devices_.size());
+      for (GGsize i = 0; i < computing_devices_.size(); ++i) {
+        if (!IsLinkerAvailable(i)) continue;
+
+        GGcout("GGEMSOpenCLManager", "GetPhysicsLibrary", 2) << "Compile physics library from file: " << library_filename << " on device: " << GetDeviceName(computing_devices_[i].index_) << " with options: " << compilation_options << GGendl;
+
+        libraries[i] = cl::Program(*computing_devices_[i].context_, program_source);
+        GGint build_status = libraries[i].compile(compilation_options.c_str());
+        CheckProgramBuild(libraries[i], build_status, i, "GetPhysicsLibrary");
+      }
+
+      library_compilation.set_value(libraries);
+    }
+    catch (...) {
+      // Error of compilation thrown to all threads waiting for library
+      library_compilation.set_exception(std::current_exception());
+    }
+  }
+
+  return physics_library.get();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+std::string GGEMSOpenCLManager::GetLinkOptions(std::string const& compilation_options) const
+{
+  // Only these options are accepted by clLinkProgram
+  std::vector<std::string> const kLinkOptions = {"-cl-denorms-are-zero", "-cl-no-signed-zeros", "-cl-unsafe-math-optimizations", "-cl-finite-math-only", "-cl-fast-relaxed-math"};
+
+  std::string link_options("");
+  std::istringstream iss(compilation_options);
+  std::string option("");
+  while (iss >> option) {
+    if (std::find(kLinkOptions.begin(), kLinkOptions.end(), option) == kLinkOptions.end()) continue;
+    if (!link_options.empty()) link_options += " ";
+    link_options += option;
+  }
+
+  return link_options;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+bool GGEMSOpenCLManager::IsLinkerAvailable(GGsize const& thread_index) const
+{
+  cl_bool is_linker_available = CL_FALSE;
+  CheckOpenCLError(devices_[computing_devices_[thread_index].index_]->getInfo(CL_DEVICE_LINKER_AVAILABLE, &is_linker_available), "GGEMSOpenCLManager", "IsLinkerAvailable");
+  return is_linker_available == CL_TRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSOpenCLManager::CheckProgramBuild(cl::Program const& program, GGint const& build_status, GGsize const& thread_index, std::string const& method_name) const
+{
+  if (build_status == CL_SUCCESS) return;
+
+  std::ostringstream oss(std::ostringstream::out);
+  std::string log;
+  program.getBuildInfo(*devices_[computing_devices_[thread_index].index_], CL_PROGRAM_BUILD_LOG, &log);
+  oss << ErrorType(build_status) << std::endl;
+  oss << log;
+  GGEMSMisc::ThrowException("GGEMSOpenCLManager", method_name, oss.str());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+std::string GGEMSOpenCLManager::GetSPIRVFilename(std::string const& kernel_filename, std::string const& compilation_options) const
+{
+  #ifdef OPENCL_SPIRV_PATH
+  // Macros of compilation options, sorted so the name does not depend on the order of options
+  std::vector<std::string> macros;
+  std::istringstream iss(compilation_options);
+  std::string option("");
+  while (iss >> option) {
+    if (option.compare(0, 2, "-D") != 0) continue;
+    std::replace(option.begin(), option.end(), '=', '_');
+    macros.push_back(option.substr(2));
+  }
+  std::sort(macros.begin(), macros.end());
+
+  // Name of kernel file without directory and extension
+  std::string kernel_basename = kernel_filename.substr(kernel_filename.find_last_of("/\\") + 1);
+  kernel_basename = kernel_basename.substr(0, kernel_basename.find_last_of('.'));
+
+  std::string spirv_filename = std::string(OPENCL_SPIRV_PATH) + "/" + kernel_basename;
+  for (auto&& macro : macros) spirv_filename += "_" + macro;
+  spirv_filename += ".spv";
+
+  return spirv_filename;
+  #else
+  return std::string("");
+  #endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+bool GGEMSOpenCLManager::CreateProgramFromSPIRV(std::string const& spirv_filename, GGsize const& thread_index, cl::Program& program) const
+{
+  #if defined(OPENCL_SPIRV_PATH) && defined(CL_VERSION_2_1)
+  if (spirv_filename.empty()) return false;
+
+  // Kernel variant not precompiled, source is compiled
+  std::ifstream spirv_stream(spirv_filename, std::ios::in | std::ios::binary);
+  if (!spirv_stream) return false;
+
+  // SPIR-V is supported from OpenCL 2.1
+  std::string il_version("");
+  devices_[computing_devices_[thread_index].index_]->getInfo(CL_DEVICE_IL_VERSION, &il_version);
+  if (il_version.find("SPIR-V") == std::string::npos) return false;
+
+  std::vector<char> spirv_code((std::istreambuf_iterator<char>(spirv_stream)), std::istreambuf_iterator<char>());
+
+  GGint error = 0;
+  cl_program spirv_program = clCreateProgramWithIL((*computing_devices_[thread_index].context_)(), spirv_code.data(), spirv_code.size(), &error);
+  if (error != CL_SUCCESS) {
+    GGwarn("GGEMSOpenCLManager", "CreateProgramFromSPIRV", 0) << "SPIR-V file " << spirv_filename << " not loaded (" << ErrorType(error) << "), source is compiled" << GGendl;
+    return false;
+  }
+
+  program = cl::Program(spirv_program);
+  return true;
+  #else
+  return false;
+  #endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 cl::Buffer* GGEMSOpenCLManager::Allocate(void* host_ptr, GGsize const& size, GGsize const& thread_index, cl_mem_flags flags, std::string const& class_name)
 {
   GGcout("GGEMSOpenCLManager","Allocate", 3) << "Allocating memory on OpenCL device memory..." << GGendl;
@@ -965,6 +1357,45 @@ void GGEMSOpenCLManager::Deallocate(cl::Buffer* buffer, GGsize size, GGsize cons
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+cl::Buffer* GGEMSOpenCLManager::AllocateSubBuffer(cl::Buffer* buffer, GGsize const& origin, GGsize const& size, GGsize const& thread_index, cl_mem_flags flags)
+{
+  GGcout("GGEMSOpenCLManager","AllocateSubBuffer", 3) << "Creating sub-buffer on OpenCL device memory..." << GGendl;
+
+  // Get index of the device
+  GGsize device_index = GetIndexOfActivatedDevice(thread_index);
+
+  // Origin of sub-buffer has to be aligned, alignment is given in bits
+  GGsize alignment = static_cast<GGsize>(device_mem_base_addr_align_[device_index]) / 8;
+  if (alignment != 0 && origin % alignment != 0) {
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "Origin of sub-buffer: " << origin << " bytes, is not aligned on " << alignment << " bytes!!!";
+    GGEMSMisc::ThrowException("GGEMSOpenCLManager", "AllocateSubBuffer", oss.str());
+  }
+
+  cl_buffer_region region = {origin, size};
+
+  GGint error = 0;
+  cl::Buffer* sub_buffer = new cl::Buffer(buffer->createSubBuffer(flags, CL_BUFFER_CREATE_TYPE_REGION, &region, &error));
+  CheckOpenCLError(error, "GGEMSOpenCLManager", "AllocateSubBuffer");
+
+  return sub_buffer;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSOpenCLManager::DeallocateSubBuffer(cl::Buffer* buffer)
+{
+  GGcout("GGEMSOpenCLManager","DeallocateSubBuffer", 3) << "Deleting sub-buffer..." << GGendl;
+
+  delete buffer;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 void GGEMSOpenCLManager::CleanBuffer(cl::Buffer* buffer, GGsize const& size, GGsize const& thread_index)
 {
   GGcout("GGEMSOpenCLManager","CleanBuffer", 3) << "Cleaning OpenCL buffer..." << GGendl;
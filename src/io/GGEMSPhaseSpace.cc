@@ -0,0 +1,275 @@
+// ************************************************************************
+// * This file is part of GGEMS.                                          *
+// *                                                                      *
+// * GGEMS is free software: you can redistribute it and/or modify        *
+// * it under the terms of the GNU General Public License as published by *
+// * the Free Software Foundation, either version 3 of the License, or    *
+// * (at your option) any later version.                                  *
+// *                                                                      *
+// * GGEMS is distributed in the hope that it will be useful,             *
+// * but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+// * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+// * GNU General Public License for more details.                         *
+// *                                                                      *
+// * You should have received a copy of the GNU General Public License    *
+// * along with GGEMS.  If not, see <https://www.gnu.org/licenses/>.      *
+// *                                                                      *
+// ************************************************************************
+
+/*!
+  \file GGEMSPhaseSpace.cc
+
+  \brief I/O class storing particles exiting a phantom in a phase space file and loading them for a replay
+
+  \author Julien BERT <julien.bert@univ-brest.fr>
+  \author Didier BENOIT <didier.benoit@inserm.fr>
+  \author LaTIM, INSERM - U1101, Brest, FRANCE
+  \version 1.0
+  \date Sunday October 18, 2026
+*/
+
+#include <cstring>
+#include <vector>
+
+#include "GGEMS/io/GGEMSPhaseSpace.hh"
+#include "GGEMS/io/GGEMSPhaseSpaceParticles.hh"
+#include "GGEMS/tools/GGEMSTools.hh"
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+GGEMSPhaseSpace::GGEMSPhaseSpace(void)
+: filename_(""),
+  is_writing_(false),
+  number_of_particles_(0),
+  number_of_read_particles_(0),
+  particles_(nullptr)
+{
+  GGcout("GGEMSPhaseSpace", "GGEMSPhaseSpace", 3) << "GGEMSPhaseSpace creating..." << GGendl;
+
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+  number_activated_devices_ = opencl_manager.GetNumberOfActivatedDevice();
+
+  GGcout("GGEMSPhaseSpace", "GGEMSPhaseSpace", 3) << "GGEMSPhaseSpace created!!!" << GGendl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+GGEMSPhaseSpace::~GGEMSPhaseSpace(void)
+{
+  GGcout("GGEMSPhaseSpace", "~GGEMSPhaseSpace", 3) << "GGEMSPhaseSpace erasing..." << GGendl;
+
+  Close();
+
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  if (particles_) {
+    for (GGsize i = 0; i < number_activated_devices_; ++i) {
+      opencl_manager.Deallocate(particles_[i], sizeof(GGEMSPhaseSpaceParticles), i);
+    }
+    delete[] particles_;
+    particles_ = nullptr;
+  }
+
+  GGcout("GGEMSPhaseSpace", "~GGEMSPhaseSpace", 3) << "GGEMSPhaseSpace erased!!!" << GGendl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSPhaseSpace::AllocateParticles(void)
+{
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  if (particles_) return;
+
+  particles_ = new cl::Buffer*[number_activated_devices_];
+  for (GGsize i = 0; i < number_activated_devices_; ++i) {
+    particles_[i] = opencl_manager.Allocate(nullptr, sizeof(GGEMSPhaseSpaceParticles), i, CL_MEM_READ_WRITE, "GGEMSPhaseSpace");
+    opencl_manager.CleanBuffer(particles_[i], sizeof(GGEMSPhaseSpaceParticles), i);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSPhaseSpace::OpenForWriting(std::string const& filename)
+{
+  GGcout("GGEMSPhaseSpace", "OpenForWriting", 1) << "Opening phase space " << filename << " for writing..." << GGendl;
+
+  if (stream_.is_open()) {
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "Phase space " << filename_ << " is already open!!!";
+    GGEMSMisc::ThrowException("GGEMSPhaseSpace", "OpenForWriting", oss.str());
+  }
+
+  stream_.open(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!stream_.is_open()) {
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "Problem creating phase space " << filename << "!!!";
+    GGEMSMisc::ThrowException("GGEMSPhaseSpace", "OpenForWriting", oss.str());
+  }
+
+  filename_ = filename;
+  is_writing_ = true;
+  number_of_particles_ = 0;
+
+  // Header is written again when closing with the final number of particles
+  GGEMSPhaseSpaceHeader header;
+  std::memset(&header, 0, sizeof(GGEMSPhaseSpaceHeader));
+  std::memcpy(header.magic_, "GGEMSPHS", 8);
+  header.version_ = 1;
+  stream_.write(reinterpret_cast<char*>(&header), sizeof(GGEMSPhaseSpaceHeader));
+
+  AllocateParticles();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSPhaseSpace::OpenForReading(std::string const& filename)
+{
+  GGcout("GGEMSPhaseSpace", "OpenForReading", 1) << "Opening phase space " << filename << " for reading..." << GGendl;
+
+  if (stream_.is_open()) {
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "Phase space " << filename_ << " is already open!!!";
+    GGEMSMisc::ThrowException("GGEMSPhaseSpace", "OpenForReading", oss.str());
+  }
+
+  stream_.open(filename, std::ios::in | std::ios::binary);
+  if (!stream_.is_open()) {
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "Problem opening phase space " << filename << "!!!";
+    GGEMSMisc::ThrowException("GGEMSPhaseSpace", "OpenForReading", oss.str());
+  }
+
+  GGEMSPhaseSpaceHeader header;
+  stream_.read(reinterpret_cast<char*>(&header), sizeof(GGEMSPhaseSpaceHeader));
+  if (!stream_ || std::memcmp(header.magic_, "GGEMSPHS", 8) != 0) {
+    stream_.close();
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "File " << filename << " is not a GGEMS phase space!!!";
+    GGEMSMisc::ThrowException("GGEMSPhaseSpace", "OpenForReading", oss.str());
+  }
+
+  filename_ = filename;
+  is_writing_ = false;
+  number_of_particles_ = static_cast<GGsize>(header.number_of_particles_);
+  number_of_read_particles_ = 0;
+
+  GGcout("GGEMSPhaseSpace", "OpenForReading", 1) << "Number of particles in phase space: " << number_of_particles_ << GGendl;
+
+  AllocateParticles();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSPhaseSpace::StoreParticles(GGsize const& thread_index, GGsize const& number_of_particles)
+{
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  GGEMSPhaseSpaceParticles* particles_device = opencl_manager.GetDeviceBuffer<GGEMSPhaseSpaceParticles>(particles_[thread_index], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSPhaseSpaceParticles), thread_index);
+
+  // Packing the recorded particles of the batch
+  std::vector<GGEMSPhaseSpaceRecord> records;
+  records.reserve(number_of_particles);
+  for (GGsize i = 0; i < number_of_particles; ++i) {
+    if (particles_device->is_recorded_[i] != TRUE) continue;
+
+    GGEMSPhaseSpaceRecord record;
+    record.E_ = particles_device->E_[i];
+    record.position_[0] = particles_device->px_[i];
+    record.position_[1] = particles_device->py_[i];
+    record.position_[2] = particles_device->pz_[i];
+    record.direction_[0] = particles_device->dx_[i];
+    record.direction_[1] = particles_device->dy_[i];
+    record.direction_[2] = particles_device->dz_[i];
+    record.scatter_history_ = particles_device->scatter_history_[i];
+    std::memset(record.padding_, 0, 3);
+    records.push_back(record);
+
+    // Next batch starts from empty slot
+    particles_device->is_recorded_[i] = FALSE;
+  }
+
+  opencl_manager.ReleaseDeviceBuffer(particles_[thread_index], particles_device, thread_index);
+
+  // File is shared by all the devices
+  std::lock_guard<std::mutex> lock(mutex_);
+  stream_.write(reinterpret_cast<char*>(records.data()), static_cast<std::streamsize>(records.size()*sizeof(GGEMSPhaseSpaceRecord)));
+  number_of_particles_ += records.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSPhaseSpace::LoadParticles(GGsize const& thread_index, GGsize const& number_of_particles)
+{
+  std::vector<GGEMSPhaseSpaceRecord> records(number_of_particles);
+
+  // Particles are read in file order whatever the device
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (number_of_read_particles_ + number_of_particles > number_of_particles_) {
+      std::ostringstream oss(std::ostringstream::out);
+      oss << "Not enough particles in phase space " << filename_ << "!!!";
+      GGEMSMisc::ThrowException("GGEMSPhaseSpace", "LoadParticles", oss.str());
+    }
+
+    stream_.read(reinterpret_cast<char*>(records.data()), static_cast<std::streamsize>(number_of_particles*sizeof(GGEMSPhaseSpaceRecord)));
+    number_of_read_particles_ += number_of_particles;
+  }
+
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  GGEMSPhaseSpaceParticles* particles_device = opencl_manager.GetDeviceBuffer<GGEMSPhaseSpaceParticles>(particles_[thread_index], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSPhaseSpaceParticles), thread_index);
+
+  for (GGsize i = 0; i < number_of_particles; ++i) {
+    particles_device->E_[i] = records[i].E_;
+    particles_device->px_[i] = records[i].position_[0];
+    particles_device->py_[i] = records[i].position_[1];
+    particles_device->pz_[i] = records[i].position_[2];
+    particles_device->dx_[i] = records[i].direction_[0];
+    particles_device->dy_[i] = records[i].direction_[1];
+    particles_device->dz_[i] = records[i].direction_[2];
+    particles_device->scatter_history_[i] = records[i].scatter_history_;
+  }
+
+  opencl_manager.ReleaseDeviceBuffer(particles_[thread_index], particles_device, thread_index);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSPhaseSpace::Close(void)
+{
+  if (!stream_.is_open()) return;
+
+  // Final number of particles in header
+  if (is_writing_) {
+    GGEMSPhaseSpaceHeader header;
+    std::memset(&header, 0, sizeof(GGEMSPhaseSpaceHeader));
+    std::memcpy(header.magic_, "GGEMSPHS", 8);
+    header.version_ = 1;
+    header.number_of_particles_ = static_cast<GGulong>(number_of_particles_);
+
+    stream_.seekp(0, std::ios::beg);
+    stream_.write(reinterpret_cast<char*>(&header), sizeof(GGEMSPhaseSpaceHeader));
+
+    GGcout("GGEMSPhaseSpace", "Close", 1) << number_of_particles_ << " particles stored in phase space " << filename_ << GGendl;
+  }
+
+  stream_.close();
+}
@@ -0,0 +1,333 @@
+// ************************************************************************
+// * This file is part of GGEMS.                                          *
+// *                                                                      *
+// * GGEMS is free software: you can redistribute it and/or modify        *
+// * it under the terms of the GNU General Public License as published by *
+// * the Free Software Foundation, either version 3 of the License, or    *
+// * (at your option) any later version.                                  *
+// *                                                                      *
+// * GGEMS is distributed in the hope that it will be useful,             *
+// * but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+// * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+// * GNU General Public License for more details.                         *
+// *                                                                      *
+// * You should have received a copy of the GNU General Public License    *
+// * along with GGEMS.  If not, see <https://www.gnu.org/licenses/>.      *
+// *                                                                      *
+// ************************************************************************
+
+/*!
+  \file GGEMSSinogram.cc
+
+  \brief I/O class writing all the views of an acquisition in a single memory mapped file
+
+  \author Julien BERT <julien.bert@univ-brest.fr>
+  \author Didier BENOIT <didier.benoit@inserm.fr>
+  \author LaTIM, INSERM - U1101, Brest, FRANCE
+  \version 1.0
+  \date Sunday October 18, 2026
+*/
+
+#include <cstring>
+
+#ifdef _MSC_VER
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+#include "GGEMS/io/GGEMSSinogram.hh"
+#include "GGEMS/tools/GGEMSTools.hh"
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+GGEMSSinogram::GGEMSSinogram(void)
+: filename_(""),
+  mapped_file_(nullptr),
+  file_size_(0),
+  header_(nullptr),
+  index_(nullptr),
+  number_of_elements_(0),
+  number_of_appended_views_(0),
+  #ifdef _MSC_VER
+  file_handle_(nullptr),
+  mapping_handle_(nullptr),
+  #else
+  file_descriptor_(-1),
+  #endif
+  is_closing_(false),
+  is_flush_failed_(false)
+{
+  GGcout("GGEMSSinogram", "GGEMSSinogram", 3) << "GGEMSSinogram creating..." << GGendl;
+
+  GGcout("GGEMSSinogram", "GGEMSSinogram", 3) << "GGEMSSinogram created!!!" << GGendl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+GGEMSSinogram::~GGEMSSinogram(void)
+{
+  GGcout("GGEMSSinogram", "~GGEMSSinogram", 3) << "GGEMSSinogram erasing..." << GGendl;
+
+  // Exception can not leave destructor, an error of flush is only printed
+  try {
+    Close();
+  }
+  catch (std::exception const&) {
+  }
+
+  GGcout("GGEMSSinogram", "~GGEMSSinogram", 3) << "GGEMSSinogram erased!!!" << GGendl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSinogram::Open(std::string const& filename, GGsize const& number_of_views, GGsize2 const& dimensions, GGfloat3 const& element_sizes, GGsize const& number_of_scatter_channels)
+{
+  GGcout("GGEMSSinogram", "Open", 1) << "Opening sinogram " << filename << " for " << number_of_views << " views..." << GGendl;
+
+  if (IsOpen()) {
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "Sinogram " << filename_ << " is already open!!!";
+    GGEMSMisc::ThrowException("GGEMSSinogram", "Open", oss.str());
+  }
+
+  if (number_of_views == 0 || dimensions.x_ == 0 || dimensions.y_ == 0) {
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "Number of views and dimensions of sinogram have to be > 0!!!";
+    GGEMSMisc::ThrowException("GGEMSSinogram", "Open", oss.str());
+  }
+
+  filename_ = filename;
+  number_of_elements_ = dimensions.x_*dimensions.y_;
+  number_of_appended_views_ = 0;
+  is_flush_failed_ = false;
+
+  // Computing layout of file, header + index then a chunk per view, chunks are aligned on memory pages
+  GGsize page_size = GetPageSize();
+  GGsize view_size = number_of_elements_*sizeof(GGint)*(1 + number_of_scatter_channels);
+  GGsize view_chunk_size = ((view_size + page_size - 1) / page_size) * page_size;
+  GGsize index_size = sizeof(GGEMSSinogramHeader) + number_of_views*sizeof(GGEMSSinogramIndex);
+  GGsize data_offset = ((index_size + page_size - 1) / page_size) * page_size;
+
+  // Preallocating and mapping the file
+  MapFile(data_offset + number_of_views*view_chunk_size);
+
+  // Filling header
+  header_ = reinterpret_cast<GGEMSSinogramHeader*>(mapped_file_);
+  std::memcpy(header_->magic_, "GGEMSSIN", 8);
+  header_->version_ = 1;
+  header_->number_of_scatter_channels_ = static_cast<GGuint>(number_of_scatter_channels);
+  header_->number_of_views_ = static_cast<GGulong>(number_of_views);
+  header_->dimensions_[0] = static_cast<GGulong>(dimensions.x_);
+  header_->dimensions_[1] = static_cast<GGulong>(dimensions.y_);
+  for (GGint i = 0; i < 3; ++i) header_->element_sizes_[i] = element_sizes.s[i];
+  header_->padding_ = 0.0f;
+  header_->view_chunk_size_ = static_cast<GGulong>(view_chunk_size);
+  header_->data_offset_ = static_cast<GGulong>(data_offset);
+
+  // Views are not written
+  index_ = reinterpret_cast<GGEMSSinogramIndex*>(mapped_file_ + sizeof(GGEMSSinogramHeader));
+  std::memset(index_, 0, number_of_views*sizeof(GGEMSSinogramIndex));
+
+  // Starting writer thread
+  is_closing_ = false;
+  writer_thread_ = std::thread(&GGEMSSinogram::WriteViews, this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+GGsize GGEMSSinogram::GetPageSize(void) const
+{
+  #ifdef _MSC_VER
+  SYSTEM_INFO system_info;
+  GetSystemInfo(&system_info);
+  return static_cast<GGsize>(system_info.dwPageSize);
+  #else
+  long page_size = sysconf(_SC_PAGESIZE);
+  if (page_size <= 0) {
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "Impossible to get the size of memory pages for sinogram " << filename_ << "!!!";
+    GGEMSMisc::ThrowException("GGEMSSinogram", "GetPageSize", oss.str());
+  }
+  return static_cast<GGsize>(page_size);
+  #endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSinogram::MapFile(GGsize const& file_size)
+{
+  file_size_ = file_size;
+
+  #ifdef _MSC_VER
+  file_handle_ = CreateFileA(filename_.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file_handle_ != INVALID_HANDLE_VALUE) {
+    mapping_handle_ = CreateFileMappingA(file_handle_, nullptr, PAGE_READWRITE, static_cast<DWORD>(static_cast<GGulong>(file_size_) >> 32), static_cast<DWORD>(file_size_ & 0xFFFFFFFF), nullptr);
+    if (mapping_handle_) mapped_file_ = static_cast<GGchar*>(MapViewOfFile(mapping_handle_, FILE_MAP_ALL_ACCESS, 0, 0, file_size_));
+  }
+  #else
+  file_descriptor_ = open(filename_.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (file_descriptor_ != -1 && ftruncate(file_descriptor_, static_cast<off_t>(file_size_)) == 0) {
+    void* mapped_file = mmap(nullptr, file_size_, PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor_, 0);
+    if (mapped_file != MAP_FAILED) mapped_file_ = static_cast<GGchar*>(mapped_file);
+  }
+  #endif
+
+  if (!mapped_file_) {
+    UnmapFile();
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "Impossible to preallocate and map sinogram file " << filename_ << " (" << file_size_ << " bytes)!!!";
+    GGEMSMisc::ThrowException("GGEMSSinogram", "MapFile", oss.str());
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+bool GGEMSSinogram::UnmapFile(void)
+{
+  bool is_flushed = true;
+
+  #ifdef _MSC_VER
+  if (mapped_file_) {
+    if (!FlushViewOfFile(mapped_file_, 0)) is_flushed = false;
+    UnmapViewOfFile(mapped_file_);
+  }
+  if (mapping_handle_) CloseHandle(mapping_handle_);
+  if (file_handle_ && file_handle_ != INVALID_HANDLE_VALUE) CloseHandle(file_handle_);
+  mapping_handle_ = nullptr;
+  file_handle_ = nullptr;
+  #else
+  if (mapped_file_) {
+    if (msync(mapped_file_, file_size_, MS_SYNC) != 0) is_flushed = false;
+    munmap(mapped_file_, file_size_);
+  }
+  if (file_descriptor_ != -1) close(file_descriptor_);
+  file_descriptor_ = -1;
+  #endif
+
+  mapped_file_ = nullptr;
+  header_ = nullptr;
+  index_ = nullptr;
+
+  return is_flushed;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSinogram::AppendView(GGfloat const& view_angle, GGfloat const& table_position, GGint* histogram, GGint* scatter)
+{
+  if (!IsOpen() || number_of_appended_views_ == static_cast<GGsize>(header_->number_of_views_)) {
+    delete[] histogram;
+    if (scatter) delete[] scatter;
+
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "Sinogram " << filename_ << " is not open or all the preallocated views are already written!!!";
+    GGEMSMisc::ThrowException("GGEMSSinogram", "AppendView", oss.str());
+  }
+
+  GGEMSSinogramView view;
+  view.view_id_ = number_of_appended_views_++;
+  view.view_angle_ = view_angle;
+  view.table_position_ = table_position;
+  view.histogram_ = histogram;
+  view.scatter_ = scatter;
+
+  GGcout("GGEMSSinogram", "AppendView", 2) << "Appending view " << view.view_id_ << " to sinogram " << filename_ << "..." << GGendl;
+
+  // Giving the view to writer thread
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_views_.push(view);
+  }
+  condition_.notify_one();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSinogram::WriteViews(void)
+{
+  GGsize histogram_size = number_of_elements_*sizeof(GGint);
+  GGsize scatter_size = histogram_size*header_->number_of_scatter_channels_;
+
+  while (true) {
+    // Waiting for a view, thread stops when closing and no more pending view
+    std::unique_lock<std::mutex> lock(mutex_);
+    condition_.wait(lock, [this]{return is_closing_ || !pending_views_.empty();});
+    if (pending_views_.empty()) break;
+
+    GGEMSSinogramView view = pending_views_.front();
+    pending_views_.pop();
+    lock.unlock();
+
+    // Copying view in its chunk
+    GGchar* chunk = mapped_file_ + header_->data_offset_ + view.view_id_*header_->view_chunk_size_;
+    std::memcpy(chunk, view.histogram_, histogram_size);
+    if (scatter_size > 0) {
+      if (view.scatter_) std::memcpy(chunk + histogram_size, view.scatter_, scatter_size);
+      else std::memset(chunk + histogram_size, 0, scatter_size);
+    }
+
+    // Updating index, after data so a written view is always complete
+    index_[view.view_id_].view_angle_ = view.view_angle_;
+    index_[view.view_id_].table_position_ = view.table_position_;
+    index_[view.view_id_].is_written_ = 1;
+
+    // Asking the system to write the chunk to disk, without waiting, an error is thrown by Close
+    #ifdef _MSC_VER
+    bool is_flushed = FlushViewOfFile(chunk, static_cast<SIZE_T>(header_->view_chunk_size_)) != 0;
+    #else
+    bool is_flushed = msync(chunk, static_cast<GGsize>(header_->view_chunk_size_), MS_ASYNC) == 0;
+    #endif
+    if (!is_flushed) {
+      std::lock_guard<std::mutex> flush_lock(mutex_);
+      is_flush_failed_ = true;
+    }
+
+    delete[] view.histogram_;
+    if (view.scatter_) delete[] view.scatter_;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSinogram::Close(void)
+{
+  if (!IsOpen()) return;
+
+  GGcout("GGEMSSinogram", "Close", 1) << "Closing sinogram " << filename_ << ", " << number_of_appended_views_ << " view(s) written..." << GGendl;
+
+  // Stopping writer thread after the pending views
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    is_closing_ = true;
+  }
+  condition_.notify_one();
+  if (writer_thread_.joinable()) writer_thread_.join();
+
+  // Last flush waits for the data on disk
+  if (!UnmapFile() || is_flush_failed_) {
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "Impossible to flush sinogram file " << filename_ << " to disk, views may be lost!!!";
+    GGEMSMisc::ThrowException("GGEMSSinogram", "Close", oss.str());
+  }
+}
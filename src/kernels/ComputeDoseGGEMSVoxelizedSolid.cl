@@ -34,12 +34,11 @@
 #include "GGEMS/geometries/GGEMSVoxelizedSolidData.hh"
 
 /*!
-  \fn kernel void compute_dose_ggems_voxelized_solid(GGsize const dosel_id_limit, global GGEMSDoseParams const* dose_params, global GGDosiType const* edep, global GGint const* hit, global GGDosiType const* edep_squared, global GGEMSVoxelizedSolidData const* voxelized_solid_data, global GGuchar const* label_data, global GGEMSMaterialTables const* materials, global GGfloat* dose, global GGfloat* uncertainty, GGfloat const scale_factor, GGchar const is_water_reference, GGfloat const minimum_density)
-  \param dosel_id_limit - number total of dosels
+  \fn kernel void compute_dose_ggems_voxelized_solid(GGsize const dosel_id_limit, global GGEMSDoseParams const* dose_params, global GGDosiType const* edep, global GGDosiType* edep_history, global GGDosiType* edep_squared, global GGEMSVoxelizedSolidData const* voxelized_solid_data, global GGuchar const* label_data, global GGEMSMaterialTables const* materials, global GGfloat* dose, global GGfloat* uncertainty, GGfloat const scale_factor, GGchar const is_water_reference, GGfloat const minimum_density, GGDosiType const number_of_histories)
+  \param dosel_id_limit - number total of dosels in all levels of dose pyramid
   \param dose_params - params about dosemap
   \param edep - buffer storing energy deposit
-  \param hit - buffer storing hit
-  \param edep_squared - buffer storing edep squared
+  \param edep_history - buffer storing energy deposit of the last history, not yet squared
   \param voxelized_solid_data - pointer to voxelized solid data
   \param label_data - label data associated to voxelized phantom
   \param materials - registered material in voxelized phantom
@@ -48,14 +47,15 @@
   \param scale_factor - scale factor apply to dose
   \param is_water_reference - water reference mode
   \param minimum_density - minimum density threshold
-  \brief computing dose for voxelized solid
+  \param number_of_histories - number of simulated histories
+  \brief computing dose for voxelized solid, for each level of dose pyramid
 */
 kernel void compute_dose_ggems_voxelized_solid(
   GGsize const dosel_id_limit,
   global GGEMSDoseParams const* dose_params,
   global GGDosiType const* edep,
-  global GGint const* hit,
-  global GGDosiType const* edep_squared,
+  global GGDosiType* edep_history,
+  global GGDosiType* edep_squared,
   global GGEMSVoxelizedSolidData const* voxelized_solid_data,
   global GGuchar const* label_data,
   global GGEMSMaterialTables const* materials,
@@ -63,7 +63,8 @@ kernel void compute_dose_ggems_voxelized_solid(
   global GGfloat* uncertainty,
   GGfloat const scale_factor,
   GGchar const is_water_reference,
-  GGfloat const minimum_density
+  GGfloat const minimum_density,
+  GGDosiType const number_of_histories
 )
 {
   // Getting index of thread
@@ -72,13 +73,27 @@ kernel void compute_dose_ggems_voxelized_solid(
   // Return if index > to particle limit
   if (global_id >= dosel_id_limit) return;
 
+  // Get level of dose pyramid
+  GGint level = 0;
+  while (level + 1 < dose_params->number_of_levels_ && global_id >= dose_params->level_offset_[level+1]) ++level;
+
+  GGint level_id = global_id - dose_params->level_offset_[level];
+  GGint3 level_number_of_dosels = dose_params->level_number_of_dosels_[level];
+  GGint level_slice_number_of_dosels = level_number_of_dosels.x * level_number_of_dosels.y;
+
   GGint3 dosel_id;
-  dosel_id.z = global_id/dose_params->slice_number_of_dosels_;
-  dosel_id.x = (global_id - dosel_id.z*dose_params->slice_number_of_dosels_)%dose_params->number_of_dosels_.x;
-  dosel_id.y = (global_id - dosel_id.z*dose_params->slice_number_of_dosels_)/dose_params->number_of_dosels_.x;
+  dosel_id.z = level_id/level_slice_number_of_dosels;
+  dosel_id.x = (level_id - dosel_id.z*level_slice_number_of_dosels)%level_number_of_dosels.x;
+  dosel_id.y = (level_id - dosel_id.z*level_slice_number_of_dosels)/level_number_of_dosels.x;
+
+  // Finest dosels covered by dosel of the level, border dosels of coarse levels can cover less dosels
+  GGint level_size = 1 << level;
+  GGint3 first_fine_dosel_id = dosel_id * level_size;
+  GGint3 number_of_fine_dosels = min((GGint3)(level_size), dose_params->number_of_dosels_ - first_fine_dosel_id);
+  GGint3 fine_dosel_id = first_fine_dosel_id + number_of_fine_dosels/2;
 
   // Convert doxel_id into position
-  GGfloat3 dosel_pos = convert_float3(dosel_id) * dose_params->size_of_dosels_ + convert_float3((dose_params->number_of_dosels_-1)) * (-0.5f*dose_params->size_of_dosels_);
+  GGfloat3 dosel_pos = dose_params->border_min_xyz_ + (convert_float3(fine_dosel_id) + 0.5f) * dose_params->size_of_dosels_;
 
   // Get index of voxelized phantom, x, y, z
   GGint3 voxel_id = convert_int3((dosel_pos - voxelized_solid_data->obb_geometry_.border_min_xyz_) / voxelized_solid_data->voxel_sizes_xyz_);
@@ -92,6 +107,7 @@ kernel void compute_dose_ggems_voxelized_solid(
 
   // Compute volume of dosel
   GGfloat dosel_vol = dose_params->size_of_dosels_.x * dose_params->size_of_dosels_.y * dose_params->size_of_dosels_.z;
+  dosel_vol *= (GGfloat)(number_of_fine_dosels.x * number_of_fine_dosels.y * number_of_fine_dosels.z);
 
   // Get density
   GGfloat density = is_water_reference ? 1.0f * (g/cm3) : materials->density_of_material_[material_id];
@@ -99,6 +115,12 @@ kernel void compute_dose_ggems_voxelized_solid(
   // Apply threshold on density and computing dose
   dose[global_id] = density < minimum_density ? 0.0f : scale_factor * edep[global_id] / density / dosel_vol / Gy;
 
+  // Squaring energy of the last history in dosel
+  if (edep_squared) {
+    edep_squared[global_id] += edep_history[global_id] * edep_history[global_id];
+    edep_history[global_id] = 0.0;
+  }
+
   // Relative statistical uncertainty (from Ma et al. PMB 47 2002 p1671)
   //              /                                    \ ^1/2
   //              |    N*Sum(Edep^2) - Sum(Edep)^2     |
@@ -106,16 +128,206 @@ kernel void compute_dose_ggems_voxelized_solid(
   //              |                                    |
   //              \         (N-1)*Sum(Edep)^2          /
   //
-  //   where Edep represents the energy deposit in one hit and N the number of energy deposits (hits)
+  //   where Edep represents the energy deposit of one history and N the number of histories
 
   // Computing uncertainty
   if (uncertainty) {
-    if (hit[global_id] > 1 && edep[global_id] != 0.0) {
+    if (number_of_histories > 1.0 && edep[global_id] != 0.0) {
       GGDosiType sum_edep_2 = edep[global_id] * edep[global_id];
-      uncertainty[global_id] = sqrt((hit[global_id]*edep_squared[global_id] - sum_edep_2) / ((hit[global_id]-1) * sum_edep_2));
+      uncertainty[global_id] = sqrt((number_of_histories*edep_squared[global_id] - sum_edep_2) / ((number_of_histories-1.0) * sum_edep_2));
     }
     else {
       uncertainty[global_id] = 1.0f;
     }
   }
 }
+
+/*!
+  \fn kernel void select_dose_level_ggems_voxelized_solid(GGsize const dosel_id_limit, global GGEMSDoseParams const* dose_params, global GGfloat const* dose, global GGfloat const* uncertainty, global GGfloat* adaptive_dose, global GGint* dose_level, GGfloat const target_uncertainty)
+  \param dosel_id_limit - number total of dosels in finest level
+  \param dose_params - params about dosemap
+  \param dose - dose in all levels of dose pyramid
+  \param uncertainty - dose uncertainty in all levels of dose pyramid
+  \param adaptive_dose - output buffer storing dose at finest resolution
+  \param dose_level - output buffer storing selected level
+  \param target_uncertainty - target uncertainty
+  \brief selecting for each dosel the finest level of dose pyramid reaching the target uncertainty, coarsest level is used if no level reaches it
+*/
+kernel void select_dose_level_ggems_voxelized_solid(
+  GGsize const dosel_id_limit,
+  global GGEMSDoseParams const* dose_params,
+  global GGfloat const* dose,
+  global GGfloat const* uncertainty,
+  global GGfloat* adaptive_dose,
+  global GGint* dose_level,
+  GGfloat const target_uncertainty
+)
+{
+  // Getting index of thread
+  GGint global_id = get_global_id(0);
+
+  // Return if index > to particle limit
+  if (global_id >= dosel_id_limit) return;
+
+  GGint3 dosel_id;
+  dosel_id.z = global_id/dose_params->slice_number_of_dosels_;
+  dosel_id.x = (global_id - dosel_id.z*dose_params->slice_number_of_dosels_)%dose_params->number_of_dosels_.x;
+  dosel_id.y = (global_id - dosel_id.z*dose_params->slice_number_of_dosels_)/dose_params->number_of_dosels_.x;
+
+  GGint level = 0;
+  GGint level_global_id = global_id;
+  for (level = 0; level < dose_params->number_of_levels_; ++level) {
+    GGint3 level_dosel_id = dosel_id >> level;
+    GGint3 level_number_of_dosels = dose_params->level_number_of_dosels_[level];
+    level_global_id = dose_params->level_offset_[level] + level_dosel_id.x + level_dosel_id.y * level_number_of_dosels.x + level_dosel_id.z * level_number_of_dosels.x * level_number_of_dosels.y;
+
+    if (uncertainty[level_global_id] <= target_uncertainty) break;
+  }
+
+  if (level == dose_params->number_of_levels_) level = dose_params->number_of_levels_ - 1;
+
+  adaptive_dose[global_id] = dose[level_global_id];
+  dose_level[global_id] = level;
+}
+
+/*!
+  \fn kernel void reduce_dose_by_label_ggems_voxelized_solid(GGsize const dosel_id_limit, global GGEMSDoseParams const* dose_params, global GGDosiType const* edep, global GGEMSVoxelizedSolidData const* voxelized_solid_data, global GGuchar const* label_data, global GGEMSMaterialTables const* materials, GGchar const is_water_reference, GGfloat const minimum_density, global GGDosiType* label_edep, global GGDosiType* label_mass)
+  \param dosel_id_limit - number total of dosels in finest level
+  \param dose_params - params about dosemap
+  \param edep - buffer storing energy deposit
+  \param voxelized_solid_data - pointer to voxelized solid data
+  \param label_data - label data associated to voxelized phantom
+  \param materials - registered material in voxelized phantom
+  \param is_water_reference - water reference mode
+  \param minimum_density - minimum density threshold
+  \param label_edep - output buffer storing energy deposit for each label
+  \param label_mass - output buffer storing mass for each label
+  \brief summing energy deposit and mass of dosels for each label, label of a dosel is the label at its center
+*/
+kernel void reduce_dose_by_label_ggems_voxelized_solid(
+  GGsize const dosel_id_limit,
+  global GGEMSDoseParams const* dose_params,
+  global GGDosiType const* edep,
+  global GGEMSVoxelizedSolidData const* voxelized_solid_data,
+  global GGuchar const* label_data,
+  global GGEMSMaterialTables const* materials,
+  GGchar const is_water_reference,
+  GGfloat const minimum_density,
+  global GGDosiType* label_edep,
+  global GGDosiType* label_mass
+)
+{
+  // Getting index of thread
+  GGint global_id = get_global_id(0);
+
+  // Return if index > to particle limit
+  if (global_id >= dosel_id_limit) return;
+
+  GGint3 dosel_id;
+  dosel_id.z = global_id/dose_params->slice_number_of_dosels_;
+  dosel_id.x = (global_id - dosel_id.z*dose_params->slice_number_of_dosels_)%dose_params->number_of_dosels_.x;
+  dosel_id.y = (global_id - dosel_id.z*dose_params->slice_number_of_dosels_)/dose_params->number_of_dosels_.x;
+
+  // Convert doxel_id into position
+  GGfloat3 dosel_pos = dose_params->border_min_xyz_ + (convert_float3(dosel_id) + 0.5f) * dose_params->size_of_dosels_;
+
+  // Get index of voxelized phantom, x, y, z
+  GGint3 voxel_id = convert_int3((dosel_pos - voxelized_solid_data->obb_geometry_.border_min_xyz_) / voxelized_solid_data->voxel_sizes_xyz_);
+
+  // Get the material that compose this volume
+  GGuchar material_id = label_data[
+    voxel_id.x +
+    voxel_id.y * voxelized_solid_data->number_of_voxels_xyz_.x +
+    voxel_id.z * voxelized_solid_data->number_of_voxels_xyz_.x * voxelized_solid_data->number_of_voxels_xyz_.y
+  ];
+
+  // Get density, dosels under density threshold are ignored
+  GGfloat density = is_water_reference ? 1.0f * (g/cm3) : materials->density_of_material_[material_id];
+  if (density < minimum_density) return;
+
+  GGfloat dosel_mass = density * dose_params->size_of_dosels_.x * dose_params->size_of_dosels_.y * dose_params->size_of_dosels_.z;
+
+  #ifdef DOSIMETRY_DOUBLE_PRECISION
+  AtomicAddDouble(&label_mass[material_id], (GGDosiType)dosel_mass);
+  if (edep[global_id] == 0.0) return;
+  AtomicAddDouble(&label_edep[material_id], edep[global_id]);
+  #else
+  AtomicAddFloat(&label_mass[material_id], dosel_mass);
+  if (edep[global_id] == 0.0f) return;
+  AtomicAddFloat(&label_edep[material_id], edep[global_id]);
+  #endif
+}
+
+/*!
+  \fn kernel void finalize_dose_ggems_voxelized_solid(GGsize const dosel_id_limit, global GGDosiType const* edep, global GGDosiType const* edep_squared, global GGfloat const* dose, global GGfloat const* uncertainty, global GGfloat const* adaptive_dose, global GGint const* dose_level, global GGint const* hit, global GGint const* photon_tracking, global GGuchar* staging)
+  \param dosel_id_limit - number total of dosels in finest level
+  \param edep - energy deposit, null if not requested
+  \param edep_squared - energy squared deposit, null if not requested
+  \param dose - dose, null if not requested
+  \param uncertainty - dose uncertainty, null if not requested
+  \param adaptive_dose - dose selected in dose pyramid, null if not requested
+  \param dose_level - level selected in dose pyramid, null if not requested
+  \param hit - number of hits, null if not requested
+  \param photon_tracking - photon tracking, null if not requested
+  \param staging - output buffer storing all requested outputs one after the other in the order of arguments
+  \brief packing all requested outputs in one staging buffer, read with a single transfer
+*/
+kernel void finalize_dose_ggems_voxelized_solid(
+  GGsize const dosel_id_limit,
+  global GGDosiType const* edep,
+  global GGDosiType const* edep_squared,
+  global GGfloat const* dose,
+  global GGfloat const* uncertainty,
+  global GGfloat const* adaptive_dose,
+  global GGint const* dose_level,
+  global GGint const* hit,
+  global GGint const* photon_tracking,
+  global GGuchar* staging
+)
+{
+  // Getting index of thread
+  GGint global_id = get_global_id(0);
+
+  // Return if index > to particle limit
+  if (global_id >= dosel_id_limit) return;
+
+  // Outputs in GGDosiType are first to keep alignment
+  global GGuchar* output = staging;
+
+  if (edep) {
+    ((global GGDosiType*)output)[global_id] = edep[global_id];
+    output += dosel_id_limit * sizeof(GGDosiType);
+  }
+
+  if (edep_squared) {
+    ((global GGDosiType*)output)[global_id] = edep_squared[global_id];
+    output += dosel_id_limit * sizeof(GGDosiType);
+  }
+
+  if (dose) {
+    ((global GGfloat*)output)[global_id] = dose[global_id];
+    output += dosel_id_limit * sizeof(GGfloat);
+  }
+
+  if (uncertainty) {
+    ((global GGfloat*)output)[global_id] = uncertainty[global_id];
+    output += dosel_id_limit * sizeof(GGfloat);
+  }
+
+  if (adaptive_dose) {
+    ((global GGfloat*)output)[global_id] = adaptive_dose[global_id];
+    output += dosel_id_limit * sizeof(GGfloat);
+  }
+
+  if (dose_level) {
+    ((global GGint*)output)[global_id] = dose_level[global_id];
+    output += dosel_id_limit * sizeof(GGint);
+  }
+
+  if (hit) {
+    ((global GGint*)output)[global_id] = hit[global_id];
+    output += dosel_id_limit * sizeof(GGint);
+  }
+
+  if (photon_tracking) ((global GGint*)output)[global_id] = photon_tracking[global_id];
+}
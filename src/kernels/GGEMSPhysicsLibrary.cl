@@ -0,0 +1,39 @@
+// ************************************************************************
+// * This file is part of GGEMS.                                          *
+// *                                                                      *
+// * GGEMS is free software: you can redistribute it and/or modify        *
+// * it under the terms of the GNU General Public License as published by *
+// * the Free Software Foundation, either version 3 of the License, or    *
+// * (at your option) any later version.                                  *
+// *                                                                      *
+// * GGEMS is distributed in the hope that it will be useful,             *
+// * but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+// * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+// * GNU General Public License for more details.                         *
+// *                                                                      *
+// * You should have received a copy of the GNU General Public License    *
+// * along with GGEMS.  If not, see <https://www.gnu.org/licenses/>.      *
+// *                                                                      *
+// ************************************************************************
+
+/*!
+  \file GGEMSPhysicsLibrary.cl
+
+  \brief Photon navigation and physics models compiled once for each set of compilation options (clCompileProgram), kernels including GGEMSPhotonNavigator.hh are linked to it (clLinkProgram). No kernel in this file
+
+  \author Julien BERT <julien.bert@univ-brest.fr>
+  \author Didier BENOIT <didier.benoit@inserm.fr>
+  \author LaTIM, INSERM - U1101, Brest, FRANCE
+  \version 1.0
+  \date Sunday October 18, 2026
+*/
+
+#include "GGEMS/physics/GGEMSPrimaryParticles.hh"
+#include "GGEMS/materials/GGEMSMaterialTables.hh"
+#include "GGEMS/physics/GGEMSParticleCrossSections.hh"
+#include "GGEMS/randoms/GGEMSRandom.hh"
+#include "GGEMS/navigators/GGEMSPhotonNavigator.hh"
+
+// Declared extern, inline definitions of navigator are also external definitions (C99) called by linked kernels
+extern void GetPhotonNextInteraction(global GGEMSPrimaryParticles* primary_particle, global GGEMSRandom* random, global GGEMSParticleCrossSections const* particle_cross_sections, GGuchar const index_material, GGint const particle_id);
+extern void PhotonDiscreteProcess(global GGEMSPrimaryParticles* primary_particle, global GGEMSRandom* random, global GGEMSMaterialTables const* materials, global GGEMSParticleCrossSections const* particle_cross_sections, GGuchar const material_id, GGint const particle_id);
@@ -0,0 +1,138 @@
+// ************************************************************************
+// * This file is part of GGEMS.                                          *
+// *                                                                      *
+// * GGEMS is free software: you can redistribute it and/or modify        *
+// * it under the terms of the GNU General Public License as published by *
+// * the Free Software Foundation, either version 3 of the License, or    *
+// * (at your option) any later version.                                  *
+// *                                                                      *
+// * GGEMS is distributed in the hope that it will be useful,             *
+// * but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+// * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+// * GNU General Public License for more details.                         *
+// *                                                                      *
+// * You should have received a copy of the GNU General Public License    *
+// * along with GGEMS.  If not, see <https://www.gnu.org/licenses/>.      *
+// *                                                                      *
+// ************************************************************************
+
+/*!
+  \file GetPrimariesGGEMSPhaseSpaceSource.cl
+
+  \brief OpenCL kernel generating primaries from a GGEMS phase space
+
+  \author Julien BERT <julien.bert@univ-brest.fr>
+  \author Didier BENOIT <didier.benoit@inserm.fr>
+  \author LaTIM, INSERM - U1101, Brest, FRANCE
+  \version 1.0
+  \date Sunday October 18, 2026
+*/
+
+#include "GGEMS/physics/GGEMSPrimaryParticles.hh"
+#include "GGEMS/io/GGEMSPhaseSpaceParticles.hh"
+#include "GGEMS/maths/GGEMSReferentialTransformation.hh"
+#include "GGEMS/physics/GGEMSParticleConstants.hh"
+#include "GGEMS/physics/GGEMSProcessConstants.hh"
+
+/*!
+  \fn kernel void get_primaries_ggems_phase_space_source(GGsize const particle_id_limit, global GGEMSPrimaryParticles* primary_particle, global GGEMSPhaseSpaceParticles const* phase_space, GGchar const particle_name, global GGEMSTransformationMatrix const* matrix_transformation)
+  \param particle_id_limit - particle id limit
+  \param primary_particle - buffer of primary particles
+  \param phase_space - particles loaded from phase space file
+  \param particle_name - name of particle
+  \param matrix_transformation - matrix storing information about axis
+  \brief Generate primaries from phase space, particles keep their scatter history
+*/
+kernel void get_primaries_ggems_phase_space_source(
+  GGsize const particle_id_limit,
+  global GGEMSPrimaryParticles* primary_particle,
+  global GGEMSPhaseSpaceParticles const* phase_space,
+  GGchar const particle_name,
+  global GGEMSTransformationMatrix const* matrix_transformation
+)
+{
+  // Get the index of thread
+  GGsize global_id = get_global_id(0);
+
+  // Return if index > to particle limit
+  if (global_id >= particle_id_limit) return;
+
+  // Position and direction stored in phase space are moved by the source
+  GGfloat3 global_position = {phase_space->px_[global_id], phase_space->py_[global_id], phase_space->pz_[global_id]};
+  GGfloat3 direction = {phase_space->dx_[global_id], phase_space->dy_[global_id], phase_space->dz_[global_id]};
+
+  global_position = LocalToGlobalPosition(matrix_transformation, &global_position);
+  direction = normalize(LocalToGlobalDirection(matrix_transformation, &direction));
+
+  // Then set the mandatory field to create a new particle
+  primary_particle->E_[global_id] = phase_space->E_[global_id];
+
+  primary_particle->px_[global_id] = global_position.x;
+  primary_particle->py_[global_id] = global_position.y;
+  primary_particle->pz_[global_id] = global_position.z;
+
+  primary_particle->dx_[global_id] = direction.x;
+  primary_particle->dy_[global_id] = direction.y;
+  primary_particle->dz_[global_id] = direction.z;
+
+  primary_particle->scatter_history_[global_id] = phase_space->scatter_history_[global_id];
+
+  primary_particle->status_[global_id] = ALIVE;
+
+  primary_particle->level_[global_id] = PRIMARY;
+  primary_particle->pname_[global_id] = particle_name;
+
+  primary_particle->mother_id_[global_id] = -1;
+  primary_particle->exited_solid_id_[global_id] = -1;
+  primary_particle->is_candidate_hit_[global_id] = 0;
+  primary_particle->particle_solid_distance_[global_id] = OUT_OF_WORLD;
+  primary_particle->next_discrete_process_[global_id] = NO_PROCESS;
+  primary_particle->next_interaction_distance_[global_id] = 0.0f;
+
+  #ifdef OPENGL
+  // Storing vertex position for OpenGL
+  if (global_id < MAXIMUM_DISPLAYED_PARTICLES) {
+    primary_particle->stored_particles_gl_[global_id] = 0;
+
+    for (GGint i = 0; i < MAXIMUM_INTERACTIONS; ++i) {
+      primary_particle->px_gl_[global_id*MAXIMUM_INTERACTIONS+i] = 0.0f;
+      primary_particle->py_gl_[global_id*MAXIMUM_INTERACTIONS+i] = 0.0f;
+      primary_particle->pz_gl_[global_id*MAXIMUM_INTERACTIONS+i] = 0.0f;
+    }
+
+    // Storing OpenGL index on OpenCL private memory
+    //GGint stored_particles_gl = primary_particle->stored_particles_gl_[global_id];
+
+    // Checking if buffer is full
+   // if (stored_particles_gl != MAXIMUM_INTERACTIONS) {
+
+      primary_particle->px_gl_[global_id*MAXIMUM_INTERACTIONS] = primary_particle->px_[global_id];
+      primary_particle->py_gl_[global_id*MAXIMUM_INTERACTIONS] = primary_particle->py_[global_id];
+      primary_particle->pz_gl_[global_id*MAXIMUM_INTERACTIONS] = primary_particle->pz_[global_id];
+      //stored_particles_gl += 1;
+
+      // primary_particle->px_gl_[global_id*MAXIMUM_INTERACTIONS+stored_particles_gl] += primary_particle->dx_[global_id]*2.0f*m;
+      // primary_particle->py_gl_[global_id*MAXIMUM_INTERACTIONS+stored_particles_gl] += primary_particle->dy_[global_id]*2.0f*m;
+      // primary_particle->pz_gl_[global_id*MAXIMUM_INTERACTIONS+stored_particles_gl] += primary_particle->dz_[global_id]*2.0f*m;
+      // stored_particles_gl += 1;
+
+      // Storing final index
+      primary_particle->stored_particles_gl_[global_id] = 1;
+    //}
+  }
+  #endif
+
+  #ifdef GGEMS_TRACKING
+  if (global_id == primary_particle->particle_tracking_id) {
+    printf("[GGEMS OpenCL kernel get_primaries_ggems_phase_space_source] ################################################################################\n");
+    printf("[GGEMS OpenCL kernel get_primaries_ggems_phase_space_source] Particle id: %d\n", global_id);
+    printf("[GGEMS OpenCL kernel get_primaries_ggems_phase_space_source] Particle type: ");
+    if (primary_particle->pname_[global_id] == PHOTON) printf("gamma\n");
+    else if (primary_particle->pname_[global_id] == ELECTRON) printf("e-\n");
+    else if (primary_particle->pname_[global_id] == POSITRON) printf("e+\n");
+    printf("[GGEMS OpenCL kernel get_primaries_ggems_phase_space_source] Position (x, y, z): %e %e %e mm\n", global_position.x/mm, global_position.y/mm, global_position.z/mm);
+    printf("[GGEMS OpenCL kernel get_primaries_ggems_phase_space_source] Direction (x, y, z): %e %e %e\n", direction.x, direction.y, direction.z);
+    printf("[GGEMS OpenCL kernel get_primaries_ggems_phase_space_source] Energy: %e keV\n", primary_particle->E_[global_id]/keV);
+  }
+  #endif
+}
@@ -29,6 +29,7 @@
 */
 
 #include "GGEMS/physics/GGEMSPrimaryParticles.hh"
+#include "GGEMS/physics/GGEMSScatterHistory.hh"
 #include "GGEMS/randoms/GGEMSKissEngine.hh"
 #include "GGEMS/maths/GGEMSReferentialTransformation.hh"
 #include "GGEMS/maths/GGEMSMathAlgorithms.hh"
@@ -36,7 +37,7 @@
 #include "GGEMS/physics/GGEMSProcessConstants.hh"
 
 /*!
-  \fn kernel void get_primaries_ggems_xray_source(GGsize const particle_id_limit, global GGEMSPrimaryParticles* primary_particle, global GGEMSRandom* random, GGchar const particle_name, global GGfloat const* energy_spectrum, global GGfloat const* cdf, GGint const number_of_energy_bins, GGfloat const aperture, GGfloat3 const focal_spot_size, global GGfloat44 const* matrix_transformation)
+  \fn kernel void get_primaries_ggems_xray_source(GGsize const particle_id_limit, global GGEMSPrimaryParticles* primary_particle, global GGEMSRandom* random, GGchar const particle_name, global GGfloat const* energy_spectrum, global GGfloat const* cdf, GGint const number_of_energy_bins, GGfloat const aperture, GGfloat3 const focal_spot_size, global GGEMSTransformationMatrix const* matrix_transformation)
   \param particle_id_limit - particle id limit
   \param primary_particle - buffer of primary particles
   \param random - buffer for random number
@@ -59,7 +60,7 @@ kernel void get_primaries_ggems_xray_source(
   GGint const number_of_energy_bins,
   GGfloat const aperture,
   GGfloat3 const focal_spot_size,
-  global GGfloat44 const* matrix_transformation
+  global GGEMSTransformationMatrix const* matrix_transformation
 )
 {
   // Get the index of thread
@@ -122,13 +123,16 @@ kernel void get_primaries_ggems_xray_source(
   primary_particle->dy_[global_id] = direction.y;
   primary_particle->dz_[global_id] = direction.z;
 
-  primary_particle->scatter_[global_id] = FALSE;
+  primary_particle->scatter_history_[global_id] = NO_SCATTER;
 
   primary_particle->status_[global_id] = ALIVE;
 
   primary_particle->level_[global_id] = PRIMARY;
   primary_particle->pname_[global_id] = particle_name;
 
+  primary_particle->mother_id_[global_id] = -1;
+  primary_particle->exited_solid_id_[global_id] = -1;
+  primary_particle->is_candidate_hit_[global_id] = 0;
   primary_particle->particle_solid_distance_[global_id] = OUT_OF_WORLD;
   primary_particle->next_discrete_process_[global_id] = NO_PROCESS;
   primary_particle->next_interaction_distance_[global_id] = 0.0f;
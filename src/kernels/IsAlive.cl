@@ -32,16 +32,18 @@
 #include "GGEMS/physics/GGEMSParticleConstants.hh"
 
 /*!
-  \fn kernel void is_alive(GGsize const particle_id_limit, global GGEMSPrimaryParticles* primary_particle, global GGint* status)
+  \fn kernel void is_alive(GGsize const particle_id_limit, global GGEMSPrimaryParticles* primary_particle, global GGint* status, GGfloat const energy_cut)
   \param particle_id_limit - particle id limit
   \param primary_particle - pointer on primary particles
   \param status - status of particle
-  \brief checking if particle is alive
+  \param energy_cut - minimum energy cut of the scene
+  \brief checking if particle is alive, photons under the minimum energy cut of the scene are killed
 */
 kernel void is_alive(
   GGsize const particle_id_limit,
   global GGEMSPrimaryParticles* primary_particle,
-  global GGint* status
+  global GGint* status,
+  GGfloat const energy_cut
 )
 {
   // Get the index of thread
@@ -50,5 +52,8 @@ kernel void is_alive(
   // Return if index > to particle limit
   if (global_id >= particle_id_limit) return;
 
+  // Photon under the minimum energy cut of the scene would be killed by any navigator
+  if (primary_particle->status_[global_id] == ALIVE && primary_particle->E_[global_id] < energy_cut) primary_particle->status_[global_id] = DEAD;
+
   atomic_add(&status[0], primary_particle->status_[global_id]);
 }
@@ -0,0 +1,104 @@
+// ************************************************************************
+// * This file is part of GGEMS.                                          *
+// *                                                                      *
+// * GGEMS is free software: you can redistribute it and/or modify        *
+// * it under the terms of the GNU General Public License as published by *
+// * the Free Software Foundation, either version 3 of the License, or    *
+// * (at your option) any later version.                                  *
+// *                                                                      *
+// * GGEMS is distributed in the hope that it will be useful,             *
+// * but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+// * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+// * GNU General Public License for more details.                         *
+// *                                                                      *
+// * You should have received a copy of the GNU General Public License    *
+// * along with GGEMS.  If not, see <https://www.gnu.org/licenses/>.      *
+// *                                                                      *
+// ************************************************************************
+
+/*!
+  \file ParticleSolidDistanceGGEMSMotherVolume.cl
+
+  \brief OpenCL kernel computing distance between mother volume and particles
+
+  \author Julien BERT <julien.bert@univ-brest.fr>
+  \author Didier BENOIT <didier.benoit@inserm.fr>
+  \author LaTIM, INSERM - U1101, Brest, FRANCE
+  \version 1.0
+  \date Sunday October 18, 2026
+*/
+
+#include "GGEMS/physics/GGEMSPrimaryParticles.hh"
+
+#include "GGEMS/geometries/GGEMSMotherVolumeData.hh"
+#include "GGEMS/geometries/GGEMSRayTracing.hh"
+
+/*!
+  \fn kernel void particle_solid_distance_ggems_mother_volume(GGsize const particle_id_limit, global GGEMSPrimaryParticles* primary_particle, global GGEMSMotherVolumeData const* mother_volume_data)
+  \param particle_id_limit - particle id limit
+  \param primary_particle - pointer to primary particles on OpenCL memory
+  \param mother_volume_data - pointer to mother volume data
+  \brief OpenCL kernel computing distance to enter the mother volume, or distance to exit the mother volume if particle is inside
+*/
+kernel void particle_solid_distance_ggems_mother_volume(
+  GGsize const particle_id_limit,
+  global GGEMSPrimaryParticles* primary_particle,
+  global GGEMSMotherVolumeData const* mother_volume_data
+)
+{
+  // Getting index of thread
+  GGsize global_id = get_global_id(0);
+
+  // Return if index > to particle limit
+  if (global_id >= particle_id_limit) return;
+
+  // Checking particle status. If DEAD, the particle is not track
+  if (primary_particle->status_[global_id] == DEAD) return;
+
+  // Mother volume is tested by particles in its own mother (entering) or inside it (exiting)
+  GGint mother_id = primary_particle->mother_id_[global_id];
+  if (mother_id != mother_volume_data->mother_id_ && mother_id != mother_volume_data->solid_id_) return;
+
+  // Checking if the particle - solid is 0. If yes the particle is already in another navigator
+  if (primary_particle->particle_solid_distance_[global_id] == 0.0f) return;
+
+  // Position of particle
+  GGfloat3 position = {
+    primary_particle->px_[global_id],
+    primary_particle->py_[global_id],
+    primary_particle->pz_[global_id]
+  };
+
+  // Direction of particle
+  GGfloat3 direction = {
+    primary_particle->dx_[global_id],
+    primary_particle->dy_[global_id],
+    primary_particle->dz_[global_id]
+  };
+
+  GGfloat distance = 0.0f;
+  if (mother_id == mother_volume_data->solid_id_) {
+    // Particle in mother volume, distance to exit boundary. A particle on the boundary exits immediately
+    distance = ComputeDistanceToOBB(&position, &direction, &mother_volume_data->obb_geometry_);
+    if (distance == OUT_OF_WORLD) distance = 0.0f;
+  }
+  else if (!IsParticleInOBB(&position, &mother_volume_data->obb_geometry_)) {
+    // Particle outside mother volume, distance to enter it. A particle inside enters without moving
+    distance = ComputeDistanceToOBB(&position, &direction, &mother_volume_data->obb_geometry_);
+  }
+
+  // Check distance value with previous value. Store the minimum value
+  if (distance < primary_particle->particle_solid_distance_[global_id]) {
+    #ifdef GGEMS_TRACKING
+    if (global_id == primary_particle->particle_tracking_id) {
+      printf("[GGEMS OpenCL kernel particle_solid_distance_ggems_mother_volume] --------------------------------------------------------------------------------\n");
+      printf("[GGEMS OpenCL kernel particle_solid_distance_ggems_mother_volume] Find a closest solid\n");
+      printf("[GGEMS OpenCL kernel particle_solid_distance_ggems_mother_volume] Particle id: %d\n", global_id);
+      printf("[GGEMS OpenCL kernel particle_solid_distance_ggems_mother_volume] Particle %s mother volume, id: %d\n", mother_id == mother_volume_data->solid_id_ ? "exiting" : "entering", mother_volume_data->solid_id_);
+      printf("[GGEMS OpenCL kernel particle_solid_distance_ggems_mother_volume] Particle solid distance: %e mm\n", distance/mm);
+    }
+    #endif
+    primary_particle->particle_solid_distance_[global_id] = distance;
+    primary_particle->solid_id_[global_id] = mother_volume_data->solid_id_;
+  }
+}
@@ -0,0 +1,117 @@
+// ************************************************************************
+// * This file is part of GGEMS.                                          *
+// *                                                                      *
+// * GGEMS is free software: you can redistribute it and/or modify        *
+// * it under the terms of the GNU General Public License as published by *
+// * the Free Software Foundation, either version 3 of the License, or    *
+// * (at your option) any later version.                                  *
+// *                                                                      *
+// * GGEMS is distributed in the hope that it will be useful,             *
+// * but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+// * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+// * GNU General Public License for more details.                         *
+// *                                                                      *
+// * You should have received a copy of the GNU General Public License    *
+// * along with GGEMS.  If not, see <https://www.gnu.org/licenses/>.      *
+// *                                                                      *
+// ************************************************************************
+
+/*!
+  \file ParticleSolidDistanceGGEMSSolidArc.cl
+
+  \brief OpenCL kernel computing distance between solid arc and particles
+
+  \author Julien BERT <julien.bert@univ-brest.fr>
+  \author Didier BENOIT <didier.benoit@inserm.fr>
+  \author LaTIM, INSERM - U1101, Brest, FRANCE
+  \version 1.0
+  \date Sunday October 18, 2026
+*/
+
+#include "GGEMS/physics/GGEMSPrimaryParticles.hh"
+
+#include "GGEMS/geometries/GGEMSSolidArcData.hh"
+#include "GGEMS/geometries/GGEMSRayTracing.hh"
+
+/*!
+  \fn kernel void particle_solid_distance_ggems_solid_arc(GGsize const particle_id_limit, global GGEMSPrimaryParticles* primary_particle, global GGEMSSolidArcData const* solid_arc_data, GGint const mother_id)
+  \param particle_id_limit - particle id limit
+  \param primary_particle - pointer to primary particles on OpenCL memory
+  \param solid_arc_data - pointer to solid arc data
+  \param mother_id - solid index of mother volume of solid, -1 if world
+  \brief OpenCL kernel computing distance between solid arc and particles
+*/
+kernel void particle_solid_distance_ggems_solid_arc(
+  GGsize const particle_id_limit,
+  global GGEMSPrimaryParticles* primary_particle,
+  global GGEMSSolidArcData const* solid_arc_data,
+  GGint const mother_id
+)
+{
+  // Getting index of thread
+  GGsize global_id = get_global_id(0);
+
+  // Return if index > to particle limit
+  if (global_id >= particle_id_limit) return;
+
+  // Checking particle status. If DEAD, the particle is not track
+  if (primary_particle->status_[global_id] == DEAD) return;
+
+  // Only solids in the mother volume containing the particle are tested
+  if (primary_particle->mother_id_[global_id] != mother_id) return;
+
+  // Checking if the particle - solid is 0. If yes the particle is already in another navigator
+  if (primary_particle->particle_solid_distance_[global_id] == 0.0f) return;
+
+  // Position of particle
+  GGfloat3 position = {
+    primary_particle->px_[global_id],
+    primary_particle->py_[global_id],
+    primary_particle->pz_[global_id]
+  };
+
+  // Direction of particle
+  GGfloat3 direction = {
+    primary_particle->dx_[global_id],
+    primary_particle->dy_[global_id],
+    primary_particle->dz_[global_id]
+  };
+
+  // Position and direction in local arc frame
+  GGfloat3 local_position = GlobalToLocalPosition(&solid_arc_data->arc_geometry_.matrix_transformation_, &position);
+  GGfloat3 local_direction = GlobalToLocalDirection(&solid_arc_data->arc_geometry_.matrix_transformation_, &direction);
+
+  // Check if particle inside arc, if yes distance is 0.0 and not need to compute particle - solid distance
+  if (IsParticleInArc(&local_position, &solid_arc_data->arc_geometry_, GEOMETRY_TOLERANCE)) {
+    #ifdef GGEMS_TRACKING
+    if (global_id == primary_particle->particle_tracking_id) {
+      printf("[GGEMS OpenCL kernel particle_solid_distance_ggems_solid_arc] --------------------------------------------------------------------------------\n");
+      printf("[GGEMS OpenCL kernel particle_solid_distance_ggems_solid_arc] Find a closest solid\n");
+      printf("[GGEMS OpenCL kernel particle_solid_distance_ggems_solid_arc] Particle id: %d\n", global_id);
+      printf("[GGEMS OpenCL kernel particle_solid_distance_ggems_solid_arc] Particle in solid arc, id: %d\n", solid_arc_data->solid_id_);
+      printf("[GGEMS OpenCL kernel particle_solid_distance_ggems_solid_arc] Particle solid distance: 0.0\n");
+    }
+    #endif
+    primary_particle->particle_solid_distance_[global_id] = 0.0f;
+    primary_particle->solid_id_[global_id] = solid_arc_data->solid_id_;
+    return;
+  }
+
+  // Compute analytically distance between particles and arc (ray/cylinder intersection)
+  GGfloat distance = ComputeDistanceToArc(&local_position, &local_direction, &solid_arc_data->arc_geometry_);
+
+  // Check distance value with previous value. Store the minimum value
+  if (distance < primary_particle->particle_solid_distance_[global_id]) {
+    #ifdef GGEMS_TRACKING
+    if (global_id == primary_particle->particle_tracking_id) {
+      printf("[GGEMS OpenCL kernel particle_solid_distance_ggems_solid_arc] --------------------------------------------------------------------------------\n");
+      printf("[GGEMS OpenCL kernel particle_solid_distance_ggems_solid_arc] Find a closest solid\n");
+      printf("[GGEMS OpenCL kernel particle_solid_distance_ggems_solid_arc] Particle id: %d\n", global_id);
+      printf("[GGEMS OpenCL kernel particle_solid_distance_ggems_solid_arc] Particle in solid arc, id: %d\n", solid_arc_data->solid_id_);
+      printf("[GGEMS OpenCL kernel particle_solid_distance_ggems_solid_arc] Particle solid distance: %e mm\n", distance/mm);
+    }
+    #endif
+    primary_particle->particle_solid_distance_[global_id] = distance;
+    primary_particle->solid_id_[global_id] = solid_arc_data->solid_id_;
+  }
+}
@@ -34,16 +34,22 @@
 #include "GGEMS/geometries/GGEMSRayTracing.hh"
 
 /*!
-  \fn kernel void particle_solid_distance_ggems_solid_box(GGsize const particle_id_limit, global GGEMSPrimaryParticles* primary_particle, global GGEMSSolidBoxData const* solid_box_data)
+  \fn kernel void particle_solid_distance_ggems_solid_box(GGsize const particle_id_limit, global GGEMSPrimaryParticles* primary_particle, global GGEMSSolidBoxData const* solid_box_data, GGint const mother_id, GGint const search_pass, global GGint* fallback_search)
   \param particle_id_limit - particle id limit
   \param primary_particle - pointer to primary particles on OpenCL memory
   \param solid_box_data - pointer to solid box data
+  \param mother_id - solid index of mother volume of solid, -1 if world
+  \param search_pass - CANDIDATE_SEARCH testing neighbours of exited solid (and all solids for other particles), or FALLBACK_SEARCH testing other solids if no neighbour is hit
+  \param fallback_search - flag set to 1 if a particle hit no neighbour of its exited solid, given to the last solid of candidate pass only, nullptr otherwise
   \brief OpenCL kernel computing distance between solid box and particles
 */
 kernel void particle_solid_distance_ggems_solid_box(
   GGsize const particle_id_limit,
   global GGEMSPrimaryParticles* primary_particle,
-  global GGEMSSolidBoxData const* solid_box_data
+  global GGEMSSolidBoxData const* solid_box_data,
+  GGint const mother_id,
+  GGint const search_pass,
+  global GGint* fallback_search
 )
 {
   // Getting index of thread
@@ -55,9 +61,30 @@ kernel void particle_solid_distance_ggems_solid_box(
   // Checking particle status. If DEAD, the particle is not track
   if (primary_particle->status_[global_id] == DEAD) return;
 
+  // Only solids in the mother volume containing the particle are tested
+  if (primary_particle->mother_id_[global_id] != mother_id) return;
+
   // Checking if the particle - solid is 0. If yes the particle is already in another navigator
   if (primary_particle->particle_solid_distance_[global_id] == 0.0f) return;
 
+  // After exiting a solid, only its neighbours are tested, other solids are tested in fallback pass if no neighbour is hit
+  GGint exited_solid_id = primary_particle->exited_solid_id_[global_id];
+  if (exited_solid_id == -1) {
+    if (search_pass == FALLBACK_SEARCH) return;
+  }
+  else {
+    GGchar is_candidate = 0;
+    for (GGint i = 0; i < solid_box_data->number_of_neighbour_solids_; ++i) {
+      if (solid_box_data->neighbour_solid_id_[i] == exited_solid_id) is_candidate = 1;
+    }
+
+    if (search_pass == CANDIDATE_SEARCH && !is_candidate) {
+      if (fallback_search && !primary_particle->is_candidate_hit_[global_id]) *fallback_search = 1;
+      return;
+    }
+    if (search_pass == FALLBACK_SEARCH && (is_candidate || primary_particle->is_candidate_hit_[global_id])) return;
+  }
+
   // Position of particle
   GGfloat3 position = {
     primary_particle->px_[global_id],
@@ -85,12 +112,19 @@ kernel void particle_solid_distance_ggems_solid_box(
     #endif
     primary_particle->particle_solid_distance_[global_id] = 0.0f;
     primary_particle->solid_id_[global_id] = solid_box_data->solid_id_;
+    if (exited_solid_id != -1) primary_particle->is_candidate_hit_[global_id] = 1;
     return;
   }
 
   // Compute distance between particles and voxelized navigator
   GGfloat distance = ComputeDistanceToOBB(&position, &direction, &solid_box_data->obb_geometry_);
 
+  // A neighbour of exited solid is hit, no other solid can be reached before
+  if (exited_solid_id != -1 && distance != OUT_OF_WORLD) primary_particle->is_candidate_hit_[global_id] = 1;
+
+  // Last solid of candidate pass, fallback pass is needed if no neighbour is hit
+  if (fallback_search && exited_solid_id != -1 && !primary_particle->is_candidate_hit_[global_id]) *fallback_search = 1;
+
   // Check distance value with previous value. Store the minimum value
   if (distance < primary_particle->particle_solid_distance_[global_id]) {
     #ifdef GGEMS_TRACKING
@@ -34,16 +34,18 @@
 #include "GGEMS/geometries/GGEMSRayTracing.hh"
 
 /*!
-  \fn kernel void particle_solid_distance_ggems_voxelized_solid(GGsize const particle_id_limit, global GGEMSPrimaryParticles* primary_particle, global GGEMSVoxelizedSolidData const* voxelized_solid_data)
+  \fn kernel void particle_solid_distance_ggems_voxelized_solid(GGsize const particle_id_limit, global GGEMSPrimaryParticles* primary_particle, global GGEMSVoxelizedSolidData const* voxelized_solid_data, GGint const mother_id)
   \param particle_id_limit - particle id limit
   \param primary_particle - pointer to primary particles on OpenCL memory
   \param voxelized_solid_data - pointer to voxelized solid data
+  \param mother_id - solid index of mother volume of solid, -1 if world
   \brief OpenCL kernel computing distance between voxelized solid and particles
 */
 kernel void particle_solid_distance_ggems_voxelized_solid(
   GGsize const particle_id_limit,
   global GGEMSPrimaryParticles* primary_particle,
-  global GGEMSVoxelizedSolidData const* voxelized_solid_data
+  global GGEMSVoxelizedSolidData const* voxelized_solid_data,
+  GGint const mother_id
 )
 {
   // Getting index of thread
@@ -55,6 +57,9 @@ kernel void particle_solid_distance_ggems_voxelized_solid(
   // Checking particle status. If DEAD, the particle is not track
   if (primary_particle->status_[global_id] == DEAD) return;
 
+  // Only solids in the mother volume containing the particle are tested
+  if (primary_particle->mother_id_[global_id] != mother_id) return;
+
   // Checking if the particle - solid is 0. If yes the particle is already in another navigator
   if (primary_particle->particle_solid_distance_[global_id] == 0.0f) return;
 
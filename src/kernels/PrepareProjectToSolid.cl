@@ -0,0 +1,84 @@
+// ************************************************************************
+// * This file is part of GGEMS.                                          *
+// *                                                                      *
+// * GGEMS is free software: you can redistribute it and/or modify        *
+// * it under the terms of the GNU General Public License as published by *
+// * the Free Software Foundation, either version 3 of the License, or    *
+// * (at your option) any later version.                                  *
+// *                                                                      *
+// * GGEMS is distributed in the hope that it will be useful,             *
+// * but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+// * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+// * GNU General Public License for more details.                         *
+// *                                                                      *
+// * You should have received a copy of the GNU General Public License    *
+// * along with GGEMS.  If not, see <https://www.gnu.org/licenses/>.      *
+// *                                                                      *
+// ************************************************************************
+
+/*!
+  \file PrepareProjectToSolid.cl
+
+  \brief OpenCL kernel preparing particles before projection to solids of navigators
+
+  \author Julien BERT <julien.bert@univ-brest.fr>
+  \author Didier BENOIT <didier.benoit@inserm.fr>
+  \author LaTIM, INSERM - U1101, Brest, FRANCE
+  \version 1.0
+  \date Sunday October 18, 2026
+*/
+
+#include "GGEMS/physics/GGEMSPrimaryParticles.hh"
+#include "GGEMS/physics/GGEMSParticleConstants.hh"
+
+#include "GGEMS/global/GGEMSConstants.hh"
+
+/*!
+  \fn kernel void prepare_project_to_solid(GGsize const particle_id_limit, global GGEMSPrimaryParticles* primary_particle)
+  \param particle_id_limit - particle id limit
+  \param primary_particle - pointer to primary particles on OpenCL memory
+  \brief OpenCL kernel killing particles without solid or out of world, launched once before projection kernels of all solids, so each projection kernel only writes particles of its own solid
+*/
+kernel void prepare_project_to_solid(
+  GGsize const particle_id_limit,
+  global GGEMSPrimaryParticles* primary_particle
+)
+{
+  // Getting index of thread
+  GGsize global_id = get_global_id(0);
+
+  // Return if index > to particle limit
+  if (global_id >= particle_id_limit) return;
+
+  // No solid detected, consider particle as dead
+  if(primary_particle->solid_id_[global_id] == -1) primary_particle->status_[global_id] = DEAD;
+
+  // Checking if distance to navigator is OUT_OF_WORLD after computation distance
+  // If yes, the particle is OUT_OF_WORLD and DEAD, so no tracking
+  if (primary_particle->particle_solid_distance_[global_id] == OUT_OF_WORLD) {
+    primary_particle->solid_id_[global_id] = -1; // -1 is out_of_world, using for debugging
+    primary_particle->status_[global_id] = DEAD;
+
+    #ifdef OPENGL
+    if (global_id < MAXIMUM_DISPLAYED_PARTICLES) {
+      // Storing OpenGL index on OpenCL private memory
+      GGint stored_particles_gl = primary_particle->stored_particles_gl_[global_id];
+
+      // Checking if buffer is full
+      if (stored_particles_gl != MAXIMUM_INTERACTIONS) {
+        primary_particle->px_gl_[global_id*MAXIMUM_INTERACTIONS+stored_particles_gl] = primary_particle->px_[global_id] + primary_particle->dx_[global_id]*100.0*m;
+        primary_particle->py_gl_[global_id*MAXIMUM_INTERACTIONS+stored_particles_gl] = primary_particle->py_[global_id] + primary_particle->dy_[global_id]*100.0*m;
+        primary_particle->pz_gl_[global_id*MAXIMUM_INTERACTIONS+stored_particles_gl] = primary_particle->pz_[global_id] + primary_particle->dz_[global_id]*100.0*m;
+
+        // Storing final index
+        primary_particle->stored_particles_gl_[global_id] += 1;
+      }
+    }
+    #endif
+
+    return;
+  }
+
+  // Candidate solids are used by one search of closest solid only
+  primary_particle->exited_solid_id_[global_id] = -1;
+}
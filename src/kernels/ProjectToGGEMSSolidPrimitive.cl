@@ -0,0 +1,100 @@
+// ************************************************************************
+// * This file is part of GGEMS.                                          *
+// *                                                                      *
+// * GGEMS is free software: you can redistribute it and/or modify        *
+// * it under the terms of the GNU General Public License as published by *
+// * the Free Software Foundation, either version 3 of the License, or    *
+// * (at your option) any later version.                                  *
+// *                                                                      *
+// * GGEMS is distributed in the hope that it will be useful,             *
+// * but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+// * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+// * GNU General Public License for more details.                         *
+// *                                                                      *
+// * You should have received a copy of the GNU General Public License    *
+// * along with GGEMS.  If not, see <https://www.gnu.org/licenses/>.      *
+// *                                                                      *
+// ************************************************************************
+
+/*!
+  \file ProjectToGGEMSSolidPrimitive.cl
+
+  \brief OpenCL kernel moving particles to analytic primitive solid
+
+  \author Julien BERT <julien.bert@univ-brest.fr>
+  \author Didier BENOIT <didier.benoit@inserm.fr>
+  \author LaTIM, INSERM - U1101, Brest, FRANCE
+  \version 1.0
+  \date Sunday October 18, 2026
+*/
+
+#include "GGEMS/physics/GGEMSPrimaryParticles.hh"
+
+#include "GGEMS/geometries/GGEMSSolidPrimitiveData.hh"
+#include "GGEMS/geometries/GGEMSRayTracing.hh"
+
+#include "GGEMS/global/GGEMSConstants.hh"
+
+#include "GGEMS/maths/GGEMSMatrixOperations.hh"
+
+/*!
+  \fn kernel void project_to_ggems_solid_primitive(GGsize const particle_id_limit, global GGEMSPrimaryParticles* primary_particle, global GGEMSSolidPrimitiveData const* solid_primitive_data)
+  \param particle_id_limit - particle id limit
+  \param primary_particle - pointer to primary particles on OpenCL memory
+  \param solid_primitive_data - pointer to analytic primitive solid data
+  \brief OpenCL kernel moving particles to analytic primitive solid
+*/
+kernel void project_to_ggems_solid_primitive(
+  GGsize const particle_id_limit,
+  global GGEMSPrimaryParticles* primary_particle,
+  global GGEMSSolidPrimitiveData const* solid_primitive_data
+)
+{
+  // Getting index of thread
+  GGsize global_id = get_global_id(0);
+
+  // Return if index > to particle limit
+  if (global_id >= particle_id_limit) return;
+
+  // Checking if the current navigator is the selected navigator
+  if (primary_particle->solid_id_[global_id] != solid_primitive_data->solid_id_) return;
+
+  // Checking status of particle
+  if (primary_particle->status_[global_id] == DEAD) return;
+
+  // Position of particle
+  GGfloat3 position = {
+    primary_particle->px_[global_id],
+    primary_particle->py_[global_id],
+    primary_particle->pz_[global_id]
+  };
+
+  // Direction of particle
+  GGfloat3 direction = {
+    primary_particle->dx_[global_id],
+    primary_particle->dy_[global_id],
+    primary_particle->dz_[global_id]
+  };
+
+  // Distance to current navigator and geometry tolerance
+  GGfloat distance = primary_particle->particle_solid_distance_[global_id];
+
+  // Moving the particle slightly inside the volume
+  position += direction*(distance+GEOMETRY_TOLERANCE);
+
+  // Set new value for particles
+  primary_particle->px_[global_id] = position.x;
+  primary_particle->py_[global_id] = position.y;
+  primary_particle->pz_[global_id] = position.z;
+
+  primary_particle->particle_solid_distance_[global_id] = 0.0f;
+
+  #ifdef GGEMS_TRACKING
+  if (global_id == primary_particle->particle_tracking_id) {
+    printf("[GGEMS OpenCL kernel project_to_ggems_solid_primitive] ********************************************************************************\n");
+    printf("[GGEMS OpenCL kernel project_to_ggems_solid_primitive] Project to closest solid\n");
+    printf("[GGEMS OpenCL kernel project_to_ggems_solid_primitive] Particle id: %d\n", global_id);
+    printf("[GGEMS OpenCL kernel project_to_ggems_solid_primitive] Position (x, y, z): %e %e %e mm\n", position.x/mm, position.y/mm, position.z/mm);
+  }
+  #endif
+}
@@ -0,0 +1,275 @@
+// ************************************************************************
+// * This file is part of GGEMS.                                          *
+// *                                                                      *
+// * GGEMS is free software: you can redistribute it and/or modify        *
+// * it under the terms of the GNU General Public License as published by *
+// * the Free Software Foundation, either version 3 of the License, or    *
+// * (at your option) any later version.                                  *
+// *                                                                      *
+// * GGEMS is distributed in the hope that it will be useful,             *
+// * but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+// * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+// * GNU General Public License for more details.                         *
+// *                                                                      *
+// * You should have received a copy of the GNU General Public License    *
+// * along with GGEMS.  If not, see <https://www.gnu.org/licenses/>.      *
+// *                                                                      *
+// ************************************************************************
+
+/*!
+  \file TrackThroughGGEMSSolidArc.cl
+
+  \brief OpenCL kernel tracking particles within solid arc
+
+  \author Julien BERT <julien.bert@univ-brest.fr>
+  \author Didier BENOIT <didier.benoit@inserm.fr>
+  \author LaTIM, INSERM - U1101, Brest, FRANCE
+  \version 1.0
+  \date Sunday October 18, 2026
+*/
+
+#include "GGEMS/physics/GGEMSPrimaryParticles.hh"
+#include "GGEMS/physics/GGEMSScatterHistory.hh"
+#include "GGEMS/geometries/GGEMSSolidArcData.hh"
+#include "GGEMS/geometries/GGEMSRayTracing.hh"
+#include "GGEMS/materials/GGEMSMaterialTables.hh"
+#include "GGEMS/physics/GGEMSParticleCrossSections.hh"
+#include "GGEMS/randoms/GGEMSRandom.hh"
+#include "GGEMS/maths/GGEMSMatrixOperations.hh"
+#include "GGEMS/navigators/GGEMSPhotonNavigator.hh"
+#include "GGEMS/physics/GGEMSMuData.hh"
+#include "GGEMS/geometries/GGEMSAntiScatterGrid.hh"
+#include "GGEMS/randoms/GGEMSKissEngine.hh"
+
+/*!
+  \fn kernel void track_through_ggems_solid_arc(GGsize const particle_id_limit, global GGEMSPrimaryParticles* primary_particle, global GGEMSRandom* random, global GGEMSSolidArcData const* solid_arc_data, global GGuchar const* label_data, global GGEMSParticleCrossSections const* particle_cross_sections, global GGEMSMaterialTables const* materials, global GGEMSMuMuEnData const* attenuations, GGfloat const threshold, global GGint* histogram, global GGint* scatter_histogram)
+  \param particle_id_limit - particle id limit
+  \param primary_particle - pointer to primary particles on OpenCL memory
+  \param random - pointer on random numbers
+  \param solid_arc_data - pointer to solid arc data
+  \param label_data - pointer storing label of material (empty buffer here, 1 material only)
+  \param particle_cross_sections - pointer to cross sections activated in navigator
+  \param materials - pointer on material in navigator
+  \param attenuations - pointer on attenuation values
+  \param threshold - energy threshold
+  \param histogram - pointer to buffer storing histogram
+  \param scatter_histogram - pointer to buffer storing scatter histograms, one channel per scatter category
+  \brief OpenCL kernel tracking particles within solid arc, pixel index (row, column) is computed analytically from cylindrical coordinates
+*/
+kernel void track_through_ggems_solid_arc(
+  GGsize const particle_id_limit,
+  global GGEMSPrimaryParticles* primary_particle,
+  global GGEMSRandom* random,
+  global GGEMSSolidArcData const* solid_arc_data,
+  global GGuchar const* label_data,
+  global GGEMSParticleCrossSections const* particle_cross_sections,
+  global GGEMSMaterialTables const* materials,
+  global GGEMSMuMuEnData const* attenuations,
+  GGfloat const threshold
+  #ifdef HISTOGRAM
+  ,global GGint* histogram,
+  global GGint* scatter_histogram
+  #endif
+)
+{
+  // Getting index of thread
+  GGsize global_id = get_global_id(0);
+
+  // Return if index > to particle limit
+  if (global_id >= particle_id_limit) return;
+
+  // Checking if the current navigator is the selected navigator
+  if (primary_particle->solid_id_[global_id] != solid_arc_data->solid_id_) return;
+
+  // Checking status of particle
+  if (primary_particle->status_[global_id] == DEAD) {
+    #ifdef GGEMS_TRACKING
+    if (global_id == primary_particle->particle_tracking_id) {
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_arc] ################################################################################\n");
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_arc] The particle id %d is dead!!!\n", global_id);
+    }
+    #endif
+    return;
+  }
+
+  // Get the position and direction in local arc coordinate
+  GGfloat3 global_position = {primary_particle->px_[global_id], primary_particle->py_[global_id], primary_particle->pz_[global_id]};
+  GGfloat3 global_direction = {primary_particle->dx_[global_id], primary_particle->dy_[global_id], primary_particle->dz_[global_id]};
+  GGfloat3 local_position = GlobalToLocalPosition(&solid_arc_data->arc_geometry_.matrix_transformation_, &global_position);
+  GGfloat3 local_direction = GlobalToLocalDirection(&solid_arc_data->arc_geometry_.matrix_transformation_, &global_direction);
+
+  #ifdef ANTI_SCATTER_GRID
+  // Particle entering by the inner face of arc has to cross the anti-scatter grid
+  GGfloat radius = sqrt(local_position.x*local_position.x + local_position.y*local_position.y);
+  GGfloat radial_direction = (local_position.x*local_direction.x + local_position.y*local_direction.y) / radius;
+  if (radius < solid_arc_data->arc_geometry_.radius_min_ + 2.0f*GEOMETRY_TOLERANCE && radial_direction > 0.0f) {
+    global GGEMSAntiScatterGrid const* anti_scatter_grid = &solid_arc_data->anti_scatter_grid_;
+
+    // Lamellae are parallel to cylinder axis, lateral position is the arc length from central ray
+    GGfloat tangential_direction = (local_position.x*local_direction.y - local_position.y*local_direction.x) / radius;
+    GGfloat lateral_position = solid_arc_data->arc_geometry_.radius_min_*atan2(local_position.y, local_position.x) - anti_scatter_grid->focus_position_;
+
+    // Lamella slope relative to radial direction, lamellae are radial if focus distance is the inner radius
+    GGfloat lamella_slope = lateral_position*(1.0f/anti_scatter_grid->focus_distance_ - 1.0f/solid_arc_data->arc_geometry_.radius_min_);
+    GGfloat relative_slope = tangential_direction/radial_direction - lamella_slope;
+    GGfloat path_length = anti_scatter_grid->lamella_height_/radial_direction;
+
+    GGfloat transmission = ComputeAntiScatterGridTransmission(anti_scatter_grid, attenuations, lateral_position, relative_slope, path_length, primary_particle->E_[global_id]);
+
+    // Particle absorbed by the grid, global position and direction are unchanged
+    if (KissUniform(random, global_id) > transmission) {
+      primary_particle->status_[global_id] = DEAD;
+
+      #ifdef GGEMS_TRACKING
+      if (global_id == primary_particle->particle_tracking_id) {
+        printf("[GGEMS OpenCL kernel track_through_ggems_solid_arc] ################################################################################\n");
+        printf("[GGEMS OpenCL kernel track_through_ggems_solid_arc] The particle id %d is absorbed by anti-scatter grid, transmission: %e\n", global_id, transmission);
+      }
+      #endif
+      return;
+    }
+  }
+  #endif
+
+  // Storing local direction in particles 
+  primary_particle->dx_[global_id] = local_direction.x;
+  primary_particle->dy_[global_id] = local_direction.y;
+  primary_particle->dz_[global_id] = local_direction.z;
+
+  // Get arc geometry
+  global GGEMSArc const* arc_geometry = &solid_arc_data->arc_geometry_;
+
+  #ifdef HISTOGRAM
+  // Get virtual element number and size (rows along Z, columns along angle)
+  GGint number_of_rows = (GGint)solid_arc_data->virtual_element_number_xyz_[0];
+  GGint number_of_columns = (GGint)solid_arc_data->virtual_element_number_xyz_[1];
+  GGfloat row_size = solid_arc_data->element_size_xyz_[0];
+  GGfloat angular_pitch = solid_arc_data->element_size_xyz_[1];
+  #endif
+
+  // Track particle until out of solid
+  do {
+    // Find next discrete photon interaction
+    GetPhotonNextInteraction(primary_particle, random, particle_cross_sections, 0, global_id);
+    GGfloat next_interaction_distance = primary_particle->next_interaction_distance_[global_id];
+    GGchar next_discrete_process = primary_particle->next_discrete_process_[global_id];
+
+    // Get safety position of particle to be sure particle is inside arc
+    TransportGetSafetyInsideArc(&local_position, arc_geometry, GEOMETRY_TOLERANCE);
+
+    // Get the distance to next boundary
+    GGfloat distance_to_next_boundary = ComputeDistanceToArcBoundary(&local_position, &local_direction, arc_geometry);
+
+    // If distance to next boundary is inferior to distance to next interaction we move particle to boundary
+    if (distance_to_next_boundary <= next_interaction_distance) {
+      next_interaction_distance = distance_to_next_boundary + GEOMETRY_TOLERANCE;
+      next_discrete_process = TRANSPORTATION;
+    }
+
+    #ifdef GGEMS_TRACKING
+    if (global_id == primary_particle->particle_tracking_id) {
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_arc] ################################################################################\n");
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_arc] Particle id: %d\n", global_id);
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_arc] Particle type: ");
+      if (primary_particle->pname_[global_id] == PHOTON) printf("gamma\n");
+      else if (primary_particle->pname_[global_id] == ELECTRON) printf("e-\n");
+      else if (primary_particle->pname_[global_id] == POSITRON) printf("e+\n");
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_arc] Local position (x, y, z): %e %e %e mm\n", local_position.x/mm, local_position.y/mm, local_position.z/mm);
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_arc] Local direction (x, y, z): %e %e %e\n", local_direction.x, local_direction.y, local_direction.z);
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_arc] Energy: %e keV\n", primary_particle->E_[global_id]/keV);
+      printf("\n");
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_arc] Solid id: %u\n", solid_arc_data->solid_id_);
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_arc] Solid radius: %e %e mm\n", arc_geometry->radius_min_/mm, arc_geometry->radius_max_/mm);
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_arc] Solid angle: %e %e rad\n", arc_geometry->angle_min_, arc_geometry->angle_max_);
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_arc] Solid Z Borders: %e %e mm\n", arc_geometry->z_min_/mm, arc_geometry->z_max_/mm);
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_arc] Material in arc: %s\n", particle_cross_sections->material_names_[0]);
+      printf("\n");
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_arc] Next process: ");
+      if (next_discrete_process == COMPTON_SCATTERING) printf("COMPTON_SCATTERING\n");
+      if (next_discrete_process == PHOTOELECTRIC_EFFECT) printf("PHOTOELECTRIC_EFFECT\n");
+      if (next_discrete_process == RAYLEIGH_SCATTERING) printf("RAYLEIGH_SCATTERING\n");
+      if (next_discrete_process == TRANSPORTATION) printf("TRANSPORTATION\n");
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_arc] Next interaction distance: %e mm\n", next_interaction_distance/mm);
+    }
+    #endif
+
+    // Moving particle to next postion
+    local_position = local_position + local_direction*next_interaction_distance;
+
+    //  Checking if particle outside solid, still in local
+    if (!IsParticleInArc(&local_position, arc_geometry, GEOMETRY_TOLERANCE)) {
+      primary_particle->particle_solid_distance_[global_id] = OUT_OF_WORLD; // Reset to initiale value
+      primary_particle->solid_id_[global_id] = -1; // Out of world
+      break;
+    }
+
+    // Storing new position in local
+    primary_particle->px_[global_id] = local_position.x;
+    primary_particle->py_[global_id] = local_position.y;
+    primary_particle->pz_[global_id] = local_position.z;
+
+    // Check thresold
+    if (primary_particle->E_[global_id] < threshold) primary_particle->status_[global_id] = DEAD;
+
+    // Resolve process if different of TRANSPORTATION
+    if (next_discrete_process != TRANSPORTATION) {
+      PhotonDiscreteProcess(primary_particle, random, materials, particle_cross_sections, 0, global_id);
+
+      local_direction.x = primary_particle->dx_[global_id];
+      local_direction.y = primary_particle->dy_[global_id];
+      local_direction.z = primary_particle->dz_[global_id];
+
+      #ifdef HISTOGRAM
+      if (next_discrete_process == PHOTOELECTRIC_EFFECT || next_discrete_process == COMPTON_SCATTERING) {
+        // Pixel index from cylindrical coordinates: row along Z, column along angle
+        GGfloat angle = atan2(local_position.y, local_position.x);
+        GGint row_id = clamp((GGint)((local_position.z - arc_geometry->z_min_) / row_size), 0, number_of_rows - 1);
+        GGint column_id = clamp((GGint)((angle - arc_geometry->angle_min_) / angular_pitch), 0, number_of_columns - 1);
+
+        atomic_add(&histogram[row_id + column_id * number_of_rows], 1);
+
+        // Storing scatter in channel of scatter category
+        if (scatter_histogram) {
+          GGuchar scatter_history = primary_particle->scatter_history_[global_id];
+          if (scatter_history != NO_SCATTER) {
+            GGint scatter_channel = GetScatterCategory(scatter_history) * number_of_rows * number_of_columns;
+            atomic_add(&scatter_histogram[row_id + column_id * number_of_rows + scatter_channel], 1);
+          }
+        }
+      }
+      #endif
+
+      #ifdef OPENGL
+      if (global_id < MAXIMUM_DISPLAYED_PARTICLES) {
+        // Storing OpenGL index on OpenCL private memory
+        GGint stored_particles_gl = primary_particle->stored_particles_gl_[global_id];
+
+        // Checking if buffer is full
+        if (stored_particles_gl != MAXIMUM_INTERACTIONS) {
+          // Getting global position
+          global_position = LocalToGlobalPosition(&arc_geometry->matrix_transformation_, &local_position);
+
+          primary_particle->px_gl_[global_id*MAXIMUM_INTERACTIONS+stored_particles_gl] = global_position.x;
+          primary_particle->py_gl_[global_id*MAXIMUM_INTERACTIONS+stored_particles_gl] = global_position.y;
+          primary_particle->pz_gl_[global_id*MAXIMUM_INTERACTIONS+stored_particles_gl] = global_position.z;
+
+          // Storing final index
+          primary_particle->stored_particles_gl_[global_id] += 1;
+        }
+      }
+      #endif
+    }
+  } while (primary_particle->status_[global_id] == ALIVE);
+
+  // Convert to global position
+  global_position = LocalToGlobalPosition(&arc_geometry->matrix_transformation_, &local_position);
+  primary_particle->px_[global_id] = global_position.x;
+  primary_particle->py_[global_id] = global_position.y;
+  primary_particle->pz_[global_id] = global_position.z;
+
+  // Convert to global direction
+  global_direction = LocalToGlobalDirection(&arc_geometry->matrix_transformation_, &local_direction);
+  primary_particle->dx_[global_id] = global_direction.x;
+  primary_particle->dy_[global_id] = global_direction.y;
+  primary_particle->dz_[global_id] = global_direction.z;
+}
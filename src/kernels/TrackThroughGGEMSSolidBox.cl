@@ -29,6 +29,7 @@
 */
 
 #include "GGEMS/physics/GGEMSPrimaryParticles.hh"
+#include "GGEMS/physics/GGEMSScatterHistory.hh"
 #include "GGEMS/geometries/GGEMSSolidBoxData.hh"
 #include "GGEMS/geometries/GGEMSRayTracing.hh"
 #include "GGEMS/materials/GGEMSMaterialTables.hh"
@@ -37,6 +38,9 @@
 #include "GGEMS/maths/GGEMSMatrixOperations.hh"
 #include "GGEMS/navigators/GGEMSPhotonNavigator.hh"
 #include "GGEMS/physics/GGEMSMuData.hh"
+#include "GGEMS/geometries/GGEMSAntiScatterGrid.hh"
+#include "GGEMS/geometries/GGEMSModuleLayers.hh"
+#include "GGEMS/randoms/GGEMSKissEngine.hh"
 
 /*!
   \fn kernel void track_through_ggems_solid_box(GGsize const particle_id_limit, global GGEMSPrimaryParticles* primary_particle, global GGEMSRandom* random, global GGEMSSolidBoxData const* solid_box_data, global GGuchar const* label_data, global GGEMSParticleCrossSections const* particle_cross_sections, global GGEMSMaterialTables const* materials, global GGEMSMuMuEnData const* attenuations, GGfloat const threshold, global GGint* histogram, global GGint* scatter_histogram)
@@ -50,7 +54,7 @@
   \param attenuations - pointer on attenuation values
   \param threshold - energy threshold
   \param histogram - pointer to buffer storing histogram
-  \param scatter_histogram - pointer to buffer storing scatter histogram
+  \param scatter_histogram - pointer to buffer storing scatter histograms, one channel per scatter category
   \brief OpenCL kernel tracking particles within voxelized solid
 */
 kernel void track_through_ggems_solid_box(
@@ -95,6 +99,33 @@ kernel void track_through_ggems_solid_box(
   GGfloat3 local_position = GlobalToLocalPosition(&solid_box_data->obb_geometry_.matrix_transformation_, &global_position);
   GGfloat3 local_direction = GlobalToLocalDirection(&solid_box_data->obb_geometry_.matrix_transformation_, &global_direction);
 
+  #ifdef ANTI_SCATTER_GRID
+  // Particle entering by the entrance face of detector has to cross the anti-scatter grid
+  if (local_position.z < solid_box_data->obb_geometry_.border_min_xyz_.s[2] + 2.0f*GEOMETRY_TOLERANCE && local_direction.z > 0.0f) {
+    global GGEMSAntiScatterGrid const* anti_scatter_grid = &solid_box_data->anti_scatter_grid_;
+
+    // Lamellae are parallel to local X axis and focused in local YZ plane
+    GGfloat lateral_position = local_position.y - anti_scatter_grid->focus_position_;
+    GGfloat relative_slope = local_direction.y/local_direction.z - lateral_position/anti_scatter_grid->focus_distance_;
+    GGfloat path_length = anti_scatter_grid->lamella_height_/local_direction.z;
+
+    GGfloat transmission = ComputeAntiScatterGridTransmission(anti_scatter_grid, attenuations, lateral_position, relative_slope, path_length, primary_particle->E_[global_id]);
+
+    // Particle absorbed by the grid, global position and direction are unchanged
+    if (KissUniform(random, global_id) > transmission) {
+      primary_particle->status_[global_id] = DEAD;
+
+      #ifdef GGEMS_TRACKING
+      if (global_id == primary_particle->particle_tracking_id) {
+        printf("[GGEMS OpenCL kernel track_through_ggems_solid_box] ################################################################################\n");
+        printf("[GGEMS OpenCL kernel track_through_ggems_solid_box] The particle id %d is absorbed by anti-scatter grid, transmission: %e\n", global_id, transmission);
+      }
+      #endif
+      return;
+    }
+  }
+  #endif
+
   // Storing local direction in particles 
   primary_particle->dx_[global_id] = local_direction.x;
   primary_particle->dy_[global_id] = local_direction.y;
@@ -118,13 +149,12 @@ kernel void track_through_ggems_solid_box(
     solid_box_data->virtual_element_number_xyz_[2]
   };
 
+  #ifdef MODULE_LAYERS
+  global GGEMSModuleLayers const* module_layers = &solid_box_data->module_layers_;
+  #endif
+
   // Track particle until out of solid
   do {
-    // Find next discrete photon interaction
-    GetPhotonNextInteraction(primary_particle, random, particle_cross_sections, 0, global_id);
-    GGfloat next_interaction_distance = primary_particle->next_interaction_distance_[global_id];
-    GGchar next_discrete_process = primary_particle->next_discrete_process_[global_id];
-
     // Get safety position of particle to be sure particle is inside voxel
     TransportGetSafetyInsideAABB(
       &local_position,
@@ -134,6 +164,19 @@ kernel void track_through_ggems_solid_box(
       GEOMETRY_TOLERANCE
     );
 
+    // Material of the current layer, all the layers of module are tracked in this kernel
+    #ifdef MODULE_LAYERS
+    GGint layer = GetModuleLayer(module_layers, local_position.z);
+    GGint material_id = module_layers->layer_material_id_[layer];
+    #else
+    GGint material_id = 0;
+    #endif
+
+    // Find next discrete photon interaction
+    GetPhotonNextInteraction(primary_particle, random, particle_cross_sections, material_id, global_id);
+    GGfloat next_interaction_distance = primary_particle->next_interaction_distance_[global_id];
+    GGchar next_discrete_process = primary_particle->next_discrete_process_[global_id];
+
     // Get the distance to next boundary
     GGfloat distance_to_next_boundary = ComputeDistanceToAABB(
       &local_position, &local_direction,
@@ -143,6 +186,10 @@ kernel void track_through_ggems_solid_box(
       GEOMETRY_TOLERANCE
     );
 
+    #ifdef MODULE_LAYERS
+    distance_to_next_boundary = fmin(distance_to_next_boundary, ComputeDistanceToModuleLayerBoundary(module_layers, layer, local_position.z, local_direction.z));
+    #endif
+
     // If distance to next boundary is inferior to distance to next interaction we move particle to boundary
     if (distance_to_next_boundary <= next_interaction_distance) {
       next_interaction_distance = distance_to_next_boundary + GEOMETRY_TOLERANCE;
@@ -165,7 +212,7 @@ kernel void track_through_ggems_solid_box(
       printf("[GGEMS OpenCL kernel track_through_ggems_solid_box] Solid X Borders: %e %e mm\n", border_min.x/mm, border_max.x/mm);
       printf("[GGEMS OpenCL kernel track_through_ggems_solid_box] Solid Y Borders: %e %e mm\n", border_min.y/mm, border_max.y/mm);
       printf("[GGEMS OpenCL kernel track_through_ggems_solid_box] Solid Z Borders: %e %e mm\n", border_min.z/mm, border_max.z/mm);
-      printf("[GGEMS OpenCL kernel track_through_ggems_solid_box] Material in voxel: %s\n", particle_cross_sections->material_names_[0]);
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_box] Material in voxel: %s\n", particle_cross_sections->material_names_[material_id]);
       printf("\n");
       printf("[GGEMS OpenCL kernel track_through_ggems_solid_box] Next process: ");
       if (next_discrete_process == COMPTON_SCATTERING) printf("COMPTON_SCATTERING\n");
@@ -192,6 +239,12 @@ kernel void track_through_ggems_solid_box(
     if (!IsParticleInAABB(&local_position, border_min.x, border_max.x, border_min.y, border_max.y, border_min.z, border_max.z, GEOMETRY_TOLERANCE)) {
       primary_particle->particle_solid_distance_[global_id] = OUT_OF_WORLD; // Reset to initiale value
       primary_particle->solid_id_[global_id] = -1; // Out of world
+
+      // Neighbours of exited solid are the first candidates of next search
+      if (solid_box_data->number_of_neighbour_solids_ > 0) {
+        primary_particle->exited_solid_id_[global_id] = solid_box_data->solid_id_;
+        primary_particle->is_candidate_hit_[global_id] = 0;
+      }
       break;
     }
 
@@ -205,22 +258,30 @@ kernel void track_through_ggems_solid_box(
 
     // Resolve process if different of TRANSPORTATION
     if (next_discrete_process != TRANSPORTATION) {
-      PhotonDiscreteProcess(primary_particle, random, materials, particle_cross_sections, 0, global_id);
+      PhotonDiscreteProcess(primary_particle, random, materials, particle_cross_sections, material_id, global_id);
 
       local_direction.x = primary_particle->dx_[global_id];
       local_direction.y = primary_particle->dy_[global_id];
       local_direction.z = primary_particle->dz_[global_id];
 
       #ifdef HISTOGRAM
+      #ifdef MODULE_LAYERS
+      if ((next_discrete_process == PHOTOELECTRIC_EFFECT || next_discrete_process == COMPTON_SCATTERING) && layer == module_layers->sensitive_layer_) {
+      #else
       if (next_discrete_process == PHOTOELECTRIC_EFFECT || next_discrete_process == COMPTON_SCATTERING) {
+      #endif
         GGfloat3 element_size = box_size / convert_float3(virtual_element_number);
         GGint3 voxel_id = convert_int3((local_position - border_min) / element_size);
 
         atomic_add(&histogram[voxel_id.x + voxel_id.y * virtual_element_number.x], 1);
 
-        // Storing scatter
+        // Storing scatter in channel of scatter category
         if (scatter_histogram) {
-          if (primary_particle->scatter_[global_id] == TRUE) atomic_add(&scatter_histogram[voxel_id.x + voxel_id.y * virtual_element_number.x], 1);
+          GGuchar scatter_history = primary_particle->scatter_history_[global_id];
+          if (scatter_history != NO_SCATTER) {
+            GGint scatter_channel = GetScatterCategory(scatter_history) * virtual_element_number.x * virtual_element_number.y;
+            atomic_add(&scatter_histogram[voxel_id.x + voxel_id.y * virtual_element_number.x + scatter_channel], 1);
+          }
         }
       }
       #endif
@@ -0,0 +1,239 @@
+// ************************************************************************
+// * This file is part of GGEMS.                                          *
+// *                                                                      *
+// * GGEMS is free software: you can redistribute it and/or modify        *
+// * it under the terms of the GNU General Public License as published by *
+// * the Free Software Foundation, either version 3 of the License, or    *
+// * (at your option) any later version.                                  *
+// *                                                                      *
+// * GGEMS is distributed in the hope that it will be useful,             *
+// * but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+// * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+// * GNU General Public License for more details.                         *
+// *                                                                      *
+// * You should have received a copy of the GNU General Public License    *
+// * along with GGEMS.  If not, see <https://www.gnu.org/licenses/>.      *
+// *                                                                      *
+// ************************************************************************
+
+/*!
+  \file TrackThroughGGEMSSolidMesh.cl
+
+  \brief OpenCL kernel tracking particles within solid mesh
+
+  \author Julien BERT <julien.bert@univ-brest.fr>
+  \author Didier BENOIT <didier.benoit@inserm.fr>
+  \author LaTIM, INSERM - U1101, Brest, FRANCE
+  \version 1.0
+  \date Sunday October 18, 2026
+*/
+
+#include "GGEMS/physics/GGEMSPrimaryParticles.hh"
+#include "GGEMS/physics/GGEMSScatterHistory.hh"
+#include "GGEMS/geometries/GGEMSSolidMeshData.hh"
+#include "GGEMS/geometries/GGEMSRayTracing.hh"
+#include "GGEMS/materials/GGEMSMaterialTables.hh"
+#include "GGEMS/physics/GGEMSParticleCrossSections.hh"
+#include "GGEMS/randoms/GGEMSRandom.hh"
+#include "GGEMS/maths/GGEMSMatrixOperations.hh"
+#include "GGEMS/navigators/GGEMSPhotonNavigator.hh"
+#include "GGEMS/physics/GGEMSMuData.hh"
+
+/*!
+  \fn kernel void track_through_ggems_solid_mesh(GGsize const particle_id_limit, global GGEMSPrimaryParticles* primary_particle, global GGEMSRandom* random, global GGEMSSolidMeshData const* solid_mesh_data, global GGuchar const* mesh_data, global GGEMSParticleCrossSections const* particle_cross_sections, global GGEMSMaterialTables const* materials, global GGEMSMuMuEnData const* attenuations, GGfloat const threshold)
+  \param particle_id_limit - particle id limit
+  \param primary_particle - pointer to primary particles on OpenCL memory
+  \param random - pointer on random numbers
+  \param solid_mesh_data - pointer to solid mesh data
+  \param mesh_data - pointer storing BVH nodes followed by triangles of mesh
+  \param particle_cross_sections - pointer to cross sections activated in navigator
+  \param materials - pointer on material in navigator
+  \param attenuations - pointer on attenuation values
+  \param threshold - energy threshold
+  \brief OpenCL kernel tracking particles within solid mesh. Particle is inside mesh if the closest triangle crossed is crossed from inside, space between mesh and its bounding box is vacuum
+*/
+kernel void track_through_ggems_solid_mesh(
+  GGsize const particle_id_limit,
+  global GGEMSPrimaryParticles* primary_particle,
+  global GGEMSRandom* random,
+  global GGEMSSolidMeshData const* solid_mesh_data,
+  global GGuchar const* mesh_data,
+  global GGEMSParticleCrossSections const* particle_cross_sections,
+  global GGEMSMaterialTables const* materials,
+  global GGEMSMuMuEnData const* attenuations,
+  GGfloat const threshold
+)
+{
+  // Getting index of thread
+  GGsize global_id = get_global_id(0);
+
+  // Return if index > to particle limit
+  if (global_id >= particle_id_limit) return;
+
+  // Checking if the current navigator is the selected navigator
+  if (primary_particle->solid_id_[global_id] != solid_mesh_data->solid_id_) return;
+
+  // Checking status of particle
+  if (primary_particle->status_[global_id] == DEAD) {
+    #ifdef GGEMS_TRACKING
+    if (global_id == primary_particle->particle_tracking_id) {
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_mesh] ################################################################################\n");
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_mesh] The particle id %d is dead!!!\n", global_id);
+    }
+    #endif
+    return;
+  }
+
+  // BVH nodes followed by triangles
+  global GGEMSMeshBVHNode const* bvh_nodes = (global GGEMSMeshBVHNode const*)mesh_data;
+  global GGEMSMeshTriangle const* triangles = (global GGEMSMeshTriangle const*)(bvh_nodes + solid_mesh_data->number_of_bvh_nodes_);
+
+  // Get bounding box of mesh
+  global GGEMSOBB const* obb_geometry = &solid_mesh_data->obb_geometry_;
+  GGfloat3 border_min = obb_geometry->border_min_xyz_;
+  GGfloat3 border_max = obb_geometry->border_max_xyz_;
+
+  // Get the position and direction in local mesh coordinate
+  GGfloat3 global_position = {primary_particle->px_[global_id], primary_particle->py_[global_id], primary_particle->pz_[global_id]};
+  GGfloat3 global_direction = {primary_particle->dx_[global_id], primary_particle->dy_[global_id], primary_particle->dz_[global_id]};
+  GGfloat3 local_position = GlobalToLocalPosition(&obb_geometry->matrix_transformation_, &global_position);
+  GGfloat3 local_direction = GlobalToLocalDirection(&obb_geometry->matrix_transformation_, &global_direction);
+
+  // Storing local direction in particles
+  primary_particle->dx_[global_id] = local_direction.x;
+  primary_particle->dy_[global_id] = local_direction.y;
+  primary_particle->dz_[global_id] = local_direction.z;
+
+  // Track particle until out of solid
+  do {
+    // Get safety position of particle to be sure particle is inside bounding box
+    TransportGetSafetyInsideAABB(&local_position, border_min.x, border_max.x, border_min.y, border_max.y, border_min.z, border_max.z, GEOMETRY_TOLERANCE);
+
+    // Closest triangle crossed by particle
+    GGint triangle_id = -1;
+    GGfloat distance_to_triangle = ComputeDistanceToMesh(&local_position, &local_direction, bvh_nodes, triangles, &triangle_id);
+
+    // Particle inside mesh if closest triangle is crossed along its outward normal
+    GGchar is_in_mesh = FALSE;
+    if (triangle_id != -1) {
+      GGfloat3 normal = cross(triangles[triangle_id].edge_1_, triangles[triangle_id].edge_2_);
+      if (dot(normal, local_direction) > 0.0f) is_in_mesh = TRUE;
+    }
+
+    GGfloat next_interaction_distance = 0.0f;
+    GGchar next_discrete_process = TRANSPORTATION;
+    if (is_in_mesh) {
+      // Find next discrete photon interaction
+      GetPhotonNextInteraction(primary_particle, random, particle_cross_sections, 0, global_id);
+      next_interaction_distance = primary_particle->next_interaction_distance_[global_id];
+      next_discrete_process = primary_particle->next_discrete_process_[global_id];
+
+      // If distance to mesh boundary is inferior to distance to next interaction we move particle to boundary
+      if (distance_to_triangle <= next_interaction_distance) {
+        next_interaction_distance = distance_to_triangle + GEOMETRY_TOLERANCE;
+        next_discrete_process = TRANSPORTATION;
+      }
+    }
+    else if (triangle_id != -1) {
+      // Vacuum, particle is moved to the mesh
+      next_interaction_distance = distance_to_triangle + GEOMETRY_TOLERANCE;
+    }
+    else {
+      // Vacuum, particle leaves bounding box without crossing mesh
+      next_interaction_distance = ComputeDistanceToAABB(&local_position, &local_direction, border_min.x, border_max.x, border_min.y, border_max.y, border_min.z, border_max.z, GEOMETRY_TOLERANCE) + GEOMETRY_TOLERANCE;
+    }
+
+    #ifdef GGEMS_TRACKING
+    if (global_id == primary_particle->particle_tracking_id) {
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_mesh] ################################################################################\n");
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_mesh] Particle id: %d\n", global_id);
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_mesh] Particle type: ");
+      if (primary_particle->pname_[global_id] == PHOTON) printf("gamma\n");
+      else if (primary_particle->pname_[global_id] == ELECTRON) printf("e-\n");
+      else if (primary_particle->pname_[global_id] == POSITRON) printf("e+\n");
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_mesh] Local position (x, y, z): %e %e %e mm\n", local_position.x/mm, local_position.y/mm, local_position.z/mm);
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_mesh] Local direction (x, y, z): %e %e %e\n", local_direction.x, local_direction.y, local_direction.z);
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_mesh] Energy: %e keV\n", primary_particle->E_[global_id]/keV);
+      printf("\n");
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_mesh] Solid id: %u\n", solid_mesh_data->solid_id_);
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_mesh] Bounding box X Borders: %e %e mm\n", border_min.x/mm, border_max.x/mm);
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_mesh] Bounding box Y Borders: %e %e mm\n", border_min.y/mm, border_max.y/mm);
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_mesh] Bounding box Z Borders: %e %e mm\n", border_min.z/mm, border_max.z/mm);
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_mesh] Closest triangle: %d, particle in mesh: %d\n", triangle_id, is_in_mesh);
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_mesh] Material in mesh: %s\n", particle_cross_sections->material_names_[0]);
+      printf("\n");
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_mesh] Next process: ");
+      if (next_discrete_process == COMPTON_SCATTERING) printf("COMPTON_SCATTERING\n");
+      if (next_discrete_process == PHOTOELECTRIC_EFFECT) printf("PHOTOELECTRIC_EFFECT\n");
+      if (next_discrete_process == RAYLEIGH_SCATTERING) printf("RAYLEIGH_SCATTERING\n");
+      if (next_discrete_process == TRANSPORTATION) printf("TRANSPORTATION\n");
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_mesh] Next interaction distance: %e mm\n", next_interaction_distance/mm);
+    }
+    #endif
+
+    // Moving particle to next postion
+    local_position = local_position + local_direction*next_interaction_distance;
+
+    //  Checking if particle outside solid, still in local
+    if (!IsParticleInAABB(&local_position, border_min.x, border_max.x, border_min.y, border_max.y, border_min.z, border_max.z, GEOMETRY_TOLERANCE)) {
+      primary_particle->particle_solid_distance_[global_id] = OUT_OF_WORLD; // Reset to initiale value
+      primary_particle->solid_id_[global_id] = -1; // Out of world
+      break;
+    }
+
+    // Storing new position in local
+    primary_particle->px_[global_id] = local_position.x;
+    primary_particle->py_[global_id] = local_position.y;
+    primary_particle->pz_[global_id] = local_position.z;
+
+    // Check thresold
+    if (primary_particle->E_[global_id] < threshold) primary_particle->status_[global_id] = DEAD;
+
+    // Resolve process if different of TRANSPORTATION
+    if (next_discrete_process != TRANSPORTATION) {
+      PhotonDiscreteProcess(primary_particle, random, materials, particle_cross_sections, 0, global_id);
+
+      // If process is COMPTON_SCATTERING or RAYLEIGH_SCATTERING scatter history is updated
+      if (next_discrete_process == COMPTON_SCATTERING || next_discrete_process == RAYLEIGH_SCATTERING)
+      {
+        primary_particle->scatter_history_[global_id] = UpdateScatterHistory(primary_particle->scatter_history_[global_id], next_discrete_process);
+      }
+
+      local_direction.x = primary_particle->dx_[global_id];
+      local_direction.y = primary_particle->dy_[global_id];
+      local_direction.z = primary_particle->dz_[global_id];
+
+      #ifdef OPENGL
+      if (global_id < MAXIMUM_DISPLAYED_PARTICLES) {
+        // Storing OpenGL index on OpenCL private memory
+        GGint stored_particles_gl = primary_particle->stored_particles_gl_[global_id];
+
+        // Checking if buffer is full
+        if (stored_particles_gl != MAXIMUM_INTERACTIONS) {
+          // Getting global position
+          global_position = LocalToGlobalPosition(&obb_geometry->matrix_transformation_, &local_position);
+
+          primary_particle->px_gl_[global_id*MAXIMUM_INTERACTIONS+stored_particles_gl] = global_position.x;
+          primary_particle->py_gl_[global_id*MAXIMUM_INTERACTIONS+stored_particles_gl] = global_position.y;
+          primary_particle->pz_gl_[global_id*MAXIMUM_INTERACTIONS+stored_particles_gl] = global_position.z;
+
+          // Storing final index
+          primary_particle->stored_particles_gl_[global_id] += 1;
+        }
+      }
+      #endif
+    }
+  } while (primary_particle->status_[global_id] == ALIVE);
+
+  // Convert to global position
+  global_position = LocalToGlobalPosition(&obb_geometry->matrix_transformation_, &local_position);
+  primary_particle->px_[global_id] = global_position.x;
+  primary_particle->py_[global_id] = global_position.y;
+  primary_particle->pz_[global_id] = global_position.z;
+
+  // Convert to global direction
+  global_direction = LocalToGlobalDirection(&obb_geometry->matrix_transformation_, &local_direction);
+  primary_particle->dx_[global_id] = global_direction.x;
+  primary_particle->dy_[global_id] = global_direction.y;
+  primary_particle->dz_[global_id] = global_direction.z;
+}
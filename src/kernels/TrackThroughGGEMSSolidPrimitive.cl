@@ -0,0 +1,208 @@
+// ************************************************************************
+// * This file is part of GGEMS.                                          *
+// *                                                                      *
+// * GGEMS is free software: you can redistribute it and/or modify        *
+// * it under the terms of the GNU General Public License as published by *
+// * the Free Software Foundation, either version 3 of the License, or    *
+// * (at your option) any later version.                                  *
+// *                                                                      *
+// * GGEMS is distributed in the hope that it will be useful,             *
+// * but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+// * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+// * GNU General Public License for more details.                         *
+// *                                                                      *
+// * You should have received a copy of the GNU General Public License    *
+// * along with GGEMS.  If not, see <https://www.gnu.org/licenses/>.      *
+// *                                                                      *
+// ************************************************************************
+
+/*!
+  \file TrackThroughGGEMSSolidPrimitive.cl
+
+  \brief OpenCL kernel tracking particles within analytic primitive solid
+
+  \author Julien BERT <julien.bert@univ-brest.fr>
+  \author Didier BENOIT <didier.benoit@inserm.fr>
+  \author LaTIM, INSERM - U1101, Brest, FRANCE
+  \version 1.0
+  \date Sunday October 18, 2026
+*/
+
+#include "GGEMS/physics/GGEMSPrimaryParticles.hh"
+#include "GGEMS/physics/GGEMSScatterHistory.hh"
+#include "GGEMS/geometries/GGEMSSolidPrimitiveData.hh"
+#include "GGEMS/geometries/GGEMSRayTracing.hh"
+#include "GGEMS/materials/GGEMSMaterialTables.hh"
+#include "GGEMS/physics/GGEMSParticleCrossSections.hh"
+#include "GGEMS/randoms/GGEMSRandom.hh"
+#include "GGEMS/maths/GGEMSMatrixOperations.hh"
+#include "GGEMS/navigators/GGEMSPhotonNavigator.hh"
+#include "GGEMS/physics/GGEMSMuData.hh"
+
+/*!
+  \fn kernel void track_through_ggems_solid_primitive(GGsize const particle_id_limit, global GGEMSPrimaryParticles* primary_particle, global GGEMSRandom* random, global GGEMSSolidPrimitiveData const* solid_primitive_data, global GGuchar const* label_data, global GGEMSParticleCrossSections const* particle_cross_sections, global GGEMSMaterialTables const* materials, global GGEMSMuMuEnData const* attenuations, GGfloat const threshold)
+  \param particle_id_limit - particle id limit
+  \param primary_particle - pointer to primary particles on OpenCL memory
+  \param random - pointer on random numbers
+  \param solid_primitive_data - pointer to analytic primitive solid data
+  \param label_data - pointer storing label of material (empty buffer here, 1 material only)
+  \param particle_cross_sections - pointer to cross sections activated in navigator
+  \param materials - pointer on material in navigator
+  \param attenuations - pointer on attenuation values
+  \param threshold - energy threshold
+  \brief OpenCL kernel tracking particles within analytic primitive solid, distance to boundary is computed analytically
+*/
+kernel void track_through_ggems_solid_primitive(
+  GGsize const particle_id_limit,
+  global GGEMSPrimaryParticles* primary_particle,
+  global GGEMSRandom* random,
+  global GGEMSSolidPrimitiveData const* solid_primitive_data,
+  global GGuchar const* label_data,
+  global GGEMSParticleCrossSections const* particle_cross_sections,
+  global GGEMSMaterialTables const* materials,
+  global GGEMSMuMuEnData const* attenuations,
+  GGfloat const threshold
+)
+{
+  // Getting index of thread
+  GGsize global_id = get_global_id(0);
+
+  // Return if index > to particle limit
+  if (global_id >= particle_id_limit) return;
+
+  // Checking if the current navigator is the selected navigator
+  if (primary_particle->solid_id_[global_id] != solid_primitive_data->solid_id_) return;
+
+  // Checking status of particle
+  if (primary_particle->status_[global_id] == DEAD) {
+    #ifdef GGEMS_TRACKING
+    if (global_id == primary_particle->particle_tracking_id) {
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_primitive] ################################################################################\n");
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_primitive] The particle id %d is dead!!!\n", global_id);
+    }
+    #endif
+    return;
+  }
+
+  // Get the position and direction in local primitive coordinate
+  GGfloat3 global_position = {primary_particle->px_[global_id], primary_particle->py_[global_id], primary_particle->pz_[global_id]};
+  GGfloat3 global_direction = {primary_particle->dx_[global_id], primary_particle->dy_[global_id], primary_particle->dz_[global_id]};
+  GGfloat3 local_position = GlobalToLocalPosition(&solid_primitive_data->obb_geometry_.matrix_transformation_, &global_position);
+  GGfloat3 local_direction = GlobalToLocalDirection(&solid_primitive_data->obb_geometry_.matrix_transformation_, &global_direction);
+
+  // Storing local direction in particles 
+  primary_particle->dx_[global_id] = local_direction.x;
+  primary_particle->dy_[global_id] = local_direction.y;
+  primary_particle->dz_[global_id] = local_direction.z;
+
+  // Get matrix of transformation
+  global GGEMSTransformationMatrix const* matrix_transformation = &solid_primitive_data->obb_geometry_.matrix_transformation_;
+
+  // Track particle until out of solid
+  do {
+    // Find next discrete photon interaction
+    GetPhotonNextInteraction(primary_particle, random, particle_cross_sections, 0, global_id);
+    GGfloat next_interaction_distance = primary_particle->next_interaction_distance_[global_id];
+    GGchar next_discrete_process = primary_particle->next_discrete_process_[global_id];
+
+    // Get the distance to next boundary
+    GGfloat distance_to_next_boundary = ComputeDistanceToPrimitiveBoundary(&local_position, &local_direction, solid_primitive_data);
+
+    // If distance to next boundary is inferior to distance to next interaction we move particle to boundary
+    if (distance_to_next_boundary <= next_interaction_distance) {
+      next_interaction_distance = distance_to_next_boundary + GEOMETRY_TOLERANCE;
+      next_discrete_process = TRANSPORTATION;
+    }
+
+    #ifdef GGEMS_TRACKING
+    if (global_id == primary_particle->particle_tracking_id) {
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_primitive] ################################################################################\n");
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_primitive] Particle id: %d\n", global_id);
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_primitive] Particle type: ");
+      if (primary_particle->pname_[global_id] == PHOTON) printf("gamma\n");
+      else if (primary_particle->pname_[global_id] == ELECTRON) printf("e-\n");
+      else if (primary_particle->pname_[global_id] == POSITRON) printf("e+\n");
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_primitive] Local position (x, y, z): %e %e %e mm\n", local_position.x/mm, local_position.y/mm, local_position.z/mm);
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_primitive] Local direction (x, y, z): %e %e %e\n", local_direction.x, local_direction.y, local_direction.z);
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_primitive] Energy: %e keV\n", primary_particle->E_[global_id]/keV);
+      printf("\n");
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_primitive] Solid id: %u\n", solid_primitive_data->solid_id_);
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_primitive] Primitive type: %s\n", solid_primitive_data->primitive_type_ == CYLINDER_PRIMITIVE ? "cylinder" : "ellipsoid");
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_primitive] Primitive half size (x, y, z): %e %e %e mm\n", solid_primitive_data->half_size_xyz_.x/mm, solid_primitive_data->half_size_xyz_.y/mm, solid_primitive_data->half_size_xyz_.z/mm);
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_primitive] Material in primitive: %s\n", particle_cross_sections->material_names_[0]);
+      printf("\n");
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_primitive] Next process: ");
+      if (next_discrete_process == COMPTON_SCATTERING) printf("COMPTON_SCATTERING\n");
+      if (next_discrete_process == PHOTOELECTRIC_EFFECT) printf("PHOTOELECTRIC_EFFECT\n");
+      if (next_discrete_process == RAYLEIGH_SCATTERING) printf("RAYLEIGH_SCATTERING\n");
+      if (next_discrete_process == TRANSPORTATION) printf("TRANSPORTATION\n");
+      printf("[GGEMS OpenCL kernel track_through_ggems_solid_primitive] Next interaction distance: %e mm\n", next_interaction_distance/mm);
+    }
+    #endif
+
+    // Moving particle to next postion
+    local_position = local_position + local_direction*next_interaction_distance;
+
+    //  Checking if particle outside solid, still in local
+    if (!IsParticleInPrimitive(&local_position, solid_primitive_data, GEOMETRY_TOLERANCE)) {
+      primary_particle->particle_solid_distance_[global_id] = OUT_OF_WORLD; // Reset to initiale value
+      primary_particle->solid_id_[global_id] = -1; // Out of world
+      break;
+    }
+
+    // Storing new position in local
+    primary_particle->px_[global_id] = local_position.x;
+    primary_particle->py_[global_id] = local_position.y;
+    primary_particle->pz_[global_id] = local_position.z;
+
+    // Check thresold
+    if (primary_particle->E_[global_id] < threshold) primary_particle->status_[global_id] = DEAD;
+
+    // Resolve process if different of TRANSPORTATION
+    if (next_discrete_process != TRANSPORTATION) {
+      PhotonDiscreteProcess(primary_particle, random, materials, particle_cross_sections, 0, global_id);
+
+      // If process is COMPTON_SCATTERING or RAYLEIGH_SCATTERING scatter history is updated
+      if (next_discrete_process == COMPTON_SCATTERING || next_discrete_process == RAYLEIGH_SCATTERING)
+      {
+        primary_particle->scatter_history_[global_id] = UpdateScatterHistory(primary_particle->scatter_history_[global_id], next_discrete_process);
+      }
+
+      local_direction.x = primary_particle->dx_[global_id];
+      local_direction.y = primary_particle->dy_[global_id];
+      local_direction.z = primary_particle->dz_[global_id];
+
+      #ifdef OPENGL
+      if (global_id < MAXIMUM_DISPLAYED_PARTICLES) {
+        // Storing OpenGL index on OpenCL private memory
+        GGint stored_particles_gl = primary_particle->stored_particles_gl_[global_id];
+
+        // Checking if buffer is full
+        if (stored_particles_gl != MAXIMUM_INTERACTIONS) {
+          // Getting global position
+          global_position = LocalToGlobalPosition(matrix_transformation, &local_position);
+
+          primary_particle->px_gl_[global_id*MAXIMUM_INTERACTIONS+stored_particles_gl] = global_position.x;
+          primary_particle->py_gl_[global_id*MAXIMUM_INTERACTIONS+stored_particles_gl] = global_position.y;
+          primary_particle->pz_gl_[global_id*MAXIMUM_INTERACTIONS+stored_particles_gl] = global_position.z;
+
+          // Storing final index
+          primary_particle->stored_particles_gl_[global_id] += 1;
+        }
+      }
+      #endif
+    }
+  } while (primary_particle->status_[global_id] == ALIVE);
+
+  // Convert to global position
+  global_position = LocalToGlobalPosition(matrix_transformation, &local_position);
+  primary_particle->px_[global_id] = global_position.x;
+  primary_particle->py_[global_id] = global_position.y;
+  primary_particle->pz_[global_id] = global_position.z;
+
+  // Convert to global direction
+  global_direction = LocalToGlobalDirection(matrix_transformation, &local_direction);
+  primary_particle->dx_[global_id] = global_direction.x;
+  primary_particle->dy_[global_id] = global_direction.y;
+  primary_particle->dz_[global_id] = global_direction.z;
+}
@@ -29,6 +29,7 @@
 */
 
 #include "GGEMS/physics/GGEMSPrimaryParticles.hh"
+#include "GGEMS/physics/GGEMSScatterHistory.hh"
 #include "GGEMS/geometries/GGEMSVoxelizedSolidData.hh"
 #include "GGEMS/geometries/GGEMSRayTracing.hh"
 #include "GGEMS/materials/GGEMSMaterialTables.hh"
@@ -42,6 +43,10 @@
 #include "GGEMS/navigators/GGEMSDoseRecording.hh"
 #endif
 
+#if defined(PHASE_SPACE)
+#include "GGEMS/io/GGEMSPhaseSpaceParticles.hh"
+#endif
+
 /*!
   \fn kernel void track_through_ggems_voxelized_solid(GGsize const particle_id_limit, global GGEMSPrimaryParticles* primary_particle, global GGEMSRandom* random, global GGEMSVoxelizedSolidData const* voxelized_solid_data, global GGuchar const* label_data, global GGEMSParticleCrossSections const* particle_cross_sections, global GGEMSMaterialTables const* materials, global GGEMSMuMuEnData const* attenuations, GGfloat const threshold)
   \param particle_id_limit - particle id limit
@@ -53,6 +58,10 @@
   \param materials - pointer on material in navigator
   \param attenuations - pointer on attenuation values
   \param threshold - energy threshold
+  \param edep_history_tracking - energy deposit of the last history in dosels (only with DOSIMETRY option)
+  \param last_history_id - id of the last history depositing energy in dosels (only with DOSIMETRY option)
+  \param history_offset - id of the first history in batch (only with DOSIMETRY option)
+  \param phase_space - pointer on phase space particles, storing particles exiting the solid (only with PHASE_SPACE option)
   \brief OpenCL kernel tracking particles within voxelized solid
 */
 kernel void track_through_ggems_voxelized_solid(
@@ -70,7 +79,13 @@ kernel void track_through_ggems_voxelized_solid(
   global GGDosiType* edep_tracking,
   global GGDosiType* edep_squared_tracking,
   global GGint* hit_tracking,
-  global GGint* photon_tracking
+  global GGint* photon_tracking,
+  global GGDosiType* edep_history_tracking,
+  global GGulong* last_history_id,
+  GGulong const history_offset
+  #endif
+  #ifdef PHASE_SPACE
+  ,global GGEMSPhaseSpaceParticles* phase_space
   #endif
 )
 {
@@ -112,6 +127,11 @@ kernel void track_through_ggems_voxelized_solid(
   GGfloat3 voxel_size = voxelized_solid_data->voxel_sizes_xyz_;
   GGint3 number_of_voxels = voxelized_solid_data->number_of_voxels_xyz_;
 
+  #if defined(DOSIMETRY)
+  // Each primary particle is a history
+  GGulong history_id = history_offset + (GGulong)global_id;
+  #endif
+
   // Track particle until out of solid
   do {
     // Get index of voxelized phantom, x, y, z
@@ -195,6 +215,24 @@ kernel void track_through_ggems_voxelized_solid(
     }
     #endif
 
+    #if defined(DOSIMETRY) && defined(TLE)
+    // Track length estimator, energy is deposited along the whole step in all crossed dosels
+    GGfloat step_energy = primary_particle->E_[global_id];
+    GGint E_index = BinarySearchLeft(step_energy, attenuations->energy_bins_, attenuations->number_of_bins_, 0, 0);
+    GGfloat mu_en = 0.0f;
+    if (E_index == 0) {
+      mu_en = attenuations->mu_en_[material_id*attenuations->number_of_bins_];
+    }
+    else {
+      mu_en = LinearInterpolation(
+        attenuations->energy_bins_[E_index-1], attenuations->mu_en_[material_id*attenuations->number_of_bins_ + E_index-1],
+        attenuations->energy_bins_[E_index], attenuations->mu_en_[material_id*attenuations->number_of_bins_ + E_index],
+        step_energy
+      );
+    }
+    dose_record_track_length(dose_params, edep_tracking, edep_squared_tracking, edep_history_tracking, last_history_id, history_id, hit_tracking, step_energy * mu_en * 0.1f, &local_position, &local_direction, next_interaction_distance);
+    #endif
+
     // Moving particle to next position
     local_position = local_position + local_direction*next_interaction_distance;
 
@@ -219,7 +257,7 @@ kernel void track_through_ggems_voxelized_solid(
     primary_particle->py_[global_id] = local_position.y;
     primary_particle->pz_[global_id] = local_position.z;
 
-    #if defined(DOSIMETRY)
+    #if defined(DOSIMETRY) && !defined(TLE)
     GGfloat initial_energy = primary_particle->E_[global_id];
     #endif
 
@@ -228,15 +266,22 @@ kernel void track_through_ggems_voxelized_solid(
 
       PhotonDiscreteProcess(primary_particle, random, materials, particle_cross_sections, material_id, global_id);
 
-      // If process is COMPTON_SCATTERING or RAYLEIGH_SCATTERING scatter order is incremented
+      // If process is COMPTON_SCATTERING or RAYLEIGH_SCATTERING scatter history is updated
       if (next_discrete_process == COMPTON_SCATTERING || next_discrete_process == RAYLEIGH_SCATTERING)
       {
-        primary_particle->scatter_[global_id] = TRUE;
+        primary_particle->scatter_history_[global_id] = UpdateScatterHistory(primary_particle->scatter_history_[global_id], next_discrete_process);
       }
 
       #if defined(DOSIMETRY) && !defined(TLE)
       GGfloat edep = initial_energy - primary_particle->E_[global_id];
-      dose_record_standard(dose_params, edep_tracking, edep_squared_tracking, hit_tracking, edep, &local_position);
+      #if defined(CSDA)
+      // Secondary electron direction from momentum conservation, incident direction for photoelectric effect
+      GGfloat3 scattered_direction = {primary_particle->dx_[global_id], primary_particle->dy_[global_id], primary_particle->dz_[global_id]};
+      GGfloat3 electron_direction = normalize(local_direction*initial_energy - scattered_direction*primary_particle->E_[global_id]);
+      dose_record_csda(dose_params, edep_tracking, edep_squared_tracking, edep_history_tracking, last_history_id, history_id, hit_tracking, materials, material_id, edep, &local_position, &electron_direction);
+      #else
+      dose_record_standard(dose_params, edep_tracking, edep_squared_tracking, edep_history_tracking, last_history_id, history_id, hit_tracking, edep, &local_position);
+      #endif
       #endif
 
       local_direction.x = primary_particle->dx_[global_id];
@@ -264,27 +309,10 @@ kernel void track_through_ggems_voxelized_solid(
       #endif
     }
 
-    #if defined(DOSIMETRY) && defined(TLE)
-    GGint E_index = BinarySearchLeft(initial_energy, attenuations->energy_bins_, attenuations->number_of_bins_, 0, 0);
-    GGfloat mu_en = 0.0f;
-    if (E_index == 0) {
-      mu_en = attenuations->mu_en_[material_id*attenuations->number_of_bins_];
-    }
-    else {
-      mu_en = LinearInterpolation(
-        attenuations->energy_bins_[E_index-1], attenuations->mu_en_[material_id*attenuations->number_of_bins_ + E_index-1],
-        attenuations->energy_bins_[E_index], attenuations->mu_en_[material_id*attenuations->number_of_bins_ + E_index],
-        initial_energy
-      );
-    }
-    GGfloat edep = initial_energy * mu_en * next_interaction_distance * 0.1f;
-    dose_record_standard(dose_params, edep_tracking, edep_squared_tracking, hit_tracking, edep, &local_position);
-    #endif
-
     // Apply threshold
     if (primary_particle->E_[global_id] <= materials->photon_energy_cut_[material_id]) {
       #if defined(DOSIMETRY)
-      dose_record_standard(dose_params, edep_tracking, edep_squared_tracking, hit_tracking, primary_particle->E_[global_id], &local_position);
+      dose_record_standard(dose_params, edep_tracking, edep_squared_tracking, edep_history_tracking, last_history_id, history_id, hit_tracking, primary_particle->E_[global_id], &local_position);
       #endif
       primary_particle->status_[global_id] = DEAD;
     }
@@ -301,4 +329,19 @@ kernel void track_through_ggems_voxelized_solid(
   primary_particle->dx_[global_id] = global_direction.x;
   primary_particle->dy_[global_id] = global_direction.y;
   primary_particle->dz_[global_id] = global_direction.z;
+
+  #ifdef PHASE_SPACE
+  // Particle still alive after tracking has exited the solid, storing it in phase space
+  if (primary_particle->status_[global_id] == ALIVE) {
+    phase_space->E_[global_id] = primary_particle->E_[global_id];
+    phase_space->px_[global_id] = global_position.x;
+    phase_space->py_[global_id] = global_position.y;
+    phase_space->pz_[global_id] = global_position.z;
+    phase_space->dx_[global_id] = global_direction.x;
+    phase_space->dy_[global_id] = global_direction.y;
+    phase_space->dz_[global_id] = global_direction.z;
+    phase_space->scatter_history_[global_id] = primary_particle->scatter_history_[global_id];
+    phase_space->is_recorded_[global_id] = TRUE;
+  }
+  #endif
 }
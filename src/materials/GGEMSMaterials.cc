@@ -391,6 +391,28 @@ GGfloat GGEMSMaterials::GetEnergyCut(std::string const& material_name, std::stri
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+GGfloat GGEMSMaterials::GetMinimumPhotonEnergyCut(GGsize const& thread_index) const
+{
+  // Get the OpenCL manager
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  // Getting the OpenCL pointer on material tables
+  GGEMSMaterialTables* material_table_device = opencl_manager.GetDeviceBuffer<GGEMSMaterialTables>(material_tables_[thread_index], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSMaterialTables), thread_index);
+
+  GGfloat minimum_energy_cut = std::numeric_limits<GGfloat>::max();
+  for (GGsize i = 0; i < material_table_device->number_of_materials_; ++i) {
+    if (material_table_device->photon_energy_cut_[i] < minimum_energy_cut) minimum_energy_cut = material_table_device->photon_energy_cut_[i];
+  }
+
+  opencl_manager.ReleaseDeviceBuffer(material_tables_[thread_index], material_table_device, thread_index);
+
+  return minimum_energy_cut;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 void GGEMSMaterials::Initialize(void)
 {
   GGcout("GGEMSMaterials", "Initialize", 3) << "Initializing the materials..." << GGendl;
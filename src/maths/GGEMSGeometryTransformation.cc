@@ -86,6 +86,9 @@ GGEMSGeometryTransformation::GGEMSGeometryTransformation(void)
       {0.0f, 0.0f, 0.0f, 1.0f}
     };
 
+  // Initializing transformation matrix
+  matrix_local_to_global_ = matrix_orthographic_projection_;
+
   // Get OpenCL manager
   GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
 
@@ -95,23 +98,11 @@ GGEMSGeometryTransformation::GGEMSGeometryTransformation(void)
   // Allocating buffer on each activated device
   matrix_transformation_ = new cl::Buffer*[number_activated_devices_];
   for (GGsize i = 0; i < number_activated_devices_; ++i) {
-    matrix_transformation_[i] = opencl_manager.Allocate(nullptr, sizeof(GGfloat44), i, CL_MEM_READ_WRITE, "GGEMSGeometryTransformation");
-
-    // Initializing
-    GGfloat44* matrix_transformation_device = opencl_manager.GetDeviceBuffer<GGfloat44>(matrix_transformation_[i], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGfloat44), i);
-
-    // Copying
-    for (GGint j = 0; j < 4; ++j) {
-      matrix_transformation_device->m0_[j] = matrix_orthographic_projection_.m0_[j];
-      matrix_transformation_device->m1_[j] = matrix_orthographic_projection_.m1_[j];
-      matrix_transformation_device->m2_[j] = matrix_orthographic_projection_.m2_[j];
-      matrix_transformation_device->m3_[j] = matrix_orthographic_projection_.m3_[j];
-    }
-
-    // Release the pointer, mandatory step!!!
-    opencl_manager.ReleaseDeviceBuffer(matrix_transformation_[i], matrix_transformation_device, i);
+    matrix_transformation_[i] = opencl_manager.Allocate(nullptr, sizeof(GGEMSTransformationMatrix), i, CL_MEM_READ_WRITE, "GGEMSGeometryTransformation");
   }
 
+  UploadTransformationMatrix();
+
   GGcout("GGEMSGeometryTransformation", "GGEMSGeometryTransformation", 3) << "GGEMSGeometryTransformation created!!!" << GGendl;
 }
 
@@ -127,7 +118,7 @@ GGEMSGeometryTransformation::~GGEMSGeometryTransformation()
 
   if (matrix_transformation_) {
     for (GGsize i = 0; i < number_activated_devices_; ++i) {
-      opencl_manager.Deallocate(matrix_transformation_[i], sizeof(GGfloat44), i);
+      opencl_manager.Deallocate(matrix_transformation_[i], sizeof(GGEMSTransformationMatrix), i);
     }
     delete[] matrix_transformation_;
     matrix_transformation_ = nullptr;
@@ -156,28 +147,9 @@ void GGEMSGeometryTransformation::SetTranslation(GGfloat const& tx, GGfloat cons
       {0.0f, 0.0f, 0.0f, 1.0f}
     };
 
-  // Get OpenCL manager
-  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
-
-  // Setting translation on each device
-  for (GGsize i = 0; i < number_activated_devices_; ++i) {
-    // Get the pointer on device
-    GGfloat44* matrix_transformation_device = opencl_manager.GetDeviceBuffer<GGfloat44>(matrix_transformation_[i], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGfloat44), i);
-
-    // Compute a temporary matrix then copy it on OpenCL device
-    GGfloat44 matrix_tmp = GGfloat44MultGGfloat44(&matrix_translation_, matrix_transformation_device);
-
-    // Copy step
-    for (GGint j = 0; j < 4; ++j) {
-      matrix_transformation_device->m0_[j] = matrix_tmp.m0_[j];
-      matrix_transformation_device->m1_[j] = matrix_tmp.m1_[j];
-      matrix_transformation_device->m2_[j] = matrix_tmp.m2_[j];
-      matrix_transformation_device->m3_[j] = matrix_tmp.m3_[j];
-    }
-
-    // Release the pointer, mandatory step!!!
-    opencl_manager.ReleaseDeviceBuffer(matrix_transformation_[i], matrix_transformation_device, i);
-  }
+  // Composing with the current transformation
+  matrix_local_to_global_ = GGfloat44MultGGfloat44(&matrix_translation_, &matrix_local_to_global_);
+  UploadTransformationMatrix();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -243,29 +215,9 @@ void GGEMSGeometryTransformation::SetRotation(GGfloat const& rx, GGfloat const&
   matrix_rotation_ = GGfloat44MultGGfloat44(&rotation_y, &rotation_x);
   matrix_rotation_ = GGfloat44MultGGfloat44(&rotation_z, &matrix_rotation_);
 
-  // Get OpenCL manager
-  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
-
-  // Setting translation on each device
-  for (GGsize i = 0; i < number_activated_devices_; ++i) {
-    // Update the transformation matrix on OpenCL device
-    // Get the pointer on device
-    GGfloat44* matrix_transformation_device = opencl_manager.GetDeviceBuffer<GGfloat44>(matrix_transformation_[i], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGfloat44), i);
-
-    // // Compute a temporary matrix then copy it on OpenCL device
-    GGfloat44 matrix_tmp = GGfloat44MultGGfloat44(&matrix_rotation_, matrix_transformation_device);
-
-    // Copy step
-    for (GGint j = 0; j < 4; ++j) {
-      matrix_transformation_device->m0_[j] = matrix_tmp.m0_[j];
-      matrix_transformation_device->m1_[j] = matrix_tmp.m1_[j];
-      matrix_transformation_device->m2_[j] = matrix_tmp.m2_[j];
-      matrix_transformation_device->m3_[j] = matrix_tmp.m3_[j];
-    }
-
-    // Release the pointer, mandatory step!!!
-    opencl_manager.ReleaseDeviceBuffer(matrix_transformation_[i], matrix_transformation_device, i);
-  }
+  // Composing with the current transformation
+  matrix_local_to_global_ = GGfloat44MultGGfloat44(&matrix_rotation_, &matrix_local_to_global_);
+  UploadTransformationMatrix();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -314,21 +266,34 @@ void GGEMSGeometryTransformation::SetAxisTransformation(GGfloat33 const& axis)
       {0.0f, 0.0f, 0.0f, 1.0f}
     };
 
+  // Axis transformation resets the transformation
+  matrix_local_to_global_ = matrix_orthographic_projection_;
+  UploadTransformationMatrix();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSGeometryTransformation::UploadTransformationMatrix(void)
+{
+  // Local to global matrix, last row is implicit, and its inverse computed once on host
+  GGEMSTransformationMatrix transformation_matrix;
+  for (GGint j = 0; j < 4; ++j) {
+    transformation_matrix.local_to_global_.m0_[j] = matrix_local_to_global_.m0_[j];
+    transformation_matrix.local_to_global_.m1_[j] = matrix_local_to_global_.m1_[j];
+    transformation_matrix.local_to_global_.m2_[j] = matrix_local_to_global_.m2_[j];
+  }
+  ComputeGlobalToLocalMatrix(&transformation_matrix);
+
   // Get OpenCL manager
   GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
 
-  // Setting translation on each device
+  // Copying transformation on each device
   for (GGsize i = 0; i < number_activated_devices_; ++i) {
-    // Initialize to 0
-    GGfloat44* matrix_transformation_device = opencl_manager.GetDeviceBuffer<GGfloat44>(matrix_transformation_[i], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGfloat44), i);
-
-    // Copy step
-    for (GGint j = 0; j < 4; ++j) {
-      matrix_transformation_device->m0_[j] = matrix_orthographic_projection_.m0_[j];
-      matrix_transformation_device->m1_[j] = matrix_orthographic_projection_.m1_[j];
-      matrix_transformation_device->m2_[j] = matrix_orthographic_projection_.m2_[j];
-      matrix_transformation_device->m3_[j] = matrix_orthographic_projection_.m3_[j];
-    }
+    GGEMSTransformationMatrix* matrix_transformation_device = opencl_manager.GetDeviceBuffer<GGEMSTransformationMatrix>(matrix_transformation_[i], CL_TRUE, CL_MAP_WRITE, sizeof(GGEMSTransformationMatrix), i);
+
+    *matrix_transformation_device = transformation_matrix;
 
     // Release the pointer, mandatory step!!!
     opencl_manager.ReleaseDeviceBuffer(matrix_transformation_[i], matrix_transformation_device, i);
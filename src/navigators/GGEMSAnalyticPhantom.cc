@@ -0,0 +1,215 @@
+// ************************************************************************
+// * This file is part of GGEMS.                                          *
+// *                                                                      *
+// * GGEMS is free software: you can redistribute it and/or modify        *
+// * it under the terms of the GNU General Public License as published by *
+// * the Free Software Foundation, either version 3 of the License, or    *
+// * (at your option) any later version.                                  *
+// *                                                                      *
+// * GGEMS is distributed in the hope that it will be useful,             *
+// * but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+// * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+// * GNU General Public License for more details.                         *
+// *                                                                      *
+// * You should have received a copy of the GNU General Public License    *
+// * along with GGEMS.  If not, see <https://www.gnu.org/licenses/>.      *
+// *                                                                      *
+// ************************************************************************
+
+/*!
+  \file GGEMSAnalyticPhantom.cc
+
+  \brief Child GGEMS class handling analytic phantom, a sphere, a cylinder or an ellipsoid filled with one material
+
+  \author Julien BERT <julien.bert@univ-brest.fr>
+  \author Didier BENOIT <didier.benoit@inserm.fr>
+  \author LaTIM, INSERM - U1101, Brest, FRANCE
+  \date Sunday October 18, 2026
+*/
+
+#include "GGEMS/navigators/GGEMSAnalyticPhantom.hh"
+#include "GGEMS/geometries/GGEMSSolidPrimitive.hh"
+#include "GGEMS/geometries/GGEMSSolidPrimitiveData.hh"
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+GGEMSAnalyticPhantom::GGEMSAnalyticPhantom(std::string const& analytic_phantom_name)
+: GGEMSNavigator(analytic_phantom_name),
+  primitive_type_(-1),
+  material_name_("")
+{
+  GGcout("GGEMSAnalyticPhantom", "GGEMSAnalyticPhantom", 3) << "GGEMSAnalyticPhantom creating..." << GGendl;
+
+  half_size_xyz_ = {{0.0f, 0.0f, 0.0f}};
+
+  GGcout("GGEMSAnalyticPhantom", "GGEMSAnalyticPhantom", 3) << "GGEMSAnalyticPhantom created!!!" << GGendl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+GGEMSAnalyticPhantom::~GGEMSAnalyticPhantom(void)
+{
+  GGcout("GGEMSAnalyticPhantom", "~GGEMSAnalyticPhantom", 3) << "GGEMSAnalyticPhantom erasing..." << GGendl;
+
+  GGcout("GGEMSAnalyticPhantom", "~GGEMSAnalyticPhantom", 3) << "GGEMSAnalyticPhantom erased!!!" << GGendl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSAnalyticPhantom::CheckParameters(void) const
+{
+  GGcout("GGEMSAnalyticPhantom", "CheckParameters", 3) << "Checking the mandatory parameters..." << GGendl;
+
+  // Checking primitive
+  if (primitive_type_ == -1) {
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "You have to set a sphere, a cylinder or an ellipsoid for the analytic phantom!!!";
+    GGEMSMisc::ThrowException("GGEMSAnalyticPhantom", "CheckParameters", oss.str());
+  }
+
+  // Checking material of primitive
+  if (material_name_.empty()) {
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "You have to set a material for the analytic phantom!!!";
+    GGEMSMisc::ThrowException("GGEMSAnalyticPhantom", "CheckParameters", oss.str());
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSAnalyticPhantom::Initialize(void)
+{
+  GGcout("GGEMSAnalyticPhantom", "Initialize", 3) << "Initializing a GGEMS analytic phantom..." << GGendl;
+
+  CheckParameters();
+
+  // Getting the current number of registered solid
+  GGEMSNavigatorManager& navigator_manager = GGEMSNavigatorManager::GetInstance();
+
+  // Get the number of already registered buffer
+  GGsize number_of_registered_solids = navigator_manager.GetNumberOfRegisteredSolids();
+
+  // Allocation of memory for solid, 1 solid and 1 material per primitive
+  solids_ = new GGEMSSolid*[1];
+  number_of_solids_ = 1;
+
+  materials_->AddMaterial(material_name_);
+
+  solids_[0] = new GGEMSSolidPrimitive(primitive_type_, half_size_xyz_);
+
+  // Enabling tracking if necessary
+  if (is_tracking_) solids_[0]->EnableTracking();
+
+  // Initializing kernels
+  solids_[0]->Initialize(materials_);
+
+  // Perform rotation before position
+  if (is_update_rot_) solids_[0]->SetRotation(rotation_xyz_);
+  if (is_update_pos_) solids_[0]->SetPosition(position_xyz_);
+
+  for (GGsize j = 0; j < number_activated_devices_; ++j) {
+    solids_[0]->SetSolidID<GGEMSSolidPrimitiveData>(number_of_registered_solids, j);
+    // Store the transformation matrix in solid object
+    solids_[0]->UpdateTransformationMatrix(j);
+  }
+
+  // Initialize parent class
+  GGEMSNavigator::Initialize();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSAnalyticPhantom::SetSphere(GGfloat const& radius, std::string const& material_name, std::string const& unit)
+{
+  SetEllipsoid(radius, radius, radius, material_name, unit);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSAnalyticPhantom::SetCylinder(GGfloat const& radius, GGfloat const& height, std::string const& material_name, std::string const& unit)
+{
+  primitive_type_ = CYLINDER_PRIMITIVE;
+  half_size_xyz_.s[0] = DistanceUnit(radius, unit);
+  half_size_xyz_.s[1] = DistanceUnit(radius, unit);
+  half_size_xyz_.s[2] = DistanceUnit(height, unit) * 0.5f;
+  material_name_ = material_name;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSAnalyticPhantom::SetEllipsoid(GGfloat const& radius_x, GGfloat const& radius_y, GGfloat const& radius_z, std::string const& material_name, std::string const& unit)
+{
+  primitive_type_ = ELLIPSOID_PRIMITIVE;
+  half_size_xyz_.s[0] = DistanceUnit(radius_x, unit);
+  half_size_xyz_.s[1] = DistanceUnit(radius_y, unit);
+  half_size_xyz_.s[2] = DistanceUnit(radius_z, unit);
+  material_name_ = material_name;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+GGEMSAnalyticPhantom* create_ggems_analytic_phantom(char const* analytic_phantom_name)
+{
+  return new(std::nothrow) GGEMSAnalyticPhantom(analytic_phantom_name);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void set_sphere_ggems_analytic_phantom(GGEMSAnalyticPhantom* analytic_phantom, GGfloat const radius, char const* material_name, char const* unit)
+{
+  analytic_phantom->SetSphere(radius, material_name, unit);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void set_cylinder_ggems_analytic_phantom(GGEMSAnalyticPhantom* analytic_phantom, GGfloat const radius, GGfloat const height, char const* material_name, char const* unit)
+{
+  analytic_phantom->SetCylinder(radius, height, material_name, unit);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void set_ellipsoid_ggems_analytic_phantom(GGEMSAnalyticPhantom* analytic_phantom, GGfloat const radius_x, GGfloat const radius_y, GGfloat const radius_z, char const* material_name, char const* unit)
+{
+  analytic_phantom->SetEllipsoid(radius_x, radius_y, radius_z, material_name, unit);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void set_position_ggems_analytic_phantom(GGEMSAnalyticPhantom* analytic_phantom, GGfloat const position_x, GGfloat const position_y, GGfloat const position_z, char const* unit)
+{
+  analytic_phantom->SetPosition(position_x, position_y, position_z, unit);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void set_rotation_ggems_analytic_phantom(GGEMSAnalyticPhantom* analytic_phantom, GGfloat const rx, GGfloat const ry, GGfloat const rz, char const* unit)
+{
+  analytic_phantom->SetRotation(rx, ry, rz, unit);
+}
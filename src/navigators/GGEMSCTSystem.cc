@@ -27,9 +27,13 @@
   \date Monday October 19, 2020
 */
 
+#include <vector>
+
 #include "GGEMS/navigators/GGEMSCTSystem.hh"
 #include "GGEMS/geometries/GGEMSSolidBox.hh"
 #include "GGEMS/geometries/GGEMSSolidBoxData.hh"
+#include "GGEMS/geometries/GGEMSSolidArc.hh"
+#include "GGEMS/geometries/GGEMSSolidArcData.hh"
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
@@ -39,10 +43,22 @@ GGEMSCTSystem::GGEMSCTSystem(std::string const& ct_system_name)
 : GGEMSSystem(ct_system_name),
   ct_system_type_(""),
   source_isocenter_distance_(0.0f),
-  source_detector_distance_(0.0f)
+  source_detector_distance_(0.0f),
+  is_anti_scatter_grid_(false),
+  lamella_material_(""),
+  interspace_material_("Air"),
+  sensitive_layer_(-1)
 {
   GGcout("GGEMSCTSystem", "GGEMSCTSystem", 3) << "GGEMSCTSystem creating..." << GGendl;
 
+  anti_scatter_grid_.lamella_pitch_ = 0.0f;
+  anti_scatter_grid_.lamella_thickness_ = 0.0f;
+  anti_scatter_grid_.lamella_height_ = 0.0f;
+  anti_scatter_grid_.focus_distance_ = 0.0f;
+  anti_scatter_grid_.focus_position_ = 0.0f;
+  anti_scatter_grid_.lamella_material_id_ = 0;
+  anti_scatter_grid_.interspace_material_id_ = 0;
+
   GGcout("GGEMSCTSystem", "GGEMSCTSystem", 3) << "GGEMSCTSystem created!!!" << GGendl;
 }
 
@@ -98,6 +114,54 @@ void GGEMSCTSystem::SetSourceDetectorDistance(GGfloat const& source_detector_dis
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+void GGEMSCTSystem::SetAntiScatterGrid(GGfloat const& lamella_pitch, GGfloat const& lamella_thickness, GGfloat const& lamella_height, GGfloat const& focus_distance, std::string const& unit)
+{
+  is_anti_scatter_grid_ = true;
+  anti_scatter_grid_.lamella_pitch_ = DistanceUnit(lamella_pitch, unit);
+  anti_scatter_grid_.lamella_thickness_ = DistanceUnit(lamella_thickness, unit);
+  anti_scatter_grid_.lamella_height_ = DistanceUnit(lamella_height, unit);
+  anti_scatter_grid_.focus_distance_ = DistanceUnit(focus_distance, unit);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSCTSystem::SetAntiScatterGridMaterial(std::string const& lamella_material, std::string const& interspace_material)
+{
+  lamella_material_ = lamella_material;
+  interspace_material_ = interspace_material;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSCTSystem::AddModuleLayer(std::string const& material_name, GGfloat const& thickness, std::string const& unit, bool const& is_sensitive)
+{
+  if (layer_materials_.size() == MAXIMUM_MODULE_LAYERS) {
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "Maximum number of layers in a module is " << MAXIMUM_MODULE_LAYERS << "!!!";
+    GGEMSMisc::ThrowException("GGEMSCTSystem", "AddModuleLayer", oss.str());
+  }
+
+  if (is_sensitive) {
+    if (sensitive_layer_ != -1) {
+      std::ostringstream oss(std::ostringstream::out);
+      oss << "Only one layer of module can be sensitive!!!";
+      GGEMSMisc::ThrowException("GGEMSCTSystem", "AddModuleLayer", oss.str());
+    }
+    sensitive_layer_ = static_cast<GGint>(layer_materials_.size());
+  }
+
+  layer_materials_.push_back(material_name);
+  layer_thicknesses_.push_back(DistanceUnit(thickness, unit));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 void GGEMSCTSystem::CheckParameters(void) const
 {
   GGcout("GGEMSCTSystem", "CheckParameters", 3) << "Checking the mandatory parameters..." << GGendl;
@@ -120,6 +184,48 @@ void GGEMSCTSystem::CheckParameters(void) const
     GGEMSMisc::ThrowException("GGEMSCTSystem", "CheckParameters", oss.str());
   }
 
+  if (!layer_materials_.empty()) {
+    if (ct_system_type_ != "flat") {
+      std::ostringstream oss(std::ostringstream::out);
+      oss << "Module layers are only available for flat CT system!!!";
+      GGEMSMisc::ThrowException("GGEMSCTSystem", "CheckParameters", oss.str());
+    }
+
+    if (sensitive_layer_ == -1) {
+      std::ostringstream oss(std::ostringstream::out);
+      oss << "A sensitive layer has to be defined in module!!!";
+      GGEMSMisc::ThrowException("GGEMSCTSystem", "CheckParameters", oss.str());
+    }
+
+    for (GGsize i = 0; i < layer_thicknesses_.size(); ++i) {
+      if (layer_thicknesses_[i] <= 0.0f) {
+        std::ostringstream oss(std::ostringstream::out);
+        oss << "Thickness of module layer " << i << " has to be > 0.0 mm!!!";
+        GGEMSMisc::ThrowException("GGEMSCTSystem", "CheckParameters", oss.str());
+      }
+    }
+  }
+
+  if (is_anti_scatter_grid_) {
+    if (anti_scatter_grid_.lamella_thickness_ <= 0.0f || anti_scatter_grid_.lamella_pitch_ <= anti_scatter_grid_.lamella_thickness_) {
+      std::ostringstream oss(std::ostringstream::out);
+      oss << "For anti-scatter grid, lamella thickness has to be > 0.0 mm and inferior to lamella pitch!!!";
+      GGEMSMisc::ThrowException("GGEMSCTSystem", "CheckParameters", oss.str());
+    }
+
+    if (anti_scatter_grid_.lamella_height_ <= 0.0f || anti_scatter_grid_.focus_distance_ < 0.0f) {
+      std::ostringstream oss(std::ostringstream::out);
+      oss << "For anti-scatter grid, lamella height has to be > 0.0 mm and focus distance >= 0.0 mm!!!";
+      GGEMSMisc::ThrowException("GGEMSCTSystem", "CheckParameters", oss.str());
+    }
+
+    if (lamella_material_.empty()) {
+      std::ostringstream oss(std::ostringstream::out);
+      oss << "Material of anti-scatter grid lamellae is not set!!!";
+      GGEMSMisc::ThrowException("GGEMSCTSystem", "CheckParameters", oss.str());
+    }
+  }
+
   // Call parent parameters
   GGEMSSystem::CheckParameters();
 }
@@ -130,55 +236,19 @@ void GGEMSCTSystem::CheckParameters(void) const
 
 void GGEMSCTSystem::InitializeCurvedGeometry(void)
 {
-  // Computing the angle 'alpha' between x-ray source and Y borders of a module
-  // Using Pythagore algorithm in a regular polygone
-  // rho = Hypotenuse
-  // h = Apothem or source detector distance in our case
-  // c = Half-distance of module in Y
-  GGfloat c = (static_cast<GGfloat>(number_of_detection_elements_inside_module_xyz_.y_)*size_of_detection_elements_xyz_.s[1])*0.5f;
-  GGfloat rho = std::sqrt(source_detector_distance_*source_detector_distance_ + c*c);
-  GGfloat alpha = 2.0f*std::asin(c/rho);
-
-  // Center of rotation O (ox, oy) is the source
-  GGfloat ox = -source_isocenter_distance_;
-  GGfloat oy = 0.0f;
-
-  // Center of module P (px, py) is source detector distance minus source isocenter distance plus half size of module in Z (module referential)
-  GGfloat px = source_detector_distance_ - source_isocenter_distance_;
-  GGfloat py = 0.0f;
-
-  // Loop over each module in X and Y, and compute angle of each module in around Z
-  for (GGsize j = 0; j < number_of_modules_xy_.y_; ++j) { // for Y modules
-    GGfloat step_angle = alpha * (static_cast<GGfloat>(j) + 0.5f*(1.0f - static_cast<GGfloat>(number_of_modules_xy_.y_)));
-
-    // Computing the X and Y positions in global position (isocenter)
-    GGfloat global_position_x = (px-ox)*std::cos(step_angle) - (py-oy)*std::sin(step_angle) + ox;
-    GGfloat global_position_y = (px-ox)*std::sin(step_angle) + (py-oy)*std::cos(step_angle) + oy;
-
-    for (GGsize i = 0; i < number_of_modules_xy_.x_; ++i) { // for X modules
-      // Computing the Z position in global position (isocenter)
-      GGfloat global_position_z = static_cast<GGfloat>(number_of_detection_elements_inside_module_xyz_.x_)*size_of_detection_elements_xyz_.s[0]*(static_cast<GGfloat>(i)+0.5f*(1.0f-static_cast<GGfloat>(number_of_modules_xy_.x_)));
-
-      GGsize global_index = i+j*number_of_modules_xy_.x_;
-
-      GGfloat3 rotation;
-      rotation.s[0] = 0.0f;
-      rotation.s[1] = 0.0f;
-      rotation.s[2] = step_angle;
-      solids_[global_index]->SetRotation(rotation);
-
-      GGfloat3 position;
-      position.s[0] = global_position_x + global_system_position_xyz_.s[0];
-      position.s[1] = global_position_y + global_system_position_xyz_.s[1];
-      position.s[2] = global_position_z + global_system_position_xyz_.s[2];
-      solids_[global_index]->SetPosition(position);
-
-      // Rotation for OpenGL volume
-      #ifdef OPENGL_VISUALIZATION
-      solids_[global_index]->SetZAngleOpenGL(step_angle);
-      #endif
-    }
-  }
+  // The curved detector is a single solid arc, the center of the arc is the x-ray source
+  // Pixel index (row, column) is computed analytically during navigation, no module tiling
+  GGfloat3 rotation;
+  rotation.s[0] = 0.0f;
+  rotation.s[1] = 0.0f;
+  rotation.s[2] = 0.0f;
+  solids_[0]->SetRotation(rotation);
+
+  GGfloat3 position;
+  position.s[0] = -source_isocenter_distance_ + global_system_position_xyz_.s[0];
+  position.s[1] = global_system_position_xyz_.s[1];
+  position.s[2] = global_system_position_xyz_.s[2];
+  solids_[0]->SetPosition(position);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -220,6 +290,81 @@ void GGEMSCTSystem::InitializeFlatGeometry(void)
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+void GGEMSCTSystem::InitializeAntiScatterGrid(void)
+{
+  // Registering grid materials in navigator
+  anti_scatter_grid_.lamella_material_id_ = RegisterMaterial(lamella_material_);
+  anti_scatter_grid_.interspace_material_id_ = RegisterMaterial(interspace_material_);
+
+  // By default the grid is focused on the source, focus is the distance to entrance face of detector
+  if (anti_scatter_grid_.focus_distance_ == 0.0f) {
+    anti_scatter_grid_.focus_distance_ = source_detector_distance_ - GetModuleThickness()*0.5f;
+  }
+
+  for (GGsize i = 0; i < number_of_solids_; ++i) {
+    // For flat CT, focus line is the central ray, computed in local frame of each module
+    if (ct_system_type_ == "flat") {
+      GGsize j = i / number_of_modules_xy_.x_;
+      GGfloat module_position_y = static_cast<GGfloat>(number_of_detection_elements_inside_module_xyz_.y_)*size_of_detection_elements_xyz_.s[1]*(static_cast<GGfloat>(j)+0.5f*(1.0f-static_cast<GGfloat>(number_of_modules_xy_.y_)));
+      anti_scatter_grid_.focus_position_ = -(module_position_y + global_system_position_xyz_.s[1]);
+    }
+    else {
+      anti_scatter_grid_.focus_position_ = 0.0f;
+    }
+
+    solids_[i]->EnableAntiScatterGrid(anti_scatter_grid_);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSCTSystem::InitializeModuleLayers(void)
+{
+  GGEMSModuleLayers module_layers;
+  module_layers.number_of_layers_ = static_cast<GGint>(layer_materials_.size());
+  module_layers.sensitive_layer_ = sensitive_layer_;
+
+  // Layers are stacked from the entrance face of module along local Z
+  module_layers.layer_z_min_[0] = -GetModuleThickness()*0.5f;
+  for (GGsize i = 0; i < layer_materials_.size(); ++i) {
+    module_layers.layer_z_min_[i+1] = module_layers.layer_z_min_[i] + layer_thicknesses_[i];
+    module_layers.layer_material_id_[i] = RegisterMaterial(layer_materials_[i]);
+  }
+
+  for (GGsize i = 0; i < number_of_solids_; ++i) solids_[i]->EnableModuleLayers(module_layers);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+GGint GGEMSCTSystem::RegisterMaterial(std::string const& material_name)
+{
+  GGsize i = 0;
+  while (i < materials_->GetNumberOfMaterials() && materials_->GetMaterialName(i) != material_name) ++i;
+  if (i == materials_->GetNumberOfMaterials()) materials_->AddMaterial(material_name);
+  return static_cast<GGint>(i);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+GGfloat GGEMSCTSystem::GetModuleThickness(void) const
+{
+  if (layer_thicknesses_.empty()) return static_cast<GGfloat>(number_of_detection_elements_inside_module_xyz_.z_)*size_of_detection_elements_xyz_.s[2];
+
+  GGfloat thickness = 0.0f;
+  for (GGsize i = 0; i < layer_thicknesses_.size(); ++i) thickness += layer_thicknesses_[i];
+  return thickness;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 void GGEMSCTSystem::Initialize(void)
 {
   GGcout("GGEMSCTSystem", "Initialize", 3) << "Initializing a GGEMS CT system..." << GGendl;
@@ -232,22 +377,61 @@ void GGEMSCTSystem::Initialize(void)
   GGEMSNavigatorManager& navigator_manager = GGEMSNavigatorManager::GetInstance();
   GGsize number_of_registered_solids = navigator_manager.GetNumberOfRegisteredSolids();
 
-  // Creating all solids, solid box for CT
-  number_of_solids_ = static_cast<GGsize>(number_of_modules_xy_.x_ * number_of_modules_xy_.y_);
-
-  // Allocation of memory for solid
-  solids_ = new GGEMSSolid*[number_of_solids_];
-
-  for (GGsize i = 0; i < number_of_solids_; ++i) { // In CT system only "HISTOGRAM"
-    solids_[i] = new GGEMSSolidBox(
-      number_of_detection_elements_inside_module_xyz_.x_,
-      number_of_detection_elements_inside_module_xyz_.y_,
+  // Creating all solids, solid arc for curved CT and solid box for flat CT
+  if (ct_system_type_ == "curved") {
+    number_of_solids_ = 1;
+
+    // Computing the angle 'alpha' between x-ray source and Y borders of a module
+    // Using Pythagore algorithm in a regular polygone
+    // rho = Hypotenuse
+    // h = Apothem or source detector distance in our case
+    // c = Half-distance of module in Y
+    GGfloat c = (static_cast<GGfloat>(number_of_detection_elements_inside_module_xyz_.y_)*size_of_detection_elements_xyz_.s[1])*0.5f;
+    GGfloat rho = std::sqrt(source_detector_distance_*source_detector_distance_ + c*c);
+    GGfloat alpha = 2.0f*std::asin(c/rho);
+
+    // Thickness of detector, centered on source detector distance
+    GGfloat thickness = static_cast<GGfloat>(number_of_detection_elements_inside_module_xyz_.z_) * size_of_detection_elements_xyz_.s[2];
+
+    // Allocation of memory for solid
+    solids_ = new GGEMSSolid*[number_of_solids_];
+
+    // In CT system only "HISTOGRAM"
+    solids_[0] = new GGEMSSolidArc(
+      number_of_modules_xy_.x_ * number_of_detection_elements_inside_module_xyz_.x_,
+      number_of_modules_xy_.y_ * number_of_detection_elements_inside_module_xyz_.y_,
       number_of_detection_elements_inside_module_xyz_.z_,
-      static_cast<GGfloat>(number_of_detection_elements_inside_module_xyz_.x_) * size_of_detection_elements_xyz_.s[0],
-      static_cast<GGfloat>(number_of_detection_elements_inside_module_xyz_.y_) * size_of_detection_elements_xyz_.s[1],
-      static_cast<GGfloat>(number_of_detection_elements_inside_module_xyz_.z_) * size_of_detection_elements_xyz_.s[2],
+      source_detector_distance_ - thickness*0.5f,
+      thickness,
+      alpha * static_cast<GGfloat>(number_of_modules_xy_.y_),
+      static_cast<GGfloat>(number_of_modules_xy_.x_ * number_of_detection_elements_inside_module_xyz_.x_) * size_of_detection_elements_xyz_.s[0],
       "HISTOGRAM"
     );
+  }
+  else {
+    number_of_solids_ = static_cast<GGsize>(number_of_modules_xy_.x_ * number_of_modules_xy_.y_);
+
+    // Allocation of memory for solid
+    solids_ = new GGEMSSolid*[number_of_solids_];
+
+    for (GGsize i = 0; i < number_of_solids_; ++i) { // In CT system only "HISTOGRAM"
+      solids_[i] = new GGEMSSolidBox(
+        number_of_detection_elements_inside_module_xyz_.x_,
+        number_of_detection_elements_inside_module_xyz_.y_,
+        number_of_detection_elements_inside_module_xyz_.z_,
+        static_cast<GGfloat>(number_of_detection_elements_inside_module_xyz_.x_) * size_of_detection_elements_xyz_.s[0],
+        static_cast<GGfloat>(number_of_detection_elements_inside_module_xyz_.y_) * size_of_detection_elements_xyz_.s[1],
+        GetModuleThickness(),
+        "HISTOGRAM"
+      );
+    }
+  }
+
+  // Anti-scatter grid and module layers have to be enabled before kernel compilation
+  if (is_anti_scatter_grid_) InitializeAntiScatterGrid();
+  if (!layer_materials_.empty()) InitializeModuleLayers();
+
+  for (GGsize i = 0; i < number_of_solids_; ++i) {
     solids_[i]->SetVisible(is_visible_);
     solids_[i]->SetMaterialName(materials_->GetMaterialName(0));
     solids_[i]->SetCustomMaterialColor(custom_material_rgb_);
@@ -287,11 +471,31 @@ void GGEMSCTSystem::Initialize(void)
   for (GGsize j = 0; j < number_activated_devices_; ++j) {
     for (GGsize i = 0; i < number_of_solids_; ++i) {
       // Set solid id
-      solids_[i]->SetSolidID<GGEMSSolidBoxData>(number_of_registered_solids+i, j);
+      if (ct_system_type_ == "curved") solids_[i]->SetSolidID<GGEMSSolidArcData>(number_of_registered_solids+i, j);
+      else solids_[i]->SetSolidID<GGEMSSolidBoxData>(number_of_registered_solids+i, j);
       solids_[i]->UpdateTransformationMatrix(j);
     }
   }
 
+  // Flat modules are contiguous on the grid, a particle exiting a module can only enter one of its 8 neighbours
+  if (ct_system_type_ == "flat") {
+    for (GGsize j = 0; j < number_of_modules_xy_.y_; ++j) {
+      for (GGsize i = 0; i < number_of_modules_xy_.x_; ++i) {
+        std::vector<GGint> neighbour_solid_ids;
+        for (GGint dj = -1; dj <= 1; ++dj) {
+          for (GGint di = -1; di <= 1; ++di) {
+            GGint ni = static_cast<GGint>(i) + di;
+            GGint nj = static_cast<GGint>(j) + dj;
+            if ((di == 0 && dj == 0) || ni < 0 || nj < 0 || ni >= static_cast<GGint>(number_of_modules_xy_.x_) || nj >= static_cast<GGint>(number_of_modules_xy_.y_)) continue;
+            neighbour_solid_ids.push_back(static_cast<GGint>(number_of_registered_solids) + ni + nj*static_cast<GGint>(number_of_modules_xy_.x_));
+          }
+        }
+        solids_[i+j*number_of_modules_xy_.x_]->SetNeighbourSolids(neighbour_solid_ids);
+      }
+    }
+    is_candidate_search_ = true;
+  }
+
   #ifdef OPENGL_VISUALIZATION
   for (GGsize i = 0; i < number_of_solids_; ++i) solids_[i]->BuildOpenGL();
   #endif
@@ -376,6 +580,33 @@ void set_source_detector_distance_ggems_ct_system(GGEMSCTSystem* ct_system, GGfl
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+void set_anti_scatter_grid_ggems_ct_system(GGEMSCTSystem* ct_system, GGfloat const lamella_pitch, GGfloat const lamella_thickness, GGfloat const lamella_height, GGfloat const focus_distance, char const* unit)
+{
+  ct_system->SetAntiScatterGrid(lamella_pitch, lamella_thickness, lamella_height, focus_distance, unit);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void set_anti_scatter_grid_material_ggems_ct_system(GGEMSCTSystem* ct_system, char const* lamella_material, char const* interspace_material)
+{
+  ct_system->SetAntiScatterGridMaterial(lamella_material, interspace_material);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void add_module_layer_ggems_ct_system(GGEMSCTSystem* ct_system, char const* material_name, GGfloat const thickness, char const* unit, bool const is_sensitive)
+{
+  ct_system->AddModuleLayer(material_name, thickness, unit, is_sensitive);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 void set_rotation_ggems_ct_system(GGEMSCTSystem* ct_system, GGfloat const rx, GGfloat const ry, GGfloat const rz, char const* unit)
 {
   ct_system->SetRotation(rx, ry, rz, unit);
@@ -403,6 +634,24 @@ void set_threshold_ggems_ct_system(GGEMSCTSystem* ct_system, GGfloat const thres
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+void set_sinogram_ggems_ct_system(GGEMSCTSystem* ct_system, GGsize const number_of_views)
+{
+  ct_system->SetSinogram(number_of_views);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void set_view_ggems_ct_system(GGEMSCTSystem* ct_system, GGfloat const view_angle, GGfloat const table_position, char const* angle_unit, char const* distance_unit)
+{
+  ct_system->SetView(view_angle, table_position, angle_unit, distance_unit);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 void store_scatter_ggems_ct_system(GGEMSCTSystem* ct_system, bool const is_scatter)
 {
   ct_system->StoreScatter(is_scatter);
@@ -27,28 +27,47 @@
   \date Wednesday January 13, 2021
 */
 
+#include <fstream>
+#include <thread>
+
 #include "GGEMS/navigators/GGEMSDosimetryCalculator.hh"
 #include "GGEMS/navigators/GGEMSDoseParams.hh"
 #include "GGEMS/geometries/GGEMSVoxelizedSolid.hh"
 #include "GGEMS/io/GGEMSMHDImage.hh"
 #include "GGEMS/tools/GGEMSProfilerManager.hh"
+#include "GGEMS/tools/GGEMSSystemOfUnits.hh"
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
 GGEMSDosimetryCalculator::GGEMSDosimetryCalculator(void)
-: dosimetry_output_filename_("dosi"),
+: total_number_of_dosels_(0),
+  number_of_pyramid_dosels_(0),
+  number_of_dose_levels_(1),
+  target_uncertainty_(0.0f),
+  is_dose_region_(false),
+  dosimetry_output_filename_("dosi"),
   navigator_(nullptr),
   is_photon_tracking_(false),
   is_edep_(false),
   is_hit_tracking_(false),
   is_edep_squared_(false),
   is_uncertainty_(false),
+  is_label_dose_(false),
+  is_dose_map_(true),
+  number_of_labels_(0),
   scale_factor_(1.0f),
   is_water_reference_(FALSE),
   minimum_density_(0.0f),
-  kernel_compute_dose_(nullptr)
+  number_of_histories_(nullptr),
+  is_dose_grid_(false),
+  is_squared_recording_(false),
+  number_of_shared_dosels_(0),
+  kernel_compute_dose_(nullptr),
+  kernel_select_dose_level_(nullptr),
+  kernel_reduce_dose_by_label_(nullptr),
+  kernel_finalize_dose_(nullptr)
 {
   GGcout("GGEMSDosimetryCalculator", "GGEMSDosimetryCalculator", 3) << "GGEMSDosimetryCalculator creating..." << GGendl;
 
@@ -56,6 +75,11 @@ GGEMSDosimetryCalculator::GGEMSDosimetryCalculator(void)
   dosel_sizes_.s[1] = -1.0f;
   dosel_sizes_.s[2] = -1.0f;
 
+  for (GGsize i = 0; i < 3; ++i) {
+    dose_region_min_xyz_.s[i] = 0.0f;
+    dose_region_max_xyz_.s[i] = 0.0f;
+  }
+
   GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
   // Get the number of activated device
   number_activated_devices_ = opencl_manager.GetNumberOfActivatedDevice();
@@ -79,10 +103,19 @@ GGEMSDosimetryCalculator::GGEMSDosimetryCalculator(void)
   dose_recording_.edep_ = new cl::Buffer*[number_activated_devices_];
   dose_recording_.dose_ = new cl::Buffer*[number_activated_devices_];
   dose_recording_.uncertainty_dose_ = new cl::Buffer*[number_activated_devices_];
+  dose_recording_.adaptive_dose_ = new cl::Buffer*[number_activated_devices_];
+  dose_recording_.dose_level_ = new cl::Buffer*[number_activated_devices_];
+  dose_recording_.label_edep_ = new cl::Buffer*[number_activated_devices_];
+  dose_recording_.label_mass_ = new cl::Buffer*[number_activated_devices_];
   dose_recording_.edep_squared_ = new cl::Buffer*[number_activated_devices_];
+  dose_recording_.edep_history_ = new cl::Buffer*[number_activated_devices_];
+  dose_recording_.last_history_id_ = new cl::Buffer*[number_activated_devices_];
   dose_recording_.hit_ = new cl::Buffer*[number_activated_devices_];
   dose_recording_.photon_tracking_ = new cl::Buffer*[number_activated_devices_];
 
+  number_of_histories_ = new GGsize[number_activated_devices_];
+  for (GGsize i = 0; i < number_activated_devices_; ++i) number_of_histories_[i] = 0;
+
   GGcout("GGEMSDosimetryCalculator", "GGEMSDosimetryCalculator", 3) << "GGEMSDosimetryCalculator created!!!" << GGendl;
 }
 
@@ -98,7 +131,7 @@ GGEMSDosimetryCalculator::~GGEMSDosimetryCalculator(void)
 
   if (dose_params_) {
     for (GGsize i = 0; i < number_activated_devices_; ++i) {
-      opencl_manager.Deallocate(dose_params_[i], sizeof(GGEMSDoseParams ), i);
+      opencl_manager.Deallocate(dose_params_[i], (is_dose_grid_ ? 1 : 1 + dose_grids_.size())*sizeof(GGEMSDoseParams), i);
     }
     delete[] dose_params_;
     dose_params_ = nullptr;
@@ -106,7 +139,8 @@ GGEMSDosimetryCalculator::~GGEMSDosimetryCalculator(void)
 
   if (dose_recording_.edep_) {
     for (GGsize i = 0; i < number_activated_devices_; ++i) {
-      opencl_manager.Deallocate(dose_recording_.edep_[i], total_number_of_dosels_*sizeof(GGDosiType), i);
+      if (is_dose_grid_) opencl_manager.DeallocateSubBuffer(dose_recording_.edep_[i]);
+      else opencl_manager.Deallocate(dose_recording_.edep_[i], number_of_shared_dosels_*sizeof(GGDosiType), i);
     }
     delete[] dose_recording_.edep_;
     dose_recording_.edep_ = nullptr;
@@ -114,7 +148,7 @@ GGEMSDosimetryCalculator::~GGEMSDosimetryCalculator(void)
 
   if (dose_recording_.dose_) {
     for (GGsize i = 0; i < number_activated_devices_; ++i) {
-      opencl_manager.Deallocate(dose_recording_.dose_[i], total_number_of_dosels_*sizeof(GGfloat), i);
+      opencl_manager.Deallocate(dose_recording_.dose_[i], number_of_pyramid_dosels_*sizeof(GGfloat), i);
     }
     delete[] dose_recording_.dose_;
     dose_recording_.dose_ = nullptr;
@@ -123,25 +157,93 @@ GGEMSDosimetryCalculator::~GGEMSDosimetryCalculator(void)
   if (dose_recording_.uncertainty_dose_) {
     if (is_uncertainty_) {
       for (GGsize i = 0; i < number_activated_devices_; ++i) {
-        opencl_manager.Deallocate(dose_recording_.uncertainty_dose_[i], total_number_of_dosels_*sizeof(GGfloat), i);
+        opencl_manager.Deallocate(dose_recording_.uncertainty_dose_[i], number_of_pyramid_dosels_*sizeof(GGfloat), i);
       }
     }
     delete[] dose_recording_.uncertainty_dose_;
     dose_recording_.uncertainty_dose_ = nullptr;
   }
 
+  if (dose_recording_.adaptive_dose_) {
+    if (number_of_dose_levels_ > 1) {
+      for (GGsize i = 0; i < number_activated_devices_; ++i) {
+        opencl_manager.Deallocate(dose_recording_.adaptive_dose_[i], total_number_of_dosels_*sizeof(GGfloat), i);
+      }
+    }
+    delete[] dose_recording_.adaptive_dose_;
+    dose_recording_.adaptive_dose_ = nullptr;
+  }
+
+  if (dose_recording_.dose_level_) {
+    if (number_of_dose_levels_ > 1) {
+      for (GGsize i = 0; i < number_activated_devices_; ++i) {
+        opencl_manager.Deallocate(dose_recording_.dose_level_[i], total_number_of_dosels_*sizeof(GGint), i);
+      }
+    }
+    delete[] dose_recording_.dose_level_;
+    dose_recording_.dose_level_ = nullptr;
+  }
+
+  if (dose_recording_.label_edep_) {
+    if (is_label_dose_) {
+      for (GGsize i = 0; i < number_activated_devices_; ++i) {
+        opencl_manager.Deallocate(dose_recording_.label_edep_[i], number_of_labels_*sizeof(GGDosiType), i);
+      }
+    }
+    delete[] dose_recording_.label_edep_;
+    dose_recording_.label_edep_ = nullptr;
+  }
+
+  if (dose_recording_.label_mass_) {
+    if (is_label_dose_) {
+      for (GGsize i = 0; i < number_activated_devices_; ++i) {
+        opencl_manager.Deallocate(dose_recording_.label_mass_[i], number_of_labels_*sizeof(GGDosiType), i);
+      }
+    }
+    delete[] dose_recording_.label_mass_;
+    dose_recording_.label_mass_ = nullptr;
+  }
+
   if (dose_recording_.edep_squared_) {
-    if (is_edep_squared_||is_uncertainty_) {
+    if (is_squared_recording_) {
       for (GGsize i = 0; i < number_activated_devices_; ++i) {
-        opencl_manager.Deallocate(dose_recording_.edep_squared_[i], total_number_of_dosels_*sizeof(GGDosiType), i);
+        if (is_dose_grid_) opencl_manager.DeallocateSubBuffer(dose_recording_.edep_squared_[i]);
+        else opencl_manager.Deallocate(dose_recording_.edep_squared_[i], number_of_shared_dosels_*sizeof(GGDosiType), i);
       }
     }
     delete[] dose_recording_.edep_squared_;
     dose_recording_.edep_squared_ = nullptr;
   }
 
+  if (dose_recording_.edep_history_) {
+    if (is_squared_recording_) {
+      for (GGsize i = 0; i < number_activated_devices_; ++i) {
+        if (is_dose_grid_) opencl_manager.DeallocateSubBuffer(dose_recording_.edep_history_[i]);
+        else opencl_manager.Deallocate(dose_recording_.edep_history_[i], number_of_shared_dosels_*sizeof(GGDosiType), i);
+      }
+    }
+    delete[] dose_recording_.edep_history_;
+    dose_recording_.edep_history_ = nullptr;
+  }
+
+  if (dose_recording_.last_history_id_) {
+    if (is_squared_recording_) {
+      for (GGsize i = 0; i < number_activated_devices_; ++i) {
+        if (is_dose_grid_) opencl_manager.DeallocateSubBuffer(dose_recording_.last_history_id_[i]);
+        else opencl_manager.Deallocate(dose_recording_.last_history_id_[i], number_of_shared_dosels_*sizeof(GGulong), i);
+      }
+    }
+    delete[] dose_recording_.last_history_id_;
+    dose_recording_.last_history_id_ = nullptr;
+  }
+
+  if (number_of_histories_) {
+    delete[] number_of_histories_;
+    number_of_histories_ = nullptr;
+  }
+
   if (dose_recording_.hit_) {
-    if (is_hit_tracking_||is_uncertainty_) {
+    if (is_hit_tracking_) {
       for (GGsize i = 0; i < number_activated_devices_; ++i) {
         opencl_manager.Deallocate(dose_recording_.hit_[i], total_number_of_dosels_*sizeof(GGint), i);
       }
@@ -165,6 +267,21 @@ GGEMSDosimetryCalculator::~GGEMSDosimetryCalculator(void)
     kernel_compute_dose_ = nullptr;
   }
 
+  if (kernel_select_dose_level_) {
+    delete[] kernel_select_dose_level_;
+    kernel_select_dose_level_ = nullptr;
+  }
+
+  if (kernel_reduce_dose_by_label_) {
+    delete[] kernel_reduce_dose_by_label_;
+    kernel_reduce_dose_by_label_ = nullptr;
+  }
+
+  if (kernel_finalize_dose_) {
+    delete[] kernel_finalize_dose_;
+    kernel_finalize_dose_ = nullptr;
+  }
+
   GGcout("GGEMSDosimetryCalculator", "~GGEMSDosimetryCalculator", 3) << "GGEMSSourceManager erased!!!" << GGendl;
 }
 
@@ -259,11 +376,73 @@ void GGEMSDosimetryCalculator::SetUncertainty(bool const& is_activated)
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+void GGEMSDosimetryCalculator::SetLabelDose(bool const& is_activated)
+{
+  is_label_dose_ = is_activated;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSDosimetryCalculator::SetDoseMap(bool const& is_activated)
+{
+  is_dose_map_ = is_activated;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 void GGEMSDosimetryCalculator::SetTLE(bool const& is_activated)
 {
   navigator_->EnableTLE(is_activated);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSDosimetryCalculator::SetCSDA(bool const& is_activated)
+{
+  navigator_->EnableCSDA(is_activated);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSDosimetryCalculator::SetAdaptiveDosels(GGsize const& number_of_levels, GGfloat const& target_uncertainty)
+{
+  number_of_dose_levels_ = number_of_levels;
+  target_uncertainty_ = target_uncertainty;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSDosimetryCalculator::SetDoseRegion(GGfloat const& x_min, GGfloat const& x_max, GGfloat const& y_min, GGfloat const& y_max, GGfloat const& z_min, GGfloat const& z_max, std::string const& unit)
+{
+  dose_region_min_xyz_.s[0] = DistanceUnit(x_min, unit);
+  dose_region_min_xyz_.s[1] = DistanceUnit(y_min, unit);
+  dose_region_min_xyz_.s[2] = DistanceUnit(z_min, unit);
+  dose_region_max_xyz_.s[0] = DistanceUnit(x_max, unit);
+  dose_region_max_xyz_.s[1] = DistanceUnit(y_max, unit);
+  dose_region_max_xyz_.s[2] = DistanceUnit(z_max, unit);
+  is_dose_region_ = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSDosimetryCalculator::AddDoseGrid(GGEMSDosimetryCalculator* dose_grid)
+{
+  dose_grid->is_dose_grid_ = true;
+  dose_grids_.push_back(dose_grid);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
@@ -293,6 +472,24 @@ void GGEMSDosimetryCalculator::CheckParameters(void) const
     oss << "A navigator has to be associated to GGEMSDosimetryCalculator!!!";
     GGEMSMisc::ThrowException("GGEMSDosimetryCalculator", "CheckParameters", oss.str());
   }
+
+  if (number_of_dose_levels_ == 0 || number_of_dose_levels_ > MAXIMUM_DOSE_LEVELS) {
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "Number of levels in dose pyramid has to be between 1 and " << MAXIMUM_DOSE_LEVELS << "!!!";
+    GGEMSMisc::ThrowException("GGEMSDosimetryCalculator", "CheckParameters", oss.str());
+  }
+
+  if (is_dose_grid_ && (is_photon_tracking_ || is_hit_tracking_)) {
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "Photon tracking and hit tracking are only available for the first dosimetry calculator attached to a navigator!!!";
+    GGEMSMisc::ThrowException("GGEMSDosimetryCalculator", "CheckParameters", oss.str());
+  }
+
+  if (is_dose_region_ && is_photon_tracking_) {
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "Photon tracking is not available with a dose region!!!";
+    GGEMSMisc::ThrowException("GGEMSDosimetryCalculator", "CheckParameters", oss.str());
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -315,6 +512,33 @@ void GGEMSDosimetryCalculator::InitializeKernel(void)
 
   // Compiling the kernels
   opencl_manager.CompileKernel(compute_dose_filename, "compute_dose_ggems_voxelized_solid", kernel_compute_dose_, nullptr, nullptr);
+
+  // Kernel selecting level in dose pyramid
+  if (number_of_dose_levels_ > 1) {
+    kernel_select_dose_level_ = new cl::Kernel*[number_activated_devices_];
+    opencl_manager.CompileKernel(compute_dose_filename, "select_dose_level_ggems_voxelized_solid", kernel_select_dose_level_, nullptr, nullptr);
+  }
+
+  // Kernel packing outputs in staging buffer
+  kernel_finalize_dose_ = new cl::Kernel*[number_activated_devices_];
+  opencl_manager.CompileKernel(compute_dose_filename, "finalize_dose_ggems_voxelized_solid", kernel_finalize_dose_, nullptr, nullptr);
+
+  // Kernel reducing dose by label
+  if (is_label_dose_) {
+    kernel_reduce_dose_by_label_ = new cl::Kernel*[number_activated_devices_];
+    opencl_manager.CompileKernel(compute_dose_filename, "reduce_dose_by_label_ggems_voxelized_solid", kernel_reduce_dose_by_label_, nullptr, nullptr);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSDosimetryCalculator::CountHistories(GGsize const& thread_index, GGsize const& number_of_histories)
+{
+  number_of_histories_[thread_index] += number_of_histories;
+
+  for (GGsize g = 0; g < dose_grids_.size(); ++g) dose_grids_[g]->CountHistories(thread_index, number_of_histories);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -336,7 +560,8 @@ void GGEMSDosimetryCalculator::ComputeDose(GGsize const& thread_index)
   // Get pointer on OpenCL device for dose parameters
   GGEMSDoseParams* dose_params_device = opencl_manager.GetDeviceBuffer<GGEMSDoseParams>(dose_params_[thread_index], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSDoseParams), thread_index);
 
-  GGsize number_of_dosels = static_cast<GGsize>(dose_params_device->total_number_of_dosels_);
+  // Dose is computed in all levels of dose pyramid
+  GGsize number_of_dosels = static_cast<GGsize>(dose_params_device->level_offset_[dose_params_device->number_of_levels_]);
 
   // Release the pointer
   opencl_manager.ReleaseDeviceBuffer(dose_params_[thread_index], dose_params_device, thread_index);
@@ -350,11 +575,12 @@ void GGEMSDosimetryCalculator::ComputeDose(GGsize const& thread_index)
   cl::NDRange local_wi(work_group_size);
 
   // Getting kernel, and setting parameters
+  opencl_manager.PrepareKernel(kernel_compute_dose_[thread_index]);
   kernel_compute_dose_[thread_index]->setArg(0, number_of_dosels);
   kernel_compute_dose_[thread_index]->setArg(1, *dose_params_[thread_index]);
   kernel_compute_dose_[thread_index]->setArg(2, *dose_recording_.edep_[thread_index]);
-  if (!dose_recording_.hit_[thread_index]) kernel_compute_dose_[thread_index]->setArg(3, sizeof(cl_mem), nullptr);
-  else kernel_compute_dose_[thread_index]->setArg(3, *dose_recording_.hit_[thread_index]);
+  if (!dose_recording_.edep_history_[thread_index]) kernel_compute_dose_[thread_index]->setArg(3, sizeof(cl_mem), nullptr);
+  else kernel_compute_dose_[thread_index]->setArg(3, *dose_recording_.edep_history_[thread_index]);
   if (!dose_recording_.edep_squared_[thread_index]) kernel_compute_dose_[thread_index]->setArg(4, sizeof(cl_mem), nullptr);
   else kernel_compute_dose_[thread_index]->setArg(4, *dose_recording_.edep_squared_[thread_index]);
   kernel_compute_dose_[thread_index]->setArg(5, *navigator_->GetSolids(0)->GetSolidData(thread_index)); // 1 solid in voxelized phantom
@@ -366,6 +592,7 @@ void GGEMSDosimetryCalculator::ComputeDose(GGsize const& thread_index)
   kernel_compute_dose_[thread_index]->setArg(10, scale_factor_);
   kernel_compute_dose_[thread_index]->setArg(11, is_water_reference_);
   kernel_compute_dose_[thread_index]->setArg(12, minimum_density_);
+  kernel_compute_dose_[thread_index]->setArg(13, static_cast<GGDosiType>(number_of_histories_[thread_index]));
 
   // Launching kernel
   cl::Event event;
@@ -375,6 +602,110 @@ void GGEMSDosimetryCalculator::ComputeDose(GGsize const& thread_index)
 
   // GGEMS Profiling
   GGEMSProfilerManager::GetInstance().HandleEvent(event, oss.str());
+
+  // Selecting level in dose pyramid
+  if (number_of_dose_levels_ > 1) SelectDoseLevel(thread_index);
+
+  // Reducing dose by label
+  if (is_label_dose_) ReduceDoseByLabel(thread_index);
+
+  // Computing dose in other dose grids
+  for (GGsize g = 0; g < dose_grids_.size(); ++g) dose_grids_[g]->ComputeDose(thread_index);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSDosimetryCalculator::SelectDoseLevel(GGsize const& thread_index)
+{
+  // Getting the OpenCL manager and infos for work-item launching
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+  cl::CommandQueue* queue = opencl_manager.GetCommandQueue(thread_index);
+
+  // Get Device name and storing methode name + device
+  GGsize device_index = opencl_manager.GetIndexOfActivatedDevice(thread_index);
+  std::string device_name = opencl_manager.GetDeviceName(device_index);
+  std::ostringstream oss(std::ostringstream::out);
+  oss << "GGEMSDosimetryCalculator::SelectDoseLevel in " << device_name << ", index " << device_index;
+
+  // Getting work group size, and work-item number
+  GGsize work_group_size = opencl_manager.GetWorkGroupSize();
+  GGsize number_of_work_items = opencl_manager.GetBestWorkItem(total_number_of_dosels_);
+
+  // Parameters for work-item in kernel
+  cl::NDRange global_wi(number_of_work_items);
+  cl::NDRange local_wi(work_group_size);
+
+  // Getting kernel, and setting parameters
+  opencl_manager.PrepareKernel(kernel_select_dose_level_[thread_index]);
+  kernel_select_dose_level_[thread_index]->setArg(0, total_number_of_dosels_);
+  kernel_select_dose_level_[thread_index]->setArg(1, *dose_params_[thread_index]);
+  kernel_select_dose_level_[thread_index]->setArg(2, *dose_recording_.dose_[thread_index]);
+  kernel_select_dose_level_[thread_index]->setArg(3, *dose_recording_.uncertainty_dose_[thread_index]);
+  kernel_select_dose_level_[thread_index]->setArg(4, *dose_recording_.adaptive_dose_[thread_index]);
+  kernel_select_dose_level_[thread_index]->setArg(5, *dose_recording_.dose_level_[thread_index]);
+  kernel_select_dose_level_[thread_index]->setArg(6, target_uncertainty_);
+
+  // Launching kernel
+  cl::Event event;
+  GGint kernel_status = queue->enqueueNDRangeKernel(*kernel_select_dose_level_[thread_index], 0, global_wi, local_wi, nullptr, &event);
+  opencl_manager.CheckOpenCLError(kernel_status, "GGEMSDosimetryCalculator", "SelectDoseLevel");
+  queue->finish();
+
+  // GGEMS Profiling
+  GGEMSProfilerManager::GetInstance().HandleEvent(event, oss.str());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSDosimetryCalculator::ReduceDoseByLabel(GGsize const& thread_index)
+{
+  // Getting the OpenCL manager and infos for work-item launching
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+  cl::CommandQueue* queue = opencl_manager.GetCommandQueue(thread_index);
+
+  // Get Device name and storing methode name + device
+  GGsize device_index = opencl_manager.GetIndexOfActivatedDevice(thread_index);
+  std::string device_name = opencl_manager.GetDeviceName(device_index);
+  std::ostringstream oss(std::ostringstream::out);
+  oss << "GGEMSDosimetryCalculator::ReduceDoseByLabel in " << device_name << ", index " << device_index;
+
+  // Tables are computed again from dose map
+  opencl_manager.CleanBuffer(dose_recording_.label_edep_[thread_index], number_of_labels_*sizeof(GGDosiType), thread_index);
+  opencl_manager.CleanBuffer(dose_recording_.label_mass_[thread_index], number_of_labels_*sizeof(GGDosiType), thread_index);
+
+  // Getting work group size, and work-item number
+  GGsize work_group_size = opencl_manager.GetWorkGroupSize();
+  GGsize number_of_work_items = opencl_manager.GetBestWorkItem(total_number_of_dosels_);
+
+  // Parameters for work-item in kernel
+  cl::NDRange global_wi(number_of_work_items);
+  cl::NDRange local_wi(work_group_size);
+
+  // Getting kernel, and setting parameters
+  opencl_manager.PrepareKernel(kernel_reduce_dose_by_label_[thread_index]);
+  kernel_reduce_dose_by_label_[thread_index]->setArg(0, total_number_of_dosels_);
+  kernel_reduce_dose_by_label_[thread_index]->setArg(1, *dose_params_[thread_index]);
+  kernel_reduce_dose_by_label_[thread_index]->setArg(2, *dose_recording_.edep_[thread_index]);
+  kernel_reduce_dose_by_label_[thread_index]->setArg(3, *navigator_->GetSolids(0)->GetSolidData(thread_index)); // 1 solid in voxelized phantom
+  kernel_reduce_dose_by_label_[thread_index]->setArg(4, *navigator_->GetSolids(0)->GetLabelData(thread_index));
+  kernel_reduce_dose_by_label_[thread_index]->setArg(5, *navigator_->GetMaterials()->GetMaterialTables(thread_index));
+  kernel_reduce_dose_by_label_[thread_index]->setArg(6, is_water_reference_);
+  kernel_reduce_dose_by_label_[thread_index]->setArg(7, minimum_density_);
+  kernel_reduce_dose_by_label_[thread_index]->setArg(8, *dose_recording_.label_edep_[thread_index]);
+  kernel_reduce_dose_by_label_[thread_index]->setArg(9, *dose_recording_.label_mass_[thread_index]);
+
+  // Launching kernel
+  cl::Event event;
+  GGint kernel_status = queue->enqueueNDRangeKernel(*kernel_reduce_dose_by_label_[thread_index], 0, global_wi, local_wi, nullptr, &event);
+  opencl_manager.CheckOpenCLError(kernel_status, "GGEMSDosimetryCalculator", "ReduceDoseByLabel");
+  queue->finish();
+
+  // GGEMS Profiling
+  GGEMSProfilerManager::GetInstance().HandleEvent(event, oss.str());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -387,13 +718,17 @@ void GGEMSDosimetryCalculator::Initialize(void)
 
   CheckParameters();
 
+  // Selecting a level in dose pyramid needs uncertainty
+  if (number_of_dose_levels_ > 1) is_uncertainty_ = true;
+
   // Get the OpenCL manager
   GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
 
   // Allocating dosimetry parameters on each device
   for (GGsize j = 0; j < number_activated_devices_; ++j) {
     // Allocate dosemetry params on OpenCL device
-    dose_params_[j] = opencl_manager.Allocate(nullptr, sizeof(GGEMSDoseParams), j, CL_MEM_READ_WRITE, "GGEMSDosimetryCalculator");
+    // First dose grid stores params of all dose grids scored during the same transport
+    dose_params_[j] = opencl_manager.Allocate(nullptr, (is_dose_grid_ ? 1 : 1 + dose_grids_.size())*sizeof(GGEMSDoseParams), j, CL_MEM_READ_WRITE, "GGEMSDosimetryCalculator");
 
     // Get pointer on OpenCL device for dose parameters
     GGEMSDoseParams* dose_params_device = opencl_manager.GetDeviceBuffer<GGEMSDoseParams>(dose_params_[j], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSDoseParams), j);
@@ -411,7 +746,7 @@ void GGEMSDosimetryCalculator::Initialize(void)
           voxel_sizes.s[2] != dynamic_cast<GGEMSVoxelizedSolid*>(navigator_->GetSolids(0))->GetVoxelSizes(j).s[2]) {
         std::ostringstream oss(std::ostringstream::out);
         oss << "Dosel size and voxel size in voxelized phantom have to be the same when photon tracking is activated!!!";
-        GGEMSMisc::ThrowException("GGEMSDosimetryCalculator", "Initialize", oss.str());
+        GGEMSMisc::ThrowException("GGEMSDosimetryCalculator", "InitializeDoseGrids", oss.str());
       }
     }
 
@@ -428,10 +763,23 @@ void GGEMSDosimetryCalculator::Initialize(void)
     dose_params_device->border_min_xyz_ = obb_geometry.border_min_xyz_;
     dose_params_device->border_max_xyz_ = obb_geometry.border_max_xyz_;
 
+    // Restricting dose map to dose region
+    if (is_dose_region_) {
+      for (GGsize i = 0; i < 3; ++i) {
+        dose_params_device->border_min_xyz_.s[i] = std::max(obb_geometry.border_min_xyz_.s[i], dose_region_min_xyz_.s[i]);
+        dose_params_device->border_max_xyz_.s[i] = std::min(obb_geometry.border_max_xyz_.s[i], dose_region_max_xyz_.s[i]);
+        if (dose_params_device->border_min_xyz_.s[i] >= dose_params_device->border_max_xyz_.s[i]) {
+          std::ostringstream oss(std::ostringstream::out);
+          oss << "Dose region is outside voxelized phantom!!!";
+          GGEMSMisc::ThrowException("GGEMSDosimetryCalculator", "InitializeDoseGrids", oss.str());
+        }
+      }
+    }
+
     // Get the size of the dose map
     GGfloat3 dosemap_size;
     for (GGsize i = 0; i < 3; ++i) {
-      dosemap_size.s[i] = obb_geometry.border_max_xyz_.s[i] - obb_geometry.border_min_xyz_.s[i];
+      dosemap_size.s[i] = dose_params_device->border_max_xyz_.s[i] - dose_params_device->border_min_xyz_.s[i];
     }
 
     // Get the number of voxels
@@ -448,30 +796,57 @@ void GGEMSDosimetryCalculator::Initialize(void)
     total_number_of_dosels_ = number_of_dosels.x_ * number_of_dosels.y_ * number_of_dosels.z_;
     dose_params_device->total_number_of_dosels_ = static_cast<GGint>(total_number_of_dosels_);
 
+    // Dose pyramid, dosel size is doubled at each level, level 0 is the dose map
+    dose_params_device->number_of_levels_ = static_cast<GGint>(number_of_dose_levels_);
+    GGint level_offset = 0;
+    for (GGsize l = 0; l < number_of_dose_levels_; ++l) {
+      GGsize level_size = static_cast<GGsize>(1) << l;
+      GGint3 level_number_of_dosels;
+      level_number_of_dosels.s[0] = static_cast<GGint>((number_of_dosels.x_ + level_size - 1) / level_size);
+      level_number_of_dosels.s[1] = static_cast<GGint>((number_of_dosels.y_ + level_size - 1) / level_size);
+      level_number_of_dosels.s[2] = static_cast<GGint>((number_of_dosels.z_ + level_size - 1) / level_size);
+      dose_params_device->level_number_of_dosels_[l] = level_number_of_dosels;
+      dose_params_device->level_offset_[l] = level_offset;
+      level_offset += level_number_of_dosels.s[0] * level_number_of_dosels.s[1] * level_number_of_dosels.s[2];
+    }
+    dose_params_device->level_offset_[number_of_dose_levels_] = level_offset;
+    number_of_pyramid_dosels_ = static_cast<GGsize>(level_offset);
+
+    // Dose grid scored alone, dose grids scored during the same transport are set later
+    dose_params_device->number_of_grids_ = 1;
+    dose_params_device->dosel_offset_ = 0;
+
     // Release the pointer
     opencl_manager.ReleaseDeviceBuffer(dose_params_[j], dose_params_device, j);
 
-    // Allocated buffers storing dose on OpenCL device
-    dose_recording_.edep_[j] = opencl_manager.Allocate(nullptr, total_number_of_dosels_*sizeof(GGDosiType), j, CL_MEM_READ_WRITE, "GGEMSDosimetryCalculator");
-    dose_recording_.dose_[j] = opencl_manager.Allocate(nullptr, total_number_of_dosels_*sizeof(GGfloat), j, CL_MEM_READ_WRITE, "GGEMSDosimetryCalculator");
+    // Allocated buffers storing dose on OpenCL device, energy buffers are allocated with dose grids
+    dose_recording_.dose_[j] = opencl_manager.Allocate(nullptr, number_of_pyramid_dosels_*sizeof(GGfloat), j, CL_MEM_READ_WRITE, "GGEMSDosimetryCalculator");
 
-    dose_recording_.uncertainty_dose_[j] = is_uncertainty_ ? opencl_manager.Allocate(nullptr, total_number_of_dosels_*sizeof(GGfloat), j, CL_MEM_READ_WRITE, "GGEMSDosimetryCalculator") : nullptr;
-    dose_recording_.edep_squared_[j] = (is_edep_squared_||is_uncertainty_) ? opencl_manager.Allocate(nullptr, total_number_of_dosels_*sizeof(GGDosiType), j, CL_MEM_READ_WRITE, "GGEMSDosimetryCalculator") : nullptr;
-    dose_recording_.hit_[j] = (is_hit_tracking_||is_uncertainty_) ? opencl_manager.Allocate(nullptr, total_number_of_dosels_*sizeof(GGint), j, CL_MEM_READ_WRITE, "GGEMSDosimetryCalculator") : nullptr;
+    dose_recording_.uncertainty_dose_[j] = is_uncertainty_ ? opencl_manager.Allocate(nullptr, number_of_pyramid_dosels_*sizeof(GGfloat), j, CL_MEM_READ_WRITE, "GGEMSDosimetryCalculator") : nullptr;
+    dose_recording_.hit_[j] = is_hit_tracking_ ? opencl_manager.Allocate(nullptr, total_number_of_dosels_*sizeof(GGint), j, CL_MEM_READ_WRITE, "GGEMSDosimetryCalculator") : nullptr;
 
     dose_recording_.photon_tracking_[j] = is_photon_tracking_ ? opencl_manager.Allocate(nullptr, total_number_of_dosels_*sizeof(GGint), j, CL_MEM_READ_WRITE, "GGEMSDosimetryCalculator") : nullptr;
 
     // Set buffer to zero
-    opencl_manager.CleanBuffer(dose_recording_.edep_[j], total_number_of_dosels_*sizeof(GGDosiType), j);
-    opencl_manager.CleanBuffer(dose_recording_.dose_[j], total_number_of_dosels_*sizeof(GGfloat), j);
+    opencl_manager.CleanBuffer(dose_recording_.dose_[j], number_of_pyramid_dosels_*sizeof(GGfloat), j);
 
-    if (is_uncertainty_) opencl_manager.CleanBuffer(dose_recording_.uncertainty_dose_[j], total_number_of_dosels_*sizeof(GGfloat), j);
-    if (is_edep_squared_||is_uncertainty_) opencl_manager.CleanBuffer(dose_recording_.edep_squared_[j], total_number_of_dosels_*sizeof(GGDosiType), j);
-    if (is_hit_tracking_||is_uncertainty_) opencl_manager.CleanBuffer(dose_recording_.hit_[j], total_number_of_dosels_*sizeof(GGint), j);
+    if (is_uncertainty_) opencl_manager.CleanBuffer(dose_recording_.uncertainty_dose_[j], number_of_pyramid_dosels_*sizeof(GGfloat), j);
+    if (is_hit_tracking_) opencl_manager.CleanBuffer(dose_recording_.hit_[j], total_number_of_dosels_*sizeof(GGint), j);
 
     if (is_photon_tracking_) opencl_manager.CleanBuffer(dose_recording_.photon_tracking_[j], total_number_of_dosels_*sizeof(GGint), j);
+
+    dose_recording_.adaptive_dose_[j] = (number_of_dose_levels_ > 1) ? opencl_manager.Allocate(nullptr, total_number_of_dosels_*sizeof(GGfloat), j, CL_MEM_READ_WRITE, "GGEMSDosimetryCalculator") : nullptr;
+    dose_recording_.dose_level_[j] = (number_of_dose_levels_ > 1) ? opencl_manager.Allocate(nullptr, total_number_of_dosels_*sizeof(GGint), j, CL_MEM_READ_WRITE, "GGEMSDosimetryCalculator") : nullptr;
+
+    // Tables storing dose by label, one entry for each material of phantom
+    number_of_labels_ = navigator_->GetMaterials()->GetNumberOfMaterials();
+    dose_recording_.label_edep_[j] = is_label_dose_ ? opencl_manager.Allocate(nullptr, number_of_labels_*sizeof(GGDosiType), j, CL_MEM_READ_WRITE, "GGEMSDosimetryCalculator") : nullptr;
+    dose_recording_.label_mass_[j] = is_label_dose_ ? opencl_manager.Allocate(nullptr, number_of_labels_*sizeof(GGDosiType), j, CL_MEM_READ_WRITE, "GGEMSDosimetryCalculator") : nullptr;
   }
 
+  // Energy buffers are shared by all dose grids attached to navigator
+  if (!is_dose_grid_) InitializeDoseGrids();
+
   InitializeKernel();
 }
 
@@ -479,279 +854,282 @@ void GGEMSDosimetryCalculator::Initialize(void)
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
-void GGEMSDosimetryCalculator::SaveResults(void) const
+void GGEMSDosimetryCalculator::InitializeDoseGrids(void)
 {
-  SaveDose();
-  if (is_photon_tracking_) SavePhotonTracking();
-  if (is_edep_) SaveEdep();
-  if (is_hit_tracking_) SaveHit();
-  if (is_edep_squared_) SaveEdepSquared();
-  if (is_uncertainty_) SaveUncertainty();
-}
+  GGcout("GGEMSDosimetryCalculator", "InitializeDoseGrids", 3) << "Initializing dose grids..." << GGendl;
 
-////////////////////////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////////////////////////
-
-void GGEMSDosimetryCalculator::SavePhotonTracking(void) const
-{
   // Get the OpenCL manager
   GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
 
-  // Get pointer on OpenCL device for dose parameters, take data from first device only
-  GGEMSDoseParams* dose_params_device = opencl_manager.GetDeviceBuffer<GGEMSDoseParams>(dose_params_[0], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSDoseParams), 0);
-
-  GGsize total_number_of_dosels = static_cast<GGsize>(dose_params_device->total_number_of_dosels_);
-  GGint* photon_tracking = new GGint[total_number_of_dosels];
-  std::memset(photon_tracking, 0, total_number_of_dosels*sizeof(GGint));
-
-  GGsize3 dimensions;
-  dimensions.x_ = static_cast<GGsize>(dose_params_device->number_of_dosels_.s[0]);
-  dimensions.y_ = static_cast<GGsize>(dose_params_device->number_of_dosels_.s[1]);
-  dimensions.z_ = static_cast<GGsize>(dose_params_device->number_of_dosels_.s[2]);
-
-  GGEMSMHDImage mhdImage;
-  mhdImage.SetOutputFileName(dosimetry_output_filename_ + "_photon_tracking.mhd");
-  mhdImage.SetDataType("MET_INT");
-  mhdImage.SetDimensions(dimensions);
-  mhdImage.SetElementSizes(dose_params_device->size_of_dosels_);
+  // Initializing other dose grids, energy squared is recorded if one dose grid needs it
+  is_squared_recording_ = is_edep_squared_ || is_uncertainty_;
+  for (GGsize g = 0; g < dose_grids_.size(); ++g) {
+    dose_grids_[g]->Initialize();
+    if (dose_grids_[g]->is_edep_squared_ || dose_grids_[g]->is_uncertainty_) is_squared_recording_ = true;
+  }
 
-  // Release the pointer
-  opencl_manager.ReleaseDeviceBuffer(dose_params_[0], dose_params_device, 0);
+  // History ids are exchanged with 64-bit atomics
+  if (is_squared_recording_) {
+    for (GGsize j = 0; j < number_activated_devices_; ++j) {
+      GGsize device_index = opencl_manager.GetIndexOfActivatedDevice(j);
+      if (!opencl_manager.IsDoublePrecisionAtomicAddition(device_index)) {
+        std::ostringstream oss(std::ostringstream::out);
+        oss << "Your OpenCL device: " << opencl_manager.GetDeviceName(device_index) << ", does not support 64-bit atomic operation!!!" << std::endl;
+        oss << "Squared energy deposit, uncertainty and label dose can not be computed on this device" << std::endl;
+        GGEMSMisc::ThrowException("GGEMSDosimetryCalculator", "InitializeDoseGrids", oss.str());
+      }
+    }
+  }
 
-  // Loop over all activated device
+  // Alignment of sub-buffers in number of dosels, alignment of device is given in bits
+  GGsize alignment = 1;
   for (GGsize j = 0; j < number_activated_devices_; ++j) {
-    GGint* photon_tracking_device = opencl_manager.GetDeviceBuffer<GGint>(dose_recording_.photon_tracking_[j], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, total_number_of_dosels*sizeof(GGint), j);
-
-    for (GGsize i = 0; i < total_number_of_dosels; ++i) photon_tracking[i] += photon_tracking_device[i];
-    opencl_manager.ReleaseDeviceBuffer(dose_recording_.photon_tracking_[j], photon_tracking_device, j);
+    GGsize device_index = opencl_manager.GetIndexOfActivatedDevice(j);
+    alignment = std::max(alignment, static_cast<GGsize>(opencl_manager.GetMemBaseAddrAlign(device_index)) / 8 / sizeof(GGint));
   }
 
-  // Writing data
-  mhdImage.Write<GGint>(photon_tracking);
-  delete[] photon_tracking;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////////////////////////
-
-void GGEMSDosimetryCalculator::SaveHit(void) const
-{
-  // Get the OpenCL manager
-  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
-
-  // Get pointer on OpenCL device for dose parameters, take data from first device only
-  GGEMSDoseParams* dose_params_device = opencl_manager.GetDeviceBuffer<GGEMSDoseParams>(dose_params_[0], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSDoseParams), 0);
-
-  GGsize total_number_of_dosels = static_cast<GGsize>(dose_params_device->total_number_of_dosels_);
-  GGint* hit_tracking = new GGint[total_number_of_dosels];
-  std::memset(hit_tracking, 0, total_number_of_dosels*sizeof(GGint));
+  // Offset of each dose grid in energy buffers
+  std::vector<GGsize> dosel_offsets(dose_grids_.size(), 0);
+  number_of_shared_dosels_ = number_of_pyramid_dosels_;
+  for (GGsize g = 0; g < dose_grids_.size(); ++g) {
+    dosel_offsets[g] = ((number_of_shared_dosels_ + alignment - 1) / alignment) * alignment;
+    number_of_shared_dosels_ = dosel_offsets[g] + dose_grids_[g]->number_of_pyramid_dosels_;
+  }
 
-  GGsize3 dimensions;
-  dimensions.x_ = static_cast<GGsize>(dose_params_device->number_of_dosels_.s[0]);
-  dimensions.y_ = static_cast<GGsize>(dose_params_device->number_of_dosels_.s[1]);
-  dimensions.z_ = static_cast<GGsize>(dose_params_device->number_of_dosels_.s[2]);
+  for (GGsize j = 0; j < number_activated_devices_; ++j) {
+    // Allocated energy buffers for all dose grids
+    dose_recording_.edep_[j] = opencl_manager.Allocate(nullptr, number_of_shared_dosels_*sizeof(GGDosiType), j, CL_MEM_READ_WRITE, "GGEMSDosimetryCalculator");
+    dose_recording_.edep_squared_[j] = is_squared_recording_ ? opencl_manager.Allocate(nullptr, number_of_shared_dosels_*sizeof(GGDosiType), j, CL_MEM_READ_WRITE, "GGEMSDosimetryCalculator") : nullptr;
+    dose_recording_.edep_history_[j] = is_squared_recording_ ? opencl_manager.Allocate(nullptr, number_of_shared_dosels_*sizeof(GGDosiType), j, CL_MEM_READ_WRITE, "GGEMSDosimetryCalculator") : nullptr;
+    dose_recording_.last_history_id_[j] = is_squared_recording_ ? opencl_manager.Allocate(nullptr, number_of_shared_dosels_*sizeof(GGulong), j, CL_MEM_READ_WRITE, "GGEMSDosimetryCalculator") : nullptr;
 
-  GGEMSMHDImage mhdImage;
-  mhdImage.SetOutputFileName(dosimetry_output_filename_ + "_hit.mhd");
-  mhdImage.SetDataType("MET_INT");
-  mhdImage.SetDimensions(dimensions);
-  mhdImage.SetElementSizes(dose_params_device->size_of_dosels_);
+    // Set buffer to zero
+    opencl_manager.CleanBuffer(dose_recording_.edep_[j], number_of_shared_dosels_*sizeof(GGDosiType), j);
+    if (is_squared_recording_) {
+      opencl_manager.CleanBuffer(dose_recording_.edep_squared_[j], number_of_shared_dosels_*sizeof(GGDosiType), j);
+      opencl_manager.CleanBuffer(dose_recording_.edep_history_[j], number_of_shared_dosels_*sizeof(GGDosiType), j);
+      opencl_manager.CleanBuffer(dose_recording_.last_history_id_[j], number_of_shared_dosels_*sizeof(GGulong), j);
+    }
 
-  // Release the pointer
-  opencl_manager.ReleaseDeviceBuffer(dose_params_[0], dose_params_device, 0);
+    // Storing params of all dose grids after params of this calculator
+    GGEMSDoseParams* dose_params_device = opencl_manager.GetDeviceBuffer<GGEMSDoseParams>(dose_params_[j], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, (1 + dose_grids_.size())*sizeof(GGEMSDoseParams), j);
 
-  // Loop over all activated device
-  for (GGsize j = 0; j < number_activated_devices_; ++j) {
-    GGint* hit_device = opencl_manager.GetDeviceBuffer<GGint>(dose_recording_.hit_[j], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, total_number_of_dosels*sizeof(GGint), j);
+    dose_params_device[0].number_of_grids_ = static_cast<GGint>(1 + dose_grids_.size());
+    for (GGsize g = 0; g < dose_grids_.size(); ++g) {
+      GGEMSDoseParams* grid_params_device = opencl_manager.GetDeviceBuffer<GGEMSDoseParams>(dose_grids_[g]->dose_params_[j], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSDoseParams), j);
+      dose_params_device[g+1] = *grid_params_device;
+      dose_params_device[g+1].dosel_offset_ = static_cast<GGint>(dosel_offsets[g]);
+      opencl_manager.ReleaseDeviceBuffer(dose_grids_[g]->dose_params_[j], grid_params_device, j);
+    }
 
-    for (GGsize i = 0; i < total_number_of_dosels; ++i) hit_tracking[i] = hit_device[i];
+    // Release the pointer
+    opencl_manager.ReleaseDeviceBuffer(dose_params_[j], dose_params_device, j);
 
-    opencl_manager.ReleaseDeviceBuffer(dose_recording_.hit_[j], hit_device, j);
+    // Energy buffers of dose grids are sub-buffers
+    for (GGsize g = 0; g < dose_grids_.size(); ++g) {
+      GGsize grid_dosels = dose_grids_[g]->number_of_pyramid_dosels_;
+      dose_grids_[g]->is_squared_recording_ = is_squared_recording_;
+      dose_grids_[g]->dose_recording_.edep_[j] = opencl_manager.AllocateSubBuffer(dose_recording_.edep_[j], dosel_offsets[g]*sizeof(GGDosiType), grid_dosels*sizeof(GGDosiType), j, CL_MEM_READ_WRITE);
+      dose_grids_[g]->dose_recording_.edep_squared_[j] = is_squared_recording_ ? opencl_manager.AllocateSubBuffer(dose_recording_.edep_squared_[j], dosel_offsets[g]*sizeof(GGDosiType), grid_dosels*sizeof(GGDosiType), j, CL_MEM_READ_WRITE) : nullptr;
+      dose_grids_[g]->dose_recording_.edep_history_[j] = is_squared_recording_ ? opencl_manager.AllocateSubBuffer(dose_recording_.edep_history_[j], dosel_offsets[g]*sizeof(GGDosiType), grid_dosels*sizeof(GGDosiType), j, CL_MEM_READ_WRITE) : nullptr;
+      dose_grids_[g]->dose_recording_.last_history_id_[j] = is_squared_recording_ ? opencl_manager.AllocateSubBuffer(dose_recording_.last_history_id_[j], dosel_offsets[g]*sizeof(GGulong), grid_dosels*sizeof(GGulong), j, CL_MEM_READ_WRITE) : nullptr;
+    }
   }
-
-  // Writing data
-  mhdImage.Write<GGint>(hit_tracking);
-  delete[] hit_tracking;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
-void GGEMSDosimetryCalculator::SaveEdep(void) const
+void GGEMSDosimetryCalculator::SaveResults(void) const
 {
-  // Get the OpenCL manager
-  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
-
-  // Get pointer on OpenCL device for dose parameters, take data from first device only
-  GGEMSDoseParams* dose_params_device = opencl_manager.GetDeviceBuffer<GGEMSDoseParams>(dose_params_[0], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSDoseParams), 0);
-
-  GGsize total_number_of_dosels = static_cast<GGsize>(dose_params_device->total_number_of_dosels_);
-  GGDosiType* edep_tracking = new GGDosiType[total_number_of_dosels];
-  std::memset(edep_tracking, 0, total_number_of_dosels*sizeof(GGDosiType));
-
-  GGsize3 dimensions;
-  dimensions.x_ = static_cast<GGsize>(dose_params_device->number_of_dosels_.s[0]);
-  dimensions.y_ = static_cast<GGsize>(dose_params_device->number_of_dosels_.s[1]);
-  dimensions.z_ = static_cast<GGsize>(dose_params_device->number_of_dosels_.s[2]);
-
-  GGEMSMHDImage mhdImage;
-  mhdImage.SetOutputFileName(dosimetry_output_filename_ + "_edep.mhd");
-  if (sizeof(GGDosiType) == 4) mhdImage.SetDataType("MET_FLOAT");
-  else if (sizeof(GGDosiType) == 8) mhdImage.SetDataType("MET_DOUBLE");
-  mhdImage.SetDimensions(dimensions);
-  mhdImage.SetElementSizes(dose_params_device->size_of_dosels_);
-
-  // Release the pointer
-  opencl_manager.ReleaseDeviceBuffer(dose_params_[0], dose_params_device, 0);
-
-  // Loop over all activated device
-  for (GGsize j = 0; j < number_activated_devices_; ++j) {
-    GGDosiType* edep_device = opencl_manager.GetDeviceBuffer<GGDosiType>(dose_recording_.edep_[j], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, total_number_of_dosels*sizeof(GGDosiType), j);
-
-    for (GGsize i = 0; i < total_number_of_dosels; ++i) edep_tracking[i] = edep_device[i];
-
-    opencl_manager.ReleaseDeviceBuffer(dose_recording_.edep_[j], edep_device, j);
-  }
+  SaveDoseMaps();
+  if (is_label_dose_) SaveLabelDose();
 
-  // Writing data
-  mhdImage.Write<GGDosiType>(edep_tracking);
-  delete[] edep_tracking;
+  for (GGsize g = 0; g < dose_grids_.size(); ++g) dose_grids_[g]->SaveResults();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
-void GGEMSDosimetryCalculator::SaveEdepSquared(void) const
+void GGEMSDosimetryCalculator::SaveDoseMaps(void) const
 {
   // Get the OpenCL manager
   GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
 
+  // Size of each output in staging buffer, outputs in GGDosiType are first to keep alignment
+  GGsize edep_size = is_edep_ ? total_number_of_dosels_*sizeof(GGDosiType) : 0;
+  GGsize edep_squared_size = is_edep_squared_ ? total_number_of_dosels_*sizeof(GGDosiType) : 0;
+  GGsize dose_size = is_dose_map_ ? total_number_of_dosels_*sizeof(GGfloat) : 0;
+  GGsize uncertainty_size = is_uncertainty_ ? total_number_of_dosels_*sizeof(GGfloat) : 0;
+  GGsize adaptive_dose_size = (number_of_dose_levels_ > 1) ? total_number_of_dosels_*sizeof(GGfloat) : 0;
+  GGsize dose_level_size = (number_of_dose_levels_ > 1) ? total_number_of_dosels_*sizeof(GGint) : 0;
+  GGsize hit_size = is_hit_tracking_ ? total_number_of_dosels_*sizeof(GGint) : 0;
+  GGsize photon_tracking_size = is_photon_tracking_ ? total_number_of_dosels_*sizeof(GGint) : 0;
+
+  GGsize edep_offset = 0;
+  GGsize edep_squared_offset = edep_offset + edep_size;
+  GGsize dose_offset = edep_squared_offset + edep_squared_size;
+  GGsize uncertainty_offset = dose_offset + dose_size;
+  GGsize adaptive_dose_offset = uncertainty_offset + uncertainty_size;
+  GGsize dose_level_offset = adaptive_dose_offset + adaptive_dose_size;
+  GGsize hit_offset = dose_level_offset + dose_level_size;
+  GGsize photon_tracking_offset = hit_offset + hit_size;
+  GGsize staging_size = photon_tracking_offset + photon_tracking_size;
+
+  if (staging_size == 0) return;
+
   // Get pointer on OpenCL device for dose parameters, take data from first device only
   GGEMSDoseParams* dose_params_device = opencl_manager.GetDeviceBuffer<GGEMSDoseParams>(dose_params_[0], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSDoseParams), 0);
 
-  GGsize total_number_of_dosels = static_cast<GGsize>(dose_params_device->total_number_of_dosels_);
-  GGDosiType* edep_squared_tracking = new GGDosiType[total_number_of_dosels];
-  std::memset(edep_squared_tracking, 0, total_number_of_dosels*sizeof(GGDosiType));
-
   GGsize3 dimensions;
   dimensions.x_ = static_cast<GGsize>(dose_params_device->number_of_dosels_.s[0]);
   dimensions.y_ = static_cast<GGsize>(dose_params_device->number_of_dosels_.s[1]);
   dimensions.z_ = static_cast<GGsize>(dose_params_device->number_of_dosels_.s[2]);
-
-  GGEMSMHDImage mhdImage;
-  mhdImage.SetOutputFileName(dosimetry_output_filename_ + "_edep_squared.mhd");
-  if (sizeof(GGDosiType) == 4) mhdImage.SetDataType("MET_FLOAT");
-  else if (sizeof(GGDosiType) == 8) mhdImage.SetDataType("MET_DOUBLE");
-  mhdImage.SetDimensions(dimensions);
-  mhdImage.SetElementSizes(dose_params_device->size_of_dosels_);
+  GGfloat3 element_sizes = dose_params_device->size_of_dosels_;
 
   // Release the pointer
   opencl_manager.ReleaseDeviceBuffer(dose_params_[0], dose_params_device, 0);
 
-  // Loop over all activated device
-  for (GGsize j = 0; j < number_activated_devices_; ++j) {
-    GGDosiType* edep_squared_device = opencl_manager.GetDeviceBuffer<GGDosiType>(dose_recording_.edep_squared_[j], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, total_number_of_dosels*sizeof(GGDosiType), j);
+  // Getting work group size, and work-item number
+  GGsize work_group_size = opencl_manager.GetWorkGroupSize();
+  GGsize number_of_work_items = opencl_manager.GetBestWorkItem(total_number_of_dosels_);
 
-    for (GGsize i = 0; i < total_number_of_dosels; ++i) edep_squared_tracking[i] = edep_squared_device[i];
+  // Parameters for work-item in kernel
+  cl::NDRange global_wi(number_of_work_items);
+  cl::NDRange local_wi(work_group_size);
 
-    opencl_manager.ReleaseDeviceBuffer(dose_recording_.edep_squared_[j], edep_squared_device, j);
+  // Packing outputs in staging buffer and reading it without blocking, devices are processed together
+  cl::Buffer** staging = new cl::Buffer*[number_activated_devices_];
+  GGuchar** staging_host = new GGuchar*[number_activated_devices_];
+  std::vector<cl::Event> kernel_events(number_activated_devices_);
+  std::vector<cl::Event> read_events(number_activated_devices_);
+  for (GGsize j = 0; j < number_activated_devices_; ++j) {
+    cl::CommandQueue* queue = opencl_manager.GetCommandQueue(j);
+
+    staging[j] = opencl_manager.Allocate(nullptr, staging_size, j, CL_MEM_WRITE_ONLY, "GGEMSDosimetryCalculator");
+    staging_host[j] = new GGuchar[staging_size];
+
+    // Getting kernel, and setting parameters
+    opencl_manager.PrepareKernel(kernel_finalize_dose_[j]);
+    kernel_finalize_dose_[j]->setArg(0, total_number_of_dosels_);
+    if (!edep_size) kernel_finalize_dose_[j]->setArg(1, sizeof(cl_mem), nullptr);
+    else kernel_finalize_dose_[j]->setArg(1, *dose_recording_.edep_[j]);
+    if (!edep_squared_size) kernel_finalize_dose_[j]->setArg(2, sizeof(cl_mem), nullptr);
+    else kernel_finalize_dose_[j]->setArg(2, *dose_recording_.edep_squared_[j]);
+    if (!dose_size) kernel_finalize_dose_[j]->setArg(3, sizeof(cl_mem), nullptr);
+    else kernel_finalize_dose_[j]->setArg(3, *dose_recording_.dose_[j]);
+    if (!uncertainty_size) kernel_finalize_dose_[j]->setArg(4, sizeof(cl_mem), nullptr);
+    else kernel_finalize_dose_[j]->setArg(4, *dose_recording_.uncertainty_dose_[j]);
+    if (!adaptive_dose_size) kernel_finalize_dose_[j]->setArg(5, sizeof(cl_mem), nullptr);
+    else kernel_finalize_dose_[j]->setArg(5, *dose_recording_.adaptive_dose_[j]);
+    if (!dose_level_size) kernel_finalize_dose_[j]->setArg(6, sizeof(cl_mem), nullptr);
+    else kernel_finalize_dose_[j]->setArg(6, *dose_recording_.dose_level_[j]);
+    if (!hit_size) kernel_finalize_dose_[j]->setArg(7, sizeof(cl_mem), nullptr);
+    else kernel_finalize_dose_[j]->setArg(7, *dose_recording_.hit_[j]);
+    if (!photon_tracking_size) kernel_finalize_dose_[j]->setArg(8, sizeof(cl_mem), nullptr);
+    else kernel_finalize_dose_[j]->setArg(8, *dose_recording_.photon_tracking_[j]);
+    kernel_finalize_dose_[j]->setArg(9, *staging[j]);
+
+    // Launching kernel, and reading staging buffer after kernel in the same queue
+    GGint kernel_status = queue->enqueueNDRangeKernel(*kernel_finalize_dose_[j], 0, global_wi, local_wi, nullptr, &kernel_events[j]);
+    opencl_manager.CheckOpenCLError(kernel_status, "GGEMSDosimetryCalculator", "SaveDoseMaps");
+    kernel_status = queue->enqueueReadBuffer(*staging[j], CL_FALSE, 0, staging_size, staging_host[j], nullptr, &read_events[j]);
+    opencl_manager.CheckOpenCLError(kernel_status, "GGEMSDosimetryCalculator", "SaveDoseMaps");
+    queue->flush();
   }
 
-  // Writing data
-  mhdImage.Write<GGDosiType>(edep_squared_tracking);
-  delete[] edep_squared_tracking;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////////////////////////
-
-void GGEMSDosimetryCalculator::SaveDose(void) const
-{
-  // Get the OpenCL manager
-  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
-
-  // Get pointer on OpenCL device for dose parameters, take data from first device only
-  GGEMSDoseParams* dose_params_device = opencl_manager.GetDeviceBuffer<GGEMSDoseParams>(dose_params_[0], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSDoseParams), 0);
-
-  GGsize total_number_of_dosels = static_cast<GGsize>(dose_params_device->total_number_of_dosels_);
-  GGfloat* dose = new GGfloat[total_number_of_dosels];
-  std::memset(dose, 0, total_number_of_dosels*sizeof(GGfloat));
-
-  GGsize3 dimensions;
-  dimensions.x_ = static_cast<GGsize>(dose_params_device->number_of_dosels_.s[0]);
-  dimensions.y_ = static_cast<GGsize>(dose_params_device->number_of_dosels_.s[1]);
-  dimensions.z_ = static_cast<GGsize>(dose_params_device->number_of_dosels_.s[2]);
+  // Waiting for all transfers
+  for (GGsize j = 0; j < number_activated_devices_; ++j) {
+    read_events[j].wait();
 
-  GGEMSMHDImage mhdImage;
-  mhdImage.SetOutputFileName(dosimetry_output_filename_ + "_dose.mhd");
-  mhdImage.SetDataType("MET_FLOAT");
-  mhdImage.SetDimensions(dimensions);
-  mhdImage.SetElementSizes(dose_params_device->size_of_dosels_);
+    // GGEMS Profiling
+    GGsize device_index = opencl_manager.GetIndexOfActivatedDevice(j);
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "GGEMSDosimetryCalculator::SaveDoseMaps in " << opencl_manager.GetDeviceName(device_index) << ", index " << device_index;
+    GGEMSProfilerManager::GetInstance().HandleEvent(kernel_events[j], oss.str());
 
-  // Release the pointer
-  opencl_manager.ReleaseDeviceBuffer(dose_params_[0], dose_params_device, 0);
+    opencl_manager.Deallocate(staging[j], staging_size, j, "GGEMSDosimetryCalculator");
+  }
 
-  // Loop over all activated device
-  for (GGsize j = 0; j < number_activated_devices_; ++j) {
-    GGfloat* dose_device = opencl_manager.GetDeviceBuffer<GGfloat>(dose_recording_.dose_[j], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, total_number_of_dosels*sizeof(GGfloat), j);
+  // Outputs of all devices are merged in staging of first device, dose and photon tracking are summed, other outputs are taken from last device
+  GGuchar* staging_output = staging_host[0];
+  for (GGsize j = 1; j < number_activated_devices_; ++j) {
+    if (dose_size) {
+      GGfloat* dose = reinterpret_cast<GGfloat*>(staging_output + dose_offset);
+      GGfloat* dose_device = reinterpret_cast<GGfloat*>(staging_host[j] + dose_offset);
+      for (GGsize i = 0; i < total_number_of_dosels_; ++i) dose[i] += dose_device[i];
+    }
 
-    for (GGsize i = 0; i < total_number_of_dosels; ++i) dose[i] += dose_device[i];
+    if (photon_tracking_size) {
+      GGint* photon_tracking = reinterpret_cast<GGint*>(staging_output + photon_tracking_offset);
+      GGint* photon_tracking_device = reinterpret_cast<GGint*>(staging_host[j] + photon_tracking_offset);
+      for (GGsize i = 0; i < total_number_of_dosels_; ++i) photon_tracking[i] += photon_tracking_device[i];
+    }
 
-    opencl_manager.ReleaseDeviceBuffer(dose_recording_.dose_[j], dose_device, j);
+    std::memcpy(staging_output + edep_offset, staging_host[j] + edep_offset, edep_size + edep_squared_size);
+    std::memcpy(staging_output + uncertainty_offset, staging_host[j] + uncertainty_offset, uncertainty_size + adaptive_dose_size + dose_level_size + hit_size);
   }
 
-  // Writing data
-  mhdImage.Write<GGfloat>(dose);
-  delete[] dose;
+  // Writing outputs in parallel
+  std::string dosi_type = (sizeof(GGDosiType) == 4) ? "MET_FLOAT" : "MET_DOUBLE";
+  std::vector<std::thread> writers;
+  if (edep_size) writers.push_back(std::thread(&GGEMSDosimetryCalculator::WriteOutput<GGDosiType>, this, dosimetry_output_filename_ + "_edep.mhd", dosi_type, dimensions, element_sizes, reinterpret_cast<GGDosiType*>(staging_output + edep_offset)));
+  if (edep_squared_size) writers.push_back(std::thread(&GGEMSDosimetryCalculator::WriteOutput<GGDosiType>, this, dosimetry_output_filename_ + "_edep_squared.mhd", dosi_type, dimensions, element_sizes, reinterpret_cast<GGDosiType*>(staging_output + edep_squared_offset)));
+  if (dose_size) writers.push_back(std::thread(&GGEMSDosimetryCalculator::WriteOutput<GGfloat>, this, dosimetry_output_filename_ + "_dose.mhd", "MET_FLOAT", dimensions, element_sizes, reinterpret_cast<GGfloat*>(staging_output + dose_offset)));
+  if (uncertainty_size) writers.push_back(std::thread(&GGEMSDosimetryCalculator::WriteOutput<GGfloat>, this, dosimetry_output_filename_ + "_uncertainty.mhd", "MET_FLOAT", dimensions, element_sizes, reinterpret_cast<GGfloat*>(staging_output + uncertainty_offset)));
+  if (adaptive_dose_size) writers.push_back(std::thread(&GGEMSDosimetryCalculator::WriteOutput<GGfloat>, this, dosimetry_output_filename_ + "_dose_adaptive.mhd", "MET_FLOAT", dimensions, element_sizes, reinterpret_cast<GGfloat*>(staging_output + adaptive_dose_offset)));
+  if (dose_level_size) writers.push_back(std::thread(&GGEMSDosimetryCalculator::WriteOutput<GGint>, this, dosimetry_output_filename_ + "_dose_level.mhd", "MET_INT", dimensions, element_sizes, reinterpret_cast<GGint*>(staging_output + dose_level_offset)));
+  if (hit_size) writers.push_back(std::thread(&GGEMSDosimetryCalculator::WriteOutput<GGint>, this, dosimetry_output_filename_ + "_hit.mhd", "MET_INT", dimensions, element_sizes, reinterpret_cast<GGint*>(staging_output + hit_offset)));
+  if (photon_tracking_size) writers.push_back(std::thread(&GGEMSDosimetryCalculator::WriteOutput<GGint>, this, dosimetry_output_filename_ + "_photon_tracking.mhd", "MET_INT", dimensions, element_sizes, reinterpret_cast<GGint*>(staging_output + photon_tracking_offset)));
+
+  for (GGsize i = 0; i < writers.size(); ++i) writers[i].join();
+
+  for (GGsize j = 0; j < number_activated_devices_; ++j) delete[] staging_host[j];
+  delete[] staging_host;
+  delete[] staging;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
-void GGEMSDosimetryCalculator::SaveUncertainty(void) const
+void GGEMSDosimetryCalculator::SaveLabelDose(void) const
 {
   // Get the OpenCL manager
   GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
 
-  // Get pointer on OpenCL device for dose parameters, take data from first device only
-  GGEMSDoseParams* dose_params_device = opencl_manager.GetDeviceBuffer<GGEMSDoseParams>(dose_params_[0], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSDoseParams), 0);
-
-  GGsize total_number_of_dosels = static_cast<GGsize>(dose_params_device->total_number_of_dosels_);
-  GGfloat* uncertainty = new GGfloat[total_number_of_dosels];
-  std::memset(uncertainty, 0, total_number_of_dosels*sizeof(GGfloat));
-
-  GGsize3 dimensions;
-  dimensions.x_ = static_cast<GGsize>(dose_params_device->number_of_dosels_.s[0]);
-  dimensions.y_ = static_cast<GGsize>(dose_params_device->number_of_dosels_.s[1]);
-  dimensions.z_ = static_cast<GGsize>(dose_params_device->number_of_dosels_.s[2]);
-
-  GGEMSMHDImage mhdImage;
-  mhdImage.SetOutputFileName(dosimetry_output_filename_ + "_uncertainty.mhd");
-  mhdImage.SetDataType("MET_FLOAT");
-  mhdImage.SetDimensions(dimensions);
-  mhdImage.SetElementSizes(dose_params_device->size_of_dosels_);
-
-  // Release the pointer
-  opencl_manager.ReleaseDeviceBuffer(dose_params_[0], dose_params_device, 0);
+  GGDosiType* label_edep = new GGDosiType[number_of_labels_];
+  std::memset(label_edep, 0, number_of_labels_*sizeof(GGDosiType));
+  GGDosiType* label_mass = new GGDosiType[number_of_labels_];
+  std::memset(label_mass, 0, number_of_labels_*sizeof(GGDosiType));
 
-  // Loop over all activated device
+  // Energy is summed over devices, mass is the same on each device
   for (GGsize j = 0; j < number_activated_devices_; ++j) {
-    GGfloat* uncertainty_device = opencl_manager.GetDeviceBuffer<GGfloat>(dose_recording_.uncertainty_dose_[j], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, total_number_of_dosels*sizeof(GGfloat), j);
+    GGDosiType* label_edep_device = opencl_manager.GetDeviceBuffer<GGDosiType>(dose_recording_.label_edep_[j], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, number_of_labels_*sizeof(GGDosiType), j);
+    GGDosiType* label_mass_device = opencl_manager.GetDeviceBuffer<GGDosiType>(dose_recording_.label_mass_[j], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, number_of_labels_*sizeof(GGDosiType), j);
 
-    for (GGsize i = 0; i < total_number_of_dosels; ++i) uncertainty[i] = uncertainty_device[i];
+    for (GGsize i = 0; i < number_of_labels_; ++i) {
+      label_edep[i] += label_edep_device[i];
+      label_mass[i] = label_mass_device[i];
+    }
 
-    opencl_manager.ReleaseDeviceBuffer(dose_recording_.uncertainty_dose_[j], uncertainty_device, j);
+    opencl_manager.ReleaseDeviceBuffer(dose_recording_.label_edep_[j], label_edep_device, j);
+    opencl_manager.ReleaseDeviceBuffer(dose_recording_.label_mass_[j], label_mass_device, j);
   }
 
-  // Writing data
-  mhdImage.Write<GGfloat>(uncertainty);
-  delete[] uncertainty;
+  // Writing table, no uncertainty since deposits of a history in dosels of a same label are correlated
+  std::ofstream label_dose_stream(dosimetry_output_filename_ + "_label_dose.txt", std::ios::out);
+  label_dose_stream << "# label material edep[MeV] mass[kg] dose[Gy]" << std::endl;
+  for (GGsize i = 0; i < number_of_labels_; ++i) {
+    GGDosiType dose = label_mass[i] > 0.0 ? scale_factor_ * label_edep[i] / label_mass[i] / Gy : 0.0;
+    label_dose_stream << i << " " << navigator_->GetMaterials()->GetMaterialName(i) << " " << label_edep[i] / MeV << " " << label_mass[i] / kg << " " << dose << std::endl;
+  }
+  label_dose_stream.close();
+
+  delete[] label_edep;
+  delete[] label_mass;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -851,6 +1229,24 @@ void dose_uncertainty_dosimetry_calculator(GGEMSDosimetryCalculator* dose_calcul
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+void dose_label_dosimetry_calculator(GGEMSDosimetryCalculator* dose_calculator, bool const is_activated)
+{
+  dose_calculator->SetLabelDose(is_activated);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void dose_map_dosimetry_calculator(GGEMSDosimetryCalculator* dose_calculator, bool const is_activated)
+{
+  dose_calculator->SetDoseMap(is_activated);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 void dose_tle_navigator(GGEMSDosimetryCalculator* dose_calculator, bool const is_activated)
 {
  dose_calculator->SetTLE(is_activated);
@@ -860,6 +1256,15 @@ void dose_tle_navigator(GGEMSDosimetryCalculator* dose_calculator, bool const is
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+void dose_csda_navigator(GGEMSDosimetryCalculator* dose_calculator, bool const is_activated)
+{
+  dose_calculator->SetCSDA(is_activated);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 void water_reference_dosimetry_calculator(GGEMSDosimetryCalculator* dose_calculator, bool const is_activated)
 {
   dose_calculator->SetWaterReference(is_activated);
@@ -878,6 +1283,24 @@ void minimum_density_dosimetry_calculator(GGEMSDosimetryCalculator* dose_calcula
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+void adaptive_dosels_dosimetry_calculator(GGEMSDosimetryCalculator* dose_calculator, GGsize const number_of_levels, GGfloat const target_uncertainty)
+{
+  dose_calculator->SetAdaptiveDosels(number_of_levels, target_uncertainty);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void set_dose_region_dosimetry_calculator(GGEMSDosimetryCalculator* dose_calculator, GGfloat const x_min, GGfloat const x_max, GGfloat const y_min, GGfloat const y_max, GGfloat const z_min, GGfloat const z_max, char const* unit)
+{
+  dose_calculator->SetDoseRegion(x_min, x_max, y_min, y_max, z_min, z_max, unit);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 void attach_to_navigator_dosimetry_calculator(GGEMSDosimetryCalculator* dose_calculator, char const* navigator)
 {
   dose_calculator->AttachToNavigator(navigator);
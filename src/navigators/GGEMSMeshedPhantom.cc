@@ -0,0 +1,169 @@
+// ************************************************************************
+// * This file is part of GGEMS.                                          *
+// *                                                                      *
+// * GGEMS is free software: you can redistribute it and/or modify        *
+// * it under the terms of the GNU General Public License as published by *
+// * the Free Software Foundation, either version 3 of the License, or    *
+// * (at your option) any later version.                                  *
+// *                                                                      *
+// * GGEMS is distributed in the hope that it will be useful,             *
+// * but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+// * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+// * GNU General Public License for more details.                         *
+// *                                                                      *
+// * You should have received a copy of the GNU General Public License    *
+// * along with GGEMS.  If not, see <https://www.gnu.org/licenses/>.      *
+// *                                                                      *
+// ************************************************************************
+
+/*!
+  \file GGEMSMeshedPhantom.cc
+
+  \brief Child GGEMS class handling meshed phantom, a closed triangle mesh filled with one material
+
+  \author Julien BERT <julien.bert@univ-brest.fr>
+  \author Didier BENOIT <didier.benoit@inserm.fr>
+  \author LaTIM, INSERM - U1101, Brest, FRANCE
+  \date Sunday October 18, 2026
+*/
+
+#include "GGEMS/navigators/GGEMSMeshedPhantom.hh"
+#include "GGEMS/geometries/GGEMSSolidMesh.hh"
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+GGEMSMeshedPhantom::GGEMSMeshedPhantom(std::string const& meshed_phantom_name)
+: GGEMSNavigator(meshed_phantom_name),
+  mesh_filename_(""),
+  material_name_("")
+{
+  GGcout("GGEMSMeshedPhantom", "GGEMSMeshedPhantom", 3) << "GGEMSMeshedPhantom creating..." << GGendl;
+
+  GGcout("GGEMSMeshedPhantom", "GGEMSMeshedPhantom", 3) << "GGEMSMeshedPhantom created!!!" << GGendl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+GGEMSMeshedPhantom::~GGEMSMeshedPhantom(void)
+{
+  GGcout("GGEMSMeshedPhantom", "~GGEMSMeshedPhantom", 3) << "GGEMSMeshedPhantom erasing..." << GGendl;
+
+  GGcout("GGEMSMeshedPhantom", "~GGEMSMeshedPhantom", 3) << "GGEMSMeshedPhantom erased!!!" << GGendl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSMeshedPhantom::CheckParameters(void) const
+{
+  GGcout("GGEMSMeshedPhantom", "CheckParameters", 3) << "Checking the mandatory parameters..." << GGendl;
+
+  // Checking mesh file
+  if (mesh_filename_.empty()) {
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "You have to set a STL or OBJ file containing the meshed phantom!!!";
+    GGEMSMisc::ThrowException("GGEMSMeshedPhantom", "CheckParameters", oss.str());
+  }
+
+  // Checking material of mesh
+  if (material_name_.empty()) {
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "You have to set a material for the meshed phantom!!!";
+    GGEMSMisc::ThrowException("GGEMSMeshedPhantom", "CheckParameters", oss.str());
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSMeshedPhantom::Initialize(void)
+{
+  GGcout("GGEMSMeshedPhantom", "Initialize", 3) << "Initializing a GGEMS meshed phantom..." << GGendl;
+
+  CheckParameters();
+
+  // Getting the current number of registered solid
+  GGEMSNavigatorManager& navigator_manager = GGEMSNavigatorManager::GetInstance();
+
+  // Get the number of already registered buffer
+  GGsize number_of_registered_solids = navigator_manager.GetNumberOfRegisteredSolids();
+
+  // Allocation of memory for solid, 1 solid and 1 material per closed mesh
+  solids_ = new GGEMSSolid*[1];
+  number_of_solids_ = 1;
+
+  materials_->AddMaterial(material_name_);
+
+  solids_[0] = new GGEMSSolidMesh(mesh_filename_);
+
+  // Enabling tracking if necessary
+  if (is_tracking_) solids_[0]->EnableTracking();
+
+  // Load mesh and building BVH
+  solids_[0]->Initialize(materials_);
+
+  // Perform rotation before position
+  if (is_update_rot_) solids_[0]->SetRotation(rotation_xyz_);
+  if (is_update_pos_) solids_[0]->SetPosition(position_xyz_);
+
+  for (GGsize j = 0; j < number_activated_devices_; ++j) {
+    solids_[0]->SetSolidID<GGEMSSolidMeshData>(number_of_registered_solids, j);
+    // Store the transformation matrix in solid object
+    solids_[0]->UpdateTransformationMatrix(j);
+  }
+
+  // Initialize parent class
+  GGEMSNavigator::Initialize();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSMeshedPhantom::SetMeshFile(std::string const& mesh_filename, std::string const& material_name)
+{
+  mesh_filename_ = mesh_filename;
+  material_name_ = material_name;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+GGEMSMeshedPhantom* create_ggems_meshed_phantom(char const* meshed_phantom_name)
+{
+  return new(std::nothrow) GGEMSMeshedPhantom(meshed_phantom_name);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void set_mesh_file_ggems_meshed_phantom(GGEMSMeshedPhantom* meshed_phantom, char const* mesh_filename, char const* material_name)
+{
+  meshed_phantom->SetMeshFile(mesh_filename, material_name);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void set_position_ggems_meshed_phantom(GGEMSMeshedPhantom* meshed_phantom, GGfloat const position_x, GGfloat const position_y, GGfloat const position_z, char const* unit)
+{
+  meshed_phantom->SetPosition(position_x, position_y, position_z, unit);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void set_rotation_ggems_meshed_phantom(GGEMSMeshedPhantom* meshed_phantom, GGfloat const rx, GGfloat const ry, GGfloat const rz, char const* unit)
+{
+  meshed_phantom->SetRotation(rx, ry, rz, unit);
+}
@@ -0,0 +1,460 @@
+// ************************************************************************
+// * This file is part of GGEMS.                                          *
+// *                                                                      *
+// * GGEMS is free software: you can redistribute it and/or modify        *
+// * it under the terms of the GNU General Public License as published by *
+// * the Free Software Foundation, either version 3 of the License, or    *
+// * (at your option) any later version.                                  *
+// *                                                                      *
+// * GGEMS is distributed in the hope that it will be useful,             *
+// * but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+// * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+// * GNU General Public License for more details.                         *
+// *                                                                      *
+// * You should have received a copy of the GNU General Public License    *
+// * along with GGEMS.  If not, see <https://www.gnu.org/licenses/>.      *
+// *                                                                      *
+// ************************************************************************
+
+/*!
+  \file GGEMSMotherVolume.cc
+
+  \brief GGEMS class handling mother volume, a box of world medium containing daughter navigators or mother volumes
+
+  \author Julien BERT <julien.bert@univ-brest.fr>
+  \author Didier BENOIT <didier.benoit@inserm.fr>
+  \author LaTIM, INSERM - U1101, Brest, FRANCE
+  \version 1.0
+  \date Sunday October 18, 2026
+*/
+
+#include "GGEMS/navigators/GGEMSNavigatorManager.hh"
+#include "GGEMS/navigators/GGEMSMotherVolume.hh"
+#include "GGEMS/geometries/GGEMSMotherVolumeData.hh"
+#include "GGEMS/maths/GGEMSGeometryTransformation.hh"
+#include "GGEMS/sources/GGEMSSourceManager.hh"
+#include "GGEMS/tools/GGEMSProfilerManager.hh"
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+GGEMSMotherVolume::GGEMSMotherVolume(std::string const& mother_volume_name)
+: mother_volume_name_(mother_volume_name),
+  is_update_pos_(false),
+  is_update_rot_(false),
+  solid_id_(-1),
+  mother_volume_(nullptr),
+  kernel_option_("")
+{
+  GGcout("GGEMSMotherVolume", "GGEMSMotherVolume", 3) << "GGEMSMotherVolume creating..." << GGendl;
+
+  size_xyz_.s[0] = -1.0f;
+  size_xyz_.s[1] = -1.0f;
+  size_xyz_.s[2] = -1.0f;
+
+  position_xyz_.s[0] = 0.0f;
+  position_xyz_.s[1] = 0.0f;
+  position_xyz_.s[2] = 0.0f;
+
+  rotation_xyz_.s[0] = 0.0f;
+  rotation_xyz_.s[1] = 0.0f;
+  rotation_xyz_.s[2] = 0.0f;
+
+  // Store the mother volume in navigator manager
+  GGEMSNavigatorManager::GetInstance().StoreMotherVolume(this);
+
+  // Allocation of geometry transformation
+  geometry_transformation_ = new GGEMSGeometryTransformation();
+
+  // Get the number of activated device
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+  number_activated_devices_ = opencl_manager.GetNumberOfActivatedDevice();
+
+  // Allocating memory on each activated device
+  mother_volume_data_ = new cl::Buffer*[number_activated_devices_];
+  for (GGsize d = 0; d < number_activated_devices_; ++d) {
+    mother_volume_data_[d] = opencl_manager.Allocate(nullptr, sizeof(GGEMSMotherVolumeData), d, CL_MEM_READ_WRITE, "GGEMSMotherVolume");
+  }
+
+  // Storing a kernel for each device
+  kernel_particle_solid_distance_ = new cl::Kernel*[number_activated_devices_];
+  kernel_project_to_solid_ = new cl::Kernel*[number_activated_devices_];
+
+  GGcout("GGEMSMotherVolume", "GGEMSMotherVolume", 3) << "GGEMSMotherVolume created!!!" << GGendl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+GGEMSMotherVolume::~GGEMSMotherVolume(void)
+{
+  GGcout("GGEMSMotherVolume", "~GGEMSMotherVolume", 3) << "GGEMSMotherVolume erasing..." << GGendl;
+
+  if (kernel_particle_solid_distance_) {
+    delete[] kernel_particle_solid_distance_;
+    kernel_particle_solid_distance_ = nullptr;
+  }
+
+  if (kernel_project_to_solid_) {
+    delete[] kernel_project_to_solid_;
+    kernel_project_to_solid_ = nullptr;
+  }
+
+  if (geometry_transformation_) {
+    delete geometry_transformation_;
+    geometry_transformation_ = nullptr;
+  }
+
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  if (mother_volume_data_) {
+    for (GGsize i = 0; i < number_activated_devices_; ++i) {
+      opencl_manager.Deallocate(mother_volume_data_[i], sizeof(GGEMSMotherVolumeData), i);
+    }
+    delete[] mother_volume_data_;
+    mother_volume_data_ = nullptr;
+  }
+
+  GGcout("GGEMSMotherVolume", "~GGEMSMotherVolume", 3) << "GGEMSMotherVolume erased!!!" << GGendl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSMotherVolume::SetSize(GGfloat const& size_x, GGfloat const& size_y, GGfloat const& size_z, std::string const& unit)
+{
+  size_xyz_.s[0] = DistanceUnit(size_x, unit);
+  size_xyz_.s[1] = DistanceUnit(size_y, unit);
+  size_xyz_.s[2] = DistanceUnit(size_z, unit);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSMotherVolume::SetPosition(GGfloat const& position_x, GGfloat const& position_y, GGfloat const& position_z, std::string const& unit)
+{
+  is_update_pos_ = true;
+  position_xyz_.s[0] = DistanceUnit(position_x, unit);
+  position_xyz_.s[1] = DistanceUnit(position_y, unit);
+  position_xyz_.s[2] = DistanceUnit(position_z, unit);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSMotherVolume::SetRotation(GGfloat const& rx, GGfloat const& ry, GGfloat const& rz, std::string const& unit)
+{
+  is_update_rot_ = true;
+  rotation_xyz_.s[0] = AngleUnit(rx, unit);
+  rotation_xyz_.s[1] = AngleUnit(ry, unit);
+  rotation_xyz_.s[2] = AngleUnit(rz, unit);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSMotherVolume::AddDaughter(std::string const& daughter_name)
+{
+  GGEMSNavigatorManager& navigator_manager = GGEMSNavigatorManager::GetInstance();
+
+  // Daughter is a mother volume
+  GGEMSMotherVolume* daughter_volume = navigator_manager.GetMotherVolume(daughter_name);
+  if (daughter_volume) {
+    daughter_volume->SetMotherVolume(this);
+    return;
+  }
+
+  // Daughter is a navigator
+  GGEMSNavigator** navigators = navigator_manager.GetNavigators();
+  GGEMSNavigator* daughter_navigator = nullptr;
+  for (GGsize i = 0; i < navigator_manager.GetNumberOfNavigators(); ++i) {
+    if (daughter_name == navigators[i]->GetNavigatorName()) daughter_navigator = navigators[i];
+  }
+
+  if (!daughter_navigator) {
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "Daughter " << daughter_name << " of mother volume " << mother_volume_name_ << " is not a registered navigator or mother volume!!!";
+    GGEMSMisc::ThrowException("GGEMSMotherVolume", "AddDaughter", oss.str());
+  }
+
+  daughter_navigator->SetMotherVolume(this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSMotherVolume::SetMotherVolume(GGEMSMotherVolume* mother_volume)
+{
+  // A mother volume is in one mother volume only
+  if (mother_volume_ && mother_volume_ != mother_volume) {
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "Mother volume " << mother_volume_name_ << " is already a daughter of mother volume " << mother_volume_->GetMotherVolumeName() << "!!!";
+    GGEMSMisc::ThrowException("GGEMSMotherVolume", "SetMotherVolume", oss.str());
+  }
+
+  // Checking the geometry tree has no cycle
+  for (GGEMSMotherVolume* volume = mother_volume; volume; volume = volume->GetMotherVolume()) {
+    if (volume == this) {
+      std::ostringstream oss(std::ostringstream::out);
+      oss << "Mother volume " << mother_volume_name_ << " can not be nested in itself!!!";
+      GGEMSMisc::ThrowException("GGEMSMotherVolume", "SetMotherVolume", oss.str());
+    }
+  }
+
+  mother_volume_ = mother_volume;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSMotherVolume::SetSolidID(GGint const& solid_id)
+{
+  solid_id_ = solid_id;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSMotherVolume::EnableTracking(void)
+{
+  kernel_option_ += " -DGGEMS_TRACKING";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSMotherVolume::CheckParameters(void) const
+{
+  GGcout("GGEMSMotherVolume", "CheckParameters", 3) << "Checking the mandatory parameters..." << GGendl;
+
+  // Checking size of mother volume
+  if (size_xyz_.s[0] <= 0.0f || size_xyz_.s[1] <= 0.0f || size_xyz_.s[2] <= 0.0f) {
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "Size of mother volume " << mother_volume_name_ << " has to be set!!!";
+    GGEMSMisc::ThrowException("GGEMSMotherVolume", "CheckParameters", oss.str());
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSMotherVolume::InitializeKernel(void)
+{
+  GGcout("GGEMSMotherVolume", "InitializeKernel", 3) << "Initializing kernel for mother volume..." << GGendl;
+
+  // Getting the OpenCLManager singleton
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  // Getting the path to kernel
+  std::string openCL_kernel_path = OPENCL_KERNEL_PATH;
+  std::string particle_solid_distance_filename = openCL_kernel_path + "/ParticleSolidDistanceGGEMSMotherVolume.cl";
+  std::string project_to_filename = openCL_kernel_path + "/ProjectToGGEMSMotherVolume.cl";
+
+  // Compiling the kernels
+  opencl_manager.CompileKernel(particle_solid_distance_filename, "particle_solid_distance_ggems_mother_volume", kernel_particle_solid_distance_, nullptr, const_cast<char*>(kernel_option_.c_str()));
+  opencl_manager.CompileKernel(project_to_filename, "project_to_ggems_mother_volume", kernel_project_to_solid_, nullptr, const_cast<char*>(kernel_option_.c_str()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSMotherVolume::Initialize(void)
+{
+  GGcout("GGEMSMotherVolume", "Initialize", 3) << "Initializing a GGEMS mother volume..." << GGendl;
+
+  CheckParameters();
+
+  // Perform rotation before position
+  if (is_update_rot_) geometry_transformation_->SetRotation(rotation_xyz_);
+  if (is_update_pos_) geometry_transformation_->SetTranslation(position_xyz_);
+
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  // Loop over the device
+  for (GGsize d = 0; d < number_activated_devices_; ++d) {
+    GGEMSMotherVolumeData* mother_volume_data_device = opencl_manager.GetDeviceBuffer<GGEMSMotherVolumeData>(mother_volume_data_[d], CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSMotherVolumeData), d);
+    GGEMSTransformationMatrix* transformation_matrix_device = opencl_manager.GetDeviceBuffer<GGEMSTransformationMatrix>(geometry_transformation_->GetTransformationMatrix(d), CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSTransformationMatrix), d);
+
+    for (GGint i = 0; i < 3; ++i) {
+      mother_volume_data_device->obb_geometry_.border_min_xyz_.s[i] = -size_xyz_.s[i]*0.5f;
+      mother_volume_data_device->obb_geometry_.border_max_xyz_.s[i] = size_xyz_.s[i]*0.5f;
+    }
+
+    mother_volume_data_device->obb_geometry_.matrix_transformation_ = *transformation_matrix_device;
+
+    mother_volume_data_device->solid_id_ = solid_id_;
+    mother_volume_data_device->mother_id_ = mother_volume_ ? mother_volume_->GetSolidID() : -1;
+
+    // Release the pointers
+    opencl_manager.ReleaseDeviceBuffer(mother_volume_data_[d], mother_volume_data_device, d);
+    opencl_manager.ReleaseDeviceBuffer(geometry_transformation_->GetTransformationMatrix(d), transformation_matrix_device, d);
+  }
+
+  InitializeKernel();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSMotherVolume::ParticleSolidDistance(GGsize const& thread_index)
+{
+  // Getting the OpenCL manager and infos for work-item launching
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+  cl::CommandQueue* queue = opencl_manager.GetCommandQueue(thread_index);
+
+  // Get Device name and storing methode name + device
+  GGsize device_index = opencl_manager.GetIndexOfActivatedDevice(thread_index);
+  std::string device_name = opencl_manager.GetDeviceName(device_index);
+  std::ostringstream oss(std::ostringstream::out);
+  oss << "GGEMSMotherVolume::ParticleSolidDistance on " << device_name << ", index " << device_index;
+
+  // Pointer to primary particles, and number to particles in buffer
+  GGEMSSourceManager& source_manager = GGEMSSourceManager::GetInstance();
+  cl::Buffer* primary_particles = source_manager.GetParticles()->GetPrimaryParticles(thread_index);
+  GGsize number_of_particles = source_manager.GetParticles()->GetNumberOfParticles(thread_index);
+
+  // Getting work group size, and work-item number
+  GGsize work_group_size = opencl_manager.GetWorkGroupSize();
+  GGsize number_of_work_items = opencl_manager.GetBestWorkItem(number_of_particles);
+
+  // Parameters for work-item in kernel
+  cl::NDRange global_wi(number_of_work_items);
+  cl::NDRange local_wi(work_group_size);
+
+  // Getting kernel, and setting parameters
+  cl::Kernel* kernel = kernel_particle_solid_distance_[thread_index];
+  opencl_manager.PrepareKernel(kernel);
+  kernel->setArg(0, number_of_particles);
+  kernel->setArg(1, *primary_particles);
+  kernel->setArg(2, *mother_volume_data_[thread_index]);
+
+  // Launching kernel
+  cl::Event event;
+  GGint kernel_status = queue->enqueueNDRangeKernel(*kernel, 0, global_wi, local_wi, nullptr, &event);
+  opencl_manager.CheckOpenCLError(kernel_status, "GGEMSMotherVolume", "ParticleSolidDistance");
+  queue->finish();
+
+  // GGEMS Profiling
+  GGEMSProfilerManager::GetInstance().HandleEvent(event, oss.str());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSMotherVolume::ProjectToSolid(GGsize const& thread_index)
+{
+  // Getting the OpenCL manager and infos for work-item launching
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+  cl::CommandQueue* queue = opencl_manager.GetCommandQueue(thread_index);
+
+  // Get Device name and storing methode name + device
+  GGsize device_index = opencl_manager.GetIndexOfActivatedDevice(thread_index);
+  std::string device_name = opencl_manager.GetDeviceName(device_index);
+  std::ostringstream oss(std::ostringstream::out);
+  oss << "GGEMSMotherVolume::ProjectToSolid on " << device_name << ", index " << device_index;
+
+  // Pointer to primary particles, and number to particles in buffer
+  GGEMSSourceManager& source_manager = GGEMSSourceManager::GetInstance();
+  cl::Buffer* primary_particles = source_manager.GetParticles()->GetPrimaryParticles(thread_index);
+  GGsize number_of_particles = source_manager.GetParticles()->GetNumberOfParticles(thread_index);
+
+  // Getting work group size, and work-item number
+  GGsize work_group_size = opencl_manager.GetWorkGroupSize();
+  GGsize number_of_work_items = opencl_manager.GetBestWorkItem(number_of_particles);
+
+  // Parameters for work-item in kernel
+  cl::NDRange global_wi(number_of_work_items);
+  cl::NDRange local_wi(work_group_size);
+
+  // Getting kernel, and setting parameters
+  cl::Kernel* kernel = kernel_project_to_solid_[thread_index];
+  opencl_manager.PrepareKernel(kernel);
+  kernel->setArg(0, number_of_particles);
+  kernel->setArg(1, *primary_particles);
+  kernel->setArg(2, *mother_volume_data_[thread_index]);
+
+  // Launching kernel
+  cl::Event event;
+  GGint kernel_status = queue->enqueueNDRangeKernel(*kernel, 0, global_wi, local_wi, nullptr, &event);
+  opencl_manager.CheckOpenCLError(kernel_status, "GGEMSMotherVolume", "ProjectToSolid");
+  queue->finish();
+
+  // GGEMS Profiling
+  GGEMSProfilerManager::GetInstance().HandleEvent(event, oss.str());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSMotherVolume::PrintInfos(void) const
+{
+  GGcout("GGEMSMotherVolume", "PrintInfos", 0) << GGendl;
+  GGcout("GGEMSMotherVolume", "PrintInfos", 0) << "GGEMSMotherVolume Infos:" << GGendl;
+  GGcout("GGEMSMotherVolume", "PrintInfos", 0) << "------------------------" << GGendl;
+  GGcout("GGEMSMotherVolume", "PrintInfos", 0) << "* Name: " << mother_volume_name_ << GGendl;
+  GGcout("GGEMSMotherVolume", "PrintInfos", 0) << "* Size: " << size_xyz_.s[0] << "x" << size_xyz_.s[1] << "x" << size_xyz_.s[2] << " mm3" << GGendl;
+  GGcout("GGEMSMotherVolume", "PrintInfos", 0) << "* Position: " << position_xyz_.s[0] << " " << position_xyz_.s[1] << " " << position_xyz_.s[2] << " mm" << GGendl;
+  GGcout("GGEMSMotherVolume", "PrintInfos", 0) << "* Mother volume: " << (mother_volume_ ? mother_volume_->GetMotherVolumeName() : "world") << GGendl;
+  GGcout("GGEMSMotherVolume", "PrintInfos", 0) << "* Solid index: " << solid_id_ << GGendl;
+  GGcout("GGEMSMotherVolume", "PrintInfos", 0) << GGendl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+GGEMSMotherVolume* create_ggems_mother_volume(char const* mother_volume_name)
+{
+  return new(std::nothrow) GGEMSMotherVolume(mother_volume_name);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void set_size_ggems_mother_volume(GGEMSMotherVolume* mother_volume, GGfloat const size_x, GGfloat const size_y, GGfloat const size_z, char const* unit)
+{
+  mother_volume->SetSize(size_x, size_y, size_z, unit);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void set_position_ggems_mother_volume(GGEMSMotherVolume* mother_volume, GGfloat const position_x, GGfloat const position_y, GGfloat const position_z, char const* unit)
+{
+  mother_volume->SetPosition(position_x, position_y, position_z, unit);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void set_rotation_ggems_mother_volume(GGEMSMotherVolume* mother_volume, GGfloat const rx, GGfloat const ry, GGfloat const rz, char const* unit)
+{
+  mother_volume->SetRotation(rx, ry, rz, unit);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void add_daughter_ggems_mother_volume(GGEMSMotherVolume* mother_volume, char const* daughter_name)
+{
+  mother_volume->AddDaughter(daughter_name);
+}
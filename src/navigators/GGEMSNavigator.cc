@@ -38,6 +38,9 @@
 #include "GGEMS/physics/GGEMSMuData.hh"
 #include "GGEMS/physics/GGEMSMuDataConstants.hh"
 #include "GGEMS/global/GGEMSOpenCLManager.hh"
+#include "GGEMS/io/GGEMSPhaseSpace.hh"
+#include "GGEMS/navigators/GGEMSMotherVolume.hh"
+#include "GGEMS/geometries/GGEMSSolidBoxData.hh"
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
@@ -48,13 +51,19 @@ GGEMSNavigator::GGEMSNavigator(std::string const& navigator_name)
   navigator_id_(NAVIGATOR_NOT_INITIALIZED),
   is_update_pos_(false),
   is_update_rot_(false),
+  threshold_(0.0f),
   is_tracking_(false),
   output_basename_(""),
   solids_(nullptr),
   number_of_solids_(0),
   dose_calculator_(nullptr),
   is_dosimetry_mode_(false),
-  is_tle_(0)
+  is_tle_(0),
+  is_csda_(false),
+  phase_space_(nullptr),
+  mother_volume_(nullptr),
+  is_candidate_search_(false),
+  fallback_search_(nullptr)
 {
   GGcout("GGEMSNavigator", "GGEMSNavigator", 3) << "GGEMSNavigator creating..." << GGendl;
 
@@ -123,6 +132,20 @@ GGEMSNavigator::~GGEMSNavigator(void)
     attenuations_ = nullptr;
   }
 
+  if (phase_space_) {
+    delete phase_space_;
+    phase_space_ = nullptr;
+  }
+
+  if (fallback_search_) {
+    GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+    for (GGsize i = 0; i < number_activated_devices_; ++i) {
+      opencl_manager.Deallocate(fallback_search_[i], sizeof(GGint), i);
+    }
+    delete[] fallback_search_;
+    fallback_search_ = nullptr;
+  }
+
   GGcout("GGEMSNavigator", "~GGEMSNavigator", 3) << "GGEMSNavigator erased!!!" << GGendl;
 }
 
@@ -132,7 +155,9 @@ GGEMSNavigator::~GGEMSNavigator(void)
 
 void GGEMSNavigator::SetDosimetryCalculator(GGEMSDosimetryCalculator* dosimetry_calculator)
 {
-  dose_calculator_ = dosimetry_calculator;
+  // Other dosimetry calculators are dose grids scored during the same transport
+  if (dose_calculator_) dose_calculator_->AddDoseGrid(dosimetry_calculator);
+  else dose_calculator_ = dosimetry_calculator;
   is_dosimetry_mode_ = true;
 }
 
@@ -140,6 +165,22 @@ void GGEMSNavigator::SetDosimetryCalculator(GGEMSDosimetryCalculator* dosimetry_
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+void GGEMSNavigator::SetMotherVolume(GGEMSMotherVolume* mother_volume)
+{
+  // A navigator is in one mother volume only
+  if (mother_volume_ && mother_volume_ != mother_volume) {
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "Navigator " << navigator_name_ << " is already a daughter of mother volume " << mother_volume_->GetMotherVolumeName() << "!!!";
+    GGEMSMisc::ThrowException("GGEMSNavigator", "SetMotherVolume", oss.str());
+  }
+
+  mother_volume_ = mother_volume;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 void GGEMSNavigator::SetPosition(GGfloat const& position_x, GGfloat const& position_y, GGfloat const& position_z, std::string const& unit)
 {
   is_update_pos_ = true;
@@ -191,6 +232,15 @@ void GGEMSNavigator::EnableTracking(void)
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+GGfloat GGEMSNavigator::GetMinimumEnergyCut(void) const
+{
+  return threshold_;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 void GGEMSNavigator::EnableTLE(bool const& is_activated)
 {
   is_tle_ = is_activated;
@@ -200,6 +250,15 @@ void GGEMSNavigator::EnableTLE(bool const& is_activated)
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+void GGEMSNavigator::EnableCSDA(bool const& is_activated)
+{
+  is_csda_ = is_activated;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 void GGEMSNavigator::SetVisible(bool const& is_visible)
 {
   is_visible_ = is_visible;
@@ -293,6 +352,15 @@ void GGEMSNavigator::Initialize(void)
 
   // Initialization of attenuations
   attenuations_->Initialize();
+
+  // Flag of fallback pass for candidate search
+  if (is_candidate_search_) {
+    GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+    fallback_search_ = new cl::Buffer*[number_activated_devices_];
+    for (GGsize j = 0; j < number_activated_devices_; ++j) {
+      fallback_search_[j] = opencl_manager.Allocate(nullptr, sizeof(GGint), j, CL_MEM_READ_WRITE, "GGEMSNavigator");
+    }
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -333,25 +401,45 @@ void GGEMSNavigator::ParticleSolidDistance(GGsize const& thread_index)
   cl::NDRange global_wi(number_of_work_items);
   cl::NDRange local_wi(work_group_size);
 
-  // Loop over all the solids
-  for (GGsize i = 0; i < number_of_solids_; ++i) {
-    // Getting solid data infos
-    cl::Buffer* solid_data = solids_[i]->GetSolidData(thread_index);
+  // Solid index of mother volume, particles outside this mother volume are not tested
+  GGint mother_id = mother_volume_ ? mother_volume_->GetSolidID() : -1;
 
-    // Getting kernel, and setting parameters
-    cl::Kernel* kernel = solids_[i]->GetKernelParticleSolidDistance(thread_index);
-    kernel->setArg(0, number_of_particles);
-    kernel->setArg(1, *primary_particles);
-    kernel->setArg(2, *solid_data);
+  // With candidate search, a particle exiting a solid tests the neighbours of the solid, then other solids in a fallback pass if no neighbour is hit
+  // The last solid of candidate pass sets a flag on device, fallback pass is launched only if a particle hit no neighbour
+  GGint number_of_search_passes = is_candidate_search_ ? 2 : 1;
+  if (is_candidate_search_) opencl_manager.CleanBuffer(fallback_search_[thread_index], sizeof(GGint), thread_index);
 
-    // Launching kernel
-    cl::Event event;
-    GGint kernel_status = queue->enqueueNDRangeKernel(*kernel, 0, global_wi, local_wi, nullptr, &event);
-    opencl_manager.CheckOpenCLError(kernel_status, "GGEMSNavigator", "ParticleSolidDistance");
-    queue->finish();
+  for (GGint pass = 0; pass < number_of_search_passes; ++pass) {
+    if (pass == FALLBACK_SEARCH) {
+      GGint* fallback_search_device = opencl_manager.GetDeviceBuffer<GGint>(fallback_search_[thread_index], CL_TRUE, CL_MAP_READ, sizeof(GGint), thread_index);
+      GGint is_fallback_search = *fallback_search_device;
+      opencl_manager.ReleaseDeviceBuffer(fallback_search_[thread_index], fallback_search_device, thread_index);
+      if (!is_fallback_search) break;
+    }
 
-    // GGEMS Profiling
-    GGEMSProfilerManager::GetInstance().HandleEvent(event, oss.str());
+    // Loop over all the solids
+    for (GGsize i = 0; i < number_of_solids_; ++i) {
+      // Getting solid data infos
+      cl::Buffer* solid_data = solids_[i]->GetSolidData(thread_index);
+
+      // Getting kernel, and setting parameters
+      cl::Kernel* kernel = solids_[i]->GetKernelParticleSolidDistance(thread_index);
+      opencl_manager.PrepareKernel(kernel);
+      kernel->setArg(0, number_of_particles);
+      kernel->setArg(1, *primary_particles);
+      kernel->setArg(2, *solid_data);
+      kernel->setArg(3, mother_id);
+      solids_[i]->SetSearchPass(thread_index, pass, (is_candidate_search_ && pass == CANDIDATE_SEARCH && i == number_of_solids_ - 1) ? fallback_search_[thread_index] : nullptr);
+
+      // Launching kernel
+      cl::Event event;
+      GGint kernel_status = queue->enqueueNDRangeKernel(*kernel, 0, global_wi, local_wi, nullptr, &event);
+      opencl_manager.CheckOpenCLError(kernel_status, "GGEMSNavigator", "ParticleSolidDistance");
+      queue->finish();
+
+      // GGEMS Profiling
+      GGEMSProfilerManager::GetInstance().HandleEvent(event, oss.str());
+    }
   }
 }
 
@@ -363,7 +451,7 @@ void GGEMSNavigator::ProjectToSolid(GGsize const& thread_index)
 {
   // Getting the OpenCL manager and infos for work-item launching
   GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
-  cl::CommandQueue* queue = opencl_manager.GetCommandQueue(thread_index);
+  cl::CommandQueue* queue = opencl_manager.GetNavigationQueue(thread_index, navigator_id_);
 
   // Get Device name and storing methode name + device
   GGsize device_index = opencl_manager.GetIndexOfActivatedDevice(thread_index);
@@ -384,13 +472,14 @@ void GGEMSNavigator::ProjectToSolid(GGsize const& thread_index)
   cl::NDRange global_wi(number_of_work_items);
   cl::NDRange local_wi(work_group_size);
 
-  // Loop over all the solids
+  // Each kernel moves only particles in its solid, kernels are not waited, GGEMSNavigatorManager finishes the navigation queues
   for (GGsize i = 0; i < number_of_solids_; ++i) {
     // Getting solid data infos
     cl::Buffer* solid_data = solids_[i]->GetSolidData(thread_index);
 
     // Getting kernel, and setting parameters
     cl::Kernel* kernel = solids_[i]->GetKernelProjectToSolid(thread_index);
+    opencl_manager.PrepareKernel(kernel);
     kernel->setArg(0, number_of_particles);
     kernel->setArg(1, *primary_particles);
     kernel->setArg(2, *solid_data);
@@ -399,7 +488,6 @@ void GGEMSNavigator::ProjectToSolid(GGsize const& thread_index)
     cl::Event event;
     GGint kernel_status = queue->enqueueNDRangeKernel(*kernel, 0, global_wi, local_wi, nullptr, &event);
     opencl_manager.CheckOpenCLError(kernel_status, "GGEMSNavigator", "ProjectToSolid");
-    queue->finish();
 
     // GGEMS Profiling
     GGEMSProfilerManager::GetInstance().HandleEvent(event, oss.str());
@@ -414,7 +502,7 @@ void GGEMSNavigator::TrackThroughSolid(GGsize const& thread_index)
 {
   // Getting the OpenCL manager and infos for work-item launching
   GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
-  cl::CommandQueue* queue = opencl_manager.GetCommandQueue(thread_index);
+  cl::CommandQueue* queue = opencl_manager.GetNavigationQueue(thread_index, navigator_id_);
 
   // Get Device name and storing methode name + device
   GGsize device_index = opencl_manager.GetIndexOfActivatedDevice(thread_index);
@@ -447,7 +535,7 @@ void GGEMSNavigator::TrackThroughSolid(GGsize const& thread_index)
   cl::NDRange global_wi(number_of_work_items);
   cl::NDRange local_wi(work_group_size);
 
-  // Loop over all the solids
+  // Each kernel moves only particles in its solid, kernels are not waited, GGEMSNavigatorManager finishes the navigation queues
   for (GGsize i = 0; i < number_of_solids_; ++i) {
     // Getting solid  and label (for GGEMSVoxelizedSolid) data infos
     cl::Buffer* solid_data = solids_[i]->GetSolidData(thread_index);
@@ -465,6 +553,8 @@ void GGEMSNavigator::TrackThroughSolid(GGsize const& thread_index)
     cl::Buffer* hit_tracking_dosimetry = nullptr;
     cl::Buffer* edep_tracking_dosimetry = nullptr;
     cl::Buffer* edep_squared_tracking_dosimetry = nullptr;
+    cl::Buffer* edep_history_tracking_dosimetry = nullptr;
+    cl::Buffer* last_history_id_dosimetry = nullptr;
     cl::Buffer* dosimetry_params = nullptr;
 
     if (data_reg_type == "HISTOGRAM") {
@@ -477,10 +567,13 @@ void GGEMSNavigator::TrackThroughSolid(GGsize const& thread_index)
       hit_tracking_dosimetry = dose_calculator_->GetHitTrackingBuffer(thread_index);
       edep_tracking_dosimetry = dose_calculator_->GetEdepBuffer(thread_index);
       edep_squared_tracking_dosimetry = dose_calculator_->GetEdepSquaredBuffer(thread_index);
+      edep_history_tracking_dosimetry = dose_calculator_->GetEdepHistoryBuffer(thread_index);
+      last_history_id_dosimetry = dose_calculator_->GetLastHistoryIDBuffer(thread_index);
     }
 
     // Getting kernel, and setting parameters
     cl::Kernel* kernel = solids_[i]->GetKernelTrackThroughSolid(thread_index);
+    opencl_manager.PrepareKernel(kernel);
     kernel->setArg(0, number_of_particles);
     kernel->setArg(1, *primary_particles);
     kernel->setArg(2, *randoms);
@@ -507,8 +600,17 @@ void GGEMSNavigator::TrackThroughSolid(GGsize const& thread_index)
       else kernel->setArg(12, *hit_tracking_dosimetry);
       if (!photon_tracking_dosimetry) kernel->setArg(13, sizeof(cl_mem), nullptr);
       else kernel->setArg(13, *photon_tracking_dosimetry);
+
+      if (!edep_history_tracking_dosimetry) kernel->setArg(14, sizeof(cl_mem), nullptr);
+      else kernel->setArg(14, *edep_history_tracking_dosimetry);
+      if (!last_history_id_dosimetry) kernel->setArg(15, sizeof(cl_mem), nullptr);
+      else kernel->setArg(15, *last_history_id_dosimetry);
+      kernel->setArg(16, dose_calculator_->GetHistoryOffset(thread_index));
     }
 
+    // Phase space is the last argument of kernel
+    if (phase_space_) kernel->setArg(data_reg_type == "DOSIMETRY" ? 17 : 9, *phase_space_->GetPhaseSpaceParticles(thread_index));
+
     // Launching kernel
     cl::Event event;
     GGint kernel_status = queue->enqueueNDRangeKernel(*kernel, 0, global_wi, local_wi, nullptr, &event);
@@ -516,7 +618,6 @@ void GGEMSNavigator::TrackThroughSolid(GGsize const& thread_index)
 
     // GGEMS Profiling
     GGEMSProfilerManager::GetInstance().HandleEvent(event, oss.str());
-    queue->finish();
   }
 }
 
@@ -533,6 +634,29 @@ void GGEMSNavigator::ComputeDose(GGsize const& thread_index)
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+void GGEMSNavigator::CountHistories(GGsize const& thread_index, GGsize const& number_of_histories)
+{
+  if (is_dosimetry_mode_) dose_calculator_->CountHistories(thread_index, number_of_histories);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSNavigator::StorePhaseSpace(GGsize const& thread_index)
+{
+  if (!phase_space_) return;
+
+  GGEMSSourceManager& source_manager = GGEMSSourceManager::GetInstance();
+  GGsize number_of_particles = source_manager.GetParticles()->GetNumberOfParticles(thread_index);
+
+  phase_space_->StoreParticles(thread_index, number_of_particles);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 void GGEMSNavigator::PrintInfos(void) const
 {
   GGcout("GGEMSNavigator", "PrintInfos", 0) << GGendl;
@@ -31,6 +31,7 @@
 #include "GGEMS/physics/GGEMSRangeCutsManager.hh"
 #include "GGEMS/geometries/GGEMSSolid.hh"
 #include "GGEMS/sources/GGEMSSourceManager.hh"
+#include "GGEMS/tools/GGEMSProfilerManager.hh"
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
@@ -39,7 +40,10 @@
 GGEMSNavigatorManager::GGEMSNavigatorManager(void)
 : navigators_(nullptr),
   number_of_navigators_(0),
-  world_(nullptr)
+  world_(nullptr),
+  mother_volumes_(nullptr),
+  number_of_mother_volumes_(0),
+  kernel_prepare_project_to_solid_(nullptr)
 {
   GGcout("GGEMSNavigatorManager", "GGEMSNavigatorManager", 3) << "GGEMSNavigatorManager creating..." << GGendl;
 
@@ -59,6 +63,16 @@ GGEMSNavigatorManager::~GGEMSNavigatorManager(void)
     navigators_ = nullptr;
   }
 
+  if (mother_volumes_) {
+    delete[] mother_volumes_;
+    mother_volumes_ = nullptr;
+  }
+
+  if (kernel_prepare_project_to_solid_) {
+    delete[] kernel_prepare_project_to_solid_;
+    kernel_prepare_project_to_solid_ = nullptr;
+  }
+
   GGcout("GGEMSNavigatorManager", "~GGEMSNavigatorManager", 3) << "GGEMSNavigatorManager erased!!!" << GGendl;
 }
 
@@ -117,6 +131,33 @@ void GGEMSNavigatorManager::StoreWorld(GGEMSWorld* world)
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+void GGEMSNavigatorManager::StoreMotherVolume(GGEMSMotherVolume* mother_volume)
+{
+  GGcout("GGEMSNavigatorManager", "StoreMotherVolume", 3) << "Storing new mother volume in GGEMS..." << GGendl;
+
+  if (number_of_mother_volumes_ == 0) {
+    mother_volumes_ = new GGEMSMotherVolume*[1];
+    mother_volumes_[0] = mother_volume;
+  }
+  else {
+    GGEMSMotherVolume** tmp = new GGEMSMotherVolume*[number_of_mother_volumes_+1];
+    for (GGsize i = 0; i < number_of_mother_volumes_; ++i) {
+      tmp[i] = mother_volumes_[i];
+    }
+
+    tmp[number_of_mother_volumes_] = mother_volume;
+
+    delete[] mother_volumes_;
+    mother_volumes_ = tmp;
+  }
+
+  number_of_mother_volumes_++;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 void GGEMSNavigatorManager::SaveResults(void) const
 {
   for (GGsize i = 0; i < number_of_navigators_; ++i) {
@@ -131,7 +172,7 @@ void GGEMSNavigatorManager::SaveResults(void) const
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
-void GGEMSNavigatorManager::Initialize(bool const& is_tracking) const
+void GGEMSNavigatorManager::Initialize(bool const& is_tracking)
 {
   GGcout("GGEMSNavigatorManager", "Initialize", 3) << "Initializing the GGEMS navigator(s)..." << GGendl;
 
@@ -152,6 +193,53 @@ void GGEMSNavigatorManager::Initialize(bool const& is_tracking) const
     if (is_tracking) navigators_[i]->EnableTracking();
     navigators_[i]->Initialize();
   }
+
+  // Solid index of mother volumes after solids of navigators, all indices set before initialization because daughter mother volumes need the index of their mother
+  GGsize number_of_registered_solids = GetNumberOfRegisteredSolids();
+  for (GGsize i = 0; i < number_of_mother_volumes_; ++i) {
+    mother_volumes_[i]->SetSolidID(static_cast<GGint>(number_of_registered_solids + i));
+  }
+
+  // Initialization of mother volumes
+  for (GGsize i = 0; i < number_of_mother_volumes_; ++i) {
+    if (is_tracking) mother_volumes_[i]->EnableTracking();
+    mother_volumes_[i]->Initialize();
+  }
+
+  // Kernel killing particles without solid, shared by all navigators
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+  std::string openCL_kernel_path = OPENCL_KERNEL_PATH;
+  std::string prepare_project_to_filename = openCL_kernel_path + "/PrepareProjectToSolid.cl";
+  if (!kernel_prepare_project_to_solid_) kernel_prepare_project_to_solid_ = new cl::Kernel*[opencl_manager.GetNumberOfActivatedDevice()];
+  opencl_manager.CompileKernel(prepare_project_to_filename, "prepare_project_to_solid", kernel_prepare_project_to_solid_, nullptr, nullptr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+GGfloat GGEMSNavigatorManager::GetMinimumEnergyCut(void) const
+{
+  if (number_of_navigators_ == 0) return 0.0f;
+
+  GGfloat minimum_energy_cut = navigators_[0]->GetMinimumEnergyCut();
+  for (GGsize i = 1; i < number_of_navigators_; ++i) {
+    GGfloat energy_cut = navigators_[i]->GetMinimumEnergyCut();
+    if (energy_cut < minimum_energy_cut) minimum_energy_cut = energy_cut;
+  }
+
+  return minimum_energy_cut;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSNavigatorManager::UpdateMotionPhase(GGsize const& thread_index, GGsize const& batch_index, GGsize const& number_of_batchs) const
+{
+  for (GGsize i = 0; i < number_of_navigators_; ++i) {
+    navigators_[i]->UpdateMotionPhase(thread_index, batch_index, number_of_batchs);
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -166,6 +254,10 @@ void GGEMSNavigatorManager::PrintInfos(void) const
   for (GGsize i = 0; i < number_of_navigators_; ++i) {
     navigators_[i]->PrintInfos();
   }
+
+  for (GGsize i = 0; i < number_of_mother_volumes_; ++i) {
+    mother_volumes_[i]->PrintInfos();
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -177,6 +269,11 @@ void GGEMSNavigatorManager::FindSolid(GGsize const& thread_index) const
   for (GGsize i = 0; i < number_of_navigators_; ++i) {
     navigators_[i]->ParticleSolidDistance(thread_index);
   }
+
+  // Boundaries of mother volumes
+  for (GGsize i = 0; i < number_of_mother_volumes_; ++i) {
+    mother_volumes_[i]->ParticleSolidDistance(thread_index);
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -185,9 +282,54 @@ void GGEMSNavigatorManager::FindSolid(GGsize const& thread_index) const
 
 void GGEMSNavigatorManager::ProjectToSolid(GGsize const& thread_index) const
 {
+  // Particles without solid are killed once on the command queue, projection kernels of navigators then write only particles of their own solid
+  if (kernel_prepare_project_to_solid_) {
+    GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+    cl::CommandQueue* queue = opencl_manager.GetCommandQueue(thread_index);
+
+    // Get Device name and storing methode name + device
+    GGsize device_index = opencl_manager.GetIndexOfActivatedDevice(thread_index);
+    std::string device_name = opencl_manager.GetDeviceName(device_index);
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "GGEMSNavigatorManager::ProjectToSolid on " << device_name << ", index " << device_index;
+
+    // Pointer to primary particles, and number to particles in buffer
+    GGEMSSourceManager& source_manager = GGEMSSourceManager::GetInstance();
+    cl::Buffer* primary_particles = source_manager.GetParticles()->GetPrimaryParticles(thread_index);
+    GGsize number_of_particles = source_manager.GetParticles()->GetNumberOfParticles(thread_index);
+
+    // Parameters for work-item in kernel
+    cl::NDRange global_wi(opencl_manager.GetBestWorkItem(number_of_particles));
+    cl::NDRange local_wi(opencl_manager.GetWorkGroupSize());
+
+    // Getting kernel, and setting parameters
+    cl::Kernel* kernel = kernel_prepare_project_to_solid_[thread_index];
+    opencl_manager.PrepareKernel(kernel);
+    kernel->setArg(0, number_of_particles);
+    kernel->setArg(1, *primary_particles);
+
+    // Launching kernel, finished before projection kernels on navigation queues
+    cl::Event event;
+    GGint kernel_status = queue->enqueueNDRangeKernel(*kernel, 0, global_wi, local_wi, nullptr, &event);
+    opencl_manager.CheckOpenCLError(kernel_status, "GGEMSNavigatorManager", "ProjectToSolid");
+    queue->finish();
+
+    // GGEMS Profiling
+    GGEMSProfilerManager::GetInstance().HandleEvent(event, oss.str());
+  }
+
+  // Navigator kernels are independent, they are launched on navigation queues and run concurrently if the device allows it
   for (GGsize i = 0; i < number_of_navigators_; ++i) {
     navigators_[i]->ProjectToSolid(thread_index);
   }
+
+  // Barrier, mother volumes and tracking kernels need all particles projected
+  GGEMSOpenCLManager::GetInstance().FinishNavigationQueues(thread_index);
+
+  // Crossing boundaries of mother volumes after the kernel killing particles without solid, a particle projected to a mother volume boundary is reset to no solid
+  for (GGsize i = 0; i < number_of_mother_volumes_; ++i) {
+    mother_volumes_[i]->ProjectToSolid(thread_index);
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -199,6 +341,9 @@ void GGEMSNavigatorManager::TrackThroughSolid(GGsize const& thread_index) const
   for (GGsize i = 0; i < number_of_navigators_; ++i) {
     navigators_[i]->TrackThroughSolid(thread_index);
   }
+
+  // Barrier before next search of closest solid
+  GGEMSOpenCLManager::GetInstance().FinishNavigationQueues(thread_index);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -221,3 +366,25 @@ void GGEMSNavigatorManager::ComputeDose(GGsize const& thread_index)
     navigators_[i]->ComputeDose(thread_index);
   }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSNavigatorManager::CountHistories(GGsize const& thread_index, GGsize const& number_of_histories)
+{
+  for (GGsize i = 0; i < number_of_navigators_; ++i) {
+    navigators_[i]->CountHistories(thread_index, number_of_histories);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSNavigatorManager::StorePhaseSpace(GGsize const& thread_index) const
+{
+  for (GGsize i = 0; i < number_of_navigators_; ++i) {
+    navigators_[i]->StorePhaseSpace(thread_index);
+  }
+}
@@ -30,6 +30,8 @@
 #include "GGEMS/navigators/GGEMSSystem.hh"
 #include "GGEMS/geometries/GGEMSSolid.hh"
 #include "GGEMS/io/GGEMSMHDImage.hh"
+#include "GGEMS/io/GGEMSSinogram.hh"
+#include "GGEMS/physics/GGEMSScatterHistory.hh"
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
@@ -57,6 +59,11 @@ GGEMSSystem::GGEMSSystem(std::string const& system_name)
   global_system_position_xyz_.s[1] = 0.0f;
   global_system_position_xyz_.s[2] = 0.0f;
 
+  sinogram_ = nullptr;
+  number_of_views_ = 0;
+  view_angle_ = 0.0f;
+  table_position_ = 0.0f;
+
   GGcout("GGEMSSystem", "GGEMSSystem", 3) << "GGEMSSystem created!!!" << GGendl;
 }
 
@@ -68,6 +75,12 @@ GGEMSSystem::~GGEMSSystem(void)
 {
   GGcout("GGEMSSystem", "~GGEMSSystem", 3) << "GGEMSSystem erasing..." << GGendl;
 
+  // Waiting for pending views and closing sinogram file
+  if (sinogram_) {
+    delete sinogram_;
+    sinogram_ = nullptr;
+  }
+
   GGcout("GGEMSSystem", "~GGEMSSystem", 3) << "GGEMSSystem erased!!!" << GGendl;
 }
 
@@ -171,95 +184,200 @@ void GGEMSSystem::CheckParameters(void) const
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
-void GGEMSSystem::SaveResults(void)
+void GGEMSSystem::SetSinogram(GGsize const& number_of_views)
 {
-  GGcout("GGEMSSystem", "SaveResults", 2) << "Saving results in MHD format..." << GGendl;
+  number_of_views_ = number_of_views;
+}
 
-  GGsize3 total_dim;
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSystem::SetView(GGfloat const& view_angle, GGfloat const& table_position, std::string const& angle_unit, std::string const& distance_unit)
+{
+  view_angle_ = AngleUnit(view_angle, angle_unit);
+  table_position_ = DistanceUnit(table_position, distance_unit);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSystem::GetDetectorCounts(GGint* output, bool const& is_scatter_counts, bool const& is_reset)
+{
+  GGsize2 total_dim;
   total_dim.x_ = number_of_modules_xy_.x_*number_of_detection_elements_inside_module_xyz_.x_;
   total_dim.y_ = number_of_modules_xy_.y_*number_of_detection_elements_inside_module_xyz_.y_;
-  total_dim.z_ = number_of_detection_elements_inside_module_xyz_.z_;
 
-  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
-  GGint* output = new GGint[total_dim.x_*total_dim.y_*total_dim.z_];
-  std::memset(output, 0, total_dim.x_*total_dim.y_*total_dim.z_*sizeof(GGint));
+  // Layout of solids in detector, a single solid (solid arc for curved CT) stores all the modules
+  GGsize2 solid_number_xy;
+  solid_number_xy.x_ = number_of_solids_ == 1 ? 1 : number_of_modules_xy_.x_;
+  solid_number_xy.y_ = number_of_solids_ == 1 ? 1 : number_of_modules_xy_.y_;
 
-  GGEMSMHDImage mhdImage;
-  mhdImage.SetOutputFileName(output_basename_);
-  mhdImage.SetDataType("MET_INT");
-  mhdImage.SetDimensions(total_dim);
-  mhdImage.SetElementSizes(size_of_detection_elements_xyz_);
+  GGsize2 element_number_xy;
+  element_number_xy.x_ = total_dim.x_ / solid_number_xy.x_;
+  element_number_xy.y_ = total_dim.y_ / solid_number_xy.y_;
+
+  // Scatter histograms store a channel per scatter category
+  GGsize number_of_channels = is_scatter_counts ? NUMBER_OF_SCATTER_CATEGORIES : 1;
+  GGsize element_channel_size = element_number_xy.x_*element_number_xy.y_;
+  GGsize total_channel_size = total_dim.x_*total_dim.y_;
+
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
 
   // Getting all the counts from solid from all OpenCL devices
   for (GGsize i = 0; i < number_activated_devices_; ++i) {
-    for (GGsize jj = 0; jj < number_of_modules_xy_.y_; ++jj) {
-      for (GGsize ii = 0; ii < number_of_modules_xy_.x_; ++ii) {
-        cl::Buffer* histogram = solids_[ii + jj* number_of_modules_xy_.x_]->GetHistogram(i);
+    for (GGsize jj = 0; jj < solid_number_xy.y_; ++jj) {
+      for (GGsize ii = 0; ii < solid_number_xy.x_; ++ii) {
+        GGEMSSolid* solid = solids_[ii + jj*solid_number_xy.x_];
+        cl::Buffer* histogram = is_scatter_counts ? solid->GetScatterHistogram(i) : solid->GetHistogram(i);
 
-        GGint* histogram_device = opencl_manager.GetDeviceBuffer<GGint>(histogram, CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, number_of_detection_elements_inside_module_xyz_.x_*number_of_detection_elements_inside_module_xyz_.y_*sizeof(GGint), i);
+        GGint* histogram_device = opencl_manager.GetDeviceBuffer<GGint>(histogram, CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, number_of_channels*element_channel_size*sizeof(GGint), i);
 
         // Storing data on host
-        for (GGsize jjj = 0; jjj < number_of_detection_elements_inside_module_xyz_.y_; ++jjj) {
-          for (GGsize iii = 0; iii < number_of_detection_elements_inside_module_xyz_.x_; ++iii) {
-            output[(iii+ii*number_of_detection_elements_inside_module_xyz_.x_) + (jjj+jj*number_of_detection_elements_inside_module_xyz_.y_)*total_dim.x_] +=
-              histogram_device[iii + jjj*number_of_detection_elements_inside_module_xyz_.x_];
+        for (GGsize c = 0; c < number_of_channels; ++c) {
+          for (GGsize jjj = 0; jjj < element_number_xy.y_; ++jjj) {
+            for (GGsize iii = 0; iii < element_number_xy.x_; ++iii) {
+              output[(iii+ii*element_number_xy.x_) + (jjj+jj*element_number_xy.y_)*total_dim.x_ + c*total_channel_size] +=
+                histogram_device[iii + jjj*element_number_xy.x_ + c*element_channel_size];
+            }
           }
         }
 
         opencl_manager.ReleaseDeviceBuffer(histogram, histogram_device, i);
+
+        // Starting next view from empty histogram
+        if (is_reset) opencl_manager.CleanBuffer(histogram, number_of_channels*element_channel_size*sizeof(GGint), i);
       }
     }
   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSystem::SaveResults(void)
+{
+  GGsize3 total_dim;
+  total_dim.x_ = number_of_modules_xy_.x_*number_of_detection_elements_inside_module_xyz_.x_;
+  total_dim.y_ = number_of_modules_xy_.y_*number_of_detection_elements_inside_module_xyz_.y_;
+  total_dim.z_ = number_of_detection_elements_inside_module_xyz_.z_;
+
+  // Sinogram, the view is appended to sinogram file and histograms are reset for next view
+  if (number_of_views_ > 0) {
+    GGcout("GGEMSSystem", "SaveResults", 2) << "Saving view in sinogram..." << GGendl;
+
+    if (!sinogram_) {
+      // From output file replace '.mhd' by '.sino' extension
+      std::string sinogram_filename = output_basename_;
+      GGsize found_mhd = output_basename_.find(".mhd");
+      if (found_mhd != std::string::npos) sinogram_filename = sinogram_filename.substr(0, found_mhd);
+      sinogram_filename += ".sino";
+
+      GGsize2 sinogram_dim;
+      sinogram_dim.x_ = total_dim.x_;
+      sinogram_dim.y_ = total_dim.y_;
+
+      sinogram_ = new GGEMSSinogram();
+      sinogram_->Open(sinogram_filename, number_of_views_, sinogram_dim, size_of_detection_elements_xyz_, is_scatter_ ? NUMBER_OF_SCATTER_CATEGORIES : 0);
+    }
+
+    // Buffers are owned by sinogram writer thread after appending
+    GGint* histogram = new GGint[total_dim.x_*total_dim.y_];
+    std::memset(histogram, 0, total_dim.x_*total_dim.y_*sizeof(GGint));
+    GetDetectorCounts(histogram, false, true);
+
+    GGint* scatter = nullptr;
+    if (is_scatter_) {
+      scatter = new GGint[NUMBER_OF_SCATTER_CATEGORIES*total_dim.x_*total_dim.y_];
+      std::memset(scatter, 0, NUMBER_OF_SCATTER_CATEGORIES*total_dim.x_*total_dim.y_*sizeof(GGint));
+      GetDetectorCounts(scatter, true, true);
+    }
+
+    sinogram_->AppendView(view_angle_, table_position_, histogram, scatter);
+    return;
+  }
+
+  GGcout("GGEMSSystem", "SaveResults", 2) << "Saving results in MHD format..." << GGendl;
 
-  mhdImage.Write<GGint>(output);
+  GGsize channel_size = total_dim.x_*total_dim.y_;
 
-  // Cleaning output buffer
+  GGint* output = new GGint[total_dim.x_*total_dim.y_*total_dim.z_];
   std::memset(output, 0, total_dim.x_*total_dim.y_*total_dim.z_*sizeof(GGint));
 
+  GetDetectorCounts(output, false, false);
+
+  WriteDetectorImage(output, "");
+
   // If scatter output if necessary
   if (is_scatter_) {
-    // From output file add '-scatter' extension
-    std::string scatter_output_filename = output_basename_;
+    GGint* scatter = new GGint[NUMBER_OF_SCATTER_CATEGORIES*channel_size];
+    std::memset(scatter, 0, NUMBER_OF_SCATTER_CATEGORIES*channel_size*sizeof(GGint));
 
-    // Checking if there is .mhd suffix
-    GGsize found_mhd = output_basename_.find(".mhd");
+    GetDetectorCounts(scatter, true, false);
 
-    if (found_mhd == std::string::npos) { // "add '-scatter.mhd' at the end of file"
-      scatter_output_filename += "-scatter.mhd";
+    // Primary photons are detected photons minus scattered photons
+    for (GGsize i = 0; i < channel_size; ++i) {
+      for (GGsize c = 0; c < NUMBER_OF_SCATTER_CATEGORIES; ++c) output[i] -= scatter[i + c*channel_size];
     }
-    else { // If suffix found, add '-scatter' between end of filename and suffix
-      scatter_output_filename = scatter_output_filename.substr(0, found_mhd) + "-scatter.mhd";
+
+    WriteDetectorImage(output, "-primary");
+
+    // Total scatter from all scatter categories
+    for (GGsize i = 0; i < channel_size; ++i) {
+      output[i] = 0;
+      for (GGsize c = 0; c < NUMBER_OF_SCATTER_CATEGORIES; ++c) output[i] += scatter[i + c*channel_size];
     }
 
-    GGEMSMHDImage mhdImageScatter;
-    mhdImageScatter.SetOutputFileName(scatter_output_filename);
-    mhdImageScatter.SetDataType("MET_INT");
-    mhdImageScatter.SetDimensions(total_dim);
-    mhdImageScatter.SetElementSizes(size_of_detection_elements_xyz_);
-
-    // Getting all the counts from solid from all OpenCL devices
-    for (GGsize i = 0; i < number_activated_devices_; ++i) {
-      for (GGsize jj = 0; jj < number_of_modules_xy_.y_; ++jj) {
-        for (GGsize ii = 0; ii < number_of_modules_xy_.x_; ++ii) {
-          cl::Buffer* scatter_histogram = solids_[ii + jj* number_of_modules_xy_.x_]->GetScatterHistogram(i);
-
-          GGint* scatter_histogram_device = opencl_manager.GetDeviceBuffer<GGint>(scatter_histogram, CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, number_of_detection_elements_inside_module_xyz_.x_*number_of_detection_elements_inside_module_xyz_.y_*sizeof(GGint), i);
-
-          // Storing data on host
-          for (GGsize jjj = 0; jjj < number_of_detection_elements_inside_module_xyz_.y_; ++jjj) {
-            for (GGsize iii = 0; iii < number_of_detection_elements_inside_module_xyz_.x_; ++iii) {
-              output[(iii+ii*number_of_detection_elements_inside_module_xyz_.x_) + (jjj+jj*number_of_detection_elements_inside_module_xyz_.y_)*total_dim.x_] +=
-                scatter_histogram_device[iii + jjj*number_of_detection_elements_inside_module_xyz_.x_];
-            }
-          }
+    WriteDetectorImage(output, "-scatter");
 
-          opencl_manager.ReleaseDeviceBuffer(scatter_histogram, scatter_histogram_device, i);
-        }
-      }
+    // A file per scatter category
+    std::string scatter_suffixes[NUMBER_OF_SCATTER_CATEGORIES];
+    scatter_suffixes[SINGLE_COMPTON] = "-single-compton";
+    scatter_suffixes[SINGLE_RAYLEIGH] = "-single-rayleigh";
+    scatter_suffixes[MULTIPLE_SCATTER] = "-multiple-scatter";
+
+    for (GGsize c = 0; c < NUMBER_OF_SCATTER_CATEGORIES; ++c) {
+      std::memcpy(output, &scatter[c*channel_size], channel_size*sizeof(GGint));
+      WriteDetectorImage(output, scatter_suffixes[c]);
     }
 
-    mhdImageScatter.Write<GGint>(output);
+    delete[] scatter;
   }
 
   delete[] output;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSSystem::WriteDetectorImage(GGint* counts, std::string const& suffix) const
+{
+  GGsize3 total_dim;
+  total_dim.x_ = number_of_modules_xy_.x_*number_of_detection_elements_inside_module_xyz_.x_;
+  total_dim.y_ = number_of_modules_xy_.y_*number_of_detection_elements_inside_module_xyz_.y_;
+  total_dim.z_ = number_of_detection_elements_inside_module_xyz_.z_;
+
+  // From output file add suffix
+  std::string output_filename = output_basename_;
+
+  // Checking if there is .mhd suffix
+  GGsize found_mhd = output_basename_.find(".mhd");
+
+  if (found_mhd == std::string::npos) { // "add suffix and '.mhd' at the end of file"
+    output_filename += suffix + ".mhd";
+  }
+  else { // If suffix found, add suffix between end of filename and '.mhd'
+    output_filename = output_filename.substr(0, found_mhd) + suffix + ".mhd";
+  }
+
+  GGEMSMHDImage mhdImage;
+  mhdImage.SetOutputFileName(output_filename);
+  mhdImage.SetDataType("MET_INT");
+  mhdImage.SetDimensions(total_dim);
+  mhdImage.SetElementSizes(size_of_detection_elements_xyz_);
+
+  mhdImage.Write<GGint>(counts);
+}
@@ -32,6 +32,7 @@
 #include "GGEMS/navigators/GGEMSDoseParams.hh"
 #include "GGEMS/geometries/GGEMSVoxelizedSolid.hh"
 #include "GGEMS/io/GGEMSMHDImage.hh"
+#include "GGEMS/io/GGEMSPhaseSpace.hh"
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
@@ -40,7 +41,10 @@
 GGEMSVoxelizedPhantom::GGEMSVoxelizedPhantom(std::string const& voxelized_phantom_name)
 : GGEMSNavigator(voxelized_phantom_name),
   voxelized_phantom_filename_(""),
-  range_data_filename_("")
+  range_data_filename_(""),
+  phase_space_filename_(""),
+  motion_phase_(0),
+  number_of_motion_cycles_(0.0f)
 {
   GGcout("GGEMSVoxelizedPhantom", "GGEMSVoxelizedPhantom", 3) << "GGEMSVoxelizedPhantom creating..." << GGendl;
 
@@ -79,6 +83,19 @@ void GGEMSVoxelizedPhantom::CheckParameters(void) const
     oss << "You have to set a file with the range to material data!!!";
     GGEMSMisc::ThrowException("GGEMSVoxelizedPhantom", "CheckParameters", oss.str());
   }
+
+  // Checking the motion phase
+  if (motion_phase_ > motion_phase_filenames_.size()) {
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "Motion phase " << motion_phase_ << " does not exist, number of motion phases: " << motion_phase_filenames_.size() + 1 << "!!!";
+    GGEMSMisc::ThrowException("GGEMSVoxelizedPhantom", "CheckParameters", oss.str());
+  }
+
+  if (number_of_motion_cycles_ < 0.0f) {
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "Number of motion cycles must be positive!!!";
+    GGEMSMisc::ThrowException("GGEMSVoxelizedPhantom", "CheckParameters", oss.str());
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -115,6 +132,29 @@ void GGEMSVoxelizedPhantom::Initialize(void)
   // Enabling TLE
   if (is_tle_) solids_[0]->AddKernelOption(" -DTLE");
 
+  // Enabling CSDA deposition of secondary electrons, TLE already accounts for electron energy
+  if (is_csda_) {
+    if (is_tle_) {
+      GGwarn("GGEMSVoxelizedPhantom", "Initialize", 0) << "CSDA deposition of secondary electrons is ignored with TLE" << GGendl;
+    }
+    else {
+      solids_[0]->AddKernelOption(" -DCSDA");
+    }
+  }
+
+  // Recording particles exiting phantom
+  if (!phase_space_filename_.empty()) {
+    phase_space_ = new GGEMSPhaseSpace();
+    phase_space_->OpenForWriting(phase_space_filename_);
+    solids_[0]->AddKernelOption(" -DPHASE_SPACE");
+  }
+
+  // Motion phases (4D phantom) share materials and tables of first phase
+  GGEMSVoxelizedSolid* voxelized_solid = dynamic_cast<GGEMSVoxelizedSolid*>(solids_[0]);
+  for (GGsize i = 0; i < motion_phase_filenames_.size(); ++i) {
+    voxelized_solid->AddMotionPhase(motion_phase_filenames_[i], motion_phase_translations_[i]);
+  }
+
   // Load voxelized phantom from MHD file and storing materials
   solids_[0]->Initialize(materials_);
   solids_[0]->SetCustomMaterialColor(custom_material_rgb_);
@@ -135,6 +175,8 @@ void GGEMSVoxelizedPhantom::Initialize(void)
     solids_[0]->SetSolidID<GGEMSVoxelizedSolidData>(number_of_registered_solids, j);
     // Store the transformation matrix in solid object
     solids_[0]->UpdateTransformationMatrix(j);
+    // Selected motion phase
+    voxelized_solid->SetMotionPhase(motion_phase_, j);
   }
 
   #ifdef OPENGL_VISUALIZATION
@@ -161,6 +203,21 @@ void GGEMSVoxelizedPhantom::SaveResults(void)
     // Compute dose and save results
     dose_calculator_->SaveResults();
   }
+
+  if (phase_space_) {
+    GGcout("GGEMSVoxelizedPhantom", "SaveResults", 2) << "Closing phase space..." << GGendl;
+
+    phase_space_->Close();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+GGfloat GGEMSVoxelizedPhantom::GetMinimumEnergyCut(void) const
+{
+  return materials_->GetMinimumPhotonEnergyCut();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -177,6 +234,97 @@ void GGEMSVoxelizedPhantom::SetPhantomFile(std::string const& voxelized_phantom_
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+void GGEMSVoxelizedPhantom::SetPhaseSpace(std::string const& phase_space_filename)
+{
+  phase_space_filename_ = phase_space_filename;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSVoxelizedPhantom::AddMotionPhase(std::string const& voxelized_phantom_filename, GGfloat const& tx, GGfloat const& ty, GGfloat const& tz, std::string const& unit)
+{
+  GGfloat3 translation_xyz;
+  translation_xyz.s[0] = DistanceUnit(tx, unit);
+  translation_xyz.s[1] = DistanceUnit(ty, unit);
+  translation_xyz.s[2] = DistanceUnit(tz, unit);
+
+  motion_phase_filenames_.push_back(voxelized_phantom_filename);
+  motion_phase_translations_.push_back(translation_xyz);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSVoxelizedPhantom::SetMotionPhase(GGsize const& motion_phase)
+{
+  motion_phase_ = motion_phase;
+
+  // Phantom already initialized, phase is changed for the next run
+  if (solids_) {
+    GGEMSVoxelizedSolid* voxelized_solid = dynamic_cast<GGEMSVoxelizedSolid*>(solids_[0]);
+    for (GGsize j = 0; j < number_activated_devices_; ++j) voxelized_solid->SetMotionPhase(motion_phase_, j);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSVoxelizedPhantom::SetMotionCycles(GGfloat const& number_of_cycles)
+{
+  number_of_motion_cycles_ = number_of_cycles;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSVoxelizedPhantom::UpdateMotionPhase(GGsize const& thread_index, GGsize const& batch_index, GGsize const& number_of_batchs)
+{
+  if (number_of_motion_cycles_ == 0.0f || motion_phase_filenames_.empty()) return;
+
+  // Time of the batch in the run, batchs are uniformly distributed in time
+  GGsize number_of_motion_phases = motion_phase_filenames_.size() + 1;
+  GGfloat batch_time = (static_cast<GGfloat>(batch_index) + 0.5f) / static_cast<GGfloat>(number_of_batchs);
+  GGsize motion_phase = static_cast<GGsize>(batch_time * number_of_motion_cycles_ * static_cast<GGfloat>(number_of_motion_phases)) % number_of_motion_phases;
+
+  dynamic_cast<GGEMSVoxelizedSolid*>(solids_[0])->SetMotionPhase(motion_phase, thread_index);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void add_motion_phase_ggems_voxelized_phantom(GGEMSVoxelizedPhantom* voxelized_phantom, char const* phantom_filename, GGfloat const tx, GGfloat const ty, GGfloat const tz, char const* unit)
+{
+  voxelized_phantom->AddMotionPhase(phantom_filename, tx, ty, tz, unit);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void set_motion_phase_ggems_voxelized_phantom(GGEMSVoxelizedPhantom* voxelized_phantom, GGsize const motion_phase)
+{
+  voxelized_phantom->SetMotionPhase(motion_phase);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void set_motion_cycles_ggems_voxelized_phantom(GGEMSVoxelizedPhantom* voxelized_phantom, GGfloat const number_of_cycles)
+{
+  voxelized_phantom->SetMotionCycles(number_of_cycles);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 GGEMSVoxelizedPhantom* create_ggems_voxelized_phantom(char const* voxelized_phantom_name)
 {
   return new(std::nothrow) GGEMSVoxelizedPhantom(voxelized_phantom_name);
@@ -195,6 +343,15 @@ void set_phantom_file_ggems_voxelized_phantom(GGEMSVoxelizedPhantom* voxelized_p
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+void set_phase_space_ggems_voxelized_phantom(GGEMSVoxelizedPhantom* voxelized_phantom, char const* phase_space_filename)
+{
+  voxelized_phantom->SetPhaseSpace(phase_space_filename);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 void set_position_ggems_voxelized_phantom(GGEMSVoxelizedPhantom* voxelized_phantom, GGfloat const position_x, GGfloat const position_y, GGfloat const position_z, char const* unit)
 {
   voxelized_phantom->SetPosition(position_x, position_y, position_z, unit);
@@ -340,6 +340,7 @@ void GGEMSWorld::Tracking(GGsize const& thread_index)
   cl::NDRange local_wi(work_group_size);
 
   // Getting kernel, and setting parameters
+  opencl_manager.PrepareKernel(kernel_world_tracking_[thread_index]);
   kernel_world_tracking_[thread_index]->setArg(0, number_of_particles);
   kernel_world_tracking_[thread_index]->setArg(0, number_of_particles);
   kernel_world_tracking_[thread_index]->setArg(1, *primary_particles);
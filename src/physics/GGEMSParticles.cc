@@ -40,7 +40,8 @@
 GGEMSParticles::GGEMSParticles(void)
 : number_of_particles_(nullptr),
   primary_particles_(nullptr),
-  kernel_alive_(nullptr)
+  kernel_alive_(nullptr),
+  energy_cut_(0.0f)
 {
   GGcout("GGEMSParticles", "GGEMSParticles", 3) << "GGEMSParticles creating..." << GGendl;
 
@@ -94,6 +95,15 @@ void GGEMSParticles::SetNumberOfParticles(GGsize const& thread_index, GGsize con
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+void GGEMSParticles::SetEnergyCut(GGfloat const& energy_cut)
+{
+  energy_cut_ = energy_cut;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 void GGEMSParticles::InitializeKernel(void)
 {
   GGcout("GGEMSParticles", "InitializeKernel", 3) << "Initializing kernel..." << GGendl;
@@ -164,9 +174,11 @@ bool GGEMSParticles::IsAlive(GGsize const& thread_index) const
   cl::NDRange local_wi(work_group_size);
 
   // Set parameters for kernel
+  opencl_manager.PrepareKernel(kernel_alive_[thread_index]);
   kernel_alive_[thread_index]->setArg(0, number_of_particles_[thread_index]);
   kernel_alive_[thread_index]->setArg(1, *particles);
   kernel_alive_[thread_index]->setArg(2, *status);
+  kernel_alive_[thread_index]->setArg(3, energy_cut_);
 
   // Launching kernel
   cl::Event event;
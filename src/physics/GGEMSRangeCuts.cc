@@ -174,6 +174,9 @@ GGfloat GGEMSRangeCuts::ConvertToEnergy(GGEMSMaterialTables* material_table, GGu
     BuildMaterialLossTable(material_table, index_mat);
   }
 
+  // Range table of electron is kept on device for CSDA deposition of secondary electrons
+  if (particle_name == "e-") StoreElectronCSDARange(material_table, index_mat);
+
   // Convert Range Cut ro Kinetic Energy Cut
   //kinetic_energy_cut = ConvertLengthToEnergyCut(range_table_material_, cut);
   kinetic_energy_cut = ConvertLengthToEnergyCut(cut);
@@ -531,6 +534,22 @@ GGfloat GGEMSRangeCuts::ComputeLossPositron(GGuchar const& atomic_number, GGfloa
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+void GGEMSRangeCuts::StoreElectronCSDARange(GGEMSMaterialTables* material_table, GGushort const& index_mat) const
+{
+  GGfloat log_energy_min = logf(CSDA_RANGE_ENERGY_MIN);
+  GGfloat delta_log_energy = (logf(CSDA_RANGE_ENERGY_MAX) - log_energy_min) / static_cast<GGfloat>(CSDA_RANGE_TABLE_NUMBER_BINS - 1);
+
+  // Range in material from integrated electron loss table, log binning in energy
+  for (GGsize i = 0; i < CSDA_RANGE_TABLE_NUMBER_BINS; ++i) {
+    GGfloat energy = expf(log_energy_min + static_cast<GGfloat>(i)*delta_log_energy);
+    material_table->electron_csda_range_[index_mat*CSDA_RANGE_TABLE_NUMBER_BINS + i] = range_table_material_->GetLossTableValue(energy);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
 GGfloat GGEMSRangeCuts::ConvertLengthToEnergyCut(GGfloat const& length_cut) const
 {
   GGfloat epsilon = 0.01f;
@@ -0,0 +1,275 @@
+// ************************************************************************
+// * This file is part of GGEMS.                                          *
+// *                                                                      *
+// * GGEMS is free software: you can redistribute it and/or modify        *
+// * it under the terms of the GNU General Public License as published by *
+// * the Free Software Foundation, either version 3 of the License, or    *
+// * (at your option) any later version.                                  *
+// *                                                                      *
+// * GGEMS is distributed in the hope that it will be useful,             *
+// * but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+// * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+// * GNU General Public License for more details.                         *
+// *                                                                      *
+// * You should have received a copy of the GNU General Public License    *
+// * along with GGEMS.  If not, see <https://www.gnu.org/licenses/>.      *
+// *                                                                      *
+// ************************************************************************
+
+/*!
+  \file GGEMSPhaseSpaceSource.cc
+
+  \brief This class define a source replaying particles stored in a GGEMS phase space file
+
+  \author Julien BERT <julien.bert@univ-brest.fr>
+  \author Didier BENOIT <didier.benoit@inserm.fr>
+  \author LaTIM, INSERM - U1101, Brest, FRANCE
+  \version 1.0
+  \date Sunday October 18, 2026
+*/
+
+#include "GGEMS/sources/GGEMSPhaseSpaceSource.hh"
+#include "GGEMS/sources/GGEMSSourceManager.hh"
+#include "GGEMS/maths/GGEMSGeometryTransformation.hh"
+#include "GGEMS/global/GGEMSConstants.hh"
+#include "GGEMS/io/GGEMSPhaseSpace.hh"
+#include "GGEMS/tools/GGEMSProfilerManager.hh"
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+GGEMSPhaseSpaceSource::GGEMSPhaseSpaceSource(std::string const& source_name)
+: GGEMSSource(source_name),
+  phase_space_filename_(""),
+  phase_space_(nullptr)
+{
+  GGcout("GGEMSPhaseSpaceSource", "GGEMSPhaseSpaceSource", 3) << "GGEMSPhaseSpaceSource creating..." << GGendl;
+
+  // Particles in phase space are photons stored in global frame, by default the source is not moved
+  particle_type_ = PHOTON;
+  geometry_transformation_->SetTranslation(0.0f, 0.0f, 0.0f);
+  geometry_transformation_->SetRotation(0.0f, 0.0f, 0.0f);
+
+  GGcout("GGEMSPhaseSpaceSource", "GGEMSPhaseSpaceSource", 3) << "GGEMSPhaseSpaceSource created!!!" << GGendl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+GGEMSPhaseSpaceSource::~GGEMSPhaseSpaceSource(void)
+{
+  GGcout("GGEMSPhaseSpaceSource", "~GGEMSPhaseSpaceSource", 3) << "GGEMSPhaseSpaceSource erasing..." << GGendl;
+
+  if (phase_space_) {
+    delete phase_space_;
+    phase_space_ = nullptr;
+  }
+
+  GGcout("GGEMSPhaseSpaceSource", "~GGEMSPhaseSpaceSource", 3) << "GGEMSPhaseSpaceSource erased!!!" << GGendl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSPhaseSpaceSource::InitializeKernel(void)
+{
+  GGcout("GGEMSPhaseSpaceSource", "InitializeKernel", 3) << "Initializing kernel..." << GGendl;
+
+  // Getting the path to kernel
+  std::string openCL_kernel_path = OPENCL_KERNEL_PATH;
+  std::string filename = openCL_kernel_path + "/GetPrimariesGGEMSPhaseSpaceSource.cl";
+
+  // Compiling the kernel
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  // Compiling kernel on each device
+  opencl_manager.CompileKernel(filename, "get_primaries_ggems_phase_space_source", kernel_get_primaries_, nullptr, const_cast<char*>(tracking_kernel_option_.c_str()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSPhaseSpaceSource::GetPrimaries(GGsize const& thread_index, GGsize const& number_of_particles)
+{
+  // Get command queue and event
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+  cl::CommandQueue* queue = opencl_manager.GetCommandQueue(thread_index);
+
+  // Get Device name and storing methode name + device
+  GGsize device_index = opencl_manager.GetIndexOfActivatedDevice(thread_index);
+  std::string device_name = opencl_manager.GetDeviceName(device_index);
+  std::ostringstream oss(std::ostringstream::out);
+  oss << "GGEMSPhaseSpaceSource::GetPrimaries on " << device_name << ", index " << device_index;
+
+  // Loading next particles from phase space file
+  phase_space_->LoadParticles(thread_index, number_of_particles);
+
+  // Get the OpenCL buffers
+  GGEMSSourceManager& source_manager = GGEMSSourceManager::GetInstance();
+  cl::Buffer* particles = source_manager.GetParticles()->GetPrimaryParticles(thread_index);
+  cl::Buffer* phase_space_particles = phase_space_->GetPhaseSpaceParticles(thread_index);
+  cl::Buffer* matrix_transformation = geometry_transformation_->GetTransformationMatrix(thread_index);
+
+  // Getting work group size, and work-item number
+  GGsize work_group_size = opencl_manager.GetWorkGroupSize();
+  GGsize number_of_work_items = opencl_manager.GetBestWorkItem(number_of_particles);
+
+  // Parameters for work-item in kernel
+  cl::NDRange global_wi(number_of_work_items);
+  cl::NDRange local_wi(work_group_size);
+
+  // Set parameters for kernel
+  opencl_manager.PrepareKernel(kernel_get_primaries_[thread_index]);
+  kernel_get_primaries_[thread_index]->setArg(0, number_of_particles);
+  kernel_get_primaries_[thread_index]->setArg(1, *particles);
+  kernel_get_primaries_[thread_index]->setArg(2, *phase_space_particles);
+  kernel_get_primaries_[thread_index]->setArg(3, particle_type_);
+  kernel_get_primaries_[thread_index]->setArg(4, *matrix_transformation);
+
+  // Launching kernel
+  cl::Event event;
+  GGint kernel_status = queue->enqueueNDRangeKernel(*kernel_get_primaries_[thread_index], 0, global_wi, local_wi, nullptr, &event);
+  opencl_manager.CheckOpenCLError(kernel_status, "GGEMSPhaseSpaceSource", "GetPrimaries");
+
+  // GGEMS Profiling
+  GGEMSProfilerManager& profiler_manager = GGEMSProfilerManager::GetInstance();
+  profiler_manager.HandleEvent(event, oss.str());
+  queue->finish();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSPhaseSpaceSource::PrintInfos(void) const
+{
+  // Get the OpenCL manager
+  GGEMSOpenCLManager& opencl_manager = GGEMSOpenCLManager::GetInstance();
+
+  // Loop over each device
+  for (GGsize j = 0; j < number_activated_devices_; ++j) {
+    // Getting index of the device
+    GGsize device_index = opencl_manager.GetIndexOfActivatedDevice(j);
+
+    GGcout("GGEMSPhaseSpaceSource", "PrintInfos", 0) << GGendl;
+    GGcout("GGEMSPhaseSpaceSource", "PrintInfos", 0) << "GGEMSPhaseSpaceSource Infos: " << GGendl;
+    GGcout("GGEMSPhaseSpaceSource", "PrintInfos", 0) << "----------------------------"  << GGendl;
+    GGcout("GGEMSPhaseSpaceSource", "PrintInfos", 0) << "* Device: " << opencl_manager.GetDeviceName(device_index) << GGendl;
+    GGcout("GGEMSPhaseSpaceSource", "PrintInfos", 0) << "* Source name: " << source_name_ << GGendl;
+    GGcout("GGEMSPhaseSpaceSource", "PrintInfos", 0) << "* Phase space file: " << phase_space_filename_ << GGendl;
+    GGcout("GGEMSPhaseSpaceSource", "PrintInfos", 0) << "* Number of particles: " << number_of_particles_by_device_[j] << GGendl;
+    GGcout("GGEMSPhaseSpaceSource", "PrintInfos", 0) << "* Number of batches: " << number_of_batchs_[j] << GGendl;
+    GGcout("GGEMSPhaseSpaceSource", "PrintInfos", 0) << "* Position: " << "(" << geometry_transformation_->GetPosition().s[0]/mm << ", " << geometry_transformation_->GetPosition().s[1]/mm << ", " << geometry_transformation_->GetPosition().s[2]/mm << " ) mm3" << GGendl;
+    GGcout("GGEMSPhaseSpaceSource", "PrintInfos", 0) << "* Rotation: " << "(" << geometry_transformation_->GetRotation().s[0] << ", " << geometry_transformation_->GetRotation().s[1] << ", " << geometry_transformation_->GetRotation().s[2] << ") degree" << GGendl;
+    GGcout("GGEMSPhaseSpaceSource", "PrintInfos", 0) << GGendl;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSPhaseSpaceSource::SetPhaseSpaceFile(std::string const& phase_space_filename)
+{
+  phase_space_filename_ = phase_space_filename;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSPhaseSpaceSource::CheckParameters(void) const
+{
+  GGcout("GGEMSPhaseSpaceSource", "CheckParameters", 3) << "Checking the mandatory parameters..." << GGendl;
+
+  // Checking the phase space file
+  if (phase_space_filename_.empty()) {
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "You have to set a phase space file for the source!!!";
+    GGEMSMisc::ThrowException("GGEMSPhaseSpaceSource", "CheckParameters", oss.str());
+  }
+
+  // Checking the number of particles
+  if (number_of_particles_ > phase_space_->GetNumberOfParticles()) {
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "Only " << phase_space_->GetNumberOfParticles() << " particles are stored in phase space " << phase_space_filename_ << "!!!";
+    GGEMSMisc::ThrowException("GGEMSPhaseSpaceSource", "CheckParameters", oss.str());
+  }
+
+  GGEMSSource::CheckParameters();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void GGEMSPhaseSpaceSource::Initialize(bool const& is_tracking)
+{
+  GGcout("GGEMSPhaseSpaceSource", "Initialize", 3) << "Initializing the GGEMS phase space source..." << GGendl;
+
+  if (phase_space_filename_.empty()) {
+    std::ostringstream oss(std::ostringstream::out);
+    oss << "You have to set a phase space file for the source!!!";
+    GGEMSMisc::ThrowException("GGEMSPhaseSpaceSource", "Initialize", oss.str());
+  }
+
+  // Opening phase space, all particles are replayed by default
+  phase_space_ = new GGEMSPhaseSpace();
+  phase_space_->OpenForReading(phase_space_filename_);
+  if (number_of_particles_ == 0) number_of_particles_ = phase_space_->GetNumberOfParticles();
+
+  // Initialize GGEMS source
+  GGEMSSource::Initialize(is_tracking);
+
+  // Initializing the kernel for OpenCL
+  InitializeKernel();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+GGEMSPhaseSpaceSource* create_ggems_phase_space_source(char const* source_name)
+{
+  return new(std::nothrow) GGEMSPhaseSpaceSource(source_name);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void set_position_ggems_phase_space_source(GGEMSPhaseSpaceSource* phase_space_source, GGfloat const pos_x, GGfloat const pos_y, GGfloat const pos_z, char const* unit)
+{
+  phase_space_source->SetPosition(pos_x, pos_y, pos_z, unit);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void set_rotation_ggems_phase_space_source(GGEMSPhaseSpaceSource* phase_space_source, GGfloat const rx, GGfloat const ry, GGfloat const rz, char const* unit)
+{
+  phase_space_source->SetRotation(rx, ry, rz, unit);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void set_number_of_particles_phase_space_source(GGEMSPhaseSpaceSource* phase_space_source, GGsize const number_of_particles)
+{
+  phase_space_source->SetNumberOfParticles(number_of_particles);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void set_phase_space_file_ggems_phase_space_source(GGEMSPhaseSpaceSource* phase_space_source, char const* phase_space_filename)
+{
+  phase_space_source->SetPhaseSpaceFile(phase_space_filename);
+}
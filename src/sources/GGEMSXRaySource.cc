@@ -163,6 +163,7 @@ void GGEMSXRaySource::GetPrimaries(GGsize const& thread_index, GGsize const& num
   cl::NDRange local_wi(work_group_size);
 
   // Set parameters for kernel
+  opencl_manager.PrepareKernel(kernel_get_primaries_[thread_index]);
   kernel_get_primaries_[thread_index]->setArg(0, number_of_particles);
   kernel_get_primaries_[thread_index]->setArg(1, *particles);
   kernel_get_primaries_[thread_index]->setArg(2, *randoms);
@@ -197,7 +198,7 @@ void GGEMSXRaySource::PrintInfos(void) const
   // Loop over each device
   for (GGsize j = 0; j < number_activated_devices_; ++j) {
     // Get pointer on OpenCL device
-    GGfloat44* transformation_matrix_device = opencl_manager.GetDeviceBuffer<GGfloat44>(geometry_transformation_->GetTransformationMatrix(j), CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGfloat44), j);
+    GGEMSTransformationMatrix* transformation_matrix_device = opencl_manager.GetDeviceBuffer<GGEMSTransformationMatrix>(geometry_transformation_->GetTransformationMatrix(j), CL_TRUE, CL_MAP_WRITE | CL_MAP_READ, sizeof(GGEMSTransformationMatrix), j);
 
     // Getting index of the device
     GGsize device_index = opencl_manager.GetIndexOfActivatedDevice(j);
@@ -232,10 +233,9 @@ void GGEMSXRaySource::PrintInfos(void) const
     GGcout("GGEMSXRaySource", "PrintInfos", 0) << "* Focal spot size: " << "(" << focal_spot_size_.s[0]/mm << ", " << focal_spot_size_.s[1]/mm << ", " << focal_spot_size_.s[2]/mm << ") mm3" << GGendl;
     GGcout("GGEMSXRaySource", "PrintInfos", 0) << "* Transformation matrix: " << GGendl;
     GGcout("GGEMSXRaySource", "PrintInfos", 0) << "[" << GGendl;
-    GGcout("GGEMSXRaySource", "PrintInfos", 0) << "    " << transformation_matrix_device->m0_[0] << " " << transformation_matrix_device->m0_[1] << " " << transformation_matrix_device->m0_[2] << " " << transformation_matrix_device->m0_[3] << GGendl;
-    GGcout("GGEMSXRaySource", "PrintInfos", 0) << "    " << transformation_matrix_device->m1_[0] << " " << transformation_matrix_device->m1_[1] << " " << transformation_matrix_device->m1_[2] << " " << transformation_matrix_device->m1_[3] << GGendl;
-    GGcout("GGEMSXRaySource", "PrintInfos", 0) << "    " << transformation_matrix_device->m2_[0] << " " << transformation_matrix_device->m2_[1] << " " << transformation_matrix_device->m2_[2] << " " << transformation_matrix_device->m2_[3] << GGendl;
-    GGcout("GGEMSXRaySource", "PrintInfos", 0) << "    " << transformation_matrix_device->m3_[0] << " " << transformation_matrix_device->m3_[1] << " " << transformation_matrix_device->m3_[2] << " " << transformation_matrix_device->m3_[3] << GGendl;
+    GGcout("GGEMSXRaySource", "PrintInfos", 0) << "    " << transformation_matrix_device->local_to_global_.m0_[0] << " " << transformation_matrix_device->local_to_global_.m0_[1] << " " << transformation_matrix_device->local_to_global_.m0_[2] << " " << transformation_matrix_device->local_to_global_.m0_[3] << GGendl;
+    GGcout("GGEMSXRaySource", "PrintInfos", 0) << "    " << transformation_matrix_device->local_to_global_.m1_[0] << " " << transformation_matrix_device->local_to_global_.m1_[1] << " " << transformation_matrix_device->local_to_global_.m1_[2] << " " << transformation_matrix_device->local_to_global_.m1_[3] << GGendl;
+    GGcout("GGEMSXRaySource", "PrintInfos", 0) << "    " << transformation_matrix_device->local_to_global_.m2_[0] << " " << transformation_matrix_device->local_to_global_.m2_[1] << " " << transformation_matrix_device->local_to_global_.m2_[2] << " " << transformation_matrix_device->local_to_global_.m2_[3] << GGendl;
     GGcout("GGEMSXRaySource", "PrintInfos", 0) << "]" << GGendl;
     GGcout("GGEMSXRaySource", "PrintInfos", 0) << GGendl;
 